@@ -14,8 +14,10 @@
  * This module implements the top-level application state machine:
  * - Welcome screen
  * - Main menu
- * - Lists (songs / chord packs)
+ * - Lists (songs / rhythm songs / chord packs)
  * - Legend screen (custom LCD symbols)
+ * - Free play (live chord naming, freeplay.h)
+ * - Latency statistics screen (debug)
  * - Lesson runtime (song lesson or chord exercise)
  *
  * The UI is controlled via three buttons: RESET, NEXT, OK.
@@ -24,18 +26,25 @@
 /* Application state definitions for the menu/lesson state machine */
 typedef enum {
     APP_STATE_WELCOME = 0,     /* Welcome screen shown on startup */
-    APP_STATE_MENU_MAIN,       /* Main menu (3 entries) */
+    APP_STATE_MENU_MAIN,       /* Main menu (6 entries) */
     APP_STATE_MENU_SONGS,      /* Song selection list */
+    APP_STATE_MENU_RHYTHM,     /* Song selection list for rhythm lessons */
     APP_STATE_MENU_CHORDPACKS, /* Chord pack selection list */
     APP_STATE_VIEW_LEGEND,     /* Note symbols legend screen */
+    APP_STATE_VIEW_LATENCY,    /* Latency histogram summary (debug) */
+    APP_STATE_FREE_PLAY,       /* Free play: names the held chord */
     APP_STATE_LESSON_SONG,     /* Active song lesson */
+    APP_STATE_LESSON_RHYTHM,   /* Active rhythm lesson */
     APP_STATE_LESSON_CHORD     /* Active chord exercise */
 } AppState;
 
 /* Initialize the application state machine (must be called once at startup). */
 void App_Init(void);
 
-/* Process button inputs and update the state machine (call periodically in main loop). */
+/*
+ * Process button inputs and update the state machine (call periodically in main loop).
+ * Also sends LCD cells left over when the display queue was full.
+ */
 void App_Update(void);
 
 #endif /* APP_H */
@@ -0,0 +1,50 @@
+#ifndef BACKLIGHT_H
+#define BACKLIGHT_H
+
+#include <stdint.h>
+
+/**
+ * @file backlight.h
+ * @brief Lesson feedback on the Grove RGB backlight.
+ *
+ * Two layers:
+ * - base color: steady state, e.g. white in menus or the accuracy gradient
+ *   during a lesson (red below 50 %, through yellow, to green at 100 %),
+ * - flash: a short full-color pulse (green = correct, red = wrong, yellow =
+ *   right note at the wrong time in rhythm lessons) that falls back to the
+ *   base color when its timer-wheel timer expires.
+ *
+ * Every change goes to LcdQueue_SetBacklight(), which keeps only the latest
+ * color, so a flash plus a base update for the same note is one I2C write.
+ * Without an RGB module (other display backends) all calls do nothing.
+ */
+
+/** Backlight color, 0..255 per channel. */
+typedef struct
+{
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} BacklightColor;
+
+#define BACKLIGHT_WHITE     ((BacklightColor){ 255, 255, 255 })
+#define BACKLIGHT_GREEN     ((BacklightColor){ 0, 255, 0 })
+#define BACKLIGHT_RED       ((BacklightColor){ 255, 0, 0 })
+#define BACKLIGHT_YELLOW    ((BacklightColor){ 255, 255, 0 })
+
+/** Flash length: long enough to be seen across a classroom. */
+#define BACKLIGHT_FLASH_MS  (200U)
+
+/** @brief Show the base color (white). Call after the LCD queue is started. */
+void Backlight_Init(void);
+
+/** @brief Change the steady color (shown now, or when a running flash ends). */
+void Backlight_SetBase(BacklightColor color);
+
+/** @brief Show color for duration_ms, then return to the base color. */
+void Backlight_Flash(BacklightColor color, uint32_t duration_ms);
+
+/** @brief Accuracy gradient: 0..50 % red to yellow, 50..100 % yellow to green. */
+BacklightColor Backlight_Accuracy(uint32_t percent);
+
+#endif /* BACKLIGHT_H */
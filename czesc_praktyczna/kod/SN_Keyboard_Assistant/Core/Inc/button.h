@@ -9,7 +9,7 @@
  * @brief Debounced button input with edge (press) detection.
  *
  * The module provides:
- * - periodic debouncing via Button_Update()
+ * - periodic debouncing, sampled by a timer-wheel timer (no main-loop polling)
  * - one-shot press events via Button_WasPressed()
  */
 
@@ -26,22 +26,15 @@ typedef enum {
  *
  * GPIO is typically configured in CubeMX, but this function also configures the
  * pins as a safety net (input + pull-up).
+ * Also starts the periodic sampling timer, so TimerWheel_Init() must run first.
  */
 void Button_Init(void);
 
-/**
- * @brief Update debouncing and press-event detection.
- *
- * Must be called periodically (e.g., every main loop iteration) for correct
- * behavior.
- */
-void Button_Update(void);
-
 /**
  * @brief Return true once per physical press (edge-triggered).
  *
  * The event is latched and cleared on read.
- * Button_Update() must be called regularly for correct behavior.
+ * Sampling runs from TimerWheel_Process(), which must be called regularly.
  *
  * @param button Button identifier.
  * @return true if a new press event occurred since last call; otherwise false.
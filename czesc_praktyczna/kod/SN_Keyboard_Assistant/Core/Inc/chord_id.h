@@ -0,0 +1,89 @@
+#ifndef CHORD_ID_H
+#define CHORD_ID_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "chords.h"
+
+/**
+ * @file chord_id.h
+ * @brief Names the chord formed by a set of held keys (free-play mode).
+ *
+ * The held pitch classes are rotated so that the bass (lowest key) is bit 0.
+ * The resulting 12-bit mask indexes a 4096-entry table in flash
+ * (chord_table.c, generated by Tools/gen_chord_table.c):
+ * - masks with bit 0 set: chords that contain the bass (root position or an
+ *   inversion),
+ * - masks with bit 0 clear: chords above a foreign bass (slash chords); used
+ *   when the full mask is no chord, after removing the bass.
+ * So a lookup is a rotate and at most two table reads, whatever the number
+ * of keys. With the bass as part of the index, C E G A names as C6 over C
+ * and as Am7 over A.
+ *
+ * Entry layout (ChordTableEntry_t):
+ * - bits 0..3  : root, in semitones above the bass
+ * - bits 4..8  : ChordQuality (CHORD_Q_NONE = no chord)
+ * - bits 9..11 : ChordInversion
+ *
+ * The chord definitions live in chord_id.c and are shared with the
+ * generator. The table stores their hash; if it is stale, ChordId_Lookup()
+ * falls back to searching the definitions (a few hundred steps).
+ *
+ * HAL-free (also built into the host generator).
+ */
+
+/** Entries in the lookup table: one per 12-bit pitch-class mask. */
+#define CHORD_TABLE_SIZE      (4096U)
+
+/** Bump when the entry layout or the search rules change (mixed into the hash). */
+#define CHORD_ID_VERSION      (1U)
+
+/** Longest name from ChordId_Format(), e.g. "C#madd9/G#", with terminator. */
+#define CHORD_NAME_MAX        (12U)
+
+typedef uint16_t ChordTableEntry_t;
+
+#define CHORD_ENTRY_ROOT(e)       ((uint8_t)((e) & 0x0FU))
+#define CHORD_ENTRY_QUALITY(e)    ((ChordQuality)(((e) >> 4) & 0x1FU))
+#define CHORD_ENTRY_INVERSION(e)  ((ChordInversion)(((e) >> 9) & 0x07U))
+#define CHORD_ENTRY(root, quality, inversion) \
+    ((ChordTableEntry_t)(((root) & 0x0FU) | (((quality) & 0x1FU) << 4) | (((inversion) & 0x07U) << 9)))
+
+/* Generated table (chord_table.c) */
+extern const ChordTableEntry_t chordTable[CHORD_TABLE_SIZE];
+extern const uint32_t CHORD_TABLE_HASH;
+
+/**
+ * @brief Identify the chord formed by the held pitch classes.
+ *
+ * @param pcs     Held pitch classes (bit pc = pitch class pc).
+ * @param bass_pc Pitch class of the lowest held key (must be in pcs).
+ * @return Identified chord; quality is CHORD_Q_NONE for fewer than two
+ *         pitch classes or an unknown combination.
+ */
+ChordId ChordId_Lookup(uint16_t pcs, uint8_t bass_pc);
+
+/**
+ * @brief Table entry for a bass-relative mask, computed from the definitions.
+ *
+ * Used by the generator for every mask, and at runtime when the table is stale.
+ */
+ChordTableEntry_t ChordId_Search(uint16_t rel_mask);
+
+/** @brief Hash of the chord definitions and CHORD_ID_VERSION. */
+uint32_t ChordId_DefinitionHash(void);
+
+/** @brief Name suffix of a quality ("" for major, "m7", "sus4", ...). */
+const char *ChordId_QualityName(ChordQuality quality);
+
+/** @brief Pitch-class name as used in chords.c ("C", "C#", "Eb", ...). */
+const char *ChordId_PitchName(uint8_t pc);
+
+/**
+ * @brief Chord name with slash bass, e.g. "Am7", "C/E", "D/F#".
+ *
+ * @return Number of characters written (0 for CHORD_Q_NONE).
+ */
+size_t ChordId_Format(const ChordId *id, char *out, size_t size);
+
+#endif /* CHORD_ID_H */
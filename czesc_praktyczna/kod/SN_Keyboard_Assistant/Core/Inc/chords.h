@@ -13,25 +13,82 @@
  * NOTE:
  * - Chord notes reuse NoteEntry from songs.h (letter + accidental + midiNote placeholder).
  * - In chord mode, lesson.c matches played notes by pitch class (note % 12),
- *   so the octave is not important.
+ *   so the octave is not important (and a doubled tone is needed only once).
+ * - All chord data is const (flash only); tones are written with TONE().
  */
 
 /* Single chord definition (one exercise step) */
 typedef struct {
-    const char *name;     /* Chord name (e.g., "Am", "F#", "Bb") */
-    uint8_t noteCount;    /* Number of valid tones in notes[] */
-    NoteEntry notes[3];   /* Chord tones (up to 3) */
+    const char *name;       /* Chord name (e.g., "Am", "F#", "Bb7") */
+    uint8_t noteCount;      /* Number of tones in notes[] */
+    const NoteEntry *notes; /* Chord tones (any number; initialize with NOTES()) */
 } Chord;
 
 /* Chord pack (collection of chords) */
 typedef struct {
     const char *packName; /* Pack/category name shown in the UI */
     uint8_t chordCount;   /* Number of chords in the pack */
-    Chord *chords;        /* Pointer to chord array */
+    const Chord *chords;  /* Pointer to chord array */
 } ChordPack;
 
+/* Checked chord tone (NOTE() without MIDI note, length or timing) */
+#define TONE(l, acc)    NOTE(l, acc, -1, 0, 0, 0)
+
+/* Chord list initializer for ChordPack: "count, array" (1..255 chords). */
+#define CHORD_LIST(a)   STEPS(a)
+
+/*
+ * Chord qualities recognised by chord identification (chord_id.h), in
+ * priority order: when a set of keys has several readings, the earlier
+ * quality wins (after root position, see chord_id.c).
+ */
+typedef enum {
+    CHORD_Q_NONE = 0,  /* not a chord */
+    CHORD_Q_MAJOR,     /* C      */
+    CHORD_Q_MINOR,     /* Cm     */
+    CHORD_Q_DOM7,      /* C7     */
+    CHORD_Q_MAJ7,      /* Cmaj7  */
+    CHORD_Q_MIN7,      /* Cm7    */
+    CHORD_Q_SUS4,      /* Csus4  */
+    CHORD_Q_SUS2,      /* Csus2  */
+    CHORD_Q_DIM,       /* Cdim   */
+    CHORD_Q_AUG,       /* Caug   */
+    CHORD_Q_HALFDIM7,  /* Cm7b5  */
+    CHORD_Q_DIM7,      /* Cdim7  */
+    CHORD_Q_SIX,       /* C6     */
+    CHORD_Q_MIN6,      /* Cm6    */
+    CHORD_Q_MINMAJ7,   /* CmM7   */
+    CHORD_Q_DOM7SUS4,  /* C7sus4 */
+    CHORD_Q_AUG7,      /* C7#5   */
+    CHORD_Q_DOM9,      /* C9     */
+    CHORD_Q_MAJ9,      /* Cmaj9  */
+    CHORD_Q_MIN9,      /* Cm9    */
+    CHORD_Q_ADD9,      /* Cadd9  */
+    CHORD_Q_MINADD9,   /* Cmadd9 */
+    CHORD_Q_POWER,     /* C5     */
+    CHORD_Q_COUNT
+} ChordQuality;
+
+/* Which chord tone is in the bass */
+typedef enum {
+    CHORD_INV_ROOT = 0,  /* root position */
+    CHORD_INV_FIRST,     /* third in the bass */
+    CHORD_INV_SECOND,    /* fifth in the bass */
+    CHORD_INV_THIRD,     /* seventh (or sixth) in the bass */
+    CHORD_INV_OTHER,     /* another chord tone (9th, sus tone) in the bass */
+    CHORD_INV_SLASH      /* bass is not a chord tone (slash chord, e.g. C/F#) */
+} ChordInversion;
+
+/* Result of identifying a set of held keys */
+typedef struct {
+    ChordQuality quality;     /* CHORD_Q_NONE if the keys form no known chord */
+    uint8_t root;             /* Root pitch class (0 = C .. 11 = B) */
+    uint8_t bass;             /* Pitch class of the lowest key */
+    ChordInversion inversion;
+} ChordId;
+
 /* Expose chord packs list and count */
-extern ChordPack chordPacks[];
+extern const ChordPack chordPacks[];
 extern const uint8_t CHORD_PACK_COUNT;
 
 #endif /* CHORDS_H */
@@ -0,0 +1,78 @@
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include <stdint.h>
+
+#ifdef DISPLAY_HOST_BUILD
+/* Host builds without the HAL headers (Tools/oled_preview.c): same values as the HAL enum. */
+typedef enum { HAL_OK = 0x00, HAL_ERROR = 0x01, HAL_BUSY = 0x02, HAL_TIMEOUT = 0x03 } HAL_StatusTypeDef;
+#else
+#include "stm32l4xx_hal.h"
+#endif
+
+/**
+ * @file display.h
+ * @brief Character display interface (16x2, HD44780-style CGRAM).
+ *
+ * The UI never talks to a driver directly: the framebuffer (lcd_framebuffer.c)
+ * flushes through a Display_t, which is a small vtable plus a driver context.
+ *
+ * Implementations:
+ * - display_grove.c   : Grove I2C LCD through the asynchronous queue (lcd_queue.c)
+ * - display_hd44780.c : parallel HD44780 (lcd_hd44780.c), blocking
+ * - display_oled.c    : text rows on the 128x64 OLED (oled_ssd1306.c), asynchronous
+ * - display_virtual.c : in-memory panel that counts bus traffic; builds on the host
+ */
+
+/** Callback used by Display_Fence(). */
+typedef void (*DisplayCallback)(void *arg);
+
+/** Driver entry points; ctx is Display_t.ctx. */
+typedef struct
+{
+    /**
+     * Write len bytes starting at (row, col). All-or-nothing: HAL_BUSY means
+     * nothing was sent and the caller should retry later.
+     */
+    HAL_StatusTypeDef (*WriteAt)(void *ctx, uint8_t row, uint8_t col, const uint8_t *buf, uint8_t len);
+
+    /** Upload count consecutive CGRAM slots starting at firstSlot. */
+    HAL_StatusTypeDef (*CreateChars)(void *ctx, uint8_t firstSlot, const uint8_t patterns[][8], uint8_t count);
+
+    /** Run callback once everything written before it is on the panel. */
+    HAL_StatusTypeDef (*Fence)(void *ctx, DisplayCallback callback, void *arg);
+
+    /** Number of writes lost since the last call (panel contents unknown if != 0). */
+    uint32_t (*TakeErrors)(void *ctx);
+} DisplayOps_t;
+
+/** A display instance. */
+typedef struct
+{
+    const DisplayOps_t *ops;
+    void *ctx;
+} Display_t;
+
+static inline HAL_StatusTypeDef Display_WriteAt(Display_t *d, uint8_t row, uint8_t col,
+                                                const uint8_t *buf, uint8_t len)
+{
+    return d->ops->WriteAt(d->ctx, row, col, buf, len);
+}
+
+static inline HAL_StatusTypeDef Display_CreateChars(Display_t *d, uint8_t firstSlot,
+                                                    const uint8_t patterns[][8], uint8_t count)
+{
+    return d->ops->CreateChars(d->ctx, firstSlot, patterns, count);
+}
+
+static inline HAL_StatusTypeDef Display_Fence(Display_t *d, DisplayCallback callback, void *arg)
+{
+    return d->ops->Fence(d->ctx, callback, arg);
+}
+
+static inline uint32_t Display_TakeErrors(Display_t *d)
+{
+    return d->ops->TakeErrors(d->ctx);
+}
+
+#endif /* DISPLAY_H */
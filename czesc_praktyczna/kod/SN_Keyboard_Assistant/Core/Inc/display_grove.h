@@ -0,0 +1,32 @@
+#ifndef DISPLAY_GROVE_H
+#define DISPLAY_GROVE_H
+
+#include "display.h"
+#include "grove_lcd16x2_i2c.h"
+
+/**
+ * @file display_grove.h
+ * @brief Display_t backend for the Grove I2C LCD (asynchronous, via lcd_queue.c).
+ */
+
+/**
+ * @brief Bind a display to an initialized Grove LCD.
+ *
+ * Starts the LCD queue (LcdQueue_Init()); from then on the blocking
+ * GroveLCD_* calls must not be used.
+ */
+void DisplayGrove_Init(Display_t *display, GroveLCD_t *lcd);
+
+/**
+ * @brief Main-loop service: bus watchdog, recovery and panel re-initialization.
+ *
+ * - a DMA transfer hanging longer than I2C_BUS_XFER_TIMEOUT_MS trips the bus breaker,
+ * - while the breaker is open the bus is recovered and probed (I2cBus_Process()),
+ * - when the LCD answers again, the backlight and the panel are set up again and
+ *   the framebuffer redraws the screen, glyphs included.
+ *
+ * Costs nothing while the bus is healthy.
+ */
+void DisplayGrove_Service(void);
+
+#endif /* DISPLAY_GROVE_H */
@@ -0,0 +1,14 @@
+#ifndef DISPLAY_HD44780_H
+#define DISPLAY_HD44780_H
+
+#include "display.h"
+
+/**
+ * @file display_hd44780.h
+ * @brief Display_t backend for the parallel HD44780 driver (blocking).
+ */
+
+/** @brief Bind a display to the parallel LCD (call LCD_Init() first). */
+void DisplayHd44780_Init(Display_t *display);
+
+#endif /* DISPLAY_HD44780_H */
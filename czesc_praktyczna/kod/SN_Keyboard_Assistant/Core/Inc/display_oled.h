@@ -0,0 +1,33 @@
+#ifndef DISPLAY_OLED_H
+#define DISPLAY_OLED_H
+
+#include <stdint.h>
+#include "display.h"
+#include "oled_gfx.h"
+
+/**
+ * @file display_oled.h
+ * @brief Display_t backend for the 128x64 OLED (oled_ssd1306.c).
+ *
+ * The 16x2 character UI is drawn as text on page 0 (row 0) and page 7
+ * (row 1), 8 pixels per cell; CGRAM slots are emulated with the uploaded
+ * 5x8 patterns. Pages 1..6 are left to graphics such as the notation view
+ * (oled_staff.h).
+ */
+
+#define DISPLAY_OLED_ROWS   (2U)
+#define DISPLAY_OLED_COLS   (16U)
+#define DISPLAY_OLED_CELL_W (8)
+
+/** Backend state. */
+typedef struct
+{
+    OledGfx_t *gfx;
+    uint8_t cgram[8][8];                                    /**< Emulated CGRAM */
+    uint8_t cells[DISPLAY_OLED_ROWS][DISPLAY_OLED_COLS];    /**< Codes currently drawn */
+} DisplayOled_t;
+
+/** @brief Bind a display to an initialized OLED (after Oled_Init()). */
+void DisplayOled_Init(Display_t *display, DisplayOled_t *text, OledGfx_t *gfx);
+
+#endif /* DISPLAY_OLED_H */
@@ -0,0 +1,70 @@
+#ifndef DISPLAY_VIRTUAL_H
+#define DISPLAY_VIRTUAL_H
+
+#include <stdint.h>
+#include "display.h"
+
+/**
+ * @file display_virtual.h
+ * @brief Headless 16x2 display: keeps the panel in RAM and counts bus traffic.
+ *
+ * Has no hardware dependencies, so UI code (framebuffer + screens) can be
+ * checked on a PC: see Tools/display_bench.c (app and lesson screens) and
+ * Tools/oled_preview.c (-DDISPLAY_HOST_BUILD, no HAL headers needed).
+ *
+ * Traffic is modeled on the Grove I2C LCD:
+ * - cursor / CGRAM address command: 1 transaction, 3 bytes (address, control, command)
+ * - data burst of n bytes: 1 transaction, 2 + n bytes (address, control, data)
+ *
+ * Each Fence closes a "frame": the panel contents are appended to a small log.
+ */
+
+#define DISPLAY_VIRTUAL_ROWS       (2U)
+#define DISPLAY_VIRTUAL_COLS       (16U)
+#define DISPLAY_VIRTUAL_FRAME_LOG  (8U)
+
+/** Traffic counters (cumulative, cleared by DisplayVirtual_ResetStats()). */
+typedef struct
+{
+    uint32_t transactions;   /**< I2C transactions (START..STOP) */
+    uint32_t busBytes;       /**< Bytes on the wire incl. address and control bytes */
+    uint32_t cellsWritten;   /**< DDRAM cells written */
+    uint32_t cgramUploads;   /**< CGRAM slots uploaded */
+    uint32_t frames;         /**< Fences seen */
+} DisplayVirtualStats_t;
+
+/** Virtual panel state. */
+typedef struct
+{
+    uint8_t ddram[DISPLAY_VIRTUAL_ROWS][DISPLAY_VIRTUAL_COLS];
+    uint8_t cgram[8][8];
+    DisplayVirtualStats_t stats;
+
+    /** Last frames (panel snapshots at each fence), oldest overwritten first. */
+    uint8_t frameLog[DISPLAY_VIRTUAL_FRAME_LOG][DISPLAY_VIRTUAL_ROWS][DISPLAY_VIRTUAL_COLS];
+} DisplayVirtual_t;
+
+/** @brief Clear the panel (all spaces) and counters, and bind it to a display. */
+void DisplayVirtual_Init(Display_t *display, DisplayVirtual_t *panel);
+
+/** @brief Zero the traffic counters (the panel contents are kept). */
+void DisplayVirtual_ResetStats(DisplayVirtual_t *panel);
+
+/**
+ * @brief Copy one row as a printable string.
+ *
+ * Custom characters (bytes 0..7) are shown as '~' so rows can be compared
+ * with plain strings; the frame log keeps the raw bytes.
+ *
+ * @param out At least DISPLAY_VIRTUAL_COLS + 1 bytes.
+ */
+void DisplayVirtual_Row(const DisplayVirtual_t *panel, uint8_t row, char *out);
+
+/**
+ * @brief Frame from the log: age 0 = last fence, 1 = the one before, ...
+ *
+ * @return NULL if fewer frames were recorded.
+ */
+const uint8_t (*DisplayVirtual_Frame(const DisplayVirtual_t *panel, uint32_t age))[DISPLAY_VIRTUAL_COLS];
+
+#endif /* DISPLAY_VIRTUAL_H */
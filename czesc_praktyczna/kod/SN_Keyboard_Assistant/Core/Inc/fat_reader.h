@@ -0,0 +1,179 @@
+#ifndef FAT_READER_H
+#define FAT_READER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "smf_reader.h"
+
+/**
+ * @file fat_reader.h
+ * @brief Read-only FAT12 / FAT16 / FAT32 file system (USB sticks, disk images).
+ *
+ * The volume is either the whole disk ("superfloppy") or the first FAT
+ * partition of an MBR. Only 512-byte sectors are supported; long file
+ * names are read (ASCII part; other characters become '?').
+ *
+ * Sectors of the FAT and of directories go through a small LRU cache of
+ * FAT_CACHE_SECTORS sectors. File data is not cached: Fat_Read() reads
+ * whole sectors straight into the caller's buffer, as many at a time as
+ * lie one after another on the disk (one command per contiguous run).
+ *
+ * To know the runs, an open file keeps an extent table: the cluster chain
+ * is followed ahead of the reads, FAT_EXTENTS runs at a time, while the
+ * FAT sector is in the cache (cluster-chain prefetch). A file written in
+ * one go is a single run, so it is read with a few large commands and one
+ * or two FAT sectors, however long its chain is.
+ *
+ * Fat_Run() gives the run at an offset, so a caller can queue the next
+ * read on FatDisk.start while it works on the previous one (song_import.h).
+ *
+ * HAL-free (also built into the host tools).
+ */
+
+#define FAT_SECTOR_SIZE     (512U)
+
+/** Cached FAT / directory sectors. */
+#ifndef FAT_CACHE_SECTORS
+#define FAT_CACHE_SECTORS   (4U)
+#endif
+
+/** Contiguous runs of a file known ahead of the reads. */
+#define FAT_EXTENTS         (8U)
+
+/** Longest name kept (longer long names are cut). */
+#define FAT_NAME_MAX        (64U)
+
+/** Most sectors in one read command of Fat_Read(). */
+#define FAT_MAX_READ_SECTORS (64U)
+
+/** FatEntry.attr bits */
+#define FAT_ATTR_READ_ONLY  (0x01U)
+#define FAT_ATTR_HIDDEN     (0x02U)
+#define FAT_ATTR_SYSTEM     (0x04U)
+#define FAT_ATTR_VOLUME_ID  (0x08U)
+#define FAT_ATTR_DIRECTORY  (0x10U)
+#define FAT_ATTR_ARCHIVE    (0x20U)
+
+typedef enum {
+    FAT_OK = 0,
+    FAT_END,                     /* no more directory entries */
+    FAT_ERR_IO,                  /* disk read failed */
+    FAT_ERR_NO_FS,               /* no FAT volume found */
+    FAT_ERR_UNSUPPORTED,         /* sector size other than 512 */
+    FAT_ERR_NOT_FOUND,
+    FAT_ERR_CORRUPT,             /* broken cluster chain, offset past the end */
+    FAT_ERR_NOT_DIR
+} FatStatus;
+
+/** FatDisk.poll() result */
+typedef enum {
+    FAT_DISK_BUSY = 0,
+    FAT_DISK_DONE,
+    FAT_DISK_FAILED
+} FatDiskState;
+
+/**
+ * Sector access. read() is blocking; start() / poll() are the same read
+ * split in two (optional, NULL when the disk has no background transfers).
+ * count is at most FAT_MAX_READ_SECTORS.
+ */
+typedef struct {
+    bool (*read)(void *ctx, uint32_t lba, uint8_t *buf, uint16_t count);
+    bool (*start)(void *ctx, uint32_t lba, uint8_t *buf, uint16_t count);
+    FatDiskState (*poll)(void *ctx);
+    void *ctx;
+} FatDisk;
+
+typedef struct {
+    uint32_t lba;                /* UINT32_MAX = empty */
+    uint32_t lastUse;
+    uint8_t data[FAT_SECTOR_SIZE];
+} FatCacheSector;
+
+typedef struct {
+    FatDisk disk;
+    uint8_t type;                /* 12, 16 or 32 */
+    uint8_t sectorsPerCluster;
+    uint32_t fatLba;             /* first FAT */
+    uint32_t rootLba;            /* FAT12 / FAT16: fixed root directory */
+    uint32_t rootSectors;
+    uint32_t rootCluster;        /* FAT32 */
+    uint32_t dataLba;            /* cluster 2 */
+    uint32_t clusterCount;
+
+    FatCacheSector cache[FAT_CACHE_SECTORS];
+    uint32_t useClock;
+
+    /* Statistics: read commands and sectors read, cached sector hits */
+    uint32_t reads;
+    uint32_t sectorsRead;
+    uint32_t cacheHits;
+} FatVolume;
+
+/** A run of clusters of a file. */
+typedef struct {
+    uint32_t fileCluster;        /* index of its first cluster in the file */
+    uint32_t cluster;            /* first cluster on the disk */
+    uint32_t count;
+} FatExtent;
+
+/** An open file or directory. */
+typedef struct {
+    FatVolume *vol;
+    uint32_t firstCluster;
+    uint32_t size;               /* bytes (0 for directories) */
+    bool isDir;
+    bool fixedRoot;              /* FAT12 / FAT16 root directory */
+    uint32_t pos;                /* directories: next entry (byte offset) */
+
+    FatExtent ext[FAT_EXTENTS];
+    uint8_t extCount;
+    uint32_t nextCluster;        /* chain after the last extent, 0 = ends there */
+} FatFile;
+
+/** A directory entry. */
+typedef struct {
+    char name[FAT_NAME_MAX];     /* long name, or the short name */
+    char shortName[13];          /* 8.3, e.g. "SONG~1.MID" */
+    uint8_t attr;
+    uint32_t cluster;
+    uint32_t size;
+} FatEntry;
+
+/** @brief Find the FAT volume on the disk and read its boot sector. */
+FatStatus Fat_Mount(FatVolume *vol, const FatDisk *disk);
+
+/** @brief Open the root directory. */
+void Fat_OpenRoot(FatVolume *vol, FatFile *dir);
+
+/** @brief Open a file or directory found with Fat_NextEntry() / Fat_Find(). */
+void Fat_Open(FatVolume *vol, const FatEntry *entry, FatFile *file);
+
+/**
+ * @brief Next entry of a directory ("." / ".." and volume labels are skipped).
+ *
+ * @return FAT_OK, FAT_END after the last entry, or an error.
+ */
+FatStatus Fat_NextEntry(FatFile *dir, FatEntry *entry);
+
+/** @brief Start reading a directory from its first entry again. */
+void Fat_Rewind(FatFile *dir);
+
+/** @brief Find an entry by long or short name (case-insensitive; rewinds dir). */
+FatStatus Fat_Find(FatFile *dir, const char *name, FatEntry *entry);
+
+/** @brief Read len bytes at offset (within the file size). */
+FatStatus Fat_Read(FatFile *file, uint32_t offset, uint8_t *buf, uint32_t len);
+
+/**
+ * @brief Disk position of the sector holding offset, and how many sectors
+ *        from there lie one after another (at least 1).
+ *
+ * @return 0 sectors if offset is past the end or the chain is broken.
+ */
+uint32_t Fat_Run(FatFile *file, uint32_t offset, uint32_t *lba);
+
+/** @brief File as an SmfSource (read callback, ctx = file, which must stay valid). */
+void Fat_Source(FatFile *file, SmfSource *src);
+
+#endif /* FAT_READER_H */
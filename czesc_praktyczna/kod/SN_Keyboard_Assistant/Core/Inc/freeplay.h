@@ -0,0 +1,33 @@
+#ifndef FREEPLAY_H
+#define FREEPLAY_H
+
+#include <stdbool.h>
+
+/*
+ * freeplay.h / freeplay.c
+ *
+ * Free-play mode: no exercise, the LCD names whatever the student holds.
+ * - Row 0: chord name with slash bass (e.g. "Am7", "C/E", "G7/F"), or the
+ *   held pitch classes from the bass upwards if they form no known chord
+ * - Row 1: inversion ("root position", "1st inversion", ...) or "no chord"
+ *
+ * Naming is a table lookup (chord_id.h) on the held-key state
+ * (held_notes.h), so it is refreshed on every NOTE ON / NOTE OFF.
+ */
+
+/* Enter free play and draw the current keys. */
+void FreePlay_Start(void);
+
+/* Leave free play (the caller draws the next screen). */
+void FreePlay_Stop(void);
+
+/* Returns true while free play is shown. */
+bool FreePlay_IsActive(void);
+
+/*
+ * Redraw after a key event (call after HeldNotes_On() / HeldNotes_Off()).
+ * Does nothing when free play is not active or the name did not change.
+ */
+void FreePlay_Update(void);
+
+#endif /* FREEPLAY_H */
@@ -0,0 +1,78 @@
+#ifndef GLYPHS_H
+#define GLYPHS_H
+
+#include <stdint.h>
+#include "display.h"
+
+/**
+ * @file glyphs.h
+ * @brief Custom LCD symbols and their on-demand mapping to the 8 CGRAM slots.
+ *
+ * The UI draws glyphs by ID (LcdFb_WriteGlyph()); framebuffer cells with a
+ * code below 0x20 hold a GlyphId (ROM characters 0x00..0x1F are CGRAM mirrors
+ * or blank, so they are never needed as text).
+ *
+ * Before each flush the framebuffer calls Glyphs_Prepare() with the set of
+ * glyphs on screen:
+ * - glyphs already resident in CGRAM keep their slot (no upload),
+ * - missing glyphs take a free slot or evict the least recently used slot
+ *   that the current frame does not need,
+ * - all new patterns are uploaded in a single CreateChars burst.
+ *
+ * If one frame needs more than 8 different glyphs, the extra ones are shown
+ * with an ASCII fallback character.
+ */
+
+/** Glyph IDs. Values 0..4 are the note-length icons used in songs.c. */
+typedef enum {
+    GLYPH_WHOLE = 0,
+    GLYPH_HALF,
+    GLYPH_QUARTER,
+    GLYPH_EIGHTH,
+    GLYPH_SIXTEENTH,
+    GLYPH_SHARP,
+    GLYPH_FLAT,
+    GLYPH_NATURAL,
+    GLYPH_DOT,            /**< Augmentation dot (dotted notes) */
+    GLYPH_REST_QUARTER,
+    GLYPH_REST_EIGHTH,
+    GLYPH_TIE,
+    GLYPH_CLEF,           /**< Treble clef (stylized) */
+    GLYPH_BAR_1,          /**< Progress bar cell, 1 of 5 columns filled */
+    GLYPH_BAR_2,
+    GLYPH_BAR_3,
+    GLYPH_BAR_4,
+    GLYPH_BAR_5,          /**< Progress bar cell, full */
+    GLYPH_CHECK,
+    GLYPH_CROSS,
+    GLYPH_COUNT
+} GlyphId;
+
+/** Number of CGRAM slots on an HD44780-compatible controller. */
+#define GLYPH_SLOTS   (8U)
+
+/** @brief Forget all slot assignments (CGRAM contents unknown). */
+void Glyphs_Init(void);
+
+/** @brief Same as Glyphs_Init(); used when the panel state is lost. */
+void Glyphs_Invalidate(void);
+
+/**
+ * @brief Make the given glyphs resident in CGRAM.
+ *
+ * @param display   Target display.
+ * @param usedMask  Bit g set = glyph g appears in the frame to be flushed.
+ * @return HAL_OK, or the display's error (e.g. HAL_BUSY); nothing is marked
+ *         resident on failure, so the next call retries.
+ */
+HAL_StatusTypeDef Glyphs_Prepare(Display_t *display, uint32_t usedMask);
+
+/**
+ * @brief Byte to send for a glyph: its CGRAM slot if resident, else its ASCII fallback.
+ */
+uint8_t Glyphs_Code(uint8_t glyph);
+
+/** @brief Number of CGRAM slots uploaded since Glyphs_Init() (for benchmarks). */
+uint32_t Glyphs_UploadCount(void);
+
+#endif /* GLYPHS_H */
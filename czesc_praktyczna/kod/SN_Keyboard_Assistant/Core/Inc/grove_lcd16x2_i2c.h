@@ -18,11 +18,66 @@ extern "C" {
  * - Command "register": 0x80
  * - Data "register":    0x40
  *
- * The driver uses HAL_I2C_Mem_Write() to write a single command or data byte.
+ * The driver uses HAL_I2C_Mem_Write() transactions: one command byte per
+ * transaction, while data (DDRAM text or CGRAM patterns) is streamed as a burst
+ * after a single data-register control byte.
+ *
+ * Every LCD write reports to the bus health tracker (i2c_bus.h) and fails
+ * with HAL_ERROR at once while its breaker is open, so a missing display
+ * cannot stall the caller.
+ *
+ * RGB modules (Grove LCD RGB Backlight v4) have a second device on the bus:
+ * a PCA9632 LED driver at 0x62 whose PWM0..PWM2 outputs drive the blue, green
+ * and red backlight LEDs. It is set up by GroveLCD_InitBacklight(); a color
+ * is one 3-byte auto-increment write starting at PWM0.
  */
 
 #define GROVE_LCD_I2C_ADDR_7BIT_DEFAULT   (0x3E)
 
+/* I2C control bytes ("registers") */
+#define GROVE_LCD_REG_CMD                 (0x80)
+#define GROVE_LCD_REG_DATA                (0x40)
+
+/* RGB backlight controller (PCA9632) */
+#define GROVE_RGB_I2C_ADDR_7BIT_DEFAULT   (0x62)
+#define GROVE_RGB_REG_MODE1               (0x00)
+#define GROVE_RGB_REG_MODE2               (0x01)
+#define GROVE_RGB_REG_PWM_BLUE            (0x02)   /* PWM0; PWM1 = green, PWM2 = red */
+#define GROVE_RGB_REG_LEDOUT              (0x08)
+#define GROVE_RGB_AUTO_INC                (0x80)   /* control byte flag: auto-increment */
+
+/* HD44780 commands shared with the asynchronous queue (lcd_queue.c) */
+#define GROVE_LCD_CMD_CLEAR               (0x01)
+#define GROVE_LCD_CMD_HOME                (0x02)
+#define GROVE_LCD_CMD_SET_CGRAM           (0x40)
+#define GROVE_LCD_CMD_SET_DDRAM           (0x80)
+#define GROVE_LCD_CMD_FUNCTION_2LINE      (0x28)   /* function set: 2 lines, 5x8 dots */
+#define GROVE_LCD_CMD_DISPLAY_ON          (0x0C)   /* display on, cursor and blink off */
+#define GROVE_LCD_CMD_ENTRY_INC           (0x06)   /* entry mode: increment, no shift */
+
+/*
+ * Controller execution times (AiP31068 / HD44780 datasheets, with margin).
+ */
+#define GROVE_LCD_EXEC_LONG_US            (1600U)  /* clear / home: 1.52 ms */
+#define GROVE_LCD_EXEC_SHORT_US           (50U)    /* other commands: 37..39 us */
+#define GROVE_LCD_POWERUP_US              (50000U) /* >40 ms after VDD rises */
+
+/**
+ * Blocking transfer timeout. The longest write (8 CGRAM slots, 66 bytes) takes
+ * ~6 ms at 100 kHz; a missing device NACKs at once, so this only bounds a hung bus.
+ */
+#define GROVE_LCD_TIMEOUT_MS              (10U)
+
+/** Number of columns per LCD row. */
+#define GROVE_LCD_COLS                    (16U)
+
+/**
+ * Set to 1 to build GroveLCD_Benchmark() (per-byte vs burst timing over SWO).
+ */
+#ifndef GROVE_LCD_ENABLE_BENCHMARK
+#define GROVE_LCD_ENABLE_BENCHMARK        0
+#endif
+
 /**
  * @brief Driver context for a single LCD instance.
  */
@@ -31,6 +86,7 @@ typedef struct
     I2C_HandleTypeDef *hi2c;   /**< HAL I2C handle used for communication */
     uint8_t addr_7bit;         /**< 7-bit I2C address (e.g. 0x3E) */
     uint32_t timeout_ms;       /**< HAL I2C timeout in milliseconds */
+    uint8_t rgb_addr_7bit;     /**< Backlight controller address, 0 = no RGB backlight */
 } GroveLCD_t;
 
 /* --- Public API --- */
@@ -62,9 +118,28 @@ HAL_StatusTypeDef GroveLCD_SetCursor(GroveLCD_t *lcd, uint8_t row, uint8_t col);
 /** @brief Write a single character at the current cursor position. */
 HAL_StatusTypeDef GroveLCD_WriteChar(GroveLCD_t *lcd, char c);
 
-/** @brief Write a null-terminated string starting at the current cursor position. */
+/**
+ * @brief Write a null-terminated string starting at the current cursor position.
+ *
+ * The whole string is sent in one I2C transaction.
+ */
 HAL_StatusTypeDef GroveLCD_Print(GroveLCD_t *lcd, const char *s);
 
+/**
+ * @brief Write raw bytes at the current cursor position in one I2C transaction.
+ *
+ * Unlike GroveLCD_Print(), the buffer may contain 0x00 (custom character slot 0).
+ */
+HAL_StatusTypeDef GroveLCD_WriteBuffer(GroveLCD_t *lcd, const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief Replace a whole row: set the cursor to column 0 and send 16 bytes.
+ *
+ * Text shorter than 16 characters is padded with spaces, longer text is clipped.
+ * Costs one command transaction plus one data burst.
+ */
+HAL_StatusTypeDef GroveLCD_WriteRow(GroveLCD_t *lcd, uint8_t row, const char *text);
+
 /**
  * @brief Define a custom character in CGRAM (slot 0..7).
  *
@@ -72,6 +147,57 @@ HAL_StatusTypeDef GroveLCD_Print(GroveLCD_t *lcd, const char *s);
  */
 HAL_StatusTypeDef GroveLCD_CreateChar(GroveLCD_t *lcd, uint8_t slot, const uint8_t pattern[8]);
 
+/**
+ * @brief Upload several consecutive CGRAM slots in a single data burst.
+ *
+ * @param firstSlot First slot (0..7).
+ * @param patterns  count patterns of 8 rows each.
+ * @param count     Number of slots; firstSlot + count must not exceed 8.
+ */
+HAL_StatusTypeDef GroveLCD_CreateChars(GroveLCD_t *lcd, uint8_t firstSlot,
+                                       const uint8_t patterns[][8], uint8_t count);
+
+/**
+ * @brief Detect and set up the RGB backlight controller; the backlight is turned white.
+ *
+ * On modules without one (plain Grove LCD) the write is not acknowledged:
+ * rgb_addr_7bit stays 0 and an error is returned, the LCD itself keeps working.
+ */
+HAL_StatusTypeDef GroveLCD_InitBacklight(GroveLCD_t *lcd, uint8_t rgb_addr_7bit);
+
+/** @brief Set the backlight color (blocking; one 3-byte write). */
+HAL_StatusTypeDef GroveLCD_SetRGB(GroveLCD_t *lcd, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief PWM register payload for a color, in PCA9632 register order (blue, green, red).
+ *
+ * Write it to GROVE_RGB_REG_PWM_BLUE | GROVE_RGB_AUTO_INC.
+ */
+static inline void GroveLCD_RgbPayload(uint8_t r, uint8_t g, uint8_t b, uint8_t out[3])
+{
+    out[0] = b;
+    out[1] = g;
+    out[2] = r;
+}
+
+/**
+ * @brief "Set DDRAM address" command for a cell (row 0 -> 0x00.., row 1 -> 0x40..).
+ */
+static inline uint8_t GroveLCD_CursorCmd(uint8_t row, uint8_t col)
+{
+    uint8_t base = (row == 0) ? 0x00 : 0x40;
+    return (uint8_t)(GROVE_LCD_CMD_SET_DDRAM | (base + (col & 0x0F)));
+}
+
+#if GROVE_LCD_ENABLE_BENCHMARK
+/**
+ * @brief Time a 16-character row write per byte vs as one burst; prints over SWO.
+ *
+ * Writes row 0 of the display and clears the display when done.
+ */
+void GroveLCD_Benchmark(GroveLCD_t *lcd);
+#endif
+
 /* Optional helpers */
 HAL_StatusTypeDef GroveLCD_DisplayOn(GroveLCD_t *lcd);
 HAL_StatusTypeDef GroveLCD_DisplayOff(GroveLCD_t *lcd);
@@ -0,0 +1,61 @@
+#ifndef HELD_NOTES_H
+#define HELD_NOTES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "note_mask.h"
+
+/**
+ * @file held_notes.h
+ * @brief Keys currently held on the MIDI keyboard, with their onset times.
+ *
+ * Fed from the main loop with every NOTE ON / NOTE OFF (NOTE ON with
+ * velocity 0 is a NOTE OFF). Keeps:
+ * - a 128-bit mask of held notes,
+ * - the onset timestamp of each held note,
+ * - per pitch class: how many keys of it are held, the resulting 12-bit
+ *   pitch-class mask, and the latest onset among its held keys.
+ *
+ * Every update touches a bounded number of entries (at most the 11 octaves
+ * of one pitch class), so it is O(1) per event regardless of how many keys
+ * are down.
+ *
+ * Timestamps are supplied by the caller (Timebase_Micros() on the target),
+ * so the module is HAL-free.
+ */
+
+/** @brief Forget all held notes (start-up, keyboard disconnected). */
+void HeldNotes_Reset(void);
+
+/** @brief Key pressed at time t_us (a repeated NOTE ON restarts its onset). */
+void HeldNotes_On(uint8_t note, uint32_t t_us);
+
+/** @brief Key released (ignored if it was not held). */
+void HeldNotes_Off(uint8_t note);
+
+/** @brief Held notes as a 128-bit mask. */
+const NoteMask128_t *HeldNotes_Mask(void);
+
+/** @brief Pitch classes with at least one held key. */
+uint16_t HeldNotes_PitchClasses(void);
+
+/** @brief Number of held keys. */
+uint8_t HeldNotes_Count(void);
+
+/** @brief Onset time of a key (valid while it is held; last NOTE ON otherwise). */
+uint32_t HeldNotes_Onset(uint8_t note);
+
+/**
+ * @brief Onset spread of a set of pitch classes that are all held.
+ *
+ * For each pitch class the most recently pressed held key counts (so a
+ * re-struck chord is judged by the new attack). The spread is the time
+ * between the first and the last of these onsets.
+ *
+ * @param pcs       Pitch classes to check.
+ * @param spread_us Out: spread in microseconds (valid when true is returned).
+ * @return true if every pitch class in pcs is held.
+ */
+bool HeldNotes_Spread(uint16_t pcs, uint32_t *spread_us);
+
+#endif /* HELD_NOTES_H */
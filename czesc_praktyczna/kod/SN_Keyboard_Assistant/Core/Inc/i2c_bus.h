@@ -0,0 +1,104 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32l4xx_hal.h"
+
+/**
+ * @file i2c_bus.h
+ * @brief I2C1 bus health: circuit breaker, bus recovery and re-probing.
+ *
+ * Every LCD transfer reports its outcome with I2cBus_Report(). After
+ * I2C_BUS_FAIL_THRESHOLD failures in a row the breaker opens:
+ * - I2cBus_Allow() returns false and the LCD drivers fail immediately with
+ *   HAL_ERROR instead of waiting for NACKs or timeouts on a dead bus,
+ * - the main loop (I2cBus_Process()) periodically recovers the bus and probes
+ *   the device; the interval doubles after each failed probe, from
+ *   I2C_BUS_PROBE_MIN_MS up to I2C_BUS_PROBE_MAX_MS.
+ *
+ * Recovery: a slave that was interrupted mid-byte (cable pulled, reset during
+ * a transfer) can hold SDA low forever. The peripheral is released, SCL is
+ * clocked as a GPIO until SDA goes high (at most 9 pulses), a STOP condition
+ * is generated and I2C1 is initialized again.
+ *
+ * A successful probe closes the breaker and makes I2cBus_Process() return
+ * true once, so the owner can set the device up again (a re-plugged module
+ * has been power-cycled).
+ *
+ * Pins default to the I2C1 pins configured in stm32l4xx_hal_msp.c.
+ */
+
+#ifndef I2C_BUS_SCL_Pin
+#define I2C_BUS_SCL_GPIO_Port     GPIOB
+#define I2C_BUS_SCL_Pin           GPIO_PIN_6
+#endif
+
+#ifndef I2C_BUS_SDA_Pin
+#define I2C_BUS_SDA_GPIO_Port     GPIOB
+#define I2C_BUS_SDA_Pin           GPIO_PIN_7
+#endif
+
+/** Consecutive failed transfers that open the breaker. */
+#define I2C_BUS_FAIL_THRESHOLD    (3U)
+
+/** First re-probe delay after the breaker opened, and the backoff cap. */
+#define I2C_BUS_PROBE_MIN_MS      (250U)
+#define I2C_BUS_PROBE_MAX_MS      (4000U)
+
+/** Timeout of the probe (address-only write); a present device ACKs in ~100 us. */
+#define I2C_BUS_PROBE_TIMEOUT_MS  (2U)
+
+/** A DMA transfer taking longer than this is considered hung (longest LCD write is ~2 ms). */
+#define I2C_BUS_XFER_TIMEOUT_MS   (20U)
+
+/** Counters for diagnostics. */
+typedef struct
+{
+    uint32_t failures;     /**< Failed transfers reported */
+    uint32_t trips;        /**< Times the breaker opened */
+    uint32_t recoveries;   /**< Successful probes (breaker closed again) */
+} I2cBusStats_t;
+
+/**
+ * @brief Start tracking a bus (after MX_I2C1_Init()).
+ *
+ * @param hi2c            Bus handle (its Init settings are reused after recovery).
+ * @param probe_addr_7bit Device whose ACK means "bus usable again".
+ */
+void I2cBus_Init(I2C_HandleTypeDef *hi2c, uint8_t probe_addr_7bit);
+
+/** @brief True while transfers may be started (breaker closed, or not initialized). */
+bool I2cBus_Allow(void);
+
+/**
+ * @brief Record the outcome of one transfer (callable from interrupts).
+ *
+ * @param st HAL_OK resets the failure count; anything else counts as a failure.
+ */
+void I2cBus_Report(HAL_StatusTypeDef st);
+
+/** @brief Open the breaker now and recover on the next I2cBus_Process() (hung transfer). */
+void I2cBus_Trip(void);
+
+/**
+ * @brief Main-loop service: recovers and probes when a probe is due.
+ *
+ * Blocks for at most ~I2C_BUS_PROBE_TIMEOUT_MS per probe; returns
+ * immediately while the breaker is closed.
+ *
+ * @return true once after the bus came back (breaker just closed).
+ */
+bool I2cBus_Process(void);
+
+/**
+ * @brief Free a stuck bus (SCL pulses + STOP) and re-initialize the peripheral.
+ *
+ * Must not be called while a transfer is in flight.
+ */
+HAL_StatusTypeDef I2cBus_Recover(void);
+
+/** @brief Copy of the diagnostic counters. */
+I2cBusStats_t I2cBus_Stats(void);
+
+#endif /* I2C_BUS_H */
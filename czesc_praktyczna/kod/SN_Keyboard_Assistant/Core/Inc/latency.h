@@ -0,0 +1,110 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32l4xx.h"   /* DWT / CoreDebug (CMSIS) */
+
+/**
+ * @file latency.h
+ * @brief Always-on input-to-feedback latency instrumentation.
+ *
+ * Every MIDI event is timestamped with the DWT cycle counter when its USB
+ * packet completes (URB done). As the event travels through the firmware,
+ * each stage records "cycles since URB done" into its own histogram:
+ *
+ *   URB done -> DEQUEUED -> EVALUATED -> LED switched -> LCD updated
+ *
+ * Histograms are log2-scaled: bucket 0 holds 0 cycles, bucket i (i >= 1)
+ * holds [2^(i-1), 2^i) cycles. Each stage is recorded at most once per event.
+ *
+ * Results can be read on the device (Latency menu) or dumped over SWO with
+ * Latency_Dump(); Tools/plot_latency.py turns a captured dump into plots.
+ */
+
+#define LATENCY_BUCKETS   (32U)
+
+/** Measured stages (all relative to URB completion). */
+typedef enum {
+    LAT_STAGE_DEQUEUED = 0,  /**< Event popped from the MIDI FIFO in main loop */
+    LAT_STAGE_EVALUATED,     /**< Lesson engine decided correct / wrong */
+    LAT_STAGE_LED,           /**< Feedback LED switched on */
+    LAT_STAGE_LCD,           /**< Last I2C transfer of the new screen completed */
+    LAT_STAGE_COUNT
+} LatencyStage;
+
+/** Histogram and summary counters for one stage. */
+typedef struct {
+    uint32_t count;                     /**< Number of samples */
+    uint32_t minCycles;                 /**< Fastest sample */
+    uint32_t maxCycles;                 /**< Slowest sample */
+    uint32_t bucket[LATENCY_BUCKETS];   /**< log2 histogram */
+} LatencyHistogram_t;
+
+/** @brief Current DWT cycle count (timestamp for Latency_BeginEvent()). */
+static inline uint32_t Latency_Now(void)
+{
+    return DWT->CYCCNT;
+}
+
+/** @brief Enable the DWT cycle counter and clear all histograms. */
+void Latency_Init(void);
+
+/** @brief Clear all histograms. */
+void Latency_Reset(void);
+
+/**
+ * @brief Open a new event.
+ *
+ * @param urbStamp Latency_Now() value captured when the USB packet completed.
+ *                 Records the DEQUEUED stage immediately.
+ */
+void Latency_BeginEvent(uint32_t urbStamp);
+
+/** @brief Record a stage for the currently open event (no-op if none is open). */
+void Latency_Mark(LatencyStage stage);
+
+/**
+ * @brief Claim a stage of the open event that completes asynchronously.
+ *
+ * Marks the stage as taken (later Latency_Mark() calls are ignored) and
+ * returns the event origin for Latency_RecordSince().
+ *
+ * @return false if no event is open or the stage was already recorded.
+ */
+bool Latency_Defer(LatencyStage stage, uint32_t *origin);
+
+/**
+ * @brief Record a deferred stage (may be called from an interrupt).
+ *
+ * @param origin Value returned by Latency_Defer().
+ */
+void Latency_RecordSince(LatencyStage stage, uint32_t origin);
+
+/** @brief Close the current event; later marks are ignored until the next begin. */
+void Latency_EndEvent(void);
+
+/** @brief Read-only access to one stage histogram. */
+const LatencyHistogram_t *Latency_GetHistogram(LatencyStage stage);
+
+/** @brief Short stage name ("DEQ", "EVAL", "LED", "LCD"). */
+const char *Latency_StageName(LatencyStage stage);
+
+/**
+ * @brief Approximate percentile in microseconds (upper edge of the bucket).
+ *
+ * @param stage   Stage to query.
+ * @param percent 1..100.
+ * @return Latency in us, or 0 if the stage has no samples.
+ */
+uint32_t Latency_PercentileUs(LatencyStage stage, uint8_t percent);
+
+/**
+ * @brief Print all histograms over printf (SWV/ITM).
+ *
+ * One line per stage, parsed by Tools/plot_latency.py:
+ *   LAT <stage> hz=<cpu> n=<count> min=<cyc> max=<cyc> h=<b0>,<b1>,...,<b31>
+ */
+void Latency_Dump(void);
+
+#endif /* LATENCY_H */
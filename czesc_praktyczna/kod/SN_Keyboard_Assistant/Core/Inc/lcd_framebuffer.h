@@ -0,0 +1,103 @@
+#ifndef LCD_FRAMEBUFFER_H
+#define LCD_FRAMEBUFFER_H
+
+#include <stdint.h>
+#include "display.h"
+#include "glyphs.h"
+
+/**
+ * @file lcd_framebuffer.h
+ * @brief 2x16 shadow framebuffer with diff-based flushing.
+ *
+ * Screens are composed in RAM (LcdFb_Clear/SetCursor/Print/WriteChar) and then
+ * sent with LcdFb_Flush(). The module keeps a copy of what the panel currently
+ * shows, so a flush only transmits the cells that changed:
+ * - changed cells in a row are grouped into runs,
+ * - each run costs one DDRAM address command plus one data burst,
+ * - runs separated by at most LCDFB_MERGE_GAP unchanged cells are merged
+ *   (re-sending a few cells is cheaper than another address command).
+ *
+ * Runs are written through the Display_t interface (display.h). With the Grove
+ * backend they go to the asynchronous LCD queue, so a flush only copies a few
+ * bytes and never waits for the bus. No clear command is ever sent
+ * after initialization, so redraws never wait for the controller's slow clear
+ * execution time.
+ *
+ * Custom symbols are drawn by glyph ID with LcdFb_WriteGlyph(); the glyph
+ * manager (glyphs.c) maps the glyphs on screen to CGRAM slots at flush time
+ * and uploads only the ones that are not resident yet.
+ */
+
+#define LCDFB_ROWS        (2U)
+#define LCDFB_COLS        (16U)
+
+/**
+ * Max. unchanged cells re-sent to join two runs instead of re-addressing.
+ * An extra byte inside a burst costs 9 bit times; a new address command costs
+ * a whole transaction (start, address, control, command, stop).
+ */
+#define LCDFB_MERGE_GAP   (3U)
+
+/**
+ * @brief Bind the framebuffer to a display and reset it.
+ *
+ * Call right after the display was initialized: the panel is assumed to be blank.
+ */
+void LcdFb_Init(Display_t *display);
+
+/** @brief Fill the whole framebuffer with spaces and move the cursor home. */
+void LcdFb_Clear(void);
+
+/** @brief Fill one row with spaces. */
+void LcdFb_ClearRow(uint8_t row);
+
+/** @brief Move the write cursor (row 0..1, col 0..15). */
+void LcdFb_SetCursor(uint8_t row, uint8_t col);
+
+/**
+ * @brief Write one byte at the cursor and advance; writes past column 15 are dropped.
+ *
+ * Bytes below 0x20 are glyph IDs (same as LcdFb_WriteGlyph()).
+ */
+void LcdFb_WriteChar(char c);
+
+/** @brief Draw a custom symbol at the cursor and advance. */
+void LcdFb_WriteGlyph(GlyphId glyph);
+
+/** @brief Write a null-terminated string at the cursor (clipped at the row end). */
+void LcdFb_Print(const char *s);
+
+/**
+ * @brief Replace the whole framebuffer with a ready-made frame.
+ *
+ * For pre-rendered screens (lesson_frames.h): one copy instead of composing
+ * cell by cell, and the glyph set is taken from glyphMask instead of being
+ * collected from the frame at flush time. Leaves the cursor at home.
+ *
+ * @param cells      Row-major 2x16 cells; codes below 0x20 are glyph IDs.
+ * @param glyphMask  Bit g set = glyph g appears in cells.
+ */
+void LcdFb_Load(const uint8_t cells[LCDFB_ROWS][LCDFB_COLS], uint32_t glyphMask);
+
+/**
+ * @brief Queue all cells that differ from the panel contents.
+ *
+ * Returns immediately. Calling it when nothing changed is cheap, so the main
+ * loop calls it every pass to retry leftovers.
+ *
+ * @return HAL_OK if everything was queued, HAL_BUSY if the queue was full
+ *         (cells that were not queued stay dirty for the next flush).
+ */
+HAL_StatusTypeDef LcdFb_Flush(void);
+
+/**
+ * @brief Run callback once everything flushed so far is visible on the panel.
+ *
+ * With the asynchronous backend the callback runs in interrupt context.
+ */
+HAL_StatusTypeDef LcdFb_Fence(DisplayCallback callback, void *arg);
+
+/** @brief Forget the panel contents: the next flush redraws every cell. */
+void LcdFb_Invalidate(void);
+
+#endif /* LCD_FRAMEBUFFER_H */
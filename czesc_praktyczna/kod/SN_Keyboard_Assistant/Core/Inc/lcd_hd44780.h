@@ -2,9 +2,56 @@
 #define LCD_HD44780_H
 
 #include <stdint.h>
+#include "stm32l4xx_hal.h"
+
+/**
+ * @file lcd_hd44780.h
+ * @brief Parallel HD44780 16x2 LCD driver (4-bit mode).
+ *
+ * Alternative to the Grove I2C display for a bare HD44780 module.
+ *
+ * Wiring requirements:
+ * - D4..D7 on four consecutive pins of one port (LCD_DATA_GPIO_Port, starting at
+ *   LCD_DATA_PIN_POS), so a whole nibble is written with a single BSRR store.
+ * - RS and E on any pins.
+ * - R/W optional: with LCD_USE_BUSY_FLAG = 1 the driver polls the busy flag and
+ *   continues as soon as the controller is ready; otherwise tie R/W to GND and
+ *   the worst-case execution times are waited on the TIM2 microsecond timebase.
+ *   When reading, the 5 V module drives D4..D7: use 5 V tolerant (FT) pins.
+ *
+ * Defaults below can be overridden in main.h (USER CODE Private defines).
+ * Timebase_Init() must run before LCD_Init().
+ */
+
+#ifndef LCD_RS_Pin
+#define LCD_RS_GPIO_Port        GPIOB
+#define LCD_RS_Pin              GPIO_PIN_1
+#endif
+
+#ifndef LCD_E_Pin
+#define LCD_E_GPIO_Port         GPIOB
+#define LCD_E_Pin               GPIO_PIN_2
+#endif
+
+#ifndef LCD_RW_Pin
+#define LCD_RW_GPIO_Port        GPIOB
+#define LCD_RW_Pin              GPIO_PIN_10
+#endif
+
+#ifndef LCD_DATA_GPIO_Port
+#define LCD_DATA_GPIO_Port      GPIOB        /* D4..D7 = PB12..PB15 (FT pins) */
+#define LCD_DATA_PIN_POS        (12U)
+#endif
+
+/** Set to 1 if R/W is wired: poll the busy flag instead of fixed delays. */
+#ifndef LCD_USE_BUSY_FLAG
+#define LCD_USE_BUSY_FLAG       0
+#endif
 
 /**
  * @brief Initialize the HD44780 16x2 LCD (4-bit mode).
+ *
+ * Configures the LCD pins, runs the 4-bit entry sequence and clears the display.
  */
 void LCD_Init(void);
 
@@ -25,4 +72,16 @@ void LCD_SetCursor(uint8_t row, uint8_t col);
  */
 void LCD_Print(const char *str);
 
+/**
+ * @brief Write raw bytes at the current cursor position (may contain CGRAM slot 0).
+ */
+void LCD_Write(const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief Define count consecutive custom characters starting at CGRAM slot firstSlot.
+ *
+ * Each pattern has 8 rows (lower 5 bits used). Leaves the address counter in DDRAM.
+ */
+void LCD_CreateChars(uint8_t firstSlot, const uint8_t patterns[][8], uint8_t count);
+
 #endif /* LCD_HD44780_H */
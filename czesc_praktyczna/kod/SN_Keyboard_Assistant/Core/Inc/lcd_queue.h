@@ -0,0 +1,140 @@
+#ifndef LCD_QUEUE_H
+#define LCD_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "grove_lcd16x2_i2c.h"
+
+/**
+ * @file lcd_queue.h
+ * @brief Asynchronous command queue for the Grove 16x2 LCD.
+ *
+ * Producers (UI code in the main loop) only copy commands into a ring buffer
+ * and return. The queue is drained entirely from interrupts:
+ * - each entry is sent with HAL_I2C_Mem_Write_DMA() (I2C1_TX on DMA1 Channel 6),
+ * - the next entry is started from the I2C completion interrupt
+ *   (main.c forwards HAL_I2C_MemTxCpltCallback() to LcdQueue_I2cTxDone()),
+ * - clear/home execution time (1.6 ms) is waited with the TIM2 alarm
+ *   (Timebase_SetAlarmUs()) instead of a busy delay.
+ *
+ * Other commands need ~40 us, which is always covered by the address phase
+ * of the next I2C transaction, so no explicit delay is queued for them.
+ *
+ * The RGB backlight (second device on the module) is not queued: it has a
+ * single latest-value slot. LcdQueue_SetBacklight() only overwrites that
+ * slot, and the consumer sends it before the next queue entry, so any number
+ * of color changes between two transfers costs one 3-byte write.
+ *
+ * After LcdQueue_Init() all LCD traffic must go through this queue: the
+ * blocking GroveLCD_* calls would find the I2C handle busy.
+ *
+ * Transfers are reported to the bus health tracker (i2c_bus.h). While its
+ * breaker is open every producer call returns HAL_ERROR immediately and
+ * queued entries are dropped; DisplayGrove_Service() brings the panel back
+ * with LcdQueue_Reinit() once the bus recovers.
+ */
+
+/** Queue depth (entries, power of two). A full 2x16 redraw needs 4 entries. */
+#define LCDQ_DEPTH          (16U)
+
+/** Max. data bytes per entry; longer writes are split into several entries. */
+#define LCDQ_MAX_DATA       (16U)
+
+/** NVIC priority of I2C1 / DMA1 Channel 6 (must equal TIMEBASE_IRQ_PRIORITY). */
+#define LCDQ_IRQ_PRIORITY   (5U)
+
+/** Fence callback; runs in interrupt context once all earlier entries were sent. */
+typedef void (*LcdQueueCallback)(void *arg);
+
+/** @brief Bind the queue to an initialized LCD (after GroveLCD_Init()). */
+void LcdQueue_Init(GroveLCD_t *lcd);
+
+/**
+ * @brief Queue one command byte.
+ *
+ * @param cmd      HD44780 command.
+ * @param delay_us Controller execution time to wait before the next entry
+ *                 (0 for short commands).
+ * @return HAL_OK, or HAL_BUSY if the queue is full (nothing queued).
+ */
+HAL_StatusTypeDef LcdQueue_Command(uint8_t cmd, uint16_t delay_us);
+
+/** @brief Queue "clear display" including its execution time. */
+HAL_StatusTypeDef LcdQueue_Clear(void);
+
+/** @brief Queue "return home" including its execution time. */
+HAL_StatusTypeDef LcdQueue_Home(void);
+
+/** @brief Queue a DDRAM address command (row 0..1, col 0..15). */
+HAL_StatusTypeDef LcdQueue_SetCursor(uint8_t row, uint8_t col);
+
+/**
+ * @brief Queue data bytes for the current DDRAM/CGRAM address.
+ *
+ * The bytes are copied, the caller's buffer may be reused immediately.
+ * All-or-nothing: returns HAL_BUSY without queuing anything if there is
+ * not enough room for the whole buffer.
+ */
+HAL_StatusTypeDef LcdQueue_Write(const uint8_t *buf, uint16_t len);
+
+/** @brief Queue a CGRAM upload of consecutive slots (see GroveLCD_CreateChars()). */
+HAL_StatusTypeDef LcdQueue_CreateChars(uint8_t firstSlot, const uint8_t patterns[][8], uint8_t count);
+
+/**
+ * @brief Queue a callback that runs when all entries queued before it are on the panel.
+ *
+ * If the queue is dropped (bus breaker open) the callback runs then, although
+ * the panel was not updated; LcdQueue_TakeErrors() reports the lost entries.
+ */
+HAL_StatusTypeDef LcdQueue_Fence(LcdQueueCallback callback, void *arg);
+
+/**
+ * @brief Request a backlight color (RGB modules, see GroveLCD_InitBacklight()).
+ *
+ * Never blocks and never fails for lack of space: a color that was not sent
+ * yet is replaced.
+ *
+ * @return HAL_OK, or HAL_ERROR if the queue is not started or the module has
+ *         no RGB backlight. While the bus breaker is open the color is kept
+ *         and sent after recovery.
+ */
+HAL_StatusTypeDef LcdQueue_SetBacklight(uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Queue the panel initialization sequence (after the bus recovered).
+ *
+ * Also counts one error, so the framebuffer redraws the whole screen and
+ * re-uploads its glyphs (a re-plugged panel starts blank), and resends the
+ * last backlight color.
+ */
+HAL_StatusTypeDef LcdQueue_Reinit(void);
+
+/**
+ * @brief Give up on a DMA transfer that did not finish within timeout_ms.
+ *
+ * Trips the bus breaker and drops the queue; the bus is then recovered by
+ * I2cBus_Process(). Call from the main loop.
+ *
+ * @return true if a hung transfer was abandoned.
+ */
+bool LcdQueue_Watchdog(uint32_t timeout_ms);
+
+/** @brief Number of free entries. */
+uint32_t LcdQueue_Free(void);
+
+/** @brief True when nothing is queued or in flight. */
+bool LcdQueue_IsIdle(void);
+
+/** @brief Block until the queue is drained (for init / shutdown paths only). */
+HAL_StatusTypeDef LcdQueue_WaitIdle(uint32_t timeout_ms);
+
+/** @brief Number of entries dropped on bus errors since the last call (then cleared). */
+uint32_t LcdQueue_TakeErrors(void);
+
+/** @brief I2C Mem TX complete (forwarded from HAL_I2C_MemTxCpltCallback()). */
+void LcdQueue_I2cTxDone(I2C_HandleTypeDef *hi2c);
+
+/** @brief I2C error (forwarded from HAL_I2C_ErrorCallback()). */
+void LcdQueue_I2cError(I2C_HandleTypeDef *hi2c);
+
+#endif /* LCD_QUEUE_H */
@@ -5,20 +5,25 @@
 #include <stdbool.h>
 #include "songs.h"
 #include "chords.h"
+#include "oled_gfx.h"
 
 /*
  * lesson.h / lesson.c
  *
  * This module implements the "lesson engine" used by the application:
  * - Song lesson mode: user must play the required notes for each step
- * - Chord exercise mode: user must play the chord tones (pitch-class matching)
+ * - Chord exercise mode: user must play the chord tones together
+ *   (pitch-class matching on the held keys, see held_notes.h)
+ * - Rhythm lesson mode: song mode, plus every onset is scored against its
+ *   expected time (song tempo and note onsets in ticks, see songs.h) and
+ *   every release against the note's duration and articulation
  *
  * Inputs are provided through Lesson_HandleInput():
  * - MIDI notes (0..127)
  * - Special button codes (LESSON_INPUT_BTN_*)
  *
- * The module also provides a non-blocking update function (Lesson_Update())
- * for time-based feedback (LED blinking).
+ * Time-based feedback (LED blinking) runs on timer-wheel timers, dispatched
+ * by TimerWheel_Process() from the main loop.
  */
 
 /* Special codes for non-note inputs to Lesson_HandleInput() */
@@ -26,27 +31,64 @@
 #define LESSON_INPUT_BTN_NEXT  0xF2  /* Backward / NEXT (previous step) */
 #define LESSON_INPUT_BTN_RESET 0xF3  /* Reset */
 
+/* Default chord onset window: all tones must start within this time. */
+#define LESSON_ONSET_WINDOW_MS  (80U)
+
 /* Initialize and start a song lesson. */
-void Lesson_StartSong(Song *song);
+void Lesson_StartSong(const Song *song);
+
+/* Default rhythm tolerance: a note within +-this of its expected time is on time. */
+#define LESSON_RHYTHM_WINDOW_MS (60U)
+
+/*
+ * Initialize and start a rhythm lesson: the first correct note starts the
+ * song clock, every following one is scored as early / on time / late.
+ */
+void Lesson_StartRhythm(const Song *song);
 
 /* Initialize and start a chord exercise (chord pack). */
-void Lesson_StartChordExercise(ChordPack *pack);
+void Lesson_StartChordExercise(const ChordPack *pack);
 
 /*
  * Handle one input event.
- * - For MIDI NOTE ON: pass the note value directly (0..127).
+ * - For MIDI NOTE ON: pass the note value directly (0..127), after
+ *   HeldNotes_On() so chord mode sees the key as held and rhythm mode
+ *   reads its onset time.
  * - For buttons: pass one of LESSON_INPUT_BTN_* constants.
  */
 void Lesson_HandleInput(uint8_t input);
 
+/*
+ * Handle a MIDI NOTE OFF (or NOTE ON with velocity 0) released at t_us
+ * (same timebase as HeldNotes_On()). Rhythm mode scores how long the key
+ * was held; other modes ignore it. Call before HeldNotes_Off().
+ */
+void Lesson_HandleRelease(uint8_t note, uint32_t t_us);
+
+/*
+ * Chord mode: maximum time between the first and the last tone of a chord
+ * for it to count as played together (default LESSON_ONSET_WINDOW_MS).
+ */
+void Lesson_SetOnsetWindowMs(uint16_t ms);
+
+/* Rhythm mode: largest early/late deviation that still counts as on time. */
+void Lesson_SetRhythmWindowMs(uint16_t ms);
+
 /* Returns true if a lesson is currently active (running or summary screen). */
 bool Lesson_IsActive(void);
 
 /*
- * Periodic non-blocking update.
- * Used mainly for timing-based feedback (e.g. turning LEDs off after a blink).
- * Call regularly from the main loop (e.g. from App_Update()).
+ * Optional graphics display: when set, each step is also drawn as notation
+ * (oled_staff.h) into the free area of this framebuffer. NULL disables it.
+ */
+void Lesson_SetStaffCanvas(OledGfx_t *canvas);
+
+/*
+ * Called from App_Update(): flush the LCD framebuffer (cells left over when
+ * the queue was full). Once a lesson screen is queued completely, its LCD
+ * latency fence is set, so the stage is measured to the last cell of the
+ * screen.
  */
-void Lesson_Update(void);
+void Lesson_Flush(void);
 
 #endif /* LESSON_H */
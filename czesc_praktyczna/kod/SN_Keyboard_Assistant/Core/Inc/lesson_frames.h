@@ -0,0 +1,32 @@
+#ifndef LESSON_FRAMES_H
+#define LESSON_FRAMES_H
+
+#include <stdint.h>
+#include "lesson_render.h"
+
+/**
+ * @file lesson_frames.h
+ * @brief Pre-rendered lesson step screens, stored in flash.
+ *
+ * lesson_frames.c is generated by Tools/gen_lesson_frames.c from songs.c,
+ * chords.c and lesson_render.c; regenerate it after changing any of them.
+ * Set i belongs to songs[i] / chordPacks[i]. A set is only used if its
+ * frameCount and sourceHash still match the data (LessonRender_SongHash() /
+ * LessonRender_ChordPackHash()); otherwise lesson.c renders at runtime.
+ */
+
+/** Frames for all steps of one song or chord pack. */
+typedef struct
+{
+    uint32_t sourceHash;          /**< Hash of the data the frames were rendered from */
+    uint8_t frameCount;           /**< One frame per step */
+    const LessonFrame_t *frames;
+} LessonFrameSet_t;
+
+extern const LessonFrameSet_t songFrameSets[];
+extern const uint8_t SONG_FRAME_SET_COUNT;
+
+extern const LessonFrameSet_t chordPackFrameSets[];
+extern const uint8_t CHORD_PACK_FRAME_SET_COUNT;
+
+#endif /* LESSON_FRAMES_H */
@@ -0,0 +1,55 @@
+#ifndef LESSON_RENDER_H
+#define LESSON_RENDER_H
+
+#include <stdint.h>
+#include "songs.h"
+#include "chords.h"
+#include "glyphs.h"
+
+/**
+ * @file lesson_render.h
+ * @brief Layout of the lesson step screens as plain 2x16 frames.
+ *
+ * The renderer only fills a LessonFrame_t (cells + glyph mask); it has no
+ * HAL or framebuffer dependencies, so the same code runs:
+ * - on the host, in Tools/gen_lesson_frames.c, which pre-renders every step
+ *   of the built-in songs/chord packs into Core/Src/lesson_frames.c,
+ * - on the target, as a fallback for lessons without an up-to-date table.
+ *
+ * Cells below 0x20 are glyph IDs, as in the framebuffer (lcd_framebuffer.h).
+ */
+
+#define LESSON_FRAME_ROWS   (2U)
+#define LESSON_FRAME_COLS   (16U)
+
+/**
+ * Layout version, mixed into the source hashes. Bump it whenever the output
+ * of the render functions changes, so old generated tables are ignored.
+ */
+#define LESSON_RENDER_VERSION   (2U)
+
+/** One pre-rendered step screen. */
+typedef struct
+{
+    uint8_t cells[LESSON_FRAME_ROWS][LESSON_FRAME_COLS];
+    uint32_t glyphs;    /**< Bit g set = glyph g appears in cells */
+} LessonFrame_t;
+
+/** @brief Song step screen: note names on row 0, length icons + progress on row 1. */
+void LessonRender_SongStep(const SongStep *step, uint8_t index, uint8_t total, LessonFrame_t *out);
+
+/** @brief Chord step screen: chord name + progress on row 0, chord tones on row 1. */
+void LessonRender_ChordStep(const Chord *chord, uint8_t index, uint8_t total, LessonFrame_t *out);
+
+/**
+ * @brief Hash of everything the song screens are rendered from (steps + layout version).
+ *
+ * Stored next to each generated table and compared at runtime, so a table
+ * that no longer matches songs.c is never shown.
+ */
+uint32_t LessonRender_SongHash(const Song *song);
+
+/** @brief Same as LessonRender_SongHash() for a chord pack. */
+uint32_t LessonRender_ChordPackHash(const ChordPack *pack);
+
+#endif /* LESSON_RENDER_H */
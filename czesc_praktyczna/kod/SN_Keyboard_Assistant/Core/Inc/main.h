@@ -77,6 +77,14 @@ void Error_Handler(void);
 #define BTN_OK_PORT     GPIOA
 #define BTN_OK_PIN      GPIO_PIN_4			 /* e.g. PA4 */
 
+/*
+ * 1 = content store (songs, chord packs, stats) on an external SPI NOR chip
+ * (pins in spi_nor.h), with songs imported from a USB stick (MSC class).
+ */
+#ifndef STORE_USE_SPI_NOR
+#define STORE_USE_SPI_NOR     0
+#endif
+
 
 /* Compile-time guards: fail early if any required mapping is missing. */
 #ifndef GREEN_LED_GPIO_Port
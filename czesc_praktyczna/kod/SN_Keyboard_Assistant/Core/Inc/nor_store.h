@@ -0,0 +1,200 @@
+#ifndef NOR_STORE_H
+#define NOR_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "smf_reader.h"
+
+/**
+ * @file nor_store.h
+ * @brief Log-structured content store on NOR flash (songs, chord packs, stats).
+ *
+ * The flash is a ring of erase segments. Items (a key and a byte payload)
+ * are only ever appended at the head of the ring; a newer item with the
+ * same key replaces the older one, a delete record removes it. When free
+ * segments run out, the oldest segment (the tail) is collected: its items
+ * that are still current are copied to the head, then it is erased and
+ * becomes free. Every segment is erased in turn, so wear is spread evenly
+ * over the chip, and each segment keeps its erase count.
+ *
+ *   segment := header (16 bytes), record..., 0xFF to the end
+ *   header  := magic:u32, eraseCount:u32, seq:u32, ~seq:u32
+ *              (seq all ones = erased and free)
+ *   record  := key:u32, length:u32, seq:u32, dataCrc:u32,
+ *              headCrc:u16, kind:u8, commit:u8   (20 bytes), payload,
+ *              padding to 4 bytes
+ *
+ * Power-fail safety: a record is written header first (commit = 0xFF),
+ * then the payload, then the commit byte is programmed to 0x00. Mount
+ * ignores records that were not committed, and stops reading a segment at a
+ * header that fails its CRC (a torn write; the rest of that segment is
+ * left unused until it is collected). Collection copies before it erases,
+ * so a power cut leaves at worst an item twice, and the newer copy wins.
+ * The reserve lets a collection cut short be finished after the next
+ * mount; cuts in several collections in a row can use it up, and the store
+ * then reports NOR_STORE_ERR_FULL until items are deleted.
+ *
+ * Lookups: NorStore_Mount() builds a RAM index sorted by key (8 bytes per
+ * item, NOR_STORE_INDEX_MAX items), so finding an item is a binary search
+ * plus one flash read for its record header. Reads go through a small LRU
+ * cache of NOR_STORE_CACHE_BLOCKS blocks of NOR_STORE_BLOCK bytes.
+ *
+ * An item can be read in place through NorStore_Source() as an SmfSource,
+ * so .mid and text songs play straight from the store (smf_reader.h,
+ * song_text.h).
+ *
+ * The flash is reached through NorDevice (spi_nor.h on the board,
+ * Tools/store_image.c on the host against an image file).
+ *
+ * HAL-free (also built into the host tools).
+ */
+
+#ifndef NOR_STORE_INDEX_MAX
+#define NOR_STORE_INDEX_MAX     (2048U)
+#endif
+
+/** Read cache: blocks and block size (bytes, power of two). */
+#define NOR_STORE_CACHE_BLOCKS  (4U)
+#define NOR_STORE_BLOCK         (256U)
+
+/** Segments kept free for collection: one to copy the tail into, one more
+ *  so that a collection cut short by a power loss can still be finished. */
+#define NOR_STORE_RESERVE       (2U)
+
+#define NOR_STORE_SEGMENT_HEADER  (16U)
+#define NOR_STORE_RECORD_HEADER   (20U)
+
+/** Largest payload (one record never crosses a segment). */
+#define NOR_STORE_MAX_PAYLOAD(segmentSize) \
+    ((segmentSize) - NOR_STORE_SEGMENT_HEADER - NOR_STORE_RECORD_HEADER)
+
+/** Item keys: content type in the top byte, 24-bit id below. */
+#define NOR_STORE_KEY(type, id)   ((uint32_t)(((uint32_t)(type) << 24) | ((uint32_t)(id) & 0x00FFFFFFUL)))
+#define NOR_STORE_KEY_TYPE(key)   ((uint8_t)((key) >> 24))
+#define NOR_STORE_KEY_ID(key)     ((key) & 0x00FFFFFFUL)
+
+/** Content types */
+#define NOR_STORE_SONG_SMF     (1U)   /* Standard MIDI File */
+#define NOR_STORE_SONG_TEXT    (2U)   /* text song (song_text.h) */
+#define NOR_STORE_CHORD_PACK   (3U)
+#define NOR_STORE_STATS        (4U)
+#define NOR_STORE_SONG_TITLE   (5U)   /* title of the song with the same id (song_import.h) */
+
+typedef enum {
+    NOR_STORE_OK = 0,
+    NOR_STORE_ERR_IO,            /* device read / program / erase failed */
+    NOR_STORE_ERR_UNFORMATTED,   /* no store on the chip (NorStore_Format()) */
+    NOR_STORE_ERR_FULL,          /* no room, even after collection */
+    NOR_STORE_ERR_INDEX_FULL,    /* NOR_STORE_INDEX_MAX items */
+    NOR_STORE_ERR_TOO_LARGE,     /* payload larger than a segment */
+    NOR_STORE_ERR_NOT_FOUND,
+    NOR_STORE_ERR_CRC,           /* payload does not match its CRC */
+    NOR_STORE_ERR_STATE          /* NorStore_Append() / _Commit() without _Begin() */
+} NorStoreStatus;
+
+/**
+ * NOR flash access. Programming may only clear bits (1 -> 0) and must
+ * accept any address / length (the driver splits at page boundaries);
+ * erase sets one segment to 0xFF.
+ */
+typedef struct {
+    bool (*read)(void *ctx, uint32_t addr, uint8_t *buf, uint32_t len);
+    bool (*program)(void *ctx, uint32_t addr, const uint8_t *buf, uint32_t len);
+    bool (*erase)(void *ctx, uint32_t addr);
+    void *ctx;
+    uint32_t segmentSize;        /* erase unit, bytes */
+    uint16_t segmentCount;
+} NorDevice;
+
+typedef struct {
+    uint32_t key;
+    uint32_t addr;               /* record header */
+} NorStoreEntry;
+
+typedef struct {
+    uint32_t addr;               /* block address, UINT32_MAX = empty */
+    uint32_t lastUse;
+    uint8_t data[NOR_STORE_BLOCK];
+} NorStoreBlock;
+
+typedef struct {
+    NorDevice dev;
+    uint16_t tail;               /* oldest segment in use */
+    uint16_t head;               /* segment being written */
+    uint16_t used;               /* segments in use (tail .. head) */
+    uint32_t headOffset;         /* next record in the head segment */
+    uint32_t nextSegSeq;
+    uint32_t nextSeq;            /* record sequence */
+    uint32_t maxEraseCount;
+
+    NorStoreEntry index[NOR_STORE_INDEX_MAX];
+    uint16_t count;
+
+    /* Record being written by NorStore_Begin() / _Append() */
+    bool writing;
+    uint32_t writeAddr;
+    uint32_t writeKey;
+    uint32_t writeLength;
+    uint32_t written;
+    uint32_t writeCrc;
+
+    NorStoreBlock cache[NOR_STORE_CACHE_BLOCKS];
+    uint32_t useClock;
+} NorStore;
+
+/** A found item. */
+typedef struct {
+    NorStore *store;
+    uint32_t key;
+    uint32_t data;               /* payload address */
+    uint32_t length;
+    uint32_t crc;
+} NorStoreItem;
+
+/** @brief Erase every segment and start an empty store (erase counts are kept where readable). */
+NorStoreStatus NorStore_Format(NorStore *s, const NorDevice *dev);
+
+/**
+ * @brief Open the store: read all segment and record headers, build the index.
+ *
+ * Segments left half-erased by a power cut are erased again.
+ */
+NorStoreStatus NorStore_Mount(NorStore *s, const NorDevice *dev);
+
+/** @brief Find the current version of an item (one flash read). */
+NorStoreStatus NorStore_Find(NorStore *s, uint32_t key, NorStoreItem *item);
+
+/** @brief Read part of an item's payload (through the block cache). */
+bool NorStore_Read(const NorStoreItem *item, uint32_t offset, uint8_t *buf, uint32_t len);
+
+/** @brief Read the whole payload once and compare it with its CRC. */
+NorStoreStatus NorStore_Verify(const NorStoreItem *item);
+
+/** @brief Item as an SmfSource (read callback, ctx = item, which must stay valid). */
+void NorStore_Source(NorStoreItem *item, SmfSource *src);
+
+/** @brief Store an item from RAM (replaces an item with the same key). */
+NorStoreStatus NorStore_Write(NorStore *s, uint32_t key, const uint8_t *data, uint32_t length);
+
+/**
+ * @brief Store an item in pieces (e.g. while it arrives over USB): Begin with
+ *        the total length, Append the bytes, Commit. Until Commit the old
+ *        version stays current; a power cut before it leaves the old version.
+ */
+NorStoreStatus NorStore_Begin(NorStore *s, uint32_t key, uint32_t length);
+NorStoreStatus NorStore_Append(NorStore *s, const uint8_t *data, uint32_t length);
+NorStoreStatus NorStore_Commit(NorStore *s);
+
+/** @brief Remove an item. */
+NorStoreStatus NorStore_Delete(NorStore *s, uint32_t key);
+
+/** @brief Key of the i-th item in key order (0..NorStore_Count()-1). */
+uint32_t NorStore_KeyAt(const NorStore *s, uint16_t i);
+
+/** @brief Number of items. */
+uint16_t NorStore_Count(const NorStore *s);
+
+/** @brief Bytes that can still be written (free segments, without the reserve). */
+uint32_t NorStore_FreeBytes(const NorStore *s);
+
+#endif /* NOR_STORE_H */
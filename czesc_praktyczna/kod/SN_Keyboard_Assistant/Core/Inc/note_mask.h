@@ -0,0 +1,107 @@
+#ifndef NOTE_MASK_H
+#define NOTE_MASK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file note_mask.h
+ * @brief Note sets as bit masks: 128 MIDI notes, or 12 pitch classes.
+ *
+ * - NoteMask128_t: bit n = MIDI note n, in four 32-bit words (native width
+ *   on Cortex-M4; a note touches exactly one word).
+ * - pitch-class mask (uint16_t): bit pc = pitch class pc (C = 0 .. B = 11).
+ *
+ * Set operations are word-wise AND/OR and popcounts, so their cost does not
+ * depend on how many notes a step or chord has.
+ *
+ * Header-only and HAL-free (also used by the host tools).
+ */
+
+#define NOTE_MASK_WORDS     (4U)
+
+/** Mask with all 12 pitch classes set. */
+#define PC_MASK_ALL         (0x0FFFU)
+
+/** Set of MIDI notes 0..127. */
+typedef struct
+{
+    uint32_t w[NOTE_MASK_WORDS];
+} NoteMask128_t;
+
+static inline void NoteMask_Clear(NoteMask128_t *m)
+{
+    for (uint8_t i = 0; i < NOTE_MASK_WORDS; i++) m->w[i] = 0;
+}
+
+static inline void NoteMask_Set(NoteMask128_t *m, uint8_t note)
+{
+    m->w[(note >> 5) & 3U] |= (1UL << (note & 31U));
+}
+
+static inline void NoteMask_Reset(NoteMask128_t *m, uint8_t note)
+{
+    m->w[(note >> 5) & 3U] &= ~(uint32_t)(1UL << (note & 31U));
+}
+
+static inline bool NoteMask_Test(const NoteMask128_t *m, uint8_t note)
+{
+    return (m->w[(note >> 5) & 3U] & (1UL << (note & 31U))) != 0U;
+}
+
+/** @brief Number of notes in the set. */
+static inline uint32_t NoteMask_Count(const NoteMask128_t *m)
+{
+    uint32_t n = 0;
+    for (uint8_t i = 0; i < NOTE_MASK_WORDS; i++) n += (uint32_t)__builtin_popcount(m->w[i]);
+    return n;
+}
+
+static inline bool NoteMask_IsEmpty(const NoteMask128_t *m)
+{
+    return (m->w[0] | m->w[1] | m->w[2] | m->w[3]) == 0U;
+}
+
+/** @brief True if every note of sub is also in set. */
+static inline bool NoteMask_Contains(const NoteMask128_t *set, const NoteMask128_t *sub)
+{
+    uint32_t missing = 0;
+    for (uint8_t i = 0; i < NOTE_MASK_WORDS; i++) missing |= sub->w[i] & ~set->w[i];
+    return missing == 0U;
+}
+
+/** @brief Pitch classes present in a note set (octaves folded; one step per note in the set). */
+static inline uint16_t NoteMask_PitchClasses(const NoteMask128_t *m)
+{
+    uint16_t pcs = 0;
+    for (uint8_t i = 0; i < NOTE_MASK_WORDS; i++) {
+        for (uint32_t bits = m->w[i]; bits != 0U; bits &= bits - 1U) {
+            uint32_t note = (uint32_t)i * 32U + (uint32_t)__builtin_ctz(bits);
+            pcs |= (uint16_t)(1U << (note % 12U));
+        }
+    }
+    return pcs;
+}
+
+/** @brief Lowest note in the set, or 0xFF if it is empty. */
+static inline uint8_t NoteMask_Lowest(const NoteMask128_t *m)
+{
+    for (uint8_t i = 0; i < NOTE_MASK_WORDS; i++) {
+        if (m->w[i] != 0U) return (uint8_t)(i * 32U + (uint32_t)__builtin_ctz(m->w[i]));
+    }
+    return 0xFFU;
+}
+
+/** @brief Single-bit pitch-class mask of a MIDI note. */
+static inline uint16_t PcMask_OfNote(uint8_t note)
+{
+    return (uint16_t)(1U << (note % 12U));
+}
+
+/** @brief Number of pitch classes in a mask. */
+static inline uint32_t PcMask_Count(uint16_t pcs)
+{
+    return (uint32_t)__builtin_popcount(pcs & PC_MASK_ALL);
+}
+
+#endif /* NOTE_MASK_H */
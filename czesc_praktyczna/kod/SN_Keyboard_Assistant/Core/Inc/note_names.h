@@ -0,0 +1,237 @@
+#ifndef NOTE_NAMES_H
+#define NOTE_NAMES_H
+
+/*
+ * note_names.h
+ *
+ * GENERATED by Tools/gen_note_names.c - do not edit.
+ *
+ * PITCH_<name>: letter, accidental and MIDI number of a spelled note, as
+ * the first three NOTE() arguments (songs.h). Sharps are written 's'
+ * (Cs4 = C#4), flats 'b' (Bb3). Use through PITCH().
+ */
+
+/* Octave 0 */
+#define PITCH_C0   'C', ACC_NONE,   12
+#define PITCH_Cs0  'C', ACC_SHARP,  13
+#define PITCH_Cb0  'C', ACC_FLAT,   11
+#define PITCH_D0   'D', ACC_NONE,   14
+#define PITCH_Ds0  'D', ACC_SHARP,  15
+#define PITCH_Db0  'D', ACC_FLAT,   13
+#define PITCH_E0   'E', ACC_NONE,   16
+#define PITCH_Es0  'E', ACC_SHARP,  17
+#define PITCH_Eb0  'E', ACC_FLAT,   15
+#define PITCH_F0   'F', ACC_NONE,   17
+#define PITCH_Fs0  'F', ACC_SHARP,  18
+#define PITCH_Fb0  'F', ACC_FLAT,   16
+#define PITCH_G0   'G', ACC_NONE,   19
+#define PITCH_Gs0  'G', ACC_SHARP,  20
+#define PITCH_Gb0  'G', ACC_FLAT,   18
+#define PITCH_A0   'A', ACC_NONE,   21
+#define PITCH_As0  'A', ACC_SHARP,  22
+#define PITCH_Ab0  'A', ACC_FLAT,   20
+#define PITCH_B0   'B', ACC_NONE,   23
+#define PITCH_Bs0  'B', ACC_SHARP,  24
+#define PITCH_Bb0  'B', ACC_FLAT,   22
+
+/* Octave 1 */
+#define PITCH_C1   'C', ACC_NONE,   24
+#define PITCH_Cs1  'C', ACC_SHARP,  25
+#define PITCH_Cb1  'C', ACC_FLAT,   23
+#define PITCH_D1   'D', ACC_NONE,   26
+#define PITCH_Ds1  'D', ACC_SHARP,  27
+#define PITCH_Db1  'D', ACC_FLAT,   25
+#define PITCH_E1   'E', ACC_NONE,   28
+#define PITCH_Es1  'E', ACC_SHARP,  29
+#define PITCH_Eb1  'E', ACC_FLAT,   27
+#define PITCH_F1   'F', ACC_NONE,   29
+#define PITCH_Fs1  'F', ACC_SHARP,  30
+#define PITCH_Fb1  'F', ACC_FLAT,   28
+#define PITCH_G1   'G', ACC_NONE,   31
+#define PITCH_Gs1  'G', ACC_SHARP,  32
+#define PITCH_Gb1  'G', ACC_FLAT,   30
+#define PITCH_A1   'A', ACC_NONE,   33
+#define PITCH_As1  'A', ACC_SHARP,  34
+#define PITCH_Ab1  'A', ACC_FLAT,   32
+#define PITCH_B1   'B', ACC_NONE,   35
+#define PITCH_Bs1  'B', ACC_SHARP,  36
+#define PITCH_Bb1  'B', ACC_FLAT,   34
+
+/* Octave 2 */
+#define PITCH_C2   'C', ACC_NONE,   36
+#define PITCH_Cs2  'C', ACC_SHARP,  37
+#define PITCH_Cb2  'C', ACC_FLAT,   35
+#define PITCH_D2   'D', ACC_NONE,   38
+#define PITCH_Ds2  'D', ACC_SHARP,  39
+#define PITCH_Db2  'D', ACC_FLAT,   37
+#define PITCH_E2   'E', ACC_NONE,   40
+#define PITCH_Es2  'E', ACC_SHARP,  41
+#define PITCH_Eb2  'E', ACC_FLAT,   39
+#define PITCH_F2   'F', ACC_NONE,   41
+#define PITCH_Fs2  'F', ACC_SHARP,  42
+#define PITCH_Fb2  'F', ACC_FLAT,   40
+#define PITCH_G2   'G', ACC_NONE,   43
+#define PITCH_Gs2  'G', ACC_SHARP,  44
+#define PITCH_Gb2  'G', ACC_FLAT,   42
+#define PITCH_A2   'A', ACC_NONE,   45
+#define PITCH_As2  'A', ACC_SHARP,  46
+#define PITCH_Ab2  'A', ACC_FLAT,   44
+#define PITCH_B2   'B', ACC_NONE,   47
+#define PITCH_Bs2  'B', ACC_SHARP,  48
+#define PITCH_Bb2  'B', ACC_FLAT,   46
+
+/* Octave 3 */
+#define PITCH_C3   'C', ACC_NONE,   48
+#define PITCH_Cs3  'C', ACC_SHARP,  49
+#define PITCH_Cb3  'C', ACC_FLAT,   47
+#define PITCH_D3   'D', ACC_NONE,   50
+#define PITCH_Ds3  'D', ACC_SHARP,  51
+#define PITCH_Db3  'D', ACC_FLAT,   49
+#define PITCH_E3   'E', ACC_NONE,   52
+#define PITCH_Es3  'E', ACC_SHARP,  53
+#define PITCH_Eb3  'E', ACC_FLAT,   51
+#define PITCH_F3   'F', ACC_NONE,   53
+#define PITCH_Fs3  'F', ACC_SHARP,  54
+#define PITCH_Fb3  'F', ACC_FLAT,   52
+#define PITCH_G3   'G', ACC_NONE,   55
+#define PITCH_Gs3  'G', ACC_SHARP,  56
+#define PITCH_Gb3  'G', ACC_FLAT,   54
+#define PITCH_A3   'A', ACC_NONE,   57
+#define PITCH_As3  'A', ACC_SHARP,  58
+#define PITCH_Ab3  'A', ACC_FLAT,   56
+#define PITCH_B3   'B', ACC_NONE,   59
+#define PITCH_Bs3  'B', ACC_SHARP,  60
+#define PITCH_Bb3  'B', ACC_FLAT,   58
+
+/* Octave 4 */
+#define PITCH_C4   'C', ACC_NONE,   60
+#define PITCH_Cs4  'C', ACC_SHARP,  61
+#define PITCH_Cb4  'C', ACC_FLAT,   59
+#define PITCH_D4   'D', ACC_NONE,   62
+#define PITCH_Ds4  'D', ACC_SHARP,  63
+#define PITCH_Db4  'D', ACC_FLAT,   61
+#define PITCH_E4   'E', ACC_NONE,   64
+#define PITCH_Es4  'E', ACC_SHARP,  65
+#define PITCH_Eb4  'E', ACC_FLAT,   63
+#define PITCH_F4   'F', ACC_NONE,   65
+#define PITCH_Fs4  'F', ACC_SHARP,  66
+#define PITCH_Fb4  'F', ACC_FLAT,   64
+#define PITCH_G4   'G', ACC_NONE,   67
+#define PITCH_Gs4  'G', ACC_SHARP,  68
+#define PITCH_Gb4  'G', ACC_FLAT,   66
+#define PITCH_A4   'A', ACC_NONE,   69
+#define PITCH_As4  'A', ACC_SHARP,  70
+#define PITCH_Ab4  'A', ACC_FLAT,   68
+#define PITCH_B4   'B', ACC_NONE,   71
+#define PITCH_Bs4  'B', ACC_SHARP,  72
+#define PITCH_Bb4  'B', ACC_FLAT,   70
+
+/* Octave 5 */
+#define PITCH_C5   'C', ACC_NONE,   72
+#define PITCH_Cs5  'C', ACC_SHARP,  73
+#define PITCH_Cb5  'C', ACC_FLAT,   71
+#define PITCH_D5   'D', ACC_NONE,   74
+#define PITCH_Ds5  'D', ACC_SHARP,  75
+#define PITCH_Db5  'D', ACC_FLAT,   73
+#define PITCH_E5   'E', ACC_NONE,   76
+#define PITCH_Es5  'E', ACC_SHARP,  77
+#define PITCH_Eb5  'E', ACC_FLAT,   75
+#define PITCH_F5   'F', ACC_NONE,   77
+#define PITCH_Fs5  'F', ACC_SHARP,  78
+#define PITCH_Fb5  'F', ACC_FLAT,   76
+#define PITCH_G5   'G', ACC_NONE,   79
+#define PITCH_Gs5  'G', ACC_SHARP,  80
+#define PITCH_Gb5  'G', ACC_FLAT,   78
+#define PITCH_A5   'A', ACC_NONE,   81
+#define PITCH_As5  'A', ACC_SHARP,  82
+#define PITCH_Ab5  'A', ACC_FLAT,   80
+#define PITCH_B5   'B', ACC_NONE,   83
+#define PITCH_Bs5  'B', ACC_SHARP,  84
+#define PITCH_Bb5  'B', ACC_FLAT,   82
+
+/* Octave 6 */
+#define PITCH_C6   'C', ACC_NONE,   84
+#define PITCH_Cs6  'C', ACC_SHARP,  85
+#define PITCH_Cb6  'C', ACC_FLAT,   83
+#define PITCH_D6   'D', ACC_NONE,   86
+#define PITCH_Ds6  'D', ACC_SHARP,  87
+#define PITCH_Db6  'D', ACC_FLAT,   85
+#define PITCH_E6   'E', ACC_NONE,   88
+#define PITCH_Es6  'E', ACC_SHARP,  89
+#define PITCH_Eb6  'E', ACC_FLAT,   87
+#define PITCH_F6   'F', ACC_NONE,   89
+#define PITCH_Fs6  'F', ACC_SHARP,  90
+#define PITCH_Fb6  'F', ACC_FLAT,   88
+#define PITCH_G6   'G', ACC_NONE,   91
+#define PITCH_Gs6  'G', ACC_SHARP,  92
+#define PITCH_Gb6  'G', ACC_FLAT,   90
+#define PITCH_A6   'A', ACC_NONE,   93
+#define PITCH_As6  'A', ACC_SHARP,  94
+#define PITCH_Ab6  'A', ACC_FLAT,   92
+#define PITCH_B6   'B', ACC_NONE,   95
+#define PITCH_Bs6  'B', ACC_SHARP,  96
+#define PITCH_Bb6  'B', ACC_FLAT,   94
+
+/* Octave 7 */
+#define PITCH_C7   'C', ACC_NONE,   96
+#define PITCH_Cs7  'C', ACC_SHARP,  97
+#define PITCH_Cb7  'C', ACC_FLAT,   95
+#define PITCH_D7   'D', ACC_NONE,   98
+#define PITCH_Ds7  'D', ACC_SHARP,  99
+#define PITCH_Db7  'D', ACC_FLAT,   97
+#define PITCH_E7   'E', ACC_NONE,  100
+#define PITCH_Es7  'E', ACC_SHARP, 101
+#define PITCH_Eb7  'E', ACC_FLAT,   99
+#define PITCH_F7   'F', ACC_NONE,  101
+#define PITCH_Fs7  'F', ACC_SHARP, 102
+#define PITCH_Fb7  'F', ACC_FLAT,  100
+#define PITCH_G7   'G', ACC_NONE,  103
+#define PITCH_Gs7  'G', ACC_SHARP, 104
+#define PITCH_Gb7  'G', ACC_FLAT,  102
+#define PITCH_A7   'A', ACC_NONE,  105
+#define PITCH_As7  'A', ACC_SHARP, 106
+#define PITCH_Ab7  'A', ACC_FLAT,  104
+#define PITCH_B7   'B', ACC_NONE,  107
+#define PITCH_Bs7  'B', ACC_SHARP, 108
+#define PITCH_Bb7  'B', ACC_FLAT,  106
+
+/* Octave 8 */
+#define PITCH_C8   'C', ACC_NONE,  108
+#define PITCH_Cs8  'C', ACC_SHARP, 109
+#define PITCH_Cb8  'C', ACC_FLAT,  107
+#define PITCH_D8   'D', ACC_NONE,  110
+#define PITCH_Ds8  'D', ACC_SHARP, 111
+#define PITCH_Db8  'D', ACC_FLAT,  109
+#define PITCH_E8   'E', ACC_NONE,  112
+#define PITCH_Es8  'E', ACC_SHARP, 113
+#define PITCH_Eb8  'E', ACC_FLAT,  111
+#define PITCH_F8   'F', ACC_NONE,  113
+#define PITCH_Fs8  'F', ACC_SHARP, 114
+#define PITCH_Fb8  'F', ACC_FLAT,  112
+#define PITCH_G8   'G', ACC_NONE,  115
+#define PITCH_Gs8  'G', ACC_SHARP, 116
+#define PITCH_Gb8  'G', ACC_FLAT,  114
+#define PITCH_A8   'A', ACC_NONE,  117
+#define PITCH_As8  'A', ACC_SHARP, 118
+#define PITCH_Ab8  'A', ACC_FLAT,  116
+#define PITCH_B8   'B', ACC_NONE,  119
+#define PITCH_Bs8  'B', ACC_SHARP, 120
+#define PITCH_Bb8  'B', ACC_FLAT,  118
+
+/* Octave 9 */
+#define PITCH_C9   'C', ACC_NONE,  120
+#define PITCH_Cs9  'C', ACC_SHARP, 121
+#define PITCH_Cb9  'C', ACC_FLAT,  119
+#define PITCH_D9   'D', ACC_NONE,  122
+#define PITCH_Ds9  'D', ACC_SHARP, 123
+#define PITCH_Db9  'D', ACC_FLAT,  121
+#define PITCH_E9   'E', ACC_NONE,  124
+#define PITCH_Es9  'E', ACC_SHARP, 125
+#define PITCH_Eb9  'E', ACC_FLAT,  123
+#define PITCH_F9   'F', ACC_NONE,  125
+#define PITCH_Fs9  'F', ACC_SHARP, 126
+#define PITCH_Fb9  'F', ACC_FLAT,  124
+#define PITCH_G9   'G', ACC_NONE,  127
+#define PITCH_Gb9  'G', ACC_FLAT,  126
+
+#endif /* NOTE_NAMES_H */
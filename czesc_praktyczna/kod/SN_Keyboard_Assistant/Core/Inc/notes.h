@@ -22,11 +22,12 @@ typedef enum
  *
  * Format:
  *   - Note names are CASE-INSENSITIVE ("C4", "c4", "Cis4" all work).
- *   - Supported roots include:
- *       C, CIS, DES, D, DIS, ES, E, F, FIS, GES, G, GIS, AS,
- *       A, AIS, B, BES, H, HES
+ *   - Supported roots: a letter C, D, E, F, G, A, B, H, optionally followed
+ *     by '#' / 'b' or the German IS / ES (just S after A and E), e.g.
+ *       C#, Db, CIS, DES, DIS, ES, FIS, GES, GIS, AS, AIS, BES, HES
  *	 - Naming convention used in this project: "B" means B natural; Bb can be written as "Bb" or "BES"/"HES".
  *   - Last character is the octave digit (0..9), e.g. "C4".
+ *   - The octave belongs to the letter: "Cb4" = 59, "B#4" = 72.
  *
  * MIDI convention used:
  *   - C4 = 60, A4 = 69 (standard MIDI note numbers).
@@ -37,6 +38,17 @@ typedef enum
  */
 NoteParseStatus NoteName_ToMidi(const char *name, uint8_t *outNote);
 
+/**
+ * @brief  Same as NoteName_ToMidi() for a name that is not null-terminated
+ *         (e.g. a token inside a larger text buffer).
+ *
+ * @param  name      First character of the note name.
+ * @param  len       Number of characters in the name.
+ * @param  outNote   Pointer where resulting MIDI note (0..127) will be stored.
+ * @retval NOTE_OK on success, otherwise error code.
+ */
+NoteParseStatus NoteName_ToMidiN(const char *name, size_t len, uint8_t *outNote);
+
 /**
  * @brief  Convert an array of note names to an array of MIDI note numbers.
  *
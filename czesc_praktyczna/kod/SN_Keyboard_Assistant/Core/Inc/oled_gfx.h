@@ -0,0 +1,97 @@
+#ifndef OLED_GFX_H
+#define OLED_GFX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file oled_gfx.h
+ * @brief 128x64 monochrome framebuffer with per-page dirty tracking.
+ *
+ * Memory layout matches SSD1306/SH1106 GDDRAM: 8 pages of 128 column bytes,
+ * bit n of buf[page][x] is pixel (x, page * 8 + n). That is 1 KB, which takes
+ * ~90 ms to send at 100 kHz I2C, so the panel is never redrawn as a whole:
+ * - every drawing call only stores bytes that actually change,
+ * - each page remembers the first and last changed column,
+ * - OledGfx_TakeChanges() trims that range against a copy of what the panel
+ *   shows (a screen may be cleared and redrawn with mostly the same pixels),
+ * - the driver (oled_ssd1306.c) sends just the remaining column ranges.
+ *
+ * HAL-free, so screens can be rendered and checked on a PC
+ * (Tools/oled_preview.c writes them as PBM images).
+ */
+
+#define OLED_WIDTH    (128U)
+#define OLED_HEIGHT   (64U)
+#define OLED_PAGES    (OLED_HEIGHT / 8U)
+
+/** Text cell size used by OledGfx_DrawChar() (5x7 font + spacing). */
+#define OLED_FONT_W   (6U)
+#define OLED_FONT_H   (8U)
+
+/** Framebuffer. A page is clean when dirtyLo > dirtyHi. */
+typedef struct
+{
+    uint8_t buf[OLED_PAGES][OLED_WIDTH];
+    uint8_t dirtyLo[OLED_PAGES];
+    uint8_t dirtyHi[OLED_PAGES];
+} OledGfx_t;
+
+/** @brief Blank buffer, nothing dirty (matches a freshly cleared panel). */
+void OledGfx_Init(OledGfx_t *g);
+
+/** @brief Mark every column dirty (panel contents unknown). */
+void OledGfx_MarkAllDirty(OledGfx_t *g);
+
+/**
+ * @brief Take the changes of one page for sending.
+ *
+ * Clears the page's dirty range, trims it to the columns that differ from
+ * shadow, and copies those columns into shadow.
+ *
+ * @param shadow  Panel contents as last sent (updated).
+ * @return false if nothing in the page needs to be sent.
+ */
+bool OledGfx_TakeChanges(OledGfx_t *g, uint8_t shadow[OLED_PAGES][OLED_WIDTH],
+                         uint8_t page, uint8_t *lo, uint8_t *hi);
+
+/** @brief True if any page has pending changes. */
+bool OledGfx_IsDirty(const OledGfx_t *g);
+
+/** @brief Set or clear one pixel (clipped). */
+void OledGfx_SetPixel(OledGfx_t *g, int16_t x, int16_t y, bool on);
+
+/** @brief Read one pixel (false outside the screen). */
+bool OledGfx_GetPixel(const OledGfx_t *g, int16_t x, int16_t y);
+
+/** @brief Set or clear a rectangle (clipped). */
+void OledGfx_FillRect(OledGfx_t *g, int16_t x, int16_t y, int16_t w, int16_t h, bool on);
+
+/** @brief Horizontal line from x0 to x1 inclusive. */
+void OledGfx_HLine(OledGfx_t *g, int16_t x0, int16_t x1, int16_t y);
+
+/** @brief Vertical line from y0 to y1 inclusive. */
+void OledGfx_VLine(OledGfx_t *g, int16_t x, int16_t y0, int16_t y1);
+
+/**
+ * @brief OR a small bitmap into the buffer (set pixels only).
+ *
+ * @param rows One byte per row, w <= 8 bits right-aligned: bit (w-1) is the
+ *             leftmost pixel (same format as HD44780 CGRAM patterns with w = 5).
+ */
+void OledGfx_DrawRows(OledGfx_t *g, int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *rows);
+
+/** @brief Draw one ASCII character (5x7 font, background cleared). */
+void OledGfx_DrawChar(OledGfx_t *g, int16_t x, int16_t y, char c);
+
+/**
+ * @brief Draw a 5x8 HD44780-style character pattern (bit 4 = left), background cleared.
+ *
+ * Uses the same 6x8 cell as OledGfx_DrawChar().
+ */
+void OledGfx_DrawPattern(OledGfx_t *g, int16_t x, int16_t y, const uint8_t pattern[8]);
+
+/** @brief Draw a string; returns the x position after the last character. */
+int16_t OledGfx_DrawText(OledGfx_t *g, int16_t x, int16_t y, const char *s);
+
+#endif /* OLED_GFX_H */
@@ -0,0 +1,95 @@
+#ifndef OLED_SSD1306_H
+#define OLED_SSD1306_H
+
+#include "stm32l4xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include "oled_gfx.h"
+
+/**
+ * @file oled_ssd1306.h
+ * @brief SSD1306 / SH1106 128x64 OLED driver over I2C with DMA page updates.
+ *
+ * Device basics:
+ * - Default 7-bit I2C address: 0x3C (0x3D with SA0 high)
+ * - Control byte 0x00: the following bytes are commands
+ * - Control byte 0x40: the following bytes are display data
+ *
+ * Both controllers are driven in page addressing mode (the only mode the
+ * SH1106 has); the SH1106 maps the 128 visible columns to RAM columns 2..129.
+ *
+ * Updates are incremental: Oled_Flush() takes the changed column range of
+ * every page from the framebuffer (oled_gfx.h) and sends, per page, one
+ * 3-byte address command and one data burst with HAL_I2C_Mem_Write_DMA()
+ * (I2C1_TX on DMA1 Channel 6, same setup as the LCD queue). The next transfer
+ * is started from the I2C completion interrupt, so a flush never waits for
+ * the bus. Drawing may continue while a flush is in flight; those changes go
+ * out with the next flush.
+ *
+ * The module shares the HAL I2C callbacks with lcd_queue.c (main.c forwards
+ * them to Oled_I2cTxDone() / Oled_I2cError()); only one of the two may own
+ * a given I2C bus.
+ */
+
+#define OLED_I2C_ADDR_7BIT_DEFAULT   (0x3C)
+
+#define OLED_REG_CMD                 (0x00)
+#define OLED_REG_DATA                (0x40)
+
+/** Controller type. */
+typedef enum
+{
+    OLED_SSD1306 = 0,
+    OLED_SH1106
+} OledController;
+
+/** Driver context. */
+typedef struct
+{
+    I2C_HandleTypeDef *hi2c;     /**< HAL I2C handle */
+    uint8_t addr_7bit;           /**< 7-bit I2C address */
+    OledController controller;
+    uint32_t timeout_ms;         /**< Timeout of the blocking init transfers */
+} Oled_t;
+
+/** Flush completion callback; runs in interrupt context. */
+typedef void (*OledCallback)(void *arg);
+
+/**
+ * @brief Reset the controller, clear the panel (blocking) and bind the framebuffer.
+ *
+ * gfx is reinitialized to match the blank panel.
+ */
+HAL_StatusTypeDef Oled_Init(Oled_t *oled, I2C_HandleTypeDef *hi2c, uint8_t addr_7bit,
+                            OledController controller, OledGfx_t *gfx);
+
+/**
+ * @brief Start sending all pending framebuffer changes.
+ *
+ * Cheap when nothing changed; the main loop calls it every pass.
+ *
+ * @return HAL_OK (started or nothing to do), HAL_BUSY if the previous flush is
+ *         still in flight (changes stay pending), HAL_ERROR if not initialized.
+ */
+HAL_StatusTypeDef Oled_Flush(void);
+
+/**
+ * @brief Run callback once everything drawn so far is on the panel.
+ *
+ * One fence may be pending at a time (HAL_BUSY otherwise).
+ */
+HAL_StatusTypeDef Oled_Fence(OledCallback callback, void *arg);
+
+/** @brief True when no flush is in flight. */
+bool Oled_IsIdle(void);
+
+/** @brief Number of failed transfers since the last call (then cleared). */
+uint32_t Oled_TakeErrors(void);
+
+/** @brief I2C Mem TX complete (forwarded from HAL_I2C_MemTxCpltCallback()). */
+void Oled_I2cTxDone(I2C_HandleTypeDef *hi2c);
+
+/** @brief I2C error (forwarded from HAL_I2C_ErrorCallback()). */
+void Oled_I2cError(I2C_HandleTypeDef *hi2c);
+
+#endif /* OLED_SSD1306_H */
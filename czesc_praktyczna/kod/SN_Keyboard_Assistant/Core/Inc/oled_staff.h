@@ -0,0 +1,39 @@
+#ifndef OLED_STAFF_H
+#define OLED_STAFF_H
+
+#include <stdint.h>
+#include "oled_gfx.h"
+#include "songs.h"
+#include "chords.h"
+
+/**
+ * @file oled_staff.h
+ * @brief Notation view for the OLED: treble staff with the current and next steps.
+ *
+ * Screen layout (128x64):
+ * - page 0     : text row 0 of the character UI (display_oled.c)
+ * - pages 1..6 : this view - clef, staff, note heads with stems/flags and
+ *                accidentals for the current step and the two following ones,
+ *                a marker under the current step and a progress bar
+ * - page 7     : text row 1 of the character UI
+ *
+ * Each call clears and redraws the whole area; only bytes that really change
+ * reach the panel (see oled_gfx.h), so moving to the next step costs a few
+ * hundred bytes instead of a full 1 KB frame.
+ *
+ * HAL-free (host preview: Tools/oled_preview.c).
+ */
+
+#define OLED_STAFF_Y      (8)     /* first row of the notation area */
+#define OLED_STAFF_HEIGHT (48)    /* pages 1..6 */
+
+/** @brief Draw song steps index, index+1, index+2 (current one marked). */
+void OledStaff_DrawSong(OledGfx_t *g, const Song *song, uint8_t index);
+
+/** @brief Draw chords index, index+1, index+2 of a pack (root in octave 4, tones stacked upwards). */
+void OledStaff_DrawChords(OledGfx_t *g, const ChordPack *pack, uint8_t index);
+
+/** @brief Blank the notation area (summary screen, menus). */
+void OledStaff_Clear(OledGfx_t *g);
+
+#endif /* OLED_STAFF_H */
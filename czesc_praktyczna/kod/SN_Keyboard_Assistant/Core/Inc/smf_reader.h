@@ -0,0 +1,174 @@
+#ifndef SMF_READER_H
+#define SMF_READER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "songs.h"
+
+/**
+ * @file smf_reader.h
+ * @brief Streaming Standard MIDI File reader and lesson step iterator.
+ *
+ * Reads SMF format 0 / 1 (ticks-per-quarter division) in place, from a
+ * memory-mapped image (flash) or through a block read callback. Nothing is
+ * allocated and nothing is copied out of the file: each track keeps a cursor
+ * (offset, running status, tick of its next event, plus a small read cache
+ * when there is no memory-mapped image), and the tracks are merged in time
+ * order with a binary min-heap of track indices. RAM use depends only on
+ * SMF_MAX_TRACKS, not on the file size.
+ *
+ * Two layers:
+ * - SmfReader: time-ordered events of all tracks (VLQ delta times decoded,
+ *   running status expanded, meta / SysEx payloads left in the file),
+ * - SmfSteps:  lesson steps (SongStep) in the same layout as songs compiled
+ *   by Tools/midi2song.c: onsets in SONG_PPQ ticks on the sixteenth grid,
+ *   a new step at each bar line or after maxNotes notes, drum channel
+ *   skipped. Note durations come from a look-ahead over the following
+ *   events (bounded by SMF_LOOKAHEAD_BARS).
+ *
+ * Song_Step() (song_pack.h) plays such files as songs.
+ *
+ * HAL-free (also built into the host tools).
+ */
+
+/** Tracks read from one file (further tracks are ignored). */
+#define SMF_MAX_TRACKS       (16U)
+
+/** Per-track read cache when reading through SmfSource.read. */
+#define SMF_TRACK_CACHE      (16U)
+
+/** Most notes in one step from SmfSteps_Next(). */
+#define SMF_STEP_MAX_NOTES   (8U)
+
+/** How far ahead (bars) SmfSteps looks for the NOTE OFF of a step's notes. */
+#define SMF_LOOKAHEAD_BARS   (4U)
+
+/** MIDI channel skipped by SmfSteps (channel 10, percussion). */
+#define SMF_DRUM_CHANNEL     (9U)
+
+typedef enum {
+    SMF_OK = 0,
+    SMF_ERR_HEADER,      /* no MThd chunk */
+    SMF_ERR_FORMAT,      /* format 2 */
+    SMF_ERR_DIVISION,    /* SMPTE time division */
+    SMF_ERR_READ,        /* block read failed */
+    SMF_ERR_DATA         /* malformed event data */
+} SmfStatus;
+
+/**
+ * Block read callback: copy len bytes at offset into buf.
+ * @return false on a device error.
+ */
+typedef bool (*SmfReadFn)(void *ctx, uint32_t offset, uint8_t *buf, uint16_t len);
+
+/** Where the file is: memory-mapped (base != NULL) or behind read(). */
+typedef struct {
+    const uint8_t *base;
+    SmfReadFn read;
+    void *ctx;
+    uint32_t size;
+} SmfSource;
+
+/** One event, in merged time order. */
+typedef struct {
+    uint32_t tick;       /**< Absolute time in file ticks */
+    uint8_t track;
+    uint8_t status;      /**< Channel status byte, 0xFF meta, 0xF0 / 0xF7 SysEx */
+    uint8_t data1;       /**< Channel data 1, or meta type */
+    uint8_t data2;       /**< Channel data 2 (0 for 1-byte messages) */
+    uint32_t offset;     /**< Meta / SysEx payload position in the file */
+    uint32_t length;     /**< Meta / SysEx payload length */
+} SmfEvent;
+
+/** Cursor over one MTrk chunk. */
+typedef struct {
+    uint32_t pos;        /* next unread byte */
+    uint32_t end;        /* end of the chunk */
+    uint32_t tick;       /* absolute tick of the event at pos */
+    uint8_t status;      /* running status (0 = none) */
+    uint8_t cacheLen;
+    uint32_t cacheStart;
+    uint8_t cache[SMF_TRACK_CACHE];
+} SmfTrack;
+
+typedef struct {
+    SmfSource src;
+    SmfStatus status;
+    uint16_t format;
+    uint16_t division;           /* ticks per quarter note */
+    uint8_t trackCount;
+    SmfTrack tracks[SMF_MAX_TRACKS];
+    uint8_t heap[SMF_MAX_TRACKS];  /* min-heap of track indices, by (tick, track) */
+    uint8_t heapSize;
+
+    /* First tempo / time / key signature seen (defaults until then) */
+    uint32_t tempoUsPerQuarter;  /* 0 = none yet */
+    uint8_t beatsPerBar;
+    uint8_t beatUnit;
+    int8_t keySharps;            /* <0 flats, >0 sharps */
+    bool haveTimeSig;
+    bool haveKeySig;
+} SmfReader;
+
+/**
+ * @brief Open a file: check the header and position every track at its first event.
+ *
+ * @return SMF_OK, or why the file cannot be read (also kept in r->status).
+ */
+SmfStatus SmfReader_Open(SmfReader *r, const SmfSource *src);
+
+/**
+ * @brief Next event of all tracks in time order (ties: lower track first).
+ *
+ * End-of-track meta events are consumed internally. Tempo, time and key
+ * signature meta events are also noted in the reader.
+ *
+ * @return false at the end of the file or on an error (r->status).
+ */
+bool SmfReader_Next(SmfReader *r, SmfEvent *ev);
+
+/** @brief Copy len bytes at offset (e.g. a meta payload). */
+bool SmfReader_Read(SmfReader *r, uint32_t offset, uint8_t *buf, uint16_t len);
+
+/** Lesson step iterator over an SmfReader. */
+typedef struct {
+    SmfReader reader;        /* positioned after the last note taken */
+    uint32_t barTicks;       /* SONG_PPQ ticks per bar */
+    uint8_t maxNotes;
+    uint8_t index;           /* index of the step the next call returns */
+    bool havePending;        /* first note of the next step already read */
+    uint8_t pendingNote;
+    uint8_t pendingChannel;
+    uint32_t pendingTick;    /* file ticks */
+    uint16_t tempoBpm;       /* 0 = file has no tempo */
+    uint8_t beatsPerBar;
+    uint8_t beatUnit;
+    int8_t keySharps;
+    bool tickOverflow;       /* stopped at a note past tick 65535 (the rest is not played) */
+} SmfSteps;
+
+/**
+ * @brief Start iterating steps of a file (the meter is read from the events
+ *        before the first note).
+ *
+ * @param maxNotes Notes per step (1..SMF_STEP_MAX_NOTES); notes starting
+ *                 together are kept in one step up to SMF_STEP_MAX_NOTES.
+ */
+SmfStatus SmfSteps_Begin(SmfSteps *it, const SmfSource *src, uint8_t maxNotes);
+
+/**
+ * @brief Next step.
+ *
+ * Fills notes[0..SMF_STEP_MAX_NOTES-1] with midiNote, onsetTick and
+ * durationTicks (0 when durations is false, which skips the look-ahead);
+ * letter, accidental and lengthIcon are left to the caller. step->notes
+ * points at notes.
+ *
+ * Not reentrant (the look-ahead uses one static reader).
+ *
+ * @return false after the last step, on an error, or past tick 65535
+ *         (it->tickOverflow set: notes after that are left out).
+ */
+bool SmfSteps_Next(SmfSteps *it, SongStep *step, NoteEntry *notes, bool durations);
+
+#endif /* SMF_READER_H */
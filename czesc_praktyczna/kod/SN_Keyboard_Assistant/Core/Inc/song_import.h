@@ -0,0 +1,74 @@
+#ifndef SONG_IMPORT_H
+#define SONG_IMPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fat_reader.h"
+#include "nor_store.h"
+
+/**
+ * @file song_import.h
+ * @brief Copy the songs of a FAT folder (USB stick) into the content store.
+ *
+ * Every .mid file becomes a NOR_STORE_SONG_SMF item and every .txt file a
+ * NOR_STORE_SONG_TEXT item; a NOR_STORE_SONG_TITLE item with the same id
+ * holds the file name without its extension, shown in the song list.
+ * The id is a 24-bit hash of the file name, so importing the folder again
+ * replaces the songs instead of adding copies. A file whose bytes are
+ * already in the store is only compared, not written again (no flash wear
+ * for an unchanged library).
+ *
+ * Reads are pipelined: a file is read in chunks of up to SONG_IMPORT_CHUNK
+ * bytes (one read command per chunk, Fat_Run()), and while one chunk is
+ * being programmed into the flash the next one is already on its way
+ * (FatDisk.start / poll, polled between SONG_IMPORT_PIECE-byte program
+ * steps). Disks without start / poll are read blocking, chunk by chunk.
+ *
+ * HAL-free (also built into the host tools).
+ */
+
+/** Bytes per read command (two buffers of this size). */
+#define SONG_IMPORT_CHUNK      (4096U)
+
+/** Bytes programmed (or compared) between two polls of the disk. */
+#define SONG_IMPORT_PIECE      (256U)
+
+/** Longest title kept (LCD row width, as TEXT_SONG_TITLE_MAX). */
+#define SONG_IMPORT_TITLE_MAX  (16U)
+
+typedef struct {
+    uint16_t files;              /* .mid / .txt files found */
+    uint16_t imported;           /* written to the store */
+    uint16_t unchanged;          /* already in the store */
+    uint16_t skipped;            /* empty or too large */
+    uint16_t failed;             /* broken on the disk */
+    uint32_t bytes;              /* bytes written */
+    uint32_t reads;              /* read commands for file data */
+    uint32_t sectors;            /* sectors read for file data */
+    NorStoreStatus storeStatus;  /* why the import stopped, if it did */
+    FatStatus diskStatus;
+} SongImportReport;
+
+/** @brief Store id (24 bits) of a file name; upper / lower case do not matter. */
+uint32_t SongImport_Id(const char *name);
+
+/** @brief Title of a file name: without the extension, at most SONG_IMPORT_TITLE_MAX chars. */
+void SongImport_Title(const char *name, char title[SONG_IMPORT_TITLE_MAX + 1U]);
+
+/**
+ * @brief Import one file (ignored unless its extension is .mid or .txt).
+ *
+ * @return false if the import has to stop: the store failed (full, flash
+ *         error) or the disk stopped answering (see report).
+ */
+bool SongImport_File(NorStore *store, FatVolume *vol, const FatEntry *entry, SongImportReport *report);
+
+/**
+ * @brief Import every song file of a folder (subfolders are not entered).
+ *
+ * report is cleared first.
+ * @return true if the whole folder was read.
+ */
+bool SongImport_Folder(NorStore *store, FatFile *dir, SongImportReport *report);
+
+#endif /* SONG_IMPORT_H */
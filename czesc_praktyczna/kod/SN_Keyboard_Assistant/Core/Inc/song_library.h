@@ -0,0 +1,20 @@
+#ifndef SONG_LIBRARY_H
+#define SONG_LIBRARY_H
+
+#include <stdint.h>
+#include "song_pack.h"
+
+/*
+ * song_library.h / song_library.c
+ *
+ * Songs compiled from MIDI files by Tools/midi2song.c (packed, see
+ * song_pack.h). They are listed after the built-in songs (songs.h).
+ *
+ * song_library.c is generated; an empty library has LIBRARY_SONG_COUNT == 0
+ * (librarySongs[] then holds one unused placeholder).
+ */
+
+extern const Song librarySongs[];
+extern const uint8_t LIBRARY_SONG_COUNT;
+
+#endif /* SONG_LIBRARY_H */
@@ -0,0 +1,74 @@
+#ifndef SONG_LZ_H
+#define SONG_LZ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "songs.h"
+
+/**
+ * @file song_lz.h
+ * @brief Compressed song bodies (PackedSong with SONG_PACK_LZ) and their decoder.
+ *
+ * Songs are cut into blocks of at most SONG_LZ_BLOCK_STEPS steps whose
+ * token stream fits SONG_LZ_BLOCK_MAX bytes. Each block is compressed on its
+ * own, so reaching any step means inflating one block into a RAM buffer of
+ * SONG_LZ_BLOCK_MAX bytes (plus walking to the step inside it):
+ *
+ *   data   := blockCount:u8, index[blockCount], block...
+ *   index  := offset:u16 (of the block in data), startTick:u16,
+ *             firstStep:u8                                   (5 bytes)
+ *   block  := rawLength-1:u8, LZSS stream
+ *
+ * Tokens (the inflated block), per step:
+ *   count:u8, then per note
+ *   - pitch change to the previous note, zigzag VLQ (60 before the first
+ *     note of a block); one byte for steps up to 63 semitones
+ *   - dur:4 | delta:4, delta = onset distance to the previous note (block
+ *     start for the first) in SONG_PACK_GRID_TICKS; delta 15 is followed by
+ *     a VLQ with the rest
+ *
+ * LZSS stream: a flag byte for each group of 8 items (LSB first, 1 = match);
+ * a literal is one byte, a match two: distance-1, length-3 (copies from the
+ * bytes already inflated in the block, which may overlap the output).
+ *
+ * Written by Tools/midi2song.c --lz; read through Song_Step() (song_pack.h).
+ *
+ * HAL-free (also built into the host tools).
+ */
+
+/** Most steps in one block. */
+#define SONG_LZ_BLOCK_STEPS   (16U)
+
+/** Most token bytes in one block (size of the inflate buffer). */
+#define SONG_LZ_BLOCK_MAX     (256U)
+
+/** Pitch the delta coding starts from in each block. */
+#define SONG_LZ_BASE_PITCH    (60U)
+
+/** Bytes per index entry. */
+#define SONG_LZ_INDEX_ENTRY   (5U)
+
+/** Shortest and longest match. */
+#define SONG_LZ_MIN_MATCH     (3U)
+#define SONG_LZ_MAX_MATCH     (255U + SONG_LZ_MIN_MATCH)
+
+/**
+ * @brief Decode one step of a compressed body.
+ *
+ * Fills midiNote, onsetTick, durationTicks and lengthIcon of
+ * notes[0..SONG_PACK_MAX_STEP_NOTES-1] and points step->notes at them;
+ * the caller spells the notes. Going forward within a block only walks the
+ * tokens; another block is inflated first.
+ *
+ * @return false if the index is out of range or the data is corrupt.
+ */
+bool SongLz_DecodeStep(const uint8_t *data, uint16_t size, uint8_t index, SongStep *step, NoteEntry *notes);
+
+/**
+ * @brief Inflate an LZSS stream (format above).
+ *
+ * @return false if the stream is corrupt or does not produce exactly dstLen bytes.
+ */
+bool SongLz_Inflate(const uint8_t *src, uint16_t srcLen, uint8_t *dst, uint16_t dstLen);
+
+#endif /* SONG_LZ_H */
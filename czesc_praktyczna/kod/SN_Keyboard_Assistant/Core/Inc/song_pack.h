@@ -0,0 +1,178 @@
+#ifndef SONG_PACK_H
+#define SONG_PACK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "songs.h"
+#include "note_mask.h"
+#include "lesson_render.h"
+#include "smf_reader.h"
+
+/**
+ * @file song_pack.h
+ * @brief Compact song format for large libraries, and step access for all songs.
+ *
+ * Songs compiled from MIDI files (Tools/midi2song.c -> song_library.c) are
+ * stored as a byte stream instead of SongStep / NoteEntry arrays:
+ *
+ *   step  := count:u8, entry[count]
+ *   entry := u16, little endian
+ *            bits 0..6   pitch (MIDI 1..127; 0 = rest, only advances time)
+ *            bits 7..10  duration code (songPackDurations[])
+ *            bits 11..15 onset delta to the previous entry, in
+ *                        SONG_PACK_GRID_TICKS (0 = together with it)
+ *
+ * So a note costs 2 bytes and a step 1 more; letter, accidental, length icon
+ * and absolute ticks are derived when a step is decoded. Gaps longer than the
+ * delta field are bridged with rests.
+ *
+ * With SONG_PACK_LZ set, the same steps are delta/VLQ coded and LZSS
+ * compressed in blocks (song_lz.h), for large libraries.
+ *
+ * With SONG_PACK_SMF set, data is a Standard MIDI File image instead, read
+ * in place by the streaming reader (smf_reader.h) with the same step rules
+ * (SONG_PACK_SMF_STEP_NOTES notes per step). SongPack_OpenSmf() turns a
+ * .mid image in flash into a song at run time; SongPack_OpenSmfSource()
+ * does the same for a file that is read through a callback.
+ *
+ * A song has at most 255 steps (Song.stepCount). An SMF or text song that
+ * is longer is opened with its first 255 steps and SONG_PACK_TRUNCATED set
+ * (SongPack_IsTruncated()), so the UI can say that the piece was cut. The
+ * same goes for an SMF song with notes past tick 65535 (NoteEntry.onsetTick);
+ * a text song that long is an error (SONG_TEXT_ERR_TOO_LONG).
+ *
+ * With SONG_PACK_TEXT set, data is a text song (song_text.h), parsed in
+ * place step by step (SONG_PACK_TEXT_STEP_NOTES notes per step);
+ * SongPack_OpenText() makes the song.
+ *
+ * Optional per-step extras, emitted by the compiler on request:
+ * - masks : the step's notes as a NoteMask128_t (used by the lesson engine
+ *           when the step has no repeated notes),
+ * - frames: pre-rendered LCD screens (lesson_render.h).
+ *
+ * Song_Step() returns any song's step as a SongStep: a pointer into the
+ * array for hand-written songs, or a step decoded into a small RAM window
+ * for packed ones. The window holds SONG_PACK_WINDOW steps (current step +
+ * the staff view's look-ahead); the pointer stays valid until
+ * SONG_PACK_WINDOW other steps have been requested.
+ *
+ * HAL-free (also built into the host tools).
+ */
+
+/** Onset grid: sixteenth notes. */
+#define SONG_PACK_GRID_TICKS      (SONG_PPQ / 4U)
+
+/** Largest onset delta of one entry, in grid units. */
+#define SONG_PACK_MAX_DELTA       (31U)
+
+/** Most entries (notes + rests) in one step. */
+#define SONG_PACK_MAX_STEP_NOTES  (8U)
+
+/** Decoded steps kept in RAM. */
+#define SONG_PACK_WINDOW          (4U)
+
+#define SONG_PACK_REST            (0U)
+
+/** PackedSong.flags: spell black keys with flats (Bb, Eb) instead of sharps. */
+#define SONG_PACK_FLATS           (0x01U)
+
+/** PackedSong.flags: data is a Standard MIDI File (format 0 / 1). */
+#define SONG_PACK_SMF             (0x02U)
+
+/** PackedSong.flags: data is compressed (song_lz.h). */
+#define SONG_PACK_LZ              (0x04U)
+
+/** PackedSong.flags: data is a text song (song_text.h). */
+#define SONG_PACK_TEXT            (0x08U)
+
+/** PackedSong.flags: the file is longer than a song can hold (255 steps, tick 65535); the rest is not played. */
+#define SONG_PACK_TRUNCATED       (0x10U)
+
+/** Notes per step of SMF songs (Tools/midi2song.c default). */
+#define SONG_PACK_SMF_STEP_NOTES  (4U)
+
+/** Notes per step of text songs (a bar line also ends a step). */
+#define SONG_PACK_TEXT_STEP_NOTES (4U)
+
+#define SONG_PACK_ENTRY(pitch, dur, delta) \
+    ((uint16_t)(((pitch) & 0x7FU) | (((dur) & 0x0FU) << 7) | (((delta) & 0x1FU) << 11)))
+#define SONG_PACK_PITCH(e)        ((uint8_t)((e) & 0x7FU))
+#define SONG_PACK_DUR(e)          ((uint8_t)(((e) >> 7) & 0x0FU))
+#define SONG_PACK_DELTA(e)        ((uint8_t)(((e) >> 11) & 0x1FU))
+
+/** Note durations in ticks, by duration code. */
+extern const uint16_t songPackDurations[16];
+
+/** Packed song body (Song.packed). */
+typedef struct PackedSong
+{
+    const uint8_t *data;          /**< Step stream (format above), compressed blocks, .mid image or text */
+    uint16_t size;                /**< Bytes in data */
+    uint16_t noteCount;           /**< Notes (without rests), for reports */
+    uint8_t flags;                /**< SONG_PACK_* */
+    const NoteMask128_t *masks;   /**< One per step, or NULL */
+    const LessonFrame_t *frames;  /**< One per step, or NULL */
+    const SmfSource *source;      /**< SMF / text read through a callback (data is NULL), or NULL */
+} PackedSong;
+
+/**
+ * @brief Step of any song (hand-written or packed).
+ *
+ * @return The step, or NULL if index is out of range or the data is corrupt.
+ */
+const SongStep *Song_Step(const Song *song, uint8_t index);
+
+/**
+ * @brief Make a song of a Standard MIDI File image (memory-mapped, read in place).
+ *
+ * Reads tempo, meter and key signature and counts the steps (one pass over
+ * the file). The song refers to body and file, which must stay valid.
+ *
+ * @return false if the file cannot be read, is larger than 64 KiB or has no
+ *         notes. A file with more than 255 steps or notes past tick
+ *         65535 is not an error: it is cut there and flagged
+ *         SONG_PACK_TRUNCATED.
+ */
+bool SongPack_OpenSmf(Song *song, PackedSong *body, const uint8_t *file, uint32_t size, const char *title);
+
+/**
+ * @brief Make a song of a text song (song_text.h, memory-mapped, read in place).
+ *
+ * Reads the header fields and counts the steps (one pass over the text).
+ * The song refers to body and text, which must stay valid.
+ *
+ * @param title Shown in the UI (the text's T: field is read with SongText_Title()).
+ * @return false if the text has an error (error line in *errorLine when
+ *         not NULL), is larger than 64 KiB or has no notes. Steps after
+ *         the 255th are not parsed (SONG_PACK_TRUNCATED).
+ */
+bool SongPack_OpenText(Song *song, PackedSong *body, const char *text, uint32_t size,
+                       const char *title, uint16_t *errorLine);
+
+/**
+ * @brief SongPack_OpenSmf() for a file behind a read callback (external
+ *        flash store, USB stick).
+ *
+ * src must stay valid while the song is used (the body keeps a pointer to
+ * it). Steps are re-read through src as they are played.
+ */
+bool SongPack_OpenSmfSource(Song *song, PackedSong *body, const SmfSource *src, const char *title);
+
+/** @brief SongPack_OpenText() for a text behind a read callback (see SongPack_OpenSmfSource()). */
+bool SongPack_OpenTextSource(Song *song, PackedSong *body, const SmfSource *src,
+                             const char *title, uint16_t *errorLine);
+
+/** @brief true if the song was opened without the end of its file (SONG_PACK_TRUNCATED). */
+bool SongPack_IsTruncated(const Song *song);
+
+/** @brief Duration code closest to a length in ticks (compiler side). */
+uint8_t SongPack_DurationCode(uint32_t ticks);
+
+/** @brief Length icon (GLYPH_WHOLE..GLYPH_SIXTEENTH) for a length in ticks. */
+uint8_t SongPack_LengthIcon(uint32_t ticks);
+
+/** @brief Fill letter / accidental of a NoteEntry from its midiNote. */
+void SongPack_Spell(NoteEntry *note, bool flats);
+
+#endif /* SONG_PACK_H */
@@ -0,0 +1,125 @@
+#ifndef SONG_TEXT_H
+#define SONG_TEXT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "songs.h"
+#include "note_mask.h"
+#include "smf_reader.h"
+
+/**
+ * @file song_text.h
+ * @brief Text song notation (ABC-like) and its streaming step parser.
+ *
+ * Exercises can be written as plain text and played without being expanded
+ * into SongStep / NoteEntry arrays first: the parser reads the text in place
+ * (memory-mapped, or through the block read callback of SmfSource) and
+ * returns one lesson step per call. Nothing is allocated; the state is the
+ * SongText struct plus one static copy for the tie look-ahead.
+ *
+ *   % comment (to the end of the line)
+ *   T:Scale in C          title
+ *   Q:96                  tempo, quarter notes per minute (also Q:1/4=96)
+ *   M:3/4                 meter (M:C = 4/4, M:C| = 2/2)
+ *   L:1/8                 unit length of the notes below (default 1/4)
+ *   C4 D4 E4*2 | F#4/2 Bb4/2 A4. z/2 | [C4 E4 G4]*4- | [C4 E4 G4]*4 ||
+ *
+ * - note:  a name as NoteName_ToMidi() reads it (C4, F#4, Bb3, Cis5, H3)
+ * - rest:  z
+ * - chord: notes in brackets, sounding together; the chord takes as long
+ *          as its first note
+ * - length after a note, rest or chord, in units: *n multiplies, /n divides
+ *          (/ alone halves), each '.' adds half of the previous value
+ *          (C4*3/2, E4/, G4.)
+ * - tie:   '-' after a note (or after a chord for all its notes) holds it
+ *          into the next note of the same pitch, which is then not played
+ *          again
+ * - bar:   '|' (also ||, |], |:, :|; repeats are not expanded)
+ *
+ * Steps: a bar line ends a step, and a step also ends before a chord or
+ * note that would take it past maxNotes. Onsets and lengths are in
+ * SONG_PPQ ticks. Letter and accidental come from the note name as written.
+ *
+ * Header fields set the song values only before the first note; later
+ * L: fields change the unit from there on, other fields are ignored.
+ *
+ * HAL-free (also built into the host tools).
+ */
+
+/** Most notes in one step (and in one chord). */
+#define SONG_TEXT_MAX_NOTES   (8U)
+
+/** Read cache when reading through SmfSource.read. */
+#define SONG_TEXT_CACHE       (32U)
+
+/** Bar lines the tie look-ahead crosses before giving up. */
+#define SONG_TEXT_TIE_BARS    (2U)
+
+typedef enum {
+    SONG_TEXT_OK = 0,
+    SONG_TEXT_ERR_READ,      /* block read failed */
+    SONG_TEXT_ERR_SYNTAX,    /* unexpected character */
+    SONG_TEXT_ERR_NOTE,      /* note name NoteName_ToMidi() rejects */
+    SONG_TEXT_ERR_LENGTH,    /* zero or too long note length */
+    SONG_TEXT_ERR_CHORD,     /* empty, unclosed or too large chord */
+    SONG_TEXT_ERR_TOO_LONG   /* past tick 65535 */
+} SongTextStatus;
+
+/** Parse position (copied to rewind or look ahead). */
+typedef struct {
+    uint32_t pos;            /* next unread character */
+    uint16_t line;           /* line of pos (1 = first), for error messages */
+    uint16_t unitTicks;      /* L: */
+    uint32_t tick;           /* onset of the next note */
+    NoteMask128_t tied;      /* pitches whose next note continues a tie */
+} SongTextCursor;
+
+typedef struct {
+    SmfSource src;
+    SongTextStatus status;
+    SongTextCursor at;
+    uint8_t maxNotes;
+    uint8_t index;           /* index of the step the next call returns */
+
+    /* Header fields before the first note (defaults when missing) */
+    uint16_t tempoBpm;       /* 0 = no Q: field */
+    uint8_t beatsPerBar;
+    uint8_t beatUnit;
+    uint32_t titlePos;       /* T: value, titleLen 0 = none */
+    uint8_t titleLen;
+
+    uint32_t cacheStart;
+    uint8_t cacheLen;
+    char cache[SONG_TEXT_CACHE];
+} SongText;
+
+/**
+ * @brief Start parsing a text song: reads the header fields before the first note.
+ *
+ * @param maxNotes Notes per step (1..SONG_TEXT_MAX_NOTES).
+ * @return SONG_TEXT_OK, or the first error (also kept in it->status, the
+ *         line in it->at.line).
+ */
+SongTextStatus SongText_Begin(SongText *it, const SmfSource *src, uint8_t maxNotes);
+
+/**
+ * @brief Next step.
+ *
+ * Fills notes[0..SONG_TEXT_MAX_NOTES-1] with letter, accidental, midiNote,
+ * onsetTick and durationTicks; lengthIcon is left to the caller.
+ * step->notes points at notes.
+ *
+ * Not reentrant (the tie look-ahead uses one static parser).
+ *
+ * @return false after the last step or on an error (it->status, it->at.line).
+ */
+bool SongText_Next(SongText *it, SongStep *step, NoteEntry *notes);
+
+/**
+ * @brief Copy the T: field (null-terminated, cut to size - 1 characters).
+ *
+ * @return false if the text has no title before its first note.
+ */
+bool SongText_Title(SongText *it, char *buf, uint8_t size);
+
+#endif /* SONG_TEXT_H */
@@ -2,43 +2,127 @@
 #define SONGS_H
 
 #include <stdint.h>
+#include "note_names.h"
 
 /*
  * songs.h
  *
  * This header defines the data structures used to describe built-in songs.
- * A song consists of multiple steps (SongStep). Each step holds up to 3 notes.
+ * A song consists of multiple steps (SongStep). Each step holds any number of
+ * notes (a short phrase or a chord); the same note may appear several times.
  *
  * The lesson engine (lesson.c) uses these structures to display required notes
  * and verify user input from a MIDI keyboard.
+ *
+ * Timing (rhythm lessons): every note carries its onset and duration in ticks
+ * of SONG_PPQ per quarter note, counted from the start of the song; the song
+ * gives the tempo and time signature that turn ticks into microseconds. Each
+ * step also says how its notes are to be held (Articulation), which rhythm
+ * lessons check against the NOTE OFF times.
+ *
+ * All song data is const and stays in flash (nothing is copied to RAM at
+ * start-up). Notes are written with PITCH() / NOTE(), which check each value
+ * at compile time (see below).
  */
 
+/* Timing resolution: ticks per quarter note (divisible by 2..32nd notes and triplets) */
+#define SONG_PPQ            (96U)
+
+/* Tempo used when a song does not set one */
+#define SONG_DEFAULT_BPM    (100U)
+
 /* Accidental indicator for notes */
 typedef enum { ACC_NONE = 0, ACC_SHARP, ACC_FLAT } Accidental;
 
-/* Structure describing a single note within a step */
+/* Structure describing a single note within a step (8 bytes) */
 typedef struct {
-    char letter;            /* Note letter A..G */
-    Accidental accidental;  /* ACC_NONE / ACC_SHARP / ACC_FLAT */
-    int8_t midiNote;        /* MIDI note number (0..127), or -1 if not applicable */
-    uint8_t lengthIcon;     /* LCD custom char slot for note length icon (0..4) */
+    char letter;                /* Note letter A..G */
+    uint8_t accidental : 2;     /* Accidental: ACC_NONE / ACC_SHARP / ACC_FLAT */
+    int8_t midiNote;            /* MIDI note number (0..127), or -1 if not applicable */
+    uint8_t lengthIcon : 3;     /* Glyph ID of the note length icon (0..4, see glyphs.h) */
+    uint16_t onsetTick;         /* Start, in ticks from the song start (0 in chord mode) */
+    uint16_t durationTicks;     /* Length in ticks (0 in chord mode) */
 } NoteEntry;
 
-/* A step in a song lesson (up to 3 notes, each with a duration) */
+/* How the notes of a step are held, relative to their written duration */
+typedef enum {
+    ARTIC_NORMAL = 0,   /* non-legato: at least half, not past the next note */
+    ARTIC_LEGATO,       /* almost the full value, a short overlap is fine */
+    ARTIC_STACCATO      /* short: at most half the value */
+} Articulation;
+
+/* A step in a song lesson (notes, each with a duration) */
 typedef struct {
-    uint8_t noteCount;      /* Number of valid entries in notes[] */
-    NoteEntry notes[3];     /* Required notes for this step */
+    uint8_t noteCount;      /* Number of entries in notes[] */
+    const NoteEntry *notes; /* Required notes for this step */
+    Articulation articulation; /* Expected articulation (omitted = ARTIC_NORMAL) */
 } SongStep;
 
-/* Song definition (title + step list) */
+/*
+ * Compile-time check usable inside initializers: evaluates to 0, or stops
+ * the build ("size of unnamed array is negative") if cond is false.
+ */
+#define SONG_CHECK(cond)    (0 * (int)sizeof(char[(cond) ? 1 : -1]))
+
+/* Pitch class of a letter (-1 if not A..G) and of a letter + accidental */
+#define NOTE_LETTER_PC(l) \
+    ((l) == 'C' ? 0 : (l) == 'D' ? 2 : (l) == 'E' ? 4 : (l) == 'F' ? 5 : \
+     (l) == 'G' ? 7 : (l) == 'A' ? 9 : (l) == 'B' ? 11 : -1)
+#define NOTE_PC(l, acc) \
+    ((NOTE_LETTER_PC(l) + ((acc) == ACC_SHARP) - ((acc) == ACC_FLAT) + 12) % 12)
+
+/*
+ * Checked NoteEntry initializer: letter A..G, a valid accidental, MIDI note
+ * -1..127 matching letter + accidental, length icon 0..4, ticks 0..65535.
+ */
+#define NOTE(l, acc, midi, icon, onset, dur) { \
+    (char)((l) + SONG_CHECK(NOTE_LETTER_PC(l) >= 0)), \
+    (acc) + SONG_CHECK((acc) >= ACC_NONE && (acc) <= ACC_FLAT), \
+    (int8_t)((midi) + SONG_CHECK((midi) >= -1 && (midi) <= 127 && \
+                                 ((midi) < 0 || (midi) % 12 == NOTE_PC(l, acc)))), \
+    (icon) + SONG_CHECK((icon) >= 0 && (icon) <= 4), \
+    (uint16_t)((onset) + SONG_CHECK((onset) >= 0 && (onset) <= 0xFFFF)), \
+    (uint16_t)((dur) + SONG_CHECK((dur) >= 0 && (dur) <= 0xFFFF)) }
+
+/*
+ * NOTE() with the pitch given by name: PITCH(Cs4, icon, onset, dur) is
+ * NOTE('C', ACC_SHARP, 61, icon, onset, dur). Sharps are written 's', flats
+ * 'b' (Bb3); names come from note_names.h (generated by Tools/gen_note_names.c
+ * from the runtime parser in notes.c), a misspelled name does not compile.
+ */
+#define PITCH(name, icon, onset, dur)   NOTE_BY_NAME(PITCH_##name, icon, onset, dur)
+#define NOTE_BY_NAME(...)               NOTE(__VA_ARGS__)
+
+/*
+ * Note list initializer for SongStep / Chord: expands to "count, array", e.g.
+ *   { NOTES(PITCH(C4, 2, 0, 96), PITCH(E4, 2, 96, 96)) }
+ * The array is a file-scope compound literal (static storage, const).
+ */
+#define NOTE_LIST_COUNT(...)   (sizeof((const NoteEntry[]){ __VA_ARGS__ }) / sizeof(NoteEntry))
+#define NOTES(...) \
+    (uint8_t)(NOTE_LIST_COUNT(__VA_ARGS__) + SONG_CHECK(NOTE_LIST_COUNT(__VA_ARGS__) <= 255U)), \
+    (const NoteEntry[]){ __VA_ARGS__ }
+
+/* Step list initializer for Song: "count, array" of a SongStep array (1..255 steps). */
+#define STEPS(a) \
+    (uint8_t)(sizeof(a) / sizeof((a)[0]) + SONG_CHECK(sizeof(a) / sizeof((a)[0]) <= 255U)), (a)
+
+/*
+ * Song definition (title + step list + meter). Songs compiled from MIDI files
+ * have steps == NULL and a packed body; read steps with Song_Step().
+ */
 typedef struct {
     const char *title;      /* Song title shown in the UI */
     uint8_t stepCount;      /* Number of steps in the song */
-    SongStep *steps;        /* Pointer to the step array */
+    const SongStep *steps;  /* Pointer to the step array */
+    uint16_t tempoBpm;      /* Quarter notes per minute (0 = SONG_DEFAULT_BPM) */
+    uint8_t beatsPerBar;    /* Time signature numerator (e.g. 3 in 3/4) */
+    uint8_t beatUnit;       /* Time signature denominator (e.g. 4 in 3/4) */
+    const struct PackedSong *packed; /* Compact body instead of steps (song_pack.h), or NULL */
 } Song;
 
 /* Expose the song list and count */
-extern Song songs[];
+extern const Song songs[];
 extern const uint8_t SONG_COUNT;
 
 #endif /* SONGS_H */
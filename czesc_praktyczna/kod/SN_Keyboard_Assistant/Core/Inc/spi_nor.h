@@ -0,0 +1,63 @@
+#ifndef SPI_NOR_H
+#define SPI_NOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nor_store.h"
+
+/**
+ * @file spi_nor.h
+ * @brief External SPI NOR flash (W25Qxx and compatibles) on SPI1 with DMA.
+ *
+ * Pins (Arduino header of the Nucleo board):
+ * - PA5 SCK (D13), PA6 MISO (D12), PA7 MOSI (D11), AF5
+ * - PA8 chip select (D7), active low
+ *
+ * Note: PA5 also drives the Nucleo user LED LD2, which flickers with the
+ * clock; that does not disturb the transfers.
+ *
+ * Commands and address phase are sent byte by byte; the data phase of
+ * reads and page programs runs on DMA1 channel 2 (SPI1_RX) and channel 3
+ * (SPI1_TX), and the CPU waits on the transfer complete flag. Calls are
+ * blocking: a page program takes up to a few ms, a 64 KB block erase up to
+ * SPI_NOR_ERASE_TIMEOUT_MS.
+ *
+ * 3-byte addressing: chips larger than 16 MB are used up to 16 MB.
+ */
+
+#define SPI_NOR_PAGE_SIZE         (256U)
+#define SPI_NOR_BLOCK_SIZE        (65536UL)     /* erase unit (command 0xD8) */
+
+#define SPI_NOR_PROGRAM_TIMEOUT_MS  (10U)
+#define SPI_NOR_ERASE_TIMEOUT_MS    (3000U)
+
+/** SPI1 clock divider exponent: SCK = PCLK2 / 2^(n+1); 1 -> 20 MHz at 80 MHz. */
+#ifndef SPI_NOR_BAUD_DIV
+#define SPI_NOR_BAUD_DIV          (1U)
+#endif
+
+/**
+ * @brief Set up the pins, SPI1 and the DMA channels, and identify the chip.
+ *
+ * @return false if no chip answers the JEDEC ID command.
+ */
+bool SpiNor_Init(void);
+
+/** @brief JEDEC ID (manufacturer << 16 | type << 8 | capacity), 0 before SpiNor_Init(). */
+uint32_t SpiNor_JedecId(void);
+
+/** @brief Usable size in bytes (from the JEDEC capacity code). */
+uint32_t SpiNor_Size(void);
+
+bool SpiNor_Read(uint32_t addr, uint8_t *buf, uint32_t len);
+
+/** @brief Program any range (split at page boundaries); bits can only go from 1 to 0. */
+bool SpiNor_Program(uint32_t addr, const uint8_t *buf, uint32_t len);
+
+/** @brief Erase the 64 KB block at addr (block aligned). */
+bool SpiNor_EraseBlock(uint32_t addr);
+
+/** @brief The chip as a NorDevice: one segment per 64 KB block. */
+void SpiNor_Device(NorDevice *dev);
+
+#endif /* SPI_NOR_H */
@@ -0,0 +1,39 @@
+#ifndef STORE_SONGS_H
+#define STORE_SONGS_H
+
+#include <stdint.h>
+#include "songs.h"
+#include "nor_store.h"
+
+/*
+ * store_songs.h / store_songs.c
+ *
+ * Songs kept in the content store on the external flash (imported from a
+ * USB stick, song_import.h), listed after the text exercises.
+ *
+ * The list is the store's NOR_STORE_SONG_SMF and NOR_STORE_SONG_TEXT
+ * items in key order. A song is opened only when it is started: the one
+ * open song is read from the flash step by step while it is played, so
+ * opening another one closes it. Titles come from the NOR_STORE_SONG_TITLE
+ * items.
+ */
+
+/* Longest title kept (LCD row width) */
+#define STORE_SONG_TITLE_MAX  (16U)
+
+/* Use the songs of a mounted store (NULL: no store, empty list). */
+void StoreSongs_Attach(NorStore *store);
+
+/* Count the songs again (after an import). */
+void StoreSongs_Refresh(void);
+
+/* Number of songs in the store. */
+uint16_t StoreSongs_Count(void);
+
+/* Title of a song by list position (valid until the next call). */
+const char *StoreSongs_Title(uint16_t index);
+
+/* Open a song for playing; NULL if it cannot be read or has no notes. */
+const Song *StoreSongs_Open(uint16_t index);
+
+#endif /* STORE_SONGS_H */
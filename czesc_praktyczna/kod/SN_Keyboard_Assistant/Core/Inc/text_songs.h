@@ -0,0 +1,30 @@
+#ifndef TEXT_SONGS_H
+#define TEXT_SONGS_H
+
+#include <stdint.h>
+#include "songs.h"
+
+/*
+ * text_songs.h / text_songs.c
+ *
+ * Exercises written in the text song notation (song_text.h), kept in flash
+ * as text and parsed step by step while they are played. They are listed
+ * after the built-in songs and the compiled library.
+ *
+ * TextSongs_Init() reads each exercise's header and counts its steps; an
+ * exercise with an error in its text is left out of the list.
+ */
+
+/* Longest title kept (LCD row width) */
+#define TEXT_SONG_TITLE_MAX   (16U)
+
+/* Open the exercises (once, at start-up). */
+void TextSongs_Init(void);
+
+/* Number of exercises that opened without errors. */
+uint8_t TextSongs_Count(void);
+
+/* Exercise by list position (0..TextSongs_Count()-1). */
+const Song *TextSongs_At(uint8_t index);
+
+#endif /* TEXT_SONGS_H */
@@ -0,0 +1,57 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <stdint.h>
+
+/**
+ * @file timebase.h
+ * @brief Free-running 32-bit microsecond timebase.
+ *
+ * TIM2 (the only 32-bit general purpose timer used by this project) is
+ * prescaled to 1 MHz and left counting over the full 32-bit range, so:
+ * - one count = 1 us
+ * - the counter wraps every ~71.6 minutes
+ *
+ * Always compare timestamps with unsigned subtraction, e.g.
+ * (uint32_t)(Timebase_Micros() - start) >= timeout_us, which is wrap-safe.
+ *
+ * Capture/compare channel 1 provides a single one-shot alarm that calls back
+ * from the TIM2 interrupt (used to wait out LCD controller execution times
+ * without blocking the main loop).
+ */
+
+/**
+ * NVIC priority of the TIM2 alarm. Must equal LCDQ_IRQ_PRIORITY so the alarm
+ * and the I2C/DMA completion handlers never preempt each other.
+ */
+#define TIMEBASE_IRQ_PRIORITY   (5U)
+
+/** Alarm callback, runs in the TIM2 interrupt. */
+typedef void (*TimebaseAlarmCallback)(void);
+
+/** @brief Start the timer (call once, after SystemClock_Config()). */
+void Timebase_Init(void);
+
+/** @brief Current timestamp in microseconds (wraps at 2^32). */
+uint32_t Timebase_Micros(void);
+
+/**
+ * @brief Busy-wait for the given number of microseconds.
+ *
+ * Intended only for short controller timing (e.g. LCD command execution time).
+ * Longer waits should be scheduled with the timer wheel instead.
+ */
+void Timebase_DelayUs(uint32_t us);
+
+/**
+ * @brief Arm the one-shot alarm (replaces a pending one).
+ *
+ * @param delay_us Microseconds from now (at least 1).
+ * @param callback Called once from the TIM2 interrupt when the delay expires.
+ */
+void Timebase_SetAlarmUs(uint32_t delay_us, TimebaseAlarmCallback callback);
+
+/** @brief TIM2 interrupt body (called from TIM2_IRQHandler). */
+void Timebase_IRQHandler(void);
+
+#endif /* TIMEBASE_H */
@@ -0,0 +1,73 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file timer_wheel.h
+ * @brief Software timers on a two-level hierarchical timer wheel.
+ *
+ * - Tick length: TIMER_WHEEL_TICK_US (1 ms), derived from the microsecond timebase.
+ * - Level 0: 256 slots, one per tick (covers the next 256 ms).
+ * - Level 1: 64 slots, 256 ticks each (covers ~16.4 s); entries are cascaded
+ *   into level 0 when their slot comes up. Longer timers are parked in the
+ *   farthest level 1 slot and re-hashed on every cascade.
+ *
+ * Start and cancel are O(1) (intrusive linked lists with back-links, no allocation).
+ * Callbacks are NOT called from interrupt context: they run from
+ * TimerWheel_Process(), which the main loop calls on every iteration.
+ *
+ * Timer objects are owned by the caller and must stay valid (typically static)
+ * while they are running.
+ */
+
+#define TIMER_WHEEL_TICK_US   (1000U)
+
+typedef void (*SoftTimerCallback)(void *arg);
+
+/**
+ * @brief One software timer. Treat all fields as private.
+ */
+typedef struct SoftTimer
+{
+    struct SoftTimer *next;     /**< Next timer in the same wheel slot */
+    struct SoftTimer **pprev;   /**< Link pointing at this timer (NULL when idle) */
+    uint32_t expires;           /**< Absolute expiry tick */
+    uint32_t period;            /**< Reload in ticks, 0 = one-shot */
+    SoftTimerCallback callback; /**< Called from TimerWheel_Process() */
+    void *arg;                  /**< Passed to callback */
+} SoftTimer_t;
+
+/** @brief Initialize the wheel (after Timebase_Init()). */
+void TimerWheel_Init(void);
+
+/**
+ * @brief Start (or restart) a timer.
+ *
+ * @param timer     Caller-owned timer object.
+ * @param delay_ms  First expiry, in ticks (ms) from now. 0 is treated as 1.
+ * @param period_ms Reload period in ms; 0 makes the timer one-shot.
+ * @param callback  Function called on expiry.
+ * @param arg       User argument for the callback.
+ */
+void TimerWheel_Start(SoftTimer_t *timer, uint32_t delay_ms, uint32_t period_ms,
+                      SoftTimerCallback callback, void *arg);
+
+/** @brief Stop a timer; safe to call on an idle timer and from callbacks. */
+void TimerWheel_Cancel(SoftTimer_t *timer);
+
+/** @brief Return true while the timer is scheduled. */
+bool TimerWheel_IsActive(const SoftTimer_t *timer);
+
+/** @brief Current wheel time in ticks (ms). */
+uint32_t TimerWheel_Now(void);
+
+/**
+ * @brief Advance the wheel to the current time and run expired callbacks.
+ *
+ * Must be called regularly from the main loop.
+ */
+void TimerWheel_Process(void);
+
+#endif /* TIMER_WHEEL_H */
@@ -3,55 +3,79 @@
  *
  * Top-level user interface and navigation logic.
  * The module reacts to button presses and drives:
- * - LCD screens (welcome/menu/lists/legend)
+ * - LCD screens (welcome/menu/lists/legend), composed in the shadow
+ *   framebuffer and sent with LcdFb_Flush() (only changed cells go on the bus)
  * - lesson engine start/stop and button forwarding during lessons
  *
  * NOTE: This file only contains UI/state-machine code. USB/MIDI parsing happens in main.c.
  */
 
 #include "app.h"
-#include "grove_lcd16x2_i2c.h"
+#include "lcd_framebuffer.h"
+#include "latency.h"
+#include "freeplay.h"
+#include "song_library.h"
+#include "text_songs.h"
+#include "store_songs.h"
 
-/* LCD instance lives in main.c (initialized there via GroveLCD_Init). */
-extern GroveLCD_t lcd;
+#include <stdio.h>  /* snprintf() */
 
 /* Current application state and menu indices (kept static inside this module). */
 static AppState appState;
 static uint8_t mainMenuIndex = 0;
-static uint8_t songListIndex = 0;
+static uint16_t songListIndex = 0;   /* built-in songs, the song library, text exercises, then the store */
 static uint8_t chordPackIndex = 0;
+static uint8_t latencyStageIndex = 0;
 
-/* Forward declarations for LCD screen rendering functions. */
-static void DisplayWelcomeScreen(void);
-static void DisplayMainMenu(void);
-static void DisplayNotesLegend(void);
-static void DisplaySongsList(void);
-static void DisplayChordPacksList(void);
+/* Number of entries in the main menu */
+#define MAIN_MENU_COUNT  6U
 
-/**
- * @brief Clears a single LCD row by overwriting it with spaces.
- * @param row LCD row index (0 or 1 for a 16x2 display).
+/*
+ * Song list: built-in songs (songs.c), the compiled library (song_library.c),
+ * the text exercises (text_songs.c), then the songs imported into the
+ * external flash (store_songs.c).
  */
-static void LCD_ClearRow(uint8_t row)
+static uint16_t SongTotal(void)
 {
-    GroveLCD_SetCursor(&lcd, row, 0);
-    GroveLCD_Print(&lcd, "                "); /* 16 spaces */
+    return (uint16_t)(SONG_COUNT + LIBRARY_SONG_COUNT + TextSongs_Count() + StoreSongs_Count());
 }
 
-/**
- * @brief Writes one of the LCD custom characters (CGRAM slot 0..7).
- * @param slot Custom character slot index.
- */
-static void LCD_WriteCustom(uint8_t slot)
+/* Song to play; store songs are opened here (one at a time), so NULL is possible. */
+static const Song *SongAt(uint16_t index)
+{
+    if (index < SONG_COUNT) return &songs[index];
+    index = (uint16_t)(index - SONG_COUNT);
+    if (index < LIBRARY_SONG_COUNT) return &librarySongs[index];
+    index = (uint16_t)(index - LIBRARY_SONG_COUNT);
+    if (index < TextSongs_Count()) return TextSongs_At((uint8_t)index);
+    return StoreSongs_Open((uint16_t)(index - TextSongs_Count()));
+}
+
+/* Title for the list, without opening a store song. */
+static const char *SongTitleAt(uint16_t index)
 {
-    GroveLCD_WriteChar(&lcd, (char)slot);
+    uint16_t first = (uint16_t)(SONG_COUNT + LIBRARY_SONG_COUNT + TextSongs_Count());
+    if (index >= first) return StoreSongs_Title((uint16_t)(index - first));
+    return SongAt(index)->title;
 }
 
+/* Forward declarations for LCD screen rendering functions. */
+static void DisplayWelcomeScreen(void);
+static void DisplayMainMenu(void);
+static void DisplayNotesLegend(void);
+static void DisplaySongsList(void);
+static void DisplayChordPacksList(void);
+static void DisplayLatency(void);
+static void ReturnFromLesson(void);
+
 void App_Init(void)
 {
     /* Initialize the button module (debouncing and edge detection). */
     Button_Init();
 
+    /* Text exercises: read their headers and count their steps. */
+    TextSongs_Init();
+
     /* Enter initial state and render the welcome screen. */
     appState = APP_STATE_WELCOME;
     DisplayWelcomeScreen();
@@ -80,17 +104,34 @@ void App_Update(void)
                     appState = APP_STATE_MENU_SONGS;
                     songListIndex = 0;
                     DisplaySongsList();
-                } else {
+                } else if (mainMenuIndex == 2) {
+                    appState = APP_STATE_MENU_RHYTHM;
+                    songListIndex = 0;
+                    DisplaySongsList();
+                } else if (mainMenuIndex == 3) {
                     appState = APP_STATE_MENU_CHORDPACKS;
                     chordPackIndex = 0;
                     DisplayChordPacksList();
+                } else if (mainMenuIndex == 4) {
+                    appState = APP_STATE_FREE_PLAY;
+                    FreePlay_Start();
+                } else {
+                    appState = APP_STATE_VIEW_LATENCY;
+                    latencyStageIndex = 0;
+                    DisplayLatency();
                 }
                 break;
 
             case APP_STATE_MENU_SONGS:
                 /* Start a song lesson for the currently selected song */
                 appState = APP_STATE_LESSON_SONG;
-                Lesson_StartSong(&songs[songListIndex]);
+                Lesson_StartSong(SongAt(songListIndex));
+                break;
+
+            case APP_STATE_MENU_RHYTHM:
+                /* Start a rhythm lesson (song with timing) */
+                appState = APP_STATE_LESSON_RHYTHM;
+                Lesson_StartRhythm(SongAt(songListIndex));
                 break;
 
             case APP_STATE_MENU_CHORDPACKS:
@@ -103,22 +144,23 @@ void App_Update(void)
                 /* OK does nothing here (RESET goes back) */
                 break;
 
+            case APP_STATE_VIEW_LATENCY:
+                /* Dump all histograms over SWO (Tools/plot_latency.py) */
+                Latency_Dump();
+                break;
+
+            case APP_STATE_FREE_PLAY:
+                /* Keys drive this screen (main.c); RESET goes back */
+                break;
+
             case APP_STATE_LESSON_SONG:
+            case APP_STATE_LESSON_RHYTHM:
             case APP_STATE_LESSON_CHORD:
                 /* Forward button input to the lesson engine */
                 Lesson_HandleInput(LESSON_INPUT_BTN_OK);
 
                 /* If the lesson ended, return to the list from which we started */
-                if (!Lesson_IsActive())
-                {
-                    if (appState == APP_STATE_LESSON_SONG) {
-                        appState = APP_STATE_MENU_SONGS;
-                        DisplaySongsList();
-                    } else {
-                        appState = APP_STATE_MENU_CHORDPACKS;
-                        DisplayChordPacksList();
-                    }
-                }
+                if (!Lesson_IsActive()) ReturnFromLesson();
                 break;
 
             default:
@@ -132,15 +174,16 @@ void App_Update(void)
         switch (appState)
         {
             case APP_STATE_MENU_MAIN:
-                /* Cycle through 3 main-menu items */
-                mainMenuIndex = (mainMenuIndex + 1) % 3;
+                /* Cycle through main-menu items */
+                mainMenuIndex = (mainMenuIndex + 1) % MAIN_MENU_COUNT;
                 DisplayMainMenu();
                 break;
 
             case APP_STATE_MENU_SONGS:
+            case APP_STATE_MENU_RHYTHM:
                 /* Cycle through songs (if any) */
-                if (SONG_COUNT > 0) {
-                    songListIndex = (songListIndex + 1) % SONG_COUNT;
+                if (SongTotal() > 0) {
+                    songListIndex = (uint16_t)((songListIndex + 1) % SongTotal());
                     DisplaySongsList();
                 }
                 break;
@@ -154,25 +197,24 @@ void App_Update(void)
                 break;
 
             case APP_STATE_VIEW_LEGEND:
+            case APP_STATE_FREE_PLAY:
                 /* Single screen -> ignore */
                 break;
 
+            case APP_STATE_VIEW_LATENCY:
+                /* Cycle through measured stages */
+                latencyStageIndex = (latencyStageIndex + 1) % LAT_STAGE_COUNT;
+                DisplayLatency();
+                break;
+
             case APP_STATE_LESSON_SONG:
+            case APP_STATE_LESSON_RHYTHM:
             case APP_STATE_LESSON_CHORD:
                 /* Forward button input to the lesson engine */
                 Lesson_HandleInput(LESSON_INPUT_BTN_NEXT);
 
                 /* If the lesson ended, return to the list */
-                if (!Lesson_IsActive())
-                {
-                    if (appState == APP_STATE_LESSON_SONG) {
-                        appState = APP_STATE_MENU_SONGS;
-                        DisplaySongsList();
-                    } else {
-                        appState = APP_STATE_MENU_CHORDPACKS;
-                        DisplayChordPacksList();
-                    }
-                }
+                if (!Lesson_IsActive()) ReturnFromLesson();
                 break;
 
             default:
@@ -190,29 +232,29 @@ void App_Update(void)
                 break;
 
             case APP_STATE_MENU_SONGS:
+            case APP_STATE_MENU_RHYTHM:
             case APP_STATE_MENU_CHORDPACKS:
             case APP_STATE_VIEW_LEGEND:
+            case APP_STATE_VIEW_LATENCY:
                 /* Back to main menu */
                 appState = APP_STATE_MENU_MAIN;
                 DisplayMainMenu();
                 break;
 
+            case APP_STATE_FREE_PLAY:
+                FreePlay_Stop();
+                appState = APP_STATE_MENU_MAIN;
+                DisplayMainMenu();
+                break;
+
             case APP_STATE_LESSON_SONG:
+            case APP_STATE_LESSON_RHYTHM:
             case APP_STATE_LESSON_CHORD:
                 /* Forward reset/cancel to the lesson engine */
                 Lesson_HandleInput(LESSON_INPUT_BTN_RESET);
 
                 /* If the lesson ended, return to the list */
-                if (!Lesson_IsActive())
-                {
-                    if (appState == APP_STATE_LESSON_SONG) {
-                        appState = APP_STATE_MENU_SONGS;
-                        DisplaySongsList();
-                    } else {
-                        appState = APP_STATE_MENU_CHORDPACKS;
-                        DisplayChordPacksList();
-                    }
-                }
+                if (!Lesson_IsActive()) ReturnFromLesson();
                 break;
 
             default:
@@ -220,102 +262,147 @@ void App_Update(void)
         }
     }
 
-    /* Periodic lesson update (e.g., non-blocking LED timing, timeouts). */
-    Lesson_Update();
+    /* Re-queue LCD cells that did not fit into the queue (no-op when clean);
+       a lesson screen's latency fence follows its last cell. */
+    Lesson_Flush();
+}
+
+/* Lesson ended: back to the list it was started from. */
+static void ReturnFromLesson(void)
+{
+    if (appState == APP_STATE_LESSON_SONG) {
+        appState = APP_STATE_MENU_SONGS;
+        DisplaySongsList();
+    } else if (appState == APP_STATE_LESSON_RHYTHM) {
+        appState = APP_STATE_MENU_RHYTHM;
+        DisplaySongsList();
+    } else {
+        appState = APP_STATE_MENU_CHORDPACKS;
+        DisplayChordPacksList();
+    }
 }
 
 /* --- Screen rendering functions --- */
 
 static void DisplayWelcomeScreen(void)
 {
-    GroveLCD_Clear(&lcd);
-    LCD_ClearRow(0);
-    LCD_ClearRow(1);
-
-    GroveLCD_SetCursor(&lcd, 0, 3);
-    GroveLCD_Print(&lcd, "Welcome to");
-    GroveLCD_SetCursor(&lcd, 1, 4);
-    GroveLCD_Print(&lcd, "KeyGuide");
+    LcdFb_Clear();
+
+    LcdFb_SetCursor(0, 3);
+    LcdFb_Print("Welcome to");
+    LcdFb_SetCursor(1, 4);
+    LcdFb_Print("KeyGuide");
+
+    LcdFb_Flush();
 }
 
 static void DisplayMainMenu(void)
 {
-    GroveLCD_Clear(&lcd);
-    LCD_ClearRow(0);
-    LCD_ClearRow(1);
+    LcdFb_Clear();
 
-    GroveLCD_SetCursor(&lcd, 0, 0);
+    LcdFb_SetCursor(0, 0);
 
     /* Print the currently selected main-menu entry */
-    if (mainMenuIndex == 0) GroveLCD_Print(&lcd, "Icons");
-    else if (mainMenuIndex == 1) GroveLCD_Print(&lcd, "Songs");
-    else GroveLCD_Print(&lcd, "Chords");
+    if (mainMenuIndex == 0) LcdFb_Print("Icons");
+    else if (mainMenuIndex == 1) LcdFb_Print("Songs");
+    else if (mainMenuIndex == 2) LcdFb_Print("Rhythm");
+    else if (mainMenuIndex == 3) LcdFb_Print("Chords");
+    else if (mainMenuIndex == 4) LcdFb_Print("Free play");
+    else LcdFb_Print("Latency");
 
     /* Optional header label on the right side */
-    GroveLCD_SetCursor(&lcd, 0, 12);
-    GroveLCD_Print(&lcd, "MENU");
+    LcdFb_SetCursor(0, 12);
+    LcdFb_Print("MENU");
 
     /* Hint line (must fit in 16 columns) */
-    GroveLCD_SetCursor(&lcd, 1, 0);
-    GroveLCD_Print(&lcd, "NEXT=Down OK=Sel");
+    LcdFb_SetCursor(1, 0);
+    LcdFb_Print("NEXT=Down OK=Sel");
+
+    LcdFb_Flush();
 }
 
 static void DisplayNotesLegend(void)
 {
-    GroveLCD_Clear(&lcd);
-    LCD_ClearRow(0);
-    LCD_ClearRow(1);
-
-    /* Example: show sharp + flat and some duration icons */
-    GroveLCD_SetCursor(&lcd, 0, 0);
-    GroveLCD_Print(&lcd, "A");
-    LCD_WriteCustom(5);          /* sharp */
-    GroveLCD_Print(&lcd, "  B");
-    LCD_WriteCustom(6);          /* flat */
-
-    GroveLCD_SetCursor(&lcd, 1, 0);
-    /* Show duration icons 0..4 */
-    LCD_WriteCustom(0);
-    LCD_WriteCustom(1);
-    LCD_WriteCustom(2);
-    LCD_WriteCustom(3);
-    LCD_WriteCustom(4);
-    GroveLCD_Print(&lcd, " RESET=Back");
+    LcdFb_Clear();
+
+    /* Example: show sharp, flat and natural (glyphs are mapped to CGRAM on flush) */
+    LcdFb_SetCursor(0, 0);
+    LcdFb_Print("A");
+    LcdFb_WriteGlyph(GLYPH_SHARP);
+    LcdFb_Print("  B");
+    LcdFb_WriteGlyph(GLYPH_FLAT);
+    LcdFb_Print("  C");
+    LcdFb_WriteGlyph(GLYPH_NATURAL);
+
+    LcdFb_SetCursor(1, 0);
+    /* Show duration icons (5 more glyphs: 8 in total, all CGRAM slots) */
+    LcdFb_WriteGlyph(GLYPH_WHOLE);
+    LcdFb_WriteGlyph(GLYPH_HALF);
+    LcdFb_WriteGlyph(GLYPH_QUARTER);
+    LcdFb_WriteGlyph(GLYPH_EIGHTH);
+    LcdFb_WriteGlyph(GLYPH_SIXTEENTH);
+    LcdFb_Print(" RESET=Back");
+
+    LcdFb_Flush();
 }
 
 static void DisplaySongsList(void)
 {
-    GroveLCD_Clear(&lcd);
-    LCD_ClearRow(0);
-    LCD_ClearRow(1);
+    LcdFb_Clear();
 
-    GroveLCD_SetCursor(&lcd, 0, 0);
-    GroveLCD_Print(&lcd, "Songs");
+    LcdFb_SetCursor(0, 0);
+    LcdFb_Print((appState == APP_STATE_MENU_RHYTHM) ? "Rhythm: songs" : "Songs");
 
-    GroveLCD_SetCursor(&lcd, 1, 0);
-    if (SONG_COUNT > 0) {
-        GroveLCD_Print(&lcd, "> ");
+    LcdFb_SetCursor(1, 0);
+    if (SongTotal() > 0) {
+        LcdFb_Print("> ");
         /* No explicit truncation; LCD will stop at 16 characters. */
-        GroveLCD_Print(&lcd, songs[songListIndex].title);
+        LcdFb_Print(SongTitleAt(songListIndex));
     } else {
-        GroveLCD_Print(&lcd, "<no songs>");
+        LcdFb_Print("<no songs>");
     }
+
+    LcdFb_Flush();
 }
 
 static void DisplayChordPacksList(void)
 {
-    GroveLCD_Clear(&lcd);
-    LCD_ClearRow(0);
-    LCD_ClearRow(1);
+    LcdFb_Clear();
 
-    GroveLCD_SetCursor(&lcd, 0, 0);
-    GroveLCD_Print(&lcd, "Chord packs");
+    LcdFb_SetCursor(0, 0);
+    LcdFb_Print("Chord packs");
 
-    GroveLCD_SetCursor(&lcd, 1, 0);
+    LcdFb_SetCursor(1, 0);
     if (CHORD_PACK_COUNT > 0) {
-        GroveLCD_Print(&lcd, "> ");
-        GroveLCD_Print(&lcd, chordPacks[chordPackIndex].packName);
+        LcdFb_Print("> ");
+        LcdFb_Print(chordPacks[chordPackIndex].packName);
     } else {
-        GroveLCD_Print(&lcd, "<no packs>");
+        LcdFb_Print("<no packs>");
     }
+
+    LcdFb_Flush();
+}
+
+static void DisplayLatency(void)
+{
+    LcdFb_Clear();
+
+    LatencyStage stage = (LatencyStage)latencyStageIndex;
+    const LatencyHistogram_t *h = Latency_GetHistogram(stage);
+
+    char line1[17];
+    char line2[17];
+
+    /* Row 0: stage name + sample count; Row 1: median / 99th percentile */
+    snprintf(line1, sizeof(line1), "%-4s n=%lu", Latency_StageName(stage), (unsigned long)h->count);
+    snprintf(line2, sizeof(line2), "%lu/%luus p50/99",
+             (unsigned long)Latency_PercentileUs(stage, 50),
+             (unsigned long)Latency_PercentileUs(stage, 99));
+
+    LcdFb_SetCursor(0, 0);
+    LcdFb_Print(line1);
+    LcdFb_SetCursor(1, 0);
+    LcdFb_Print(line2);
+
+    LcdFb_Flush();
 }
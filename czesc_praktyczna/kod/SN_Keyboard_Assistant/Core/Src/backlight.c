@@ -0,0 +1,63 @@
+#include "backlight.h"
+#include "lcd_queue.h"
+#include "timer_wheel.h"
+#include <stdbool.h>
+
+/**
+ * @file backlight.c
+ * @brief Backlight feedback colors (see backlight.h).
+ */
+
+static BacklightColor baseColor = { 255, 255, 255 };
+static bool flashing = false;
+static SoftTimer_t flashTimer;
+
+static void Show(BacklightColor c)
+{
+    /* HAL_ERROR = no RGB backlight: nothing to do. */
+    (void)LcdQueue_SetBacklight(c.r, c.g, c.b);
+}
+
+/* Timer callback: flash finished, back to the steady color. */
+static void FlashDone(void *arg)
+{
+    (void)arg;
+    flashing = false;
+    Show(baseColor);
+}
+
+void Backlight_Init(void)
+{
+    TimerWheel_Cancel(&flashTimer);
+    flashing = false;
+    baseColor = BACKLIGHT_WHITE;
+    Show(baseColor);
+}
+
+void Backlight_SetBase(BacklightColor color)
+{
+    baseColor = color;
+    if (!flashing) Show(baseColor);
+}
+
+void Backlight_Flash(BacklightColor color, uint32_t duration_ms)
+{
+    flashing = true;
+    Show(color);
+    TimerWheel_Start(&flashTimer, duration_ms, 0, FlashDone, NULL);
+}
+
+BacklightColor Backlight_Accuracy(uint32_t percent)
+{
+    BacklightColor c = { 0, 0, 0 };
+    if (percent > 100U) percent = 100U;
+
+    if (percent < 50U) {
+        c.r = 255;
+        c.g = (uint8_t)((percent * 255U) / 50U);
+    } else {
+        c.r = (uint8_t)(((100U - percent) * 255U) / 50U);
+        c.g = 255;
+    }
+    return c;
+}
@@ -1,6 +1,7 @@
 #include "button.h"
 #include "stm32l4xx_hal.h"
 #include "main.h"
+#include "timer_wheel.h"
 
 /**
  * @file button.c
@@ -11,13 +12,21 @@
  * - The code treats LOW as "pressed".
  *
  * Timing:
- * - Debouncing is implemented using a simple time threshold (DEBOUNCE_MS).
+ * - Pins are sampled every BUTTON_SAMPLE_MS by a periodic timer-wheel timer.
+ * - A new level is accepted after it was read DEBOUNCE_MS / BUTTON_SAMPLE_MS
+ *   times in a row.
  * - A press event is generated only on a stable transition: released -> pressed.
  */
 
 
 /* Debounce time threshold (milliseconds) */
-#define DEBOUNCE_MS  30U
+#define DEBOUNCE_MS        30U
+
+/* Sampling period of the debounce timer (milliseconds) */
+#define BUTTON_SAMPLE_MS   5U
+
+/* Number of identical consecutive samples needed to accept a new level */
+#define DEBOUNCE_SAMPLES   (DEBOUNCE_MS / BUTTON_SAMPLE_MS)
 
 /**
  * @brief Internal per-button state for debouncing and event latching.
@@ -26,20 +35,25 @@
  *   - 1 = released, 0 = pressed (active-low, pull-up)
  * last_raw_level:
  *   - last sampled raw level (used to detect changes)
- * last_change_ms:
- *   - timestamp of the last raw-level change (HAL_GetTick())
+ * stable_samples:
+ *   - number of consecutive samples equal to last_raw_level
  * pressed_event:
  *   - latched one-shot flag set when a new press is detected
  */
 typedef struct {
     uint8_t stable_level;
     uint8_t last_raw_level;
-    uint32_t last_change_ms;
+    uint8_t stable_samples;
     uint8_t pressed_event;
 } BtnState_t;
 
 static BtnState_t g_btn[BUTTON_COUNT];
 
+/* Periodic sampling timer */
+static SoftTimer_t g_sampleTimer;
+
+static void Button_Sample(void *arg);
+
 /**
  * @brief Read raw GPIO level and normalize to logical level.
  *
@@ -86,33 +100,40 @@ void Button_Init(void)
     HAL_GPIO_Init(BTN_RESET_PORT, &GPIO_InitStruct);
 
     /* Initialize software state from the current raw levels. */
-    uint32_t now = HAL_GetTick();
     for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
         uint8_t raw = read_raw((ButtonType)i);
         g_btn[i].stable_level   = raw;
         g_btn[i].last_raw_level = raw;
-        g_btn[i].last_change_ms = now;
+        g_btn[i].stable_samples = DEBOUNCE_SAMPLES;
         g_btn[i].pressed_event  = 0;
     }
+
+    TimerWheel_Start(&g_sampleTimer, BUTTON_SAMPLE_MS, BUTTON_SAMPLE_MS, Button_Sample, NULL);
 }
 
-void Button_Update(void)
+/**
+ * @brief Timer callback: sample all buttons and run debouncing.
+ */
+static void Button_Sample(void *arg)
 {
-    uint32_t now = HAL_GetTick();
+    (void)arg;
 
     for (uint8_t i = 0; i < BUTTON_COUNT; i++)
     {
         ButtonType b = (ButtonType)i;
         uint8_t raw = read_raw(b);
 
-        /* Track raw-level changes and reset debounce timer on any transition. */
+        /* Track raw-level changes and restart the stable-sample count on any transition. */
         if (raw != g_btn[i].last_raw_level) {
             g_btn[i].last_raw_level = raw;
-            g_btn[i].last_change_ms = now;
+            g_btn[i].stable_samples = 0;
+        }
+        if (g_btn[i].stable_samples < DEBOUNCE_SAMPLES) {
+            g_btn[i].stable_samples++;
         }
 
         /* If the raw level has been stable long enough, accept it as stable. */
-        if ((now - g_btn[i].last_change_ms) >= DEBOUNCE_MS)
+        if (g_btn[i].stable_samples >= DEBOUNCE_SAMPLES)
         {
             if (raw != g_btn[i].stable_level)
             {
@@ -0,0 +1,198 @@
+#include "chord_id.h"
+#include "note_mask.h"
+
+/*
+ * chord_id.c
+ *
+ * Chord definitions, the search that the generated table is built from, and
+ * the table lookup used in free play (see chord_id.h).
+ */
+
+/* FNV-1a, 32-bit */
+#define FNV_OFFSET   (2166136261UL)
+#define FNV_PRIME    (16777619UL)
+
+/* Interval bits relative to the root */
+#define I(semitones)  (1U << (semitones))
+
+/* One chord quality: tones that must be held, and tones that may be left out. */
+typedef struct {
+    ChordQuality quality;
+    const char *name;
+    uint16_t required;
+    uint16_t optional;
+} ChordDef;
+
+/*
+ * Order = priority for ambiguous key sets (see ChordQuality). The fifth is
+ * optional in the common seventh and ninth chords, as pianists often drop
+ * it there; elsewhere a missing fifth would name too many clusters.
+ */
+static const ChordDef chordDefs[] = {
+    { CHORD_Q_MAJOR,    "",      I(0) | I(4) | I(7),                0    },
+    { CHORD_Q_MINOR,    "m",     I(0) | I(3) | I(7),                0    },
+    { CHORD_Q_DOM7,     "7",     I(0) | I(4) | I(10),               I(7) },
+    { CHORD_Q_MAJ7,     "maj7",  I(0) | I(4) | I(11),               I(7) },
+    { CHORD_Q_MIN7,     "m7",    I(0) | I(3) | I(10),               I(7) },
+    { CHORD_Q_SUS4,     "sus4",  I(0) | I(5) | I(7),                0    },
+    { CHORD_Q_SUS2,     "sus2",  I(0) | I(2) | I(7),                0    },
+    { CHORD_Q_DIM,      "dim",   I(0) | I(3) | I(6),                0    },
+    { CHORD_Q_AUG,      "aug",   I(0) | I(4) | I(8),                0    },
+    { CHORD_Q_HALFDIM7, "m7b5",  I(0) | I(3) | I(6) | I(10),        0    },
+    { CHORD_Q_DIM7,     "dim7",  I(0) | I(3) | I(6) | I(9),         0    },
+    { CHORD_Q_SIX,      "6",     I(0) | I(4) | I(7) | I(9),         0    },
+    { CHORD_Q_MIN6,     "m6",    I(0) | I(3) | I(7) | I(9),         0    },
+    { CHORD_Q_MINMAJ7,  "mM7",   I(0) | I(3) | I(7) | I(11),        0    },
+    { CHORD_Q_DOM7SUS4, "7sus4", I(0) | I(5) | I(7) | I(10),        0    },
+    { CHORD_Q_AUG7,     "7#5",   I(0) | I(4) | I(8) | I(10),        0    },
+    { CHORD_Q_DOM9,     "9",     I(0) | I(2) | I(4) | I(10),        I(7) },
+    { CHORD_Q_MAJ9,     "maj9",  I(0) | I(2) | I(4) | I(11),        I(7) },
+    { CHORD_Q_MIN9,     "m9",    I(0) | I(2) | I(3) | I(10),        I(7) },
+    { CHORD_Q_ADD9,     "add9",  I(0) | I(2) | I(4) | I(7),         0    },
+    { CHORD_Q_MINADD9,  "madd9", I(0) | I(2) | I(3) | I(7),         0    },
+    { CHORD_Q_POWER,    "5",     I(0) | I(7),                       0    },
+};
+
+#define CHORD_DEF_COUNT  (sizeof(chordDefs) / sizeof(chordDefs[0]))
+
+/* Spelling used by the chord packs (chords.c). */
+static const char *const pitchNames[12] = {
+    "C", "C#", "D", "Eb", "E", "F", "F#", "G", "Ab", "A", "Bb", "B"
+};
+
+/* Bass spelling under a sharp root (C#m/G#, not C#m/Ab). */
+static const char *const sharpNames[12] = {
+    "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
+};
+
+/* 12-bit rotate: bit (i + n) % 12 of m becomes bit i. */
+static uint16_t RotateDown(uint16_t m, uint8_t n)
+{
+    n %= 12U;
+    if (n == 0U) return (uint16_t)(m & PC_MASK_ALL);
+    return (uint16_t)(((m >> n) | (m << (12U - n))) & PC_MASK_ALL);
+}
+
+/* Role of the bass, 'interval' semitones above the root. */
+static ChordInversion InversionOf(uint8_t interval)
+{
+    if (interval == 0U) return CHORD_INV_ROOT;
+    if (interval == 3U || interval == 4U) return CHORD_INV_FIRST;
+    if (interval >= 6U && interval <= 8U) return CHORD_INV_SECOND;
+    if (interval >= 9U) return CHORD_INV_THIRD;
+    return CHORD_INV_OTHER;
+}
+
+ChordTableEntry_t ChordId_Search(uint16_t rel_mask)
+{
+    rel_mask &= PC_MASK_ALL;
+    bool bassInChord = (rel_mask & 1U) != 0U;
+
+    ChordTableEntry_t best = 0;
+    uint32_t bestScore = UINT32_MAX;
+
+    /* r = root in semitones above the bass */
+    for (uint8_t r = 0; r < 12U; r++)
+    {
+        if ((rel_mask & (1U << r)) == 0U) continue;   /* the root is always held */
+
+        uint16_t tones = RotateDown(rel_mask, r);
+
+        for (uint8_t d = 0; d < CHORD_DEF_COUNT; d++)
+        {
+            const ChordDef *def = &chordDefs[d];
+            if ((tones & def->required) != def->required) continue;
+            if ((tones & (uint16_t)~(def->required | def->optional)) != 0U) continue;
+
+            /* Root position first, then definition order. */
+            uint32_t score = ((bassInChord && r != 0U) ? 256U : 0U) + (uint32_t)d * 12U + r;
+            if (score < bestScore)
+            {
+                ChordInversion inv = bassInChord ? InversionOf((uint8_t)((12U - r) % 12U)) : CHORD_INV_SLASH;
+                best = CHORD_ENTRY(r, def->quality, inv);
+                bestScore = score;
+            }
+        }
+    }
+    return best;
+}
+
+static uint32_t HashByte(uint32_t h, uint8_t b)
+{
+    return (h ^ b) * FNV_PRIME;
+}
+
+uint32_t ChordId_DefinitionHash(void)
+{
+    uint32_t h = HashByte(FNV_OFFSET, CHORD_ID_VERSION);
+
+    for (uint8_t d = 0; d < CHORD_DEF_COUNT; d++)
+    {
+        h = HashByte(h, (uint8_t)chordDefs[d].quality);
+        h = HashByte(h, (uint8_t)(chordDefs[d].required & 0xFFU));
+        h = HashByte(h, (uint8_t)(chordDefs[d].required >> 8));
+        h = HashByte(h, (uint8_t)(chordDefs[d].optional & 0xFFU));
+        h = HashByte(h, (uint8_t)(chordDefs[d].optional >> 8));
+    }
+    return h;
+}
+
+/* Table entry for a bass-relative mask: flash table if current, else search. */
+static ChordTableEntry_t Entry(uint16_t rel_mask)
+{
+    static int8_t tableValid = -1;   /* -1 = not checked yet */
+
+    if (tableValid < 0) tableValid = (CHORD_TABLE_HASH == ChordId_DefinitionHash()) ? 1 : 0;
+    return tableValid ? chordTable[rel_mask] : ChordId_Search(rel_mask);
+}
+
+ChordId ChordId_Lookup(uint16_t pcs, uint8_t bass_pc)
+{
+    ChordId id = { CHORD_Q_NONE, 0, (uint8_t)(bass_pc % 12U), CHORD_INV_ROOT };
+
+    pcs &= PC_MASK_ALL;
+    if ((pcs & PcMask_OfNote(id.bass)) == 0U || PcMask_Count(pcs) < 2U) return id;
+
+    uint16_t rel = RotateDown(pcs, id.bass);
+    ChordTableEntry_t e = Entry(rel);
+    if (CHORD_ENTRY_QUALITY(e) == CHORD_Q_NONE) e = Entry((uint16_t)(rel & ~1U));
+
+    id.quality = CHORD_ENTRY_QUALITY(e);
+    id.root = (uint8_t)((id.bass + CHORD_ENTRY_ROOT(e)) % 12U);
+    id.inversion = CHORD_ENTRY_INVERSION(e);
+    return id;
+}
+
+const char *ChordId_QualityName(ChordQuality quality)
+{
+    for (uint8_t d = 0; d < CHORD_DEF_COUNT; d++) {
+        if (chordDefs[d].quality == quality) return chordDefs[d].name;
+    }
+    return "?";
+}
+
+const char *ChordId_PitchName(uint8_t pc)
+{
+    return pitchNames[pc % 12U];
+}
+
+size_t ChordId_Format(const ChordId *id, char *out, size_t size)
+{
+    size_t n = 0;
+
+    if (size == 0U) return 0;
+    out[0] = '\0';
+    if (id->quality == CHORD_Q_NONE) return 0;
+
+    const char *parts[4] = { ChordId_PitchName(id->root), ChordId_QualityName(id->quality), NULL, NULL };
+    if (id->inversion != CHORD_INV_ROOT) {
+        parts[2] = "/";
+        parts[3] = (parts[0][1] == '#') ? sharpNames[id->bass % 12U] : ChordId_PitchName(id->bass);
+    }
+
+    for (uint8_t p = 0; p < 4U && parts[p] != NULL; p++) {
+        for (const char *s = parts[p]; *s != '\0' && n + 1U < size; s++) out[n++] = *s;
+    }
+    out[n] = '\0';
+    return n;
+}
@@ -0,0 +1,529 @@
+#include "chord_id.h"
+
+/*
+ * chord_table.c
+ *
+ * GENERATED by Tools/gen_chord_table.c - do not edit.
+ *
+ * Chord per bass-relative pitch-class mask (see chord_id.h).
+ * Comments: mask of the first entry, and the chord each entry names
+ * over a C bass.
+ * Version 1.
+ */
+
+const uint32_t CHORD_TABLE_HASH = 0xCB9A7201UL;
+
+const ChordTableEntry_t chordTable[CHORD_TABLE_SIZE] = {
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 000 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 008 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 010 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 018 */
+    0x0000, 0x0565, 0x0000, 0x0641, 0x0000, 0x0652, 0x0000, 0x0000,   /* 020 F5/C C#maj7/C Dm7/C */
+    0x0000, 0x0000, 0x0000, 0x0721, 0x0000, 0x0000, 0x0000, 0x0000,   /* 028 C#maj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0732, 0x0000, 0x0000,   /* 030 Dm9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 038 */
+    0x0000, 0x0000, 0x0B66, 0x0000, 0x0000, 0x0632, 0x0A42, 0x0000,   /* 040 F#5/C D7/C Dmaj7/C */
+    0x0000, 0x0080, 0x0A53, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 048 Cdim Ebm7/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0712, 0x0B22, 0x0000,   /* 050 D9/C Dmaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 058 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 060 */
+    0x0000, 0x0000, 0x0B33, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 068 Ebm9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 070 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 078 */
+    0x0000, 0x0160, 0x0000, 0x0000, 0x0B67, 0x0070, 0x0000, 0x0000,   /* 080 C5 G5/C Csus2 */
+    0x0000, 0x0020, 0x0A33, 0x0000, 0x0A43, 0x0150, 0x0000, 0x0000,   /* 088 Cm Eb7/C Ebmaj7/C Cmadd9 */
+    0x0000, 0x0010, 0x0A81, 0x0000, 0x0A54, 0x0140, 0x0000, 0x0000,   /* 090 C C#dim/C Em7/C Cadd9 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 098 */
+    0x0000, 0x0060, 0x0000, 0x0000, 0x0000, 0x08F7, 0x0000, 0x0000,   /* 0A0 Csus4 G7sus4/C */
+    0x0000, 0x0000, 0x0B13, 0x0000, 0x0B23, 0x0000, 0x0000, 0x0000,   /* 0A8 Eb9/C Ebmaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 0B0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 0B8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 0C0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 0C8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0B34, 0x0000, 0x0000, 0x0000,   /* 0D0 Em9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 0D8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 0E0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 0E8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 0F0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 0F8 */
+    0x0000, 0x0000, 0x0B61, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 100 C#5/C */
+    0x0B68, 0x0218, 0x0A68, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 108 Ab5/C Ab/C Absus4/C */
+    0x0000, 0x0090, 0x0A21, 0x06E1, 0x0A34, 0x0504, 0x0000, 0x0000,   /* 110 Caug C#m/C C#mM7/C E7/C E7#5/C */
+    0x0A44, 0x0000, 0x0B51, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 118 Emaj7/C C#madd9/C */
+    0x0000, 0x0425, 0x0A11, 0x0641, 0x0A82, 0x06A2, 0x0000, 0x0000,   /* 120 Fm/C C#/C C#maj7/C Ddim/C Dm7b5/C */
+    0x0A55, 0x0455, 0x0B41, 0x0721, 0x0000, 0x0000, 0x0000, 0x0000,   /* 128 Fm7/C Fm7/C C#add9/C C#maj9/C */
+    0x0000, 0x04E5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 130 FmM7/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 138 */
+    0x0000, 0x0238, 0x0A61, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 140 Ab7/C C#sus4/C */
+    0x0000, 0x0238, 0x0AF8, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 148 Ab7/C Ab7sus4/C */
+    0x0000, 0x0308, 0x0000, 0x0000, 0x0B14, 0x0000, 0x0000, 0x0000,   /* 150 Ab7#5/C E9/C */
+    0x0B24, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 158 Emaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 160 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 168 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 170 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 178 */
+    0x0000, 0x0248, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 180 Abmaj7/C */
+    0x0000, 0x0248, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 188 Abmaj7/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 190 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 198 */
+    0x0000, 0x0555, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 1A0 Fmadd9/C */
+    0x0B35, 0x0535, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 1A8 Fm9/C Fm9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 1B0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 1B8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 1C0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 1C8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 1D0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 1D8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 1E0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 1E8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 1F0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 1F8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0B62, 0x0000, 0x0000, 0x0000,   /* 200 D5/C */
+    0x0000, 0x0289, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 208 Adim/C */
+    0x0B69, 0x0229, 0x0A19, 0x0000, 0x0A69, 0x0000, 0x0000, 0x0000,   /* 210 A5/C Am/C A/C Asus4/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 218 */
+    0x0000, 0x0415, 0x0A91, 0x0000, 0x0A22, 0x0652, 0x0AE2, 0x0000,   /* 220 F/C C#aug/C Dm/C Dm7/C DmM7/C */
+    0x0A35, 0x0435, 0x0B05, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 228 F7/C F7/C F7#5/C */
+    0x0A45, 0x0445, 0x0000, 0x0000, 0x0B52, 0x0732, 0x0000, 0x0000,   /* 230 Fmaj7/C Fmaj7/C Dmadd9/C Dm9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 238 */
+    0x0000, 0x0486, 0x0A26, 0x0000, 0x0A12, 0x0632, 0x0A42, 0x0000,   /* 240 F#dim/C F#m/C D/C D7/C Dmaj7/C */
+    0x0A83, 0x00B0, 0x0AA3, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 248 Ebdim/C Cdim7 Ebm7b5/C */
+    0x0A56, 0x04A6, 0x0A56, 0x0000, 0x0B42, 0x0712, 0x0B22, 0x0000,   /* 250 F#m7/C F#m7b5/C F#m7/C Dadd9/C D9/C Dmaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 258 */
+    0x0000, 0x0000, 0x0AE6, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 260 F#mM7/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 268 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 270 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 278 */
+    0x0000, 0x0259, 0x0A39, 0x0000, 0x0A62, 0x06F2, 0x0000, 0x0000,   /* 280 Am7/C A7/C Dsus4/C D7sus4/C */
+    0x0000, 0x00D0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 288 Cm6 */
+    0x0000, 0x00C0, 0x0A39, 0x0000, 0x0AF9, 0x0000, 0x0000, 0x0000,   /* 290 C6 A7/C A7sus4/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 298 */
+    0x0000, 0x0545, 0x0B09, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 2A0 Fadd9/C A7#5/C */
+    0x0B15, 0x0515, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 2A8 F9/C F9/C */
+    0x0B25, 0x0525, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 2B0 Fmaj9/C Fmaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 2B8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 2C0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 2C8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 2D0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 2D8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 2E0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 2E8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 2F0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 2F8 */
+    0x0000, 0x0000, 0x0A49, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 300 Amaj7/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 308 */
+    0x0000, 0x02E9, 0x0A49, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 310 AmM7/C Amaj7/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 318 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 320 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 328 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 330 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 338 */
+    0x0000, 0x0000, 0x0B56, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 340 F#madd9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 348 */
+    0x0B36, 0x0000, 0x0B36, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 350 F#m9/C F#m9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 358 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 360 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 368 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 370 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 378 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 380 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 388 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 390 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 398 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 3A0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 3A8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 3B0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 3B8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 3C0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 3C8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 3D0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 3D8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 3E0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 3E8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 3F0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 3F8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 400 */
+    0x0B63, 0x0050, 0x0000, 0x0000, 0x0000, 0x0130, 0x0000, 0x0000,   /* 408 Eb5/C Cm7 Cm9 */
+    0x0000, 0x0030, 0x0A8A, 0x0000, 0x0000, 0x0110, 0x0000, 0x0000,   /* 410 C7 Bbdim/C C9 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 418 */
+    0x0B6A, 0x0465, 0x0A2A, 0x095A, 0x0A1A, 0x094A, 0x0000, 0x0000,   /* 420 Bb5/C Fsus4/C Bbm/C Bbmadd9/C Bb/C Bbadd9/C */
+    0x0A6A, 0x04F5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 428 Bbsus4/C F7sus4/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 430 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 438 */
+    0x0000, 0x0000, 0x0A16, 0x0000, 0x0A92, 0x0702, 0x0000, 0x0000,   /* 440 F#/C Daug/C D7#5/C */
+    0x0A23, 0x00A0, 0x0A53, 0x0000, 0x0AE3, 0x0000, 0x0000, 0x0000,   /* 448 Ebm/C Cm7b5 Ebm7/C EbmM7/C */
+    0x0A36, 0x0000, 0x0A36, 0x0000, 0x0B06, 0x0000, 0x0000, 0x0000,   /* 450 F#7/C F#7/C F#7#5/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 458 */
+    0x0A46, 0x0000, 0x0A46, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 460 F#maj7/C F#maj7/C */
+    0x0B53, 0x0000, 0x0B33, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 468 Ebmadd9/C Ebm9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 470 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 478 */
+    0x0000, 0x0000, 0x0A87, 0x0000, 0x0A27, 0x0000, 0x0000, 0x0000,   /* 480 Gdim/C Gm/C */
+    0x0A13, 0x0050, 0x0A33, 0x0000, 0x0A43, 0x0130, 0x0000, 0x0000,   /* 488 Eb/C Cm7 Eb7/C Ebmaj7/C Cm9 */
+    0x0A84, 0x0030, 0x0AB1, 0x0000, 0x0AA4, 0x0110, 0x0000, 0x0000,   /* 490 Edim/C C7 C#dim7/C Em7b5/C C9 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 498 */
+    0x0A57, 0x00F0, 0x0AA7, 0x0000, 0x0A57, 0x0000, 0x0000, 0x0000,   /* 4A0 Gm7/C C7sus4 Gm7b5/C Gm7/C */
+    0x0B43, 0x0000, 0x0B13, 0x0000, 0x0B23, 0x0000, 0x0000, 0x0000,   /* 4A8 Ebadd9/C Eb9/C Ebmaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 4B0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 4B8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0AE7, 0x0000, 0x0000, 0x0000,   /* 4C0 GmM7/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 4C8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 4D0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 4D8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 4E0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 4E8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 4F0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 4F8 */
+    0x0000, 0x0000, 0x0A5A, 0x093A, 0x0A3A, 0x091A, 0x0000, 0x0000,   /* 500 Bbm7/C Bbm9/C Bb7/C Bb9/C */
+    0x0A63, 0x0348, 0x0AF3, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 508 Ebsus4/C Abadd9/C Eb7sus4/C */
+    0x0000, 0x0100, 0x0AAA, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 510 C7#5 Bbm7b5/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 518 */
+    0x0000, 0x0000, 0x0A5A, 0x093A, 0x0A3A, 0x091A, 0x0000, 0x0000,   /* 520 Bbm7/C Bbm9/C Bb7/C Bb9/C */
+    0x0AFA, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 528 Bb7sus4/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 530 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 538 */
+    0x0000, 0x0318, 0x0B46, 0x0000, 0x0B0A, 0x0000, 0x0000, 0x0000,   /* 540 Ab9/C F#add9/C Bb7#5/C */
+    0x0000, 0x0318, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 548 Ab9/C */
+    0x0B16, 0x0000, 0x0B16, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 550 F#9/C F#9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 558 */
+    0x0B26, 0x0000, 0x0B26, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 560 F#maj9/C F#maj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 568 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 570 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 578 */
+    0x0000, 0x0328, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 580 Abmaj9/C */
+    0x0000, 0x0328, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 588 Abmaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 590 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 598 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 5A0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 5A8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 5B0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 5B8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 5C0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 5C8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 5D0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 5D8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 5E0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 5E8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 5F0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 5F8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0A4A, 0x092A, 0x0000, 0x0000,   /* 600 Bbmaj7/C Bbmaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 608 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 610 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 618 */
+    0x0000, 0x0000, 0x0AEA, 0x0000, 0x0A4A, 0x092A, 0x0000, 0x0000,   /* 620 BbmM7/C Bbmaj7/C Bbmaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 628 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 630 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 638 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 640 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 648 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 650 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 658 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 660 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 668 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 670 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 678 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0B57, 0x0000, 0x0000, 0x0000,   /* 680 Gmadd9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 688 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 690 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 698 */
+    0x0B37, 0x0000, 0x0000, 0x0000, 0x0B37, 0x0000, 0x0000, 0x0000,   /* 6A0 Gm9/C Gm9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 6A8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 6B0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 6B8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 6C0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 6C8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 6D0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 6D8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 6E0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 6E8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 6F0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 6F8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 700 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 708 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 710 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 718 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 720 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 728 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 730 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 738 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 740 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 748 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 750 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 758 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 760 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 768 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 770 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 778 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 780 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 788 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 790 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 798 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 7A0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 7A8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 7B0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 7B8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 7C0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 7C8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 7D0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 7D8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 7E0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 7E8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 7F0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 7F8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 800 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 808 */
+    0x0B64, 0x0040, 0x0A51, 0x0000, 0x0000, 0x0120, 0x0000, 0x0000,   /* 810 E5/C Cmaj7 C#m7/C Cmaj9 */
+    0x0000, 0x0000, 0x0B31, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 818 C#m9/C */
+    0x0000, 0x0000, 0x0A31, 0x0000, 0x0A8B, 0x0000, 0x0000, 0x0000,   /* 820 C#7/C Bdim/C */
+    0x0000, 0x0000, 0x0B11, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 828 C#9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 830 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 838 */
+    0x0B6B, 0x0000, 0x0A66, 0x0000, 0x0A2B, 0x0000, 0x0B5B, 0x0000,   /* 840 B5/C F#sus4/C Bm/C Bmadd9/C */
+    0x0A1B, 0x0000, 0x0B4B, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 848 B/C Badd9/C */
+    0x0A6B, 0x0000, 0x0AF6, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 850 Bsus4/C F#7sus4/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 858 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 860 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 868 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 870 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 878 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0A17, 0x0000, 0x0000, 0x0000,   /* 880 G/C */
+    0x0A93, 0x00E0, 0x0B03, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 888 Ebaug/C CmM7 Eb7#5/C */
+    0x0A24, 0x0040, 0x0AA1, 0x0000, 0x0A54, 0x0120, 0x0000, 0x0000,   /* 890 Em/C Cmaj7 C#m7b5/C Em7/C Cmaj9 */
+    0x0AE4, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 898 EmM7/C */
+    0x0A37, 0x0000, 0x0000, 0x0000, 0x0A37, 0x0000, 0x0000, 0x0000,   /* 8A0 G7/C G7/C */
+    0x0B07, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 8A8 G7#5/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 8B0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 8B8 */
+    0x0A47, 0x0000, 0x0000, 0x0000, 0x0A47, 0x0000, 0x0000, 0x0000,   /* 8C0 Gmaj7/C Gmaj7/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 8C8 */
+    0x0B54, 0x0000, 0x0000, 0x0000, 0x0B34, 0x0000, 0x0000, 0x0000,   /* 8D0 Emadd9/C Em9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 8D8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 8E0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 8E8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 8F0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 8F8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0A88, 0x0000, 0x0000, 0x0000,   /* 900 Abdim/C */
+    0x0A28, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 908 Abm/C */
+    0x0A14, 0x0000, 0x0A51, 0x0000, 0x0A34, 0x0000, 0x0000, 0x0000,   /* 910 E/C C#m7/C E7/C */
+    0x0A44, 0x0000, 0x0B31, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 918 Emaj7/C C#m9/C */
+    0x0A85, 0x0000, 0x0A31, 0x0000, 0x0AB2, 0x0000, 0x0000, 0x0000,   /* 920 Fdim/C C#7/C Ddim7/C */
+    0x0AA5, 0x0000, 0x0B11, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 928 Fm7b5/C C#9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 930 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 938 */
+    0x0A58, 0x0000, 0x0AF1, 0x0000, 0x0AA8, 0x0000, 0x0000, 0x0000,   /* 940 Abm7/C C#7sus4/C Abm7b5/C */
+    0x0A58, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 948 Abm7/C */
+    0x0B44, 0x0000, 0x0000, 0x0000, 0x0B14, 0x0000, 0x0000, 0x0000,   /* 950 Eadd9/C E9/C */
+    0x0B24, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 958 Emaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 960 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 968 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 970 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 978 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 980 */
+    0x0AE8, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 988 AbmM7/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 990 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 998 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 9A0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 9A8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 9B0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 9B8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 9C0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 9C8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 9D0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 9D8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 9E0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 9E8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 9F0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* 9F8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0A5B, 0x0000, 0x0B3B, 0x0000,   /* A00 Bm7/C Bm9/C */
+    0x0A3B, 0x0000, 0x0B1B, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A08 B7/C B9/C */
+    0x0A64, 0x0359, 0x0B49, 0x0000, 0x0AF4, 0x0000, 0x0000, 0x0000,   /* A10 Esus4/C Amadd9/C Aadd9/C E7sus4/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A18 */
+    0x0000, 0x0000, 0x0B01, 0x0000, 0x0AAB, 0x0000, 0x0000, 0x0000,   /* A20 C#7#5/C Bm7b5/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A28 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A30 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A38 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0A5B, 0x0000, 0x0B3B, 0x0000,   /* A40 Bm7/C Bm9/C */
+    0x0A3B, 0x0000, 0x0B1B, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A48 B7/C B9/C */
+    0x0AFB, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A50 B7sus4/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A58 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A60 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A68 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A70 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A78 */
+    0x0000, 0x0339, 0x0B19, 0x0000, 0x0B47, 0x0000, 0x0000, 0x0000,   /* A80 Am9/C A9/C Gadd9/C */
+    0x0B0B, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A88 B7#5/C */
+    0x0000, 0x0339, 0x0B19, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A90 Am9/C A9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* A98 */
+    0x0B17, 0x0000, 0x0000, 0x0000, 0x0B17, 0x0000, 0x0000, 0x0000,   /* AA0 G9/C G9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* AA8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* AB0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* AB8 */
+    0x0B27, 0x0000, 0x0000, 0x0000, 0x0B27, 0x0000, 0x0000, 0x0000,   /* AC0 Gmaj9/C Gmaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* AC8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* AD0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* AD8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* AE0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* AE8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* AF0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* AF8 */
+    0x0000, 0x0000, 0x0B29, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B00 Amaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B08 */
+    0x0000, 0x0000, 0x0B29, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B10 Amaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B18 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B20 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B28 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B30 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B38 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B40 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B48 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B50 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B58 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B60 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B68 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B70 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B78 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B80 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B88 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B90 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* B98 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* BA0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* BA8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* BB0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* BB8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* BC0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* BC8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* BD0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* BD8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* BE0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* BE8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* BF0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* BF8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C00 */
+    0x0A4B, 0x0000, 0x0B2B, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C08 Bmaj7/C Bmaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C10 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C18 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C20 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C28 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C30 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C38 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0AEB, 0x0000, 0x0000, 0x0000,   /* C40 BmM7/C */
+    0x0A4B, 0x0000, 0x0B2B, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C48 Bmaj7/C Bmaj9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C50 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C58 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C60 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C68 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C70 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C78 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C80 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C88 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C90 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* C98 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* CA0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* CA8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* CB0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* CB8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* CC0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* CC8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* CD0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* CD8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* CE0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* CE8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* CF0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* CF8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D00 */
+    0x0B58, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D08 Abmadd9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D10 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D18 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D20 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D28 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D30 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D38 */
+    0x0B38, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D40 Abm9/C */
+    0x0B38, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D48 Abm9/C */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D50 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D58 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D60 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D68 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D70 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D78 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D80 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D88 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D90 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* D98 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* DA0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* DA8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* DB0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* DB8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* DC0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* DC8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* DD0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* DD8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* DE0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* DE8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* DF0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* DF8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E00 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E08 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E10 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E18 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E20 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E28 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E30 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E38 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E40 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E48 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E50 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E58 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E60 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E68 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E70 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E78 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E80 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E88 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E90 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* E98 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* EA0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* EA8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* EB0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* EB8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* EC0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* EC8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* ED0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* ED8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* EE0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* EE8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* EF0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* EF8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F00 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F08 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F10 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F18 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F20 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F28 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F30 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F38 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F40 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F48 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F50 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F58 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F60 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F68 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F70 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F78 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F80 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F88 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F90 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* F98 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* FA0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* FA8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* FB0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* FB8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* FC0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* FC8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* FD0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* FD8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* FE0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* FE8 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* FF0 */
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   /* FF8 */
+};
@@ -4,50 +4,59 @@
  * chords.c
  *
  * This file contains only constant data definitions:
- * - Two chord packs: basic and advanced
+ * - Three chord packs: basic, advanced and seventh/ninth chords
  * - Exported registry chordPacks[] and CHORD_PACK_COUNT
  *
- * Each chord is defined as up to 3 tones. The tones use NoteEntry:
+ * Each chord lists its tones with NOTES() (any number), written with TONE():
  *   - letter + accidental define the pitch class
- *   - midiNote is not used in chord mode (kept as a placeholder value)
- *   - lengthIcon is not used in chord mode (set to 0)
+ *   - midiNote is not used in chord mode (-1)
+ *   - lengthIcon and timing are not used in chord mode (0)
  */
 
-/* Placeholder used for NoteEntry.midiNote in chord mode (not used by matching logic). */
-#define NO_MIDI_NOTE   ((int16_t)-1)
-
 /* Basic chords pack – common chords (C, G, Am, F, Dm, Em) */
-static Chord basicChords[] = {
-    { "C",  3, { {'C', ACC_NONE,  NO_MIDI_NOTE, 0}, {'E', ACC_NONE,  NO_MIDI_NOTE, 0}, {'G', ACC_NONE,  NO_MIDI_NOTE, 0} } },
-    { "G",  3, { {'G', ACC_NONE,  NO_MIDI_NOTE, 0}, {'B', ACC_NONE,  NO_MIDI_NOTE, 0}, {'D', ACC_NONE,  NO_MIDI_NOTE, 0} } },
-    { "Am", 3, { {'A', ACC_NONE,  NO_MIDI_NOTE, 0}, {'C', ACC_NONE,  NO_MIDI_NOTE, 0}, {'E', ACC_NONE,  NO_MIDI_NOTE, 0} } },
-    { "F",  3, { {'F', ACC_NONE,  NO_MIDI_NOTE, 0}, {'A', ACC_NONE,  NO_MIDI_NOTE, 0}, {'C', ACC_NONE,  NO_MIDI_NOTE, 0} } },
-    { "Dm", 3, { {'D', ACC_NONE,  NO_MIDI_NOTE, 0}, {'F', ACC_NONE,  NO_MIDI_NOTE, 0}, {'A', ACC_NONE,  NO_MIDI_NOTE, 0} } },
-    { "Em", 3, { {'E', ACC_NONE,  NO_MIDI_NOTE, 0}, {'G', ACC_NONE,  NO_MIDI_NOTE, 0}, {'B', ACC_NONE,  NO_MIDI_NOTE, 0} } }
+static const Chord basicChords[] = {
+    { "C",  NOTES(TONE('C', ACC_NONE),  TONE('E', ACC_NONE),  TONE('G', ACC_NONE)) },
+    { "G",  NOTES(TONE('G', ACC_NONE),  TONE('B', ACC_NONE),  TONE('D', ACC_NONE)) },
+    { "Am", NOTES(TONE('A', ACC_NONE),  TONE('C', ACC_NONE),  TONE('E', ACC_NONE)) },
+    { "F",  NOTES(TONE('F', ACC_NONE),  TONE('A', ACC_NONE),  TONE('C', ACC_NONE)) },
+    { "Dm", NOTES(TONE('D', ACC_NONE),  TONE('F', ACC_NONE),  TONE('A', ACC_NONE)) },
+    { "Em", NOTES(TONE('E', ACC_NONE),  TONE('G', ACC_NONE),  TONE('B', ACC_NONE)) }
 };
 
 /* Advanced chords pack – chords with sharps/flats */
-static Chord advancedChords[] = {
-    { "F#",  3, { {'F', ACC_SHARP, NO_MIDI_NOTE, 0}, {'A', ACC_SHARP, NO_MIDI_NOTE, 0}, {'C', ACC_SHARP, NO_MIDI_NOTE, 0} } },
-    { "Bb",  3, { {'B', ACC_FLAT,  NO_MIDI_NOTE, 0}, {'D', ACC_NONE,  NO_MIDI_NOTE, 0}, {'F', ACC_NONE,  NO_MIDI_NOTE, 0} } },
-    { "Gm",  3, { {'G', ACC_NONE,  NO_MIDI_NOTE, 0}, {'B', ACC_FLAT,  NO_MIDI_NOTE, 0}, {'D', ACC_NONE,  NO_MIDI_NOTE, 0} } },
-    { "Ab",  3, { {'A', ACC_FLAT,  NO_MIDI_NOTE, 0}, {'C', ACC_NONE,  NO_MIDI_NOTE, 0}, {'E', ACC_FLAT,  NO_MIDI_NOTE, 0} } },
-    { "C#m", 3, { {'C', ACC_SHARP, NO_MIDI_NOTE, 0}, {'E', ACC_NONE,  NO_MIDI_NOTE, 0}, {'G', ACC_SHARP, NO_MIDI_NOTE, 0} } },
-    { "E",   3, { {'E', ACC_NONE,  NO_MIDI_NOTE, 0}, {'G', ACC_SHARP, NO_MIDI_NOTE, 0}, {'B', ACC_NONE,  NO_MIDI_NOTE, 0} } }
+static const Chord advancedChords[] = {
+    { "F#",  NOTES(TONE('F', ACC_SHARP), TONE('A', ACC_SHARP), TONE('C', ACC_SHARP)) },
+    { "Bb",  NOTES(TONE('B', ACC_FLAT),  TONE('D', ACC_NONE),  TONE('F', ACC_NONE)) },
+    { "Gm",  NOTES(TONE('G', ACC_NONE),  TONE('B', ACC_FLAT),  TONE('D', ACC_NONE)) },
+    { "Ab",  NOTES(TONE('A', ACC_FLAT),  TONE('C', ACC_NONE),  TONE('E', ACC_FLAT)) },
+    { "C#m", NOTES(TONE('C', ACC_SHARP), TONE('E', ACC_NONE),  TONE('G', ACC_SHARP)) },
+    { "E",   NOTES(TONE('E', ACC_NONE),  TONE('G', ACC_SHARP), TONE('B', ACC_NONE)) }
+};
+
+/* Seventh and ninth chords pack – four and five tones */
+static const Chord seventhChords[] = {
+    { "Cmaj7", NOTES(TONE('C', ACC_NONE),  TONE('E', ACC_NONE),  TONE('G', ACC_NONE),  TONE('B', ACC_NONE)) },
+    { "G7",    NOTES(TONE('G', ACC_NONE),  TONE('B', ACC_NONE),  TONE('D', ACC_NONE),  TONE('F', ACC_NONE)) },
+    { "Am7",   NOTES(TONE('A', ACC_NONE),  TONE('C', ACC_NONE),  TONE('E', ACC_NONE),  TONE('G', ACC_NONE)) },
+    { "Dm7",   NOTES(TONE('D', ACC_NONE),  TONE('F', ACC_NONE),  TONE('A', ACC_NONE),  TONE('C', ACC_NONE)) },
+    { "Bb7",   NOTES(TONE('B', ACC_FLAT),  TONE('D', ACC_NONE),  TONE('F', ACC_NONE),  TONE('A', ACC_FLAT)) },
+    { "C9",    NOTES(TONE('C', ACC_NONE),  TONE('E', ACC_NONE),  TONE('G', ACC_NONE),  TONE('B', ACC_FLAT),  TONE('D', ACC_NONE)) },
+    { "G9",    NOTES(TONE('G', ACC_NONE),  TONE('B', ACC_NONE),  TONE('D', ACC_NONE),  TONE('F', ACC_NONE),  TONE('A', ACC_NONE)) }
 };
 
 /*
  * Exported chord packs registry.
  * Each entry points to a static chord array defined above.
  */
-ChordPack chordPacks[] = {
+const ChordPack chordPacks[] = {
     { "Basic chords",
-      (uint8_t)(sizeof(basicChords) / sizeof(basicChords[0])),
-      basicChords },
+      CHORD_LIST(basicChords) },
 
     { "Advanced chords",
-      (uint8_t)(sizeof(advancedChords) / sizeof(advancedChords[0])),
-      advancedChords }
+      CHORD_LIST(advancedChords) },
+
+    { "7th/9th chords",
+      CHORD_LIST(seventhChords) }
 };
 
 /* Total number of chord packs available in the application. */
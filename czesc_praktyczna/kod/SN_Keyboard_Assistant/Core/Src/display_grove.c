@@ -0,0 +1,71 @@
+#include "display_grove.h"
+#include "i2c_bus.h"
+#include "lcd_queue.h"
+
+/**
+ * @file display_grove.c
+ * @brief Grove LCD backend: every call only copies into the LCD queue.
+ */
+
+static GroveLCD_t *groveLcd = NULL;
+
+static HAL_StatusTypeDef GroveWriteAt(void *ctx, uint8_t row, uint8_t col, const uint8_t *buf, uint8_t len)
+{
+    (void)ctx;
+
+    /* Cursor + data entries, or nothing (a lone cursor command would be harmless but wasted). */
+    uint32_t needed = 1U + (((uint32_t)len + LCDQ_MAX_DATA - 1U) / LCDQ_MAX_DATA);
+    if (LcdQueue_Free() < needed) return HAL_BUSY;
+
+    HAL_StatusTypeDef st = LcdQueue_SetCursor(row, col);
+    if (st != HAL_OK) return st;
+    return LcdQueue_Write(buf, len);
+}
+
+static HAL_StatusTypeDef GroveCreateChars(void *ctx, uint8_t firstSlot, const uint8_t patterns[][8], uint8_t count)
+{
+    (void)ctx;
+    return LcdQueue_CreateChars(firstSlot, patterns, count);
+}
+
+static HAL_StatusTypeDef GroveFence(void *ctx, DisplayCallback callback, void *arg)
+{
+    (void)ctx;
+    return LcdQueue_Fence(callback, arg);
+}
+
+static uint32_t GroveTakeErrors(void *ctx)
+{
+    (void)ctx;
+    return LcdQueue_TakeErrors();
+}
+
+static const DisplayOps_t groveOps = {
+    .WriteAt     = GroveWriteAt,
+    .CreateChars = GroveCreateChars,
+    .Fence       = GroveFence,
+    .TakeErrors  = GroveTakeErrors,
+};
+
+void DisplayGrove_Init(Display_t *display, GroveLCD_t *lcd)
+{
+    groveLcd = lcd;
+    LcdQueue_Init(lcd);
+
+    display->ops = &groveOps;
+    display->ctx = lcd;
+}
+
+void DisplayGrove_Service(void)
+{
+    if (groveLcd == NULL) return;
+
+    (void)LcdQueue_Watchdog(I2C_BUS_XFER_TIMEOUT_MS);
+
+    if (!I2cBus_Process()) return;
+
+    /* The queue was dropped when the breaker opened, so the handle is free for
+       the blocking backlight setup (~1 ms); the panel itself is queued. */
+    (void)GroveLCD_InitBacklight(groveLcd, GROVE_RGB_I2C_ADDR_7BIT_DEFAULT);
+    (void)LcdQueue_Reinit();
+}
@@ -0,0 +1,51 @@
+#include "display_hd44780.h"
+#include "lcd_hd44780.h"
+
+/**
+ * @file display_hd44780.c
+ * @brief Parallel HD44780 backend: writes complete before each call returns.
+ */
+
+static HAL_StatusTypeDef Hd44780WriteAt(void *ctx, uint8_t row, uint8_t col, const uint8_t *buf, uint8_t len)
+{
+    (void)ctx;
+    LCD_SetCursor(row, col);
+    LCD_Write(buf, len);
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef Hd44780CreateChars(void *ctx, uint8_t firstSlot, const uint8_t patterns[][8], uint8_t count)
+{
+    (void)ctx;
+    if (count == 0U || firstSlot > 7U || (uint8_t)(firstSlot + count) > 8U) return HAL_ERROR;
+
+    LCD_CreateChars(firstSlot, patterns, count);
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef Hd44780Fence(void *ctx, DisplayCallback callback, void *arg)
+{
+    (void)ctx;
+    /* Synchronous driver: everything written so far is already on the panel. */
+    if (callback != NULL) callback(arg);
+    return HAL_OK;
+}
+
+static uint32_t Hd44780TakeErrors(void *ctx)
+{
+    (void)ctx;
+    return 0;
+}
+
+static const DisplayOps_t hd44780Ops = {
+    .WriteAt     = Hd44780WriteAt,
+    .CreateChars = Hd44780CreateChars,
+    .Fence       = Hd44780Fence,
+    .TakeErrors  = Hd44780TakeErrors,
+};
+
+void DisplayHd44780_Init(Display_t *display)
+{
+    display->ops = &hd44780Ops;
+    display->ctx = NULL;
+}
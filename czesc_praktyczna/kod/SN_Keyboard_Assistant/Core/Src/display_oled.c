@@ -0,0 +1,89 @@
+#include "display_oled.h"
+#include "oled_ssd1306.h"
+#include <string.h>
+
+/**
+ * @file display_oled.c
+ * @brief OLED backend: character cells are drawn into the OLED framebuffer
+ *        and sent by the driver's incremental DMA flush.
+ */
+
+/* y of the top pixel row of a text row (pages 0 and 7). */
+static int16_t RowY(uint8_t row)
+{
+    return (row == 0U) ? 0 : (int16_t)(OLED_HEIGHT - OLED_FONT_H);
+}
+
+/* Codes 0..7 are CGRAM slots, like on the HD44780. */
+static void DrawCell(DisplayOled_t *t, uint8_t row, uint8_t col)
+{
+    uint8_t code = t->cells[row][col];
+    int16_t x = (int16_t)(col * DISPLAY_OLED_CELL_W + 1);
+
+    if (code < 8U) OledGfx_DrawPattern(t->gfx, x, RowY(row), t->cgram[code]);
+    else OledGfx_DrawChar(t->gfx, x, RowY(row), (char)code);
+}
+
+static HAL_StatusTypeDef OledWriteAt(void *ctx, uint8_t row, uint8_t col, const uint8_t *buf, uint8_t len)
+{
+    DisplayOled_t *t = (DisplayOled_t *)ctx;
+    if (buf == NULL || row >= DISPLAY_OLED_ROWS) return HAL_ERROR;
+
+    for (uint8_t i = 0; i < len && (uint8_t)(col + i) < DISPLAY_OLED_COLS; i++) {
+        t->cells[row][col + i] = buf[i];
+        DrawCell(t, row, (uint8_t)(col + i));
+    }
+
+    /* HAL_BUSY only means a flush is still running: the main loop sends the rest. */
+    (void)Oled_Flush();
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef OledCreateChars(void *ctx, uint8_t firstSlot, const uint8_t patterns[][8], uint8_t count)
+{
+    DisplayOled_t *t = (DisplayOled_t *)ctx;
+    if (patterns == NULL || count == 0U || firstSlot > 7U || (uint8_t)(firstSlot + count) > 8U) return HAL_ERROR;
+
+    memcpy(t->cgram[firstSlot], patterns, (size_t)count * 8U);
+
+    /* Cells showing a re-uploaded slot change immediately, as on a real LCD. */
+    for (uint8_t row = 0; row < DISPLAY_OLED_ROWS; row++) {
+        for (uint8_t col = 0; col < DISPLAY_OLED_COLS; col++) {
+            uint8_t code = t->cells[row][col];
+            if (code >= firstSlot && code < (uint8_t)(firstSlot + count)) DrawCell(t, row, col);
+        }
+    }
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef OledFence(void *ctx, DisplayCallback callback, void *arg)
+{
+    (void)ctx;
+    return Oled_Fence(callback, arg);
+}
+
+static uint32_t OledTakeErrors(void *ctx)
+{
+    (void)ctx;
+    /* The driver resends the whole framebuffer after a bus error, so the
+       character layer never needs to redraw; just drop the count. */
+    (void)Oled_TakeErrors();
+    return 0;
+}
+
+static const DisplayOps_t oledOps = {
+    .WriteAt     = OledWriteAt,
+    .CreateChars = OledCreateChars,
+    .Fence       = OledFence,
+    .TakeErrors  = OledTakeErrors,
+};
+
+void DisplayOled_Init(Display_t *display, DisplayOled_t *text, OledGfx_t *gfx)
+{
+    memset(text, 0, sizeof(*text));
+    memset(text->cells, ' ', sizeof(text->cells));
+    text->gfx = gfx;
+
+    display->ops = &oledOps;
+    display->ctx = text;
+}
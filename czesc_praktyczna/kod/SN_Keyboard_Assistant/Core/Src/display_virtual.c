@@ -0,0 +1,110 @@
+#include "display_virtual.h"
+#include <string.h>
+
+/**
+ * @file display_virtual.c
+ * @brief In-memory display backend (see display_virtual.h).
+ *
+ * Also compiled into the firmware (it is small and unused unless bound), so it
+ * must stay free of HAL calls.
+ */
+
+/* Grove I2C framing: 7-bit address byte + control byte before the payload. */
+#define VIRT_I2C_OVERHEAD   (2U)
+
+static void CountTransaction(DisplayVirtual_t *p, uint32_t payload)
+{
+    p->stats.transactions++;
+    p->stats.busBytes += VIRT_I2C_OVERHEAD + payload;
+}
+
+static HAL_StatusTypeDef VirtWriteAt(void *ctx, uint8_t row, uint8_t col, const uint8_t *buf, uint8_t len)
+{
+    DisplayVirtual_t *p = (DisplayVirtual_t *)ctx;
+    if (buf == NULL || row >= DISPLAY_VIRTUAL_ROWS) return HAL_ERROR;
+
+    CountTransaction(p, 1U);     /* set DDRAM address */
+    CountTransaction(p, len);    /* data burst */
+
+    /* Writes past column 15 land in invisible DDRAM on a real panel: drop them. */
+    for (uint8_t i = 0; i < len && (uint8_t)(col + i) < DISPLAY_VIRTUAL_COLS; i++) {
+        p->ddram[row][col + i] = buf[i];
+    }
+    p->stats.cellsWritten += len;
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef VirtCreateChars(void *ctx, uint8_t firstSlot, const uint8_t patterns[][8], uint8_t count)
+{
+    DisplayVirtual_t *p = (DisplayVirtual_t *)ctx;
+    if (patterns == NULL || count == 0U || firstSlot > 7U || (uint8_t)(firstSlot + count) > 8U) return HAL_ERROR;
+
+    CountTransaction(p, 1U);                     /* set CGRAM address */
+    CountTransaction(p, (uint32_t)count * 8U);   /* pattern burst */
+    CountTransaction(p, 1U);                     /* back to DDRAM */
+
+    for (uint8_t c = 0; c < count; c++) {
+        for (uint8_t i = 0; i < 8U; i++) {
+            p->cgram[firstSlot + c][i] = (uint8_t)(patterns[c][i] & 0x1F);
+        }
+    }
+    p->stats.cgramUploads += count;
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef VirtFence(void *ctx, DisplayCallback callback, void *arg)
+{
+    DisplayVirtual_t *p = (DisplayVirtual_t *)ctx;
+
+    memcpy(p->frameLog[p->stats.frames % DISPLAY_VIRTUAL_FRAME_LOG], p->ddram, sizeof(p->ddram));
+    p->stats.frames++;
+
+    if (callback != NULL) callback(arg);
+    return HAL_OK;
+}
+
+static uint32_t VirtTakeErrors(void *ctx)
+{
+    (void)ctx;
+    return 0;
+}
+
+static const DisplayOps_t virtualOps = {
+    .WriteAt     = VirtWriteAt,
+    .CreateChars = VirtCreateChars,
+    .Fence       = VirtFence,
+    .TakeErrors  = VirtTakeErrors,
+};
+
+void DisplayVirtual_Init(Display_t *display, DisplayVirtual_t *panel)
+{
+    memset(panel, 0, sizeof(*panel));
+    memset(panel->ddram, ' ', sizeof(panel->ddram));
+
+    display->ops = &virtualOps;
+    display->ctx = panel;
+}
+
+void DisplayVirtual_ResetStats(DisplayVirtual_t *panel)
+{
+    memset(&panel->stats, 0, sizeof(panel->stats));
+}
+
+void DisplayVirtual_Row(const DisplayVirtual_t *panel, uint8_t row, char *out)
+{
+    if (row >= DISPLAY_VIRTUAL_ROWS) row = DISPLAY_VIRTUAL_ROWS - 1U;
+
+    for (uint8_t i = 0; i < DISPLAY_VIRTUAL_COLS; i++) {
+        uint8_t c = panel->ddram[row][i];
+        out[i] = (c < 8U) ? '~' : (char)c;
+    }
+    out[DISPLAY_VIRTUAL_COLS] = '\0';
+}
+
+const uint8_t (*DisplayVirtual_Frame(const DisplayVirtual_t *panel, uint32_t age))[DISPLAY_VIRTUAL_COLS]
+{
+    if (age >= panel->stats.frames || age >= DISPLAY_VIRTUAL_FRAME_LOG) return NULL;
+
+    uint32_t idx = (panel->stats.frames - 1U - age) % DISPLAY_VIRTUAL_FRAME_LOG;
+    return (const uint8_t (*)[DISPLAY_VIRTUAL_COLS])panel->frameLog[idx];
+}
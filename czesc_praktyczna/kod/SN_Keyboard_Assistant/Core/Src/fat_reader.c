@@ -0,0 +1,510 @@
+#include "fat_reader.h"
+#include <string.h>
+
+/**
+ * @file fat_reader.c
+ * @brief Read-only FAT file system (see fat_reader.h).
+ *
+ * Partial sectors (directory entries, FAT entries, the ends of a read)
+ * come from the sector cache; whole sectors of file data are read
+ * straight into the caller's buffer, one command per contiguous run.
+ */
+
+#define CHAIN_END        (0xFFFFFFFFUL)
+#define DIR_ENTRY_SIZE   (32U)
+#define ATTR_LONG_NAME   (0x0FU)
+#define LFN_LAST         (0x40U)
+#define LFN_CHARS        (13U)
+#define NT_LOWER_BASE    (0x08U)
+#define NT_LOWER_EXT     (0x10U)
+
+static uint16_t Get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t Get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static char Upper(char c)
+{
+    return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c;
+}
+
+static char Lower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+static bool SameName(const char *a, const char *b)
+{
+    while (*a != '\0' && Upper(*a) == Upper(*b)) { a++; b++; }
+    return Upper(*a) == Upper(*b);
+}
+
+/* --- Disk and sector cache --- */
+
+static bool DiskRead(FatVolume *vol, uint32_t lba, uint8_t *buf, uint16_t count)
+{
+    vol->reads++;
+    vol->sectorsRead += count;
+    return vol->disk.read(vol->disk.ctx, lba, buf, count);
+}
+
+static const uint8_t *CachedSector(FatVolume *vol, uint32_t lba)
+{
+    FatCacheSector *hit = NULL;
+    FatCacheSector *victim = &vol->cache[0];
+
+    for (uint8_t i = 0; i < FAT_CACHE_SECTORS; i++)
+    {
+        FatCacheSector *c = &vol->cache[i];
+        if (c->lba == lba) { hit = c; break; }
+        if (c->lba == UINT32_MAX || c->lastUse < victim->lastUse) victim = c;
+    }
+    if (hit == NULL)
+    {
+        hit = victim;
+        hit->lba = UINT32_MAX;
+        if (!DiskRead(vol, lba, hit->data, 1)) return NULL;
+        hit->lba = lba;
+    }
+    else
+    {
+        vol->cacheHits++;
+    }
+    hit->lastUse = ++vol->useClock;
+    return hit->data;
+}
+
+static bool CachedByte(FatVolume *vol, uint32_t lba, uint32_t offset, uint8_t *b)
+{
+    const uint8_t *sector = CachedSector(vol, lba + offset / FAT_SECTOR_SIZE);
+    if (sector == NULL) return false;
+    *b = sector[offset % FAT_SECTOR_SIZE];
+    return true;
+}
+
+/* --- FAT --- */
+
+/* Next cluster of the chain, CHAIN_END at its end; false on a read error or a broken chain. */
+static bool NextCluster(FatVolume *vol, uint32_t cluster, uint32_t *next)
+{
+    uint32_t value;
+
+    if (vol->type == 12U)
+    {
+        uint32_t offset = cluster + cluster / 2U;
+        uint8_t lo, hi;
+        if (!CachedByte(vol, vol->fatLba, offset, &lo) || !CachedByte(vol, vol->fatLba, offset + 1U, &hi)) return false;
+        value = (uint32_t)lo | ((uint32_t)hi << 8);
+        value = ((cluster & 1U) != 0U) ? (value >> 4) : (value & 0x0FFFU);
+        if (value >= 0x0FF8U) value = CHAIN_END;
+    }
+    else if (vol->type == 16U)
+    {
+        const uint8_t *sector = CachedSector(vol, vol->fatLba + cluster / (FAT_SECTOR_SIZE / 2U));
+        if (sector == NULL) return false;
+        value = Get16(&sector[(cluster % (FAT_SECTOR_SIZE / 2U)) * 2U]);
+        if (value >= 0xFFF8U) value = CHAIN_END;
+    }
+    else
+    {
+        const uint8_t *sector = CachedSector(vol, vol->fatLba + cluster / (FAT_SECTOR_SIZE / 4U));
+        if (sector == NULL) return false;
+        value = Get32(&sector[(cluster % (FAT_SECTOR_SIZE / 4U)) * 4U]) & 0x0FFFFFFFUL;
+        if (value >= 0x0FFFFFF8UL) value = CHAIN_END;
+    }
+
+    /* Free, reserved or bad clusters do not belong in a chain */
+    if (value != CHAIN_END && (value < 2U || value >= vol->clusterCount + 2U)) return false;
+    *next = value;
+    return true;
+}
+
+static uint32_t ClusterLba(const FatVolume *vol, uint32_t cluster)
+{
+    return vol->dataLba + (cluster - 2U) * vol->sectorsPerCluster;
+}
+
+/* Most clusters a file can have: from its size, or the whole volume for directories. */
+static uint32_t MaxClusters(const FatFile *f)
+{
+    uint32_t clusterBytes = (uint32_t)f->vol->sectorsPerCluster * FAT_SECTOR_SIZE;
+    if (f->isDir) return f->vol->clusterCount;
+    return (f->size + clusterBytes - 1U) / clusterBytes;
+}
+
+/*
+ * Follows the chain from (cluster, fileCluster) and fills the extent table
+ * with the next FAT_EXTENTS runs (the prefetch).
+ */
+static bool FillExtents(FatFile *f, uint32_t cluster, uint32_t fileCluster)
+{
+    uint32_t limit = MaxClusters(f);
+
+    f->extCount = 0;
+    f->nextCluster = 0;
+    while (f->extCount < FAT_EXTENTS && fileCluster < limit)
+    {
+        FatExtent *e = &f->ext[f->extCount++];
+        uint32_t next;
+
+        e->fileCluster = fileCluster;
+        e->cluster = cluster;
+        e->count = 1;
+        fileCluster++;
+        if (!NextCluster(f->vol, cluster, &next)) return false;
+        while (next == cluster + 1U && fileCluster < limit)
+        {
+            cluster = next;
+            e->count++;
+            fileCluster++;
+            if (!NextCluster(f->vol, cluster, &next)) return false;
+        }
+        if (next == CHAIN_END) return true;
+        cluster = next;
+        f->nextCluster = next;
+    }
+    /* Chain goes on past the table, or past the file size (ignored) */
+    if (fileCluster >= limit) f->nextCluster = 0;
+    return true;
+}
+
+/* Disk cluster of the file's fileCluster-th cluster and how many follow it in the same run. */
+static bool MapCluster(FatFile *f, uint32_t fileCluster, uint32_t *cluster, uint32_t *runLeft)
+{
+    bool restarted = false;
+
+    for (;;)
+    {
+        for (uint8_t i = 0; i < f->extCount; i++)
+        {
+            const FatExtent *e = &f->ext[i];
+            if (fileCluster >= e->fileCluster && fileCluster - e->fileCluster < e->count)
+            {
+                *cluster = e->cluster + (fileCluster - e->fileCluster);
+                *runLeft = e->count - (fileCluster - e->fileCluster);
+                return true;
+            }
+        }
+
+        /* Not in the table: go on along the chain, or start over for an earlier cluster */
+        const FatExtent *last = &f->ext[(f->extCount > 0U) ? f->extCount - 1U : 0U];
+        if (f->extCount > 0U && fileCluster >= last->fileCluster + last->count && f->nextCluster != 0U)
+        {
+            if (!FillExtents(f, f->nextCluster, last->fileCluster + last->count)) return false;
+        }
+        else if (!restarted && f->firstCluster >= 2U)
+        {
+            restarted = true;
+            if (!FillExtents(f, f->firstCluster, 0)) return false;
+        }
+        else
+        {
+            return false;
+        }
+    }
+}
+
+/* --- Files --- */
+
+uint32_t Fat_Run(FatFile *f, uint32_t offset, uint32_t *lba)
+{
+    FatVolume *vol = f->vol;
+    uint32_t sector = offset / FAT_SECTOR_SIZE;
+
+    if (f->fixedRoot)
+    {
+        if (sector >= vol->rootSectors) return 0;
+        *lba = vol->rootLba + sector;
+        return vol->rootSectors - sector;
+    }
+    if (!f->isDir && offset >= f->size) return 0;
+
+    uint32_t cluster, runLeft;
+    uint32_t inCluster = sector % vol->sectorsPerCluster;
+    if (!MapCluster(f, sector / vol->sectorsPerCluster, &cluster, &runLeft)) return 0;
+    *lba = ClusterLba(vol, cluster) + inCluster;
+    return runLeft * vol->sectorsPerCluster - inCluster;
+}
+
+FatStatus Fat_Read(FatFile *f, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    if (!f->isDir && (offset > f->size || len > f->size - offset)) return FAT_ERR_CORRUPT;
+
+    while (len > 0U)
+    {
+        uint32_t lba;
+        uint32_t run = Fat_Run(f, offset, &lba);
+        uint32_t inSector = offset % FAT_SECTOR_SIZE;
+
+        if (run == 0U) return FAT_ERR_CORRUPT;
+        if (inSector == 0U && len >= FAT_SECTOR_SIZE)
+        {
+            /* Whole sectors: straight into buf */
+            uint32_t n = len / FAT_SECTOR_SIZE;
+            if (n > run) n = run;
+            if (n > FAT_MAX_READ_SECTORS) n = FAT_MAX_READ_SECTORS;
+            if (!DiskRead(f->vol, lba, buf, (uint16_t)n)) return FAT_ERR_IO;
+            n *= FAT_SECTOR_SIZE;
+            buf += n;
+            offset += n;
+            len -= n;
+        }
+        else
+        {
+            const uint8_t *sector = CachedSector(f->vol, lba);
+            uint32_t n = FAT_SECTOR_SIZE - inSector;
+            if (sector == NULL) return FAT_ERR_IO;
+            if (n > len) n = len;
+            memcpy(buf, &sector[inSector], n);
+            buf += n;
+            offset += n;
+            len -= n;
+        }
+    }
+    return FAT_OK;
+}
+
+static bool SourceRead(void *ctx, uint32_t offset, uint8_t *buf, uint16_t len)
+{
+    return Fat_Read((FatFile *)ctx, offset, buf, len) == FAT_OK;
+}
+
+void Fat_Source(FatFile *file, SmfSource *src)
+{
+    src->base = NULL;
+    src->read = SourceRead;
+    src->ctx = file;
+    src->size = file->size;
+}
+
+static void OpenChain(FatVolume *vol, FatFile *f, uint32_t cluster, uint32_t size, bool isDir)
+{
+    memset(f, 0, sizeof(*f));
+    f->vol = vol;
+    f->firstCluster = cluster;
+    f->size = size;
+    f->isDir = isDir;
+}
+
+void Fat_OpenRoot(FatVolume *vol, FatFile *dir)
+{
+    OpenChain(vol, dir, (vol->type == 32U) ? vol->rootCluster : 0U, 0, true);
+    dir->fixedRoot = (vol->type != 32U);
+}
+
+void Fat_Open(FatVolume *vol, const FatEntry *entry, FatFile *file)
+{
+    bool isDir = (entry->attr & FAT_ATTR_DIRECTORY) != 0U;
+
+    /* ".." of a first-level directory points at cluster 0: the root */
+    if (isDir && entry->cluster == 0U) {
+        Fat_OpenRoot(vol, file);
+        return;
+    }
+    OpenChain(vol, file, entry->cluster, isDir ? 0U : entry->size, isDir);
+}
+
+/* --- Directories --- */
+
+void Fat_Rewind(FatFile *dir)
+{
+    dir->pos = 0;
+}
+
+static uint8_t ShortNameChecksum(const uint8_t *name)
+{
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < 11U; i++) {
+        sum = (uint8_t)((((sum & 1U) != 0U) ? 0x80U : 0U) + (sum >> 1) + name[i]);
+    }
+    return sum;
+}
+
+/* "NAME    EXT" -> "NAME.EXT", lower case where the NT flags ask for it */
+static void ShortName(const uint8_t *e, char *out)
+{
+    uint8_t n = 0;
+    bool lowerBase = (e[12] & NT_LOWER_BASE) != 0U;
+    bool lowerExt = (e[12] & NT_LOWER_EXT) != 0U;
+
+    for (uint8_t i = 0; i < 8U && e[i] != ' '; i++) {
+        char c = (i == 0U && e[0] == 0x05U) ? (char)0xE5 : (char)e[i];
+        out[n++] = lowerBase ? Lower(c) : c;
+    }
+    if (e[8] != ' ')
+    {
+        out[n++] = '.';
+        for (uint8_t i = 8; i < 11U && e[i] != ' '; i++) {
+            out[n++] = lowerExt ? Lower((char)e[i]) : (char)e[i];
+        }
+    }
+    out[n] = '\0';
+}
+
+/* Characters of one long-name entry into name (13 per entry, from its sequence number) */
+static void LongNamePart(const uint8_t *e, char *name)
+{
+    static const uint8_t charOffsets[LFN_CHARS] = { 1, 3, 5, 7, 9, 14, 16, 18, 20, 22, 24, 28, 30 };
+    uint32_t at = (uint32_t)((e[0] & 0x1FU) - 1U) * LFN_CHARS;
+
+    for (uint8_t i = 0; i < LFN_CHARS; i++, at++)
+    {
+        uint16_t c = Get16(&e[charOffsets[i]]);
+        if (c == 0x0000U || c == 0xFFFFU) break;
+        if (at < FAT_NAME_MAX - 1U) name[at] = (c < 0x80U) ? (char)c : '?';
+    }
+}
+
+FatStatus Fat_NextEntry(FatFile *dir, FatEntry *entry)
+{
+    uint8_t lfnNext = 0;         /* sequence number expected next, 0 = no long name pending */
+    uint8_t lfnSum = 0;
+
+    if (!dir->isDir) return FAT_ERR_NOT_DIR;
+
+    for (;;)
+    {
+        uint32_t lba;
+        if (Fat_Run(dir, dir->pos, &lba) == 0U) return FAT_END;
+        const uint8_t *sector = CachedSector(dir->vol, lba);
+        if (sector == NULL) return FAT_ERR_IO;
+
+        const uint8_t *e = &sector[dir->pos % FAT_SECTOR_SIZE];
+        if (e[0] == 0x00U) return FAT_END;
+        dir->pos += DIR_ENTRY_SIZE;
+
+        if (e[0] == 0xE5U) {
+            lfnNext = 0;
+            continue;
+        }
+        if ((e[11] & 0x3FU) == ATTR_LONG_NAME)
+        {
+            uint8_t seq = e[0] & 0x1FU;
+            if ((e[0] & LFN_LAST) != 0U)
+            {
+                memset(entry->name, 0, sizeof(entry->name));
+                lfnSum = e[13];
+                lfnNext = seq;
+            }
+            if (seq == 0U || seq != lfnNext || e[13] != lfnSum) {
+                lfnNext = 0;
+                continue;
+            }
+            LongNamePart(e, entry->name);
+            lfnNext--;
+            if (lfnNext == 0U) lfnNext = 0xFFU;    /* complete: the short entry comes next */
+            continue;
+        }
+        if ((e[11] & FAT_ATTR_VOLUME_ID) != 0U || e[0] == '.') {
+            lfnNext = 0;
+            continue;
+        }
+
+        ShortName(e, entry->shortName);
+        if (lfnNext != 0xFFU || ShortNameChecksum(e) != lfnSum || entry->name[0] == '\0')
+        {
+            strncpy(entry->name, entry->shortName, sizeof(entry->name) - 1U);
+            entry->name[sizeof(entry->name) - 1U] = '\0';
+        }
+        entry->attr = e[11];
+        entry->cluster = Get16(&e[26]) | ((dir->vol->type == 32U) ? ((uint32_t)Get16(&e[20]) << 16) : 0U);
+        entry->size = Get32(&e[28]);
+        return FAT_OK;
+    }
+}
+
+FatStatus Fat_Find(FatFile *dir, const char *name, FatEntry *entry)
+{
+    FatStatus st;
+
+    Fat_Rewind(dir);
+    while ((st = Fat_NextEntry(dir, entry)) == FAT_OK)
+    {
+        if (SameName(entry->name, name) || SameName(entry->shortName, name)) return FAT_OK;
+    }
+    return (st == FAT_END) ? FAT_ERR_NOT_FOUND : st;
+}
+
+/* --- Mount --- */
+
+static bool IsBootSector(const uint8_t *b)
+{
+    uint8_t spc = b[13];
+    return (b[0] == 0xEBU || b[0] == 0xE9U) &&
+           spc != 0U && (spc & (spc - 1U)) == 0U &&
+           Get16(&b[14]) != 0U && (b[16] == 1U || b[16] == 2U);
+}
+
+static bool IsFatPartition(uint8_t type)
+{
+    return type == 0x01U || type == 0x04U || type == 0x06U ||
+           type == 0x0BU || type == 0x0CU || type == 0x0EU;
+}
+
+FatStatus Fat_Mount(FatVolume *vol, const FatDisk *disk)
+{
+    uint32_t start = 0;
+    const uint8_t *b;
+
+    memset(vol, 0, sizeof(*vol));
+    vol->disk = *disk;
+    for (uint8_t i = 0; i < FAT_CACHE_SECTORS; i++) vol->cache[i].lba = UINT32_MAX;
+
+    if ((b = CachedSector(vol, 0)) == NULL) return FAT_ERR_IO;
+    if (b[510] != 0x55U || b[511] != 0xAAU) return FAT_ERR_NO_FS;
+    if (!IsBootSector(b))
+    {
+        /* Partition table: the first FAT partition */
+        uint8_t i;
+        for (i = 0; i < 4U; i++)
+        {
+            const uint8_t *p = &b[446U + 16U * i];
+            if (IsFatPartition(p[4]) && Get32(&p[8]) != 0U) {
+                start = Get32(&p[8]);
+                break;
+            }
+        }
+        if (i == 4U) return FAT_ERR_NO_FS;
+        if ((b = CachedSector(vol, start)) == NULL) return FAT_ERR_IO;
+        if (b[510] != 0x55U || b[511] != 0xAAU || !IsBootSector(b)) return FAT_ERR_NO_FS;
+    }
+    if (Get16(&b[11]) != FAT_SECTOR_SIZE) return FAT_ERR_UNSUPPORTED;
+
+    uint32_t reserved = Get16(&b[14]);
+    uint32_t fats = b[16];
+    uint32_t rootEntries = Get16(&b[17]);
+    uint32_t totalSectors = (Get16(&b[19]) != 0U) ? Get16(&b[19]) : Get32(&b[32]);
+    uint32_t fatSectors = (Get16(&b[22]) != 0U) ? Get16(&b[22]) : Get32(&b[36]);
+
+    vol->sectorsPerCluster = b[13];
+    vol->rootSectors = (rootEntries * DIR_ENTRY_SIZE + FAT_SECTOR_SIZE - 1U) / FAT_SECTOR_SIZE;
+    vol->fatLba = start + reserved;
+    vol->rootLba = vol->fatLba + fats * fatSectors;
+    vol->dataLba = vol->rootLba + vol->rootSectors;
+
+    uint32_t meta = reserved + fats * fatSectors + vol->rootSectors;
+    if (fatSectors == 0U || totalSectors <= meta) return FAT_ERR_NO_FS;
+    vol->clusterCount = (totalSectors - meta) / vol->sectorsPerCluster;
+
+    /* The type follows from the cluster count only (Microsoft FAT specification) */
+    if (vol->clusterCount < 4085U) vol->type = 12;
+    else if (vol->clusterCount < 65525U) vol->type = 16;
+    else vol->type = 32;
+
+    if (vol->type == 32U)
+    {
+        vol->rootCluster = Get32(&b[44]);
+        vol->rootSectors = 0;
+        if (vol->rootCluster < 2U || vol->rootCluster >= vol->clusterCount + 2U) return FAT_ERR_NO_FS;
+    }
+    else if (vol->rootSectors == 0U)
+    {
+        return FAT_ERR_NO_FS;
+    }
+    return FAT_OK;
+}
@@ -0,0 +1,115 @@
+/*
+ * freeplay.c
+ *
+ * Free-play chord naming screen (see freeplay.h).
+ */
+
+#include "freeplay.h"
+#include "chord_id.h"
+#include "held_notes.h"
+#include "lcd_framebuffer.h"
+
+static bool active = false;
+
+/* Key set currently on screen (pitch classes + bass), to skip identical redraws. */
+static uint16_t shownPcs;
+static uint8_t shownBass;
+
+/* Row 1 text per ChordInversion */
+static const char *const inversionText[] = {
+    "root position",
+    "1st inversion",
+    "2nd inversion",
+    "3rd inversion",
+    "inversion",
+    "slash chord"
+};
+
+/* Print a name with '#' and note-letter 'b' as accidental glyphs ("m7b5" stays ASCII). */
+static void PrintName(const char *s)
+{
+    char prev = '\0';
+
+    for (; *s != '\0'; prev = *s++)
+    {
+        if (*s == '#') LcdFb_WriteGlyph(GLYPH_SHARP);
+        else if (*s == 'b' && prev >= 'A' && prev <= 'G') LcdFb_WriteGlyph(GLYPH_FLAT);
+        else LcdFb_WriteChar(*s);
+    }
+}
+
+static void Draw(uint16_t pcs, uint8_t bass)
+{
+    LcdFb_Clear();
+
+    if (pcs == 0U)
+    {
+        LcdFb_SetCursor(0, 0);
+        LcdFb_Print("Free play");
+        LcdFb_SetCursor(1, 0);
+        LcdFb_Print("Play a chord");
+        LcdFb_Flush();
+        return;
+    }
+
+    ChordId id = ChordId_Lookup(pcs, bass);
+
+    LcdFb_SetCursor(0, 0);
+    if (id.quality != CHORD_Q_NONE)
+    {
+        char name[CHORD_NAME_MAX];
+        ChordId_Format(&id, name, sizeof(name));
+        PrintName(name);
+
+        LcdFb_SetCursor(1, 0);
+        LcdFb_Print(inversionText[id.inversion]);
+    }
+    else
+    {
+        /* Held pitch classes, bass first (the LCD stops at 16 columns) */
+        for (uint8_t i = 0; i < 12U; i++)
+        {
+            uint8_t pc = (uint8_t)((bass + i) % 12U);
+            if ((pcs & (1U << pc)) == 0U) continue;
+            PrintName(ChordId_PitchName(pc));
+            LcdFb_WriteChar(' ');
+        }
+
+        LcdFb_SetCursor(1, 0);
+        LcdFb_Print("no chord");
+    }
+
+    LcdFb_Flush();
+}
+
+void FreePlay_Start(void)
+{
+    active = true;
+    shownPcs = 0xFFFFU;   /* force the first draw */
+    FreePlay_Update();
+}
+
+void FreePlay_Stop(void)
+{
+    active = false;
+}
+
+bool FreePlay_IsActive(void)
+{
+    return active;
+}
+
+void FreePlay_Update(void)
+{
+    if (!active) return;
+
+    uint16_t pcs = HeldNotes_PitchClasses();
+    uint8_t lowest = NoteMask_Lowest(HeldNotes_Mask());
+    uint8_t bass = (lowest == 0xFFU) ? 0U : (uint8_t)(lowest % 12U);
+
+    if (pcs == shownPcs && bass == shownBass) return;
+    shownPcs = pcs;
+    shownBass = bass;
+
+    Draw(pcs, bass);
+}
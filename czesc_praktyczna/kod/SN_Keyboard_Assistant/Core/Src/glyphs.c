@@ -0,0 +1,174 @@
+#include "glyphs.h"
+#include <string.h>
+
+/**
+ * @file glyphs.c
+ * @brief Glyph patterns and the LRU CGRAM slot allocator (see glyphs.h).
+ *
+ * State:
+ * - glyphSlot[g] : CGRAM slot holding glyph g, or NO_SLOT
+ * - slotGlyph[s] : glyph stored in slot s, or NO_GLYPH
+ * - slotUsed[s]  : Glyphs_Prepare() call number that last needed slot s (LRU key)
+ *
+ * HAL-free, so it also builds on the host (Tools/display_bench.c).
+ */
+
+#define NO_SLOT    (0xFFU)
+#define NO_GLYPH   (0xFFU)
+
+/* Cell codes below 0x20 are glyph IDs (see glyphs.h). */
+_Static_assert(GLYPH_COUNT <= 32, "glyph IDs must fit below 0x20 and in a 32-bit mask");
+
+/* 5x8 patterns (only the lower 5 bits of each row are used). */
+static const uint8_t glyphPatterns[GLYPH_COUNT][8] = {
+    [GLYPH_WHOLE]        = { 0b00000, 0b00110, 0b01001, 0b01001, 0b01001, 0b00110, 0b00000, 0b00000 },
+    [GLYPH_HALF]         = { 0b00001, 0b00001, 0b00111, 0b01001, 0b01001, 0b00111, 0b00000, 0b00000 },
+    [GLYPH_QUARTER]      = { 0b00001, 0b00001, 0b00111, 0b01111, 0b01111, 0b00111, 0b00000, 0b00000 },
+    [GLYPH_EIGHTH]       = { 0b00011, 0b00101, 0b00011, 0b00001, 0b01111, 0b01111, 0b00110, 0b00000 },
+    [GLYPH_SIXTEENTH]    = { 0b00011, 0b00101, 0b00011, 0b00101, 0b01111, 0b01111, 0b00110, 0b00000 },
+    [GLYPH_SHARP]        = { 0b00100, 0b01110, 0b00100, 0b01110, 0b00100, 0b00000, 0b00000, 0b00000 },
+    [GLYPH_FLAT]         = { 0b00100, 0b00100, 0b00110, 0b00101, 0b00110, 0b00000, 0b00000, 0b00000 },
+    [GLYPH_NATURAL]      = { 0b01000, 0b01000, 0b01110, 0b01010, 0b01110, 0b00010, 0b00010, 0b00000 },
+    [GLYPH_DOT]          = { 0b00000, 0b00000, 0b00000, 0b00000, 0b01100, 0b01100, 0b00000, 0b00000 },
+    [GLYPH_REST_QUARTER] = { 0b00100, 0b00010, 0b00100, 0b01000, 0b00100, 0b00010, 0b00100, 0b00000 },
+    [GLYPH_REST_EIGHTH]  = { 0b00000, 0b11001, 0b11010, 0b00010, 0b00100, 0b00100, 0b01000, 0b00000 },
+    [GLYPH_TIE]          = { 0b00000, 0b00000, 0b00000, 0b00000, 0b10001, 0b01110, 0b00000, 0b00000 },
+    [GLYPH_CLEF]         = { 0b00110, 0b00101, 0b00110, 0b01100, 0b10110, 0b10101, 0b01110, 0b00100 },
+    [GLYPH_BAR_1]        = { 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000 },
+    [GLYPH_BAR_2]        = { 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000 },
+    [GLYPH_BAR_3]        = { 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100 },
+    [GLYPH_BAR_4]        = { 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110 },
+    [GLYPH_BAR_5]        = { 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111 },
+    [GLYPH_CHECK]        = { 0b00000, 0b00001, 0b00011, 0b10110, 0b11100, 0b01000, 0b00000, 0b00000 },
+    [GLYPH_CROSS]        = { 0b00000, 0b10001, 0b01010, 0b00100, 0b01010, 0b10001, 0b00000, 0b00000 },
+};
+
+/* Shown when a glyph cannot get a slot (more than 8 different glyphs in one frame). */
+static const char glyphFallback[GLYPH_COUNT] = {
+    [GLYPH_WHOLE] = 'o', [GLYPH_HALF] = 'd', [GLYPH_QUARTER] = 'q', [GLYPH_EIGHTH] = 'e',
+    [GLYPH_SIXTEENTH] = 's', [GLYPH_SHARP] = '#', [GLYPH_FLAT] = 'b', [GLYPH_NATURAL] = 'n',
+    [GLYPH_DOT] = '.', [GLYPH_REST_QUARTER] = 'r', [GLYPH_REST_EIGHTH] = 'r', [GLYPH_TIE] = '~',
+    [GLYPH_CLEF] = '&', [GLYPH_BAR_1] = '-', [GLYPH_BAR_2] = '-', [GLYPH_BAR_3] = '=',
+    [GLYPH_BAR_4] = '=', [GLYPH_BAR_5] = '#', [GLYPH_CHECK] = 'v', [GLYPH_CROSS] = 'x',
+};
+
+static uint8_t glyphSlot[GLYPH_COUNT];
+static uint8_t slotGlyph[GLYPH_SLOTS];
+static uint32_t slotUsed[GLYPH_SLOTS];
+static uint32_t prepareCount = 0;
+static uint32_t uploadCount = 0;
+
+void Glyphs_Init(void)
+{
+    memset(glyphSlot, NO_SLOT, sizeof(glyphSlot));
+    memset(slotGlyph, NO_GLYPH, sizeof(slotGlyph));
+    memset(slotUsed, 0, sizeof(slotUsed));
+    prepareCount = 0;
+    uploadCount = 0;
+}
+
+void Glyphs_Invalidate(void)
+{
+    memset(glyphSlot, NO_SLOT, sizeof(glyphSlot));
+    memset(slotGlyph, NO_GLYPH, sizeof(slotGlyph));
+    memset(slotUsed, 0, sizeof(slotUsed));
+}
+
+/* Free slot first, otherwise the least recently used slot not in pinnedSlots. */
+static uint8_t PickVictim(uint8_t pinnedSlots)
+{
+    uint8_t victim = NO_SLOT;
+
+    for (uint8_t s = 0; s < GLYPH_SLOTS; s++)
+    {
+        if (pinnedSlots & (1U << s)) continue;
+        if (slotGlyph[s] == NO_GLYPH) return s;
+        if (victim == NO_SLOT || slotUsed[s] < slotUsed[victim]) victim = s;
+    }
+    return victim;
+}
+
+HAL_StatusTypeDef Glyphs_Prepare(Display_t *display, uint32_t usedMask)
+{
+    uint8_t pinnedSlots = 0;
+    uint8_t newSlots = 0;
+    uint8_t evicted[GLYPH_SLOTS];
+
+    prepareCount++;
+
+    /* 1) Pin (and touch) everything this frame needs that is already resident. */
+    for (uint8_t g = 0; g < GLYPH_COUNT; g++)
+    {
+        if (!(usedMask & (1UL << g)) || glyphSlot[g] == NO_SLOT) continue;
+        pinnedSlots |= (uint8_t)(1U << glyphSlot[g]);
+        slotUsed[glyphSlot[g]] = prepareCount;
+    }
+
+    /* 2) Assign slots to the missing glyphs. */
+    for (uint8_t g = 0; g < GLYPH_COUNT; g++)
+    {
+        if (!(usedMask & (1UL << g)) || glyphSlot[g] != NO_SLOT) continue;
+
+        uint8_t s = PickVictim(pinnedSlots);
+        if (s == NO_SLOT) continue;              /* > 8 glyphs: g uses its fallback */
+
+        evicted[s] = slotGlyph[s];
+        if (slotGlyph[s] != NO_GLYPH) glyphSlot[slotGlyph[s]] = NO_SLOT;
+
+        slotGlyph[s] = g;
+        glyphSlot[g] = s;
+        slotUsed[s] = prepareCount;
+        pinnedSlots |= (uint8_t)(1U << s);
+        newSlots |= (uint8_t)(1U << s);
+    }
+
+    if (newSlots == 0U) return HAL_OK;
+
+    /*
+     * 3) One burst covering the lowest..highest new slot. Resident slots in
+     *    between are re-sent with their current pattern (cheaper than another
+     *    CGRAM address command); never-used slots get an empty pattern.
+     */
+    uint8_t lo = 0;
+    while (!(newSlots & (1U << lo))) lo++;
+    uint8_t hi = GLYPH_SLOTS - 1U;
+    while (!(newSlots & (1U << hi))) hi--;
+
+    uint8_t patterns[GLYPH_SLOTS][8];
+    uint8_t count = (uint8_t)(hi - lo + 1U);
+    for (uint8_t i = 0; i < count; i++)
+    {
+        uint8_t g = slotGlyph[lo + i];
+        if (g == NO_GLYPH) memset(patterns[i], 0, 8);
+        else memcpy(patterns[i], glyphPatterns[g], 8);
+    }
+
+    HAL_StatusTypeDef st = Display_CreateChars(display, lo, (const uint8_t (*)[8])patterns, count);
+    if (st != HAL_OK)
+    {
+        /* Roll back: the new glyphs are not resident; the evicted ones still are. */
+        for (uint8_t s = 0; s < GLYPH_SLOTS; s++)
+        {
+            if (!(newSlots & (1U << s))) continue;
+            glyphSlot[slotGlyph[s]] = NO_SLOT;
+            slotGlyph[s] = evicted[s];
+            if (evicted[s] != NO_GLYPH) glyphSlot[evicted[s]] = s;
+        }
+        return st;
+    }
+
+    uploadCount += count;
+    return HAL_OK;
+}
+
+uint8_t Glyphs_Code(uint8_t glyph)
+{
+    if (glyph >= GLYPH_COUNT) return (uint8_t)'?';
+    if (glyphSlot[glyph] != NO_SLOT) return glyphSlot[glyph];
+    return (uint8_t)glyphFallback[glyph];
+}
+
+uint32_t Glyphs_UploadCount(void)
+{
+    return uploadCount;
+}
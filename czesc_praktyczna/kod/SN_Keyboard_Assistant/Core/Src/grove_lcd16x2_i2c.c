@@ -1,4 +1,11 @@
 #include "grove_lcd16x2_i2c.h"
+#include "i2c_bus.h"
+#include "timebase.h"
+#include <string.h>
+
+#if GROVE_LCD_ENABLE_BENCHMARK
+#include <stdio.h>
+#endif
 
 /**
  * @file grove_lcd16x2_i2c.c
@@ -11,24 +18,15 @@
  *
  * The command set is HD44780-like (clear, home, entry mode, display control,
  * function set, set DDRAM address, set CGRAM address).
+ *
+ * Data writes are batched: the data-register control byte (Co = 0, RS = 1)
+ * is followed by any number of data bytes, and the controller auto-increments
+ * the DDRAM/CGRAM address after each one. A 16-character row therefore costs
+ * one transaction of 18 bytes instead of 16 transactions of 3 bytes each.
  */
 
-/* Grove LCD "registers" */
-#define GROVE_LCD_REG_CMD   (0x80)
-#define GROVE_LCD_REG_DATA  (0x40)
-
-/* HD44780-like commands */
-#define LCD_CMD_CLEAR           (0x01)
-#define LCD_CMD_HOME            (0x02)
-#define LCD_CMD_ENTRYMODE       (0x04)
+/* HD44780-like commands (the init sequence uses GROVE_LCD_CMD_* from the header) */
 #define LCD_CMD_DISPLAYCTRL     (0x08)
-#define LCD_CMD_FUNCTIONSET     (0x20)
-#define LCD_CMD_SET_DDRAM       (0x80)
-#define LCD_CMD_SET_CGRAM       (0x40)
-
-/* Entry mode flags */
-#define LCD_ENTRY_INC           (0x02)
-#define LCD_ENTRY_SHIFT_OFF     (0x00)
 
 /* Display control flags */
 #define LCD_DISPLAY_ON          (0x04)
@@ -38,10 +36,6 @@
 #define LCD_BLINK_ON            (0x01)
 #define LCD_BLINK_OFF           (0x00)
 
-/* Function set flags */
-#define LCD_2LINE               (0x08)
-#define LCD_5x8DOTS             (0x00)
-
 /**
  * @brief Convert 7-bit I2C address into HAL format (left-shift by 1).
  */
@@ -55,7 +49,9 @@ static inline uint16_t lcd_hal_addr(const GroveLCD_t *lcd)
  */
 static HAL_StatusTypeDef lcd_write_cmd(GroveLCD_t *lcd, uint8_t cmd)
 {
-    return HAL_I2C_Mem_Write(
+    if (!I2cBus_Allow()) return HAL_ERROR;
+
+    HAL_StatusTypeDef st = HAL_I2C_Mem_Write(
         lcd->hi2c,
         lcd_hal_addr(lcd),
         GROVE_LCD_REG_CMD,
@@ -64,6 +60,29 @@ static HAL_StatusTypeDef lcd_write_cmd(GroveLCD_t *lcd, uint8_t cmd)
         1,
         lcd->timeout_ms
     );
+    I2cBus_Report(st);
+    return st;
+}
+
+/**
+ * @brief Low-level helper: stream data bytes to the LCD data register (one transaction).
+ */
+static HAL_StatusTypeDef lcd_write_data_buf(GroveLCD_t *lcd, const uint8_t *buf, uint16_t len)
+{
+    if (len == 0) return HAL_OK;
+    if (!I2cBus_Allow()) return HAL_ERROR;
+
+    HAL_StatusTypeDef st = HAL_I2C_Mem_Write(
+        lcd->hi2c,
+        lcd_hal_addr(lcd),
+        GROVE_LCD_REG_DATA,
+        I2C_MEMADD_SIZE_8BIT,
+        (uint8_t *)buf,   /* HAL API is not const-correct; buffer is only read */
+        len,
+        lcd->timeout_ms
+    );
+    I2cBus_Report(st);
+    return st;
 }
 
 /**
@@ -71,13 +90,24 @@ static HAL_StatusTypeDef lcd_write_cmd(GroveLCD_t *lcd, uint8_t cmd)
  */
 static HAL_StatusTypeDef lcd_write_data(GroveLCD_t *lcd, uint8_t data)
 {
+    return lcd_write_data_buf(lcd, &data, 1);
+}
+
+/**
+ * @brief Low-level helper: write registers of the backlight controller (auto-increment).
+ */
+static HAL_StatusTypeDef rgb_write(GroveLCD_t *lcd, uint8_t addr_7bit, uint8_t reg, const uint8_t *buf, uint16_t len)
+{
+    /* Not reported to the bus tracker: the backlight is optional, a NACK is no bus fault. */
+    if (!I2cBus_Allow()) return HAL_ERROR;
+
     return HAL_I2C_Mem_Write(
         lcd->hi2c,
-        lcd_hal_addr(lcd),
-        GROVE_LCD_REG_DATA,
+        (uint16_t)(addr_7bit << 1),
+        (uint16_t)(reg | GROVE_RGB_AUTO_INC),
         I2C_MEMADD_SIZE_8BIT,
-        &data,
-        1,
+        (uint8_t *)buf,
+        len,
         lcd->timeout_ms
     );
 }
@@ -87,39 +117,40 @@ HAL_StatusTypeDef GroveLCD_Init(GroveLCD_t *lcd, I2C_HandleTypeDef *hi2c, uint8_
     if (lcd == NULL || hi2c == NULL)
         return HAL_ERROR;
 
-    /* Store I2C handle, address and a conservative default timeout. */
+    /* Store I2C handle, address and a timeout that only bounds a hung bus. */
     lcd->hi2c = hi2c;
     lcd->addr_7bit = addr_7bit;
-    lcd->timeout_ms = 50;
+    lcd->timeout_ms = GROVE_LCD_TIMEOUT_MS;
+    lcd->rgb_addr_7bit = 0;
 
     /* Power-up delay */
-    HAL_Delay(50);
+    Timebase_DelayUs(GROVE_LCD_POWERUP_US);
 
     /*
      * Initialization sequence (HD44780-like).
-     * Delays are conservative for reliability across modules.
+     * Delays follow the controller execution times (see GROVE_LCD_EXEC_*_US).
      */
     HAL_StatusTypeDef st;
 
-    st = lcd_write_cmd(lcd, LCD_CMD_HOME);
+    st = lcd_write_cmd(lcd, GROVE_LCD_CMD_HOME);
     if (st != HAL_OK) return st;
-    HAL_Delay(5);
+    Timebase_DelayUs(GROVE_LCD_EXEC_LONG_US);
 
-    st = lcd_write_cmd(lcd, LCD_CMD_FUNCTIONSET | LCD_2LINE | LCD_5x8DOTS); // 0x28
+    st = lcd_write_cmd(lcd, GROVE_LCD_CMD_FUNCTION_2LINE);
     if (st != HAL_OK) return st;
-    HAL_Delay(1);
+    Timebase_DelayUs(GROVE_LCD_EXEC_SHORT_US);
 
-    st = lcd_write_cmd(lcd, LCD_CMD_DISPLAYCTRL | LCD_DISPLAY_ON | LCD_CURSOR_OFF | LCD_BLINK_OFF); // 0x0C
+    st = lcd_write_cmd(lcd, GROVE_LCD_CMD_DISPLAY_ON);
     if (st != HAL_OK) return st;
-    HAL_Delay(1);
+    Timebase_DelayUs(GROVE_LCD_EXEC_SHORT_US);
 
-    st = lcd_write_cmd(lcd, LCD_CMD_CLEAR);
+    st = lcd_write_cmd(lcd, GROVE_LCD_CMD_CLEAR);
     if (st != HAL_OK) return st;
-    HAL_Delay(3);
+    Timebase_DelayUs(GROVE_LCD_EXEC_LONG_US);
 
-    st = lcd_write_cmd(lcd, LCD_CMD_ENTRYMODE | LCD_ENTRY_INC | LCD_ENTRY_SHIFT_OFF); // 0x06
+    st = lcd_write_cmd(lcd, GROVE_LCD_CMD_ENTRY_INC);
     if (st != HAL_OK) return st;
-    HAL_Delay(1);
+    Timebase_DelayUs(GROVE_LCD_EXEC_SHORT_US);
 
     return HAL_OK;
 }
@@ -127,16 +158,16 @@ HAL_StatusTypeDef GroveLCD_Init(GroveLCD_t *lcd, I2C_HandleTypeDef *hi2c, uint8_
 HAL_StatusTypeDef GroveLCD_Clear(GroveLCD_t *lcd)
 {
     /* Clear requires a longer execution time on the LCD controller. */
-    HAL_StatusTypeDef st = lcd_write_cmd(lcd, LCD_CMD_CLEAR);
-    HAL_Delay(3);
+    HAL_StatusTypeDef st = lcd_write_cmd(lcd, GROVE_LCD_CMD_CLEAR);
+    Timebase_DelayUs(GROVE_LCD_EXEC_LONG_US);
     return st;
 }
 
 HAL_StatusTypeDef GroveLCD_Home(GroveLCD_t *lcd)
 {
     /* Home requires a longer execution time on the LCD controller. */
-    HAL_StatusTypeDef st = lcd_write_cmd(lcd, LCD_CMD_HOME);
-    HAL_Delay(3);
+    HAL_StatusTypeDef st = lcd_write_cmd(lcd, GROVE_LCD_CMD_HOME);
+    Timebase_DelayUs(GROVE_LCD_EXEC_LONG_US);
     return st;
 }
 
@@ -147,9 +178,7 @@ HAL_StatusTypeDef GroveLCD_SetCursor(GroveLCD_t *lcd, uint8_t row, uint8_t col)
      * row 0 -> 0x00..0x0F
      * row 1 -> 0x40..0x4F
      */
-    uint8_t base = (row == 0) ? 0x00 : 0x40;
-    uint8_t addr = (uint8_t)(base + (col & 0x0F));
-    return lcd_write_cmd(lcd, (uint8_t)(LCD_CMD_SET_DDRAM | addr));
+    return lcd_write_cmd(lcd, GroveLCD_CursorCmd(row, col));
 }
 
 HAL_StatusTypeDef GroveLCD_WriteChar(GroveLCD_t *lcd, char c)
@@ -161,39 +190,127 @@ HAL_StatusTypeDef GroveLCD_Print(GroveLCD_t *lcd, const char *s)
 {
     if (lcd == NULL || s == NULL) return HAL_ERROR;
 
-    HAL_StatusTypeDef st = HAL_OK;
-    while (*s)
-    {
-        st = lcd_write_data(lcd, (uint8_t)*s++);
-        if (st != HAL_OK) return st;
-    }
-    return HAL_OK;
+    return lcd_write_data_buf(lcd, (const uint8_t *)s, (uint16_t)strlen(s));
+}
+
+HAL_StatusTypeDef GroveLCD_WriteBuffer(GroveLCD_t *lcd, const uint8_t *buf, uint16_t len)
+{
+    if (lcd == NULL || buf == NULL) return HAL_ERROR;
+
+    return lcd_write_data_buf(lcd, buf, len);
+}
+
+HAL_StatusTypeDef GroveLCD_WriteRow(GroveLCD_t *lcd, uint8_t row, const char *text)
+{
+    if (lcd == NULL || text == NULL) return HAL_ERROR;
+
+    /* Pad / clip to exactly one row so stale characters are overwritten. */
+    uint8_t line[GROVE_LCD_COLS];
+    uint8_t i = 0;
+    for (; i < GROVE_LCD_COLS && text[i] != '\0'; i++) line[i] = (uint8_t)text[i];
+    for (; i < GROVE_LCD_COLS; i++) line[i] = ' ';
+
+    HAL_StatusTypeDef st = GroveLCD_SetCursor(lcd, row, 0);
+    if (st != HAL_OK) return st;
+    return lcd_write_data_buf(lcd, line, GROVE_LCD_COLS);
 }
 
 HAL_StatusTypeDef GroveLCD_CreateChar(GroveLCD_t *lcd, uint8_t slot, const uint8_t pattern[8])
 {
-    if (lcd == NULL || pattern == NULL) return HAL_ERROR;
-    if (slot > 7) return HAL_ERROR;
+    if (pattern == NULL) return HAL_ERROR;
 
-    /* 1) Set CGRAM address: 0x40 | (slot * 8) */
-    uint8_t cmd = (uint8_t)(LCD_CMD_SET_CGRAM | ((slot & 0x07) << 3));
+    return GroveLCD_CreateChars(lcd, slot, (const uint8_t (*)[8])pattern, 1);
+}
+
+HAL_StatusTypeDef GroveLCD_CreateChars(GroveLCD_t *lcd, uint8_t firstSlot,
+                                       const uint8_t patterns[][8], uint8_t count)
+{
+    if (lcd == NULL || patterns == NULL) return HAL_ERROR;
+    if (count == 0 || firstSlot > 7 || (uint8_t)(firstSlot + count) > 8) return HAL_ERROR;
+
+    /* 1) Set CGRAM address: 0x40 | (slot * 8); it auto-increments across slots */
+    uint8_t cmd = (uint8_t)(GROVE_LCD_CMD_SET_CGRAM | ((firstSlot & 0x07) << 3));
     HAL_StatusTypeDef st = lcd_write_cmd(lcd, cmd);
     if (st != HAL_OK) return st;
 
-    /* 2) Write 8 rows (only lower 5 bits are used by the character generator) */
-    for (uint8_t i = 0; i < 8; i++)
+    /* 2) All rows in one burst (only lower 5 bits are used by the character generator) */
+    uint8_t rows[8 * 8];
+    uint16_t n = 0;
+    for (uint8_t c = 0; c < count; c++)
     {
-        uint8_t row = (uint8_t)(pattern[i] & 0x1F);
-        st = lcd_write_data(lcd, row);
-        if (st != HAL_OK) return st;
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            rows[n++] = (uint8_t)(patterns[c][i] & 0x1F);
+        }
     }
+    st = lcd_write_data_buf(lcd, rows, n);
+    if (st != HAL_OK) return st;
 
     /* 3) Return to DDRAM (recommended after CGRAM write) */
-    st = lcd_write_cmd(lcd, LCD_CMD_SET_DDRAM);
-    HAL_Delay(1);
+    st = lcd_write_cmd(lcd, GROVE_LCD_CMD_SET_DDRAM);
+    Timebase_DelayUs(GROVE_LCD_EXEC_SHORT_US);
     return st;
 }
 
+/* --- RGB backlight (second I2C device on the module) --- */
+
+HAL_StatusTypeDef GroveLCD_InitBacklight(GroveLCD_t *lcd, uint8_t rgb_addr_7bit)
+{
+    if (lcd == NULL || lcd->hi2c == NULL) return HAL_ERROR;
+
+    lcd->rgb_addr_7bit = 0;
+
+    /* MODE1: oscillator on (leave sleep); MODE2: defaults. */
+    static const uint8_t modes[2] = { 0x00, 0x00 };
+    HAL_StatusTypeDef st = rgb_write(lcd, rgb_addr_7bit, GROVE_RGB_REG_MODE1, modes, sizeof(modes));
+    if (st != HAL_OK) return st;
+
+    /* LEDOUT: every output driven by its own PWM register. */
+    static const uint8_t ledout = 0xAA;
+    st = rgb_write(lcd, rgb_addr_7bit, GROVE_RGB_REG_LEDOUT, &ledout, 1);
+    if (st != HAL_OK) return st;
+
+    lcd->rgb_addr_7bit = rgb_addr_7bit;
+    return GroveLCD_SetRGB(lcd, 255, 255, 255);
+}
+
+HAL_StatusTypeDef GroveLCD_SetRGB(GroveLCD_t *lcd, uint8_t r, uint8_t g, uint8_t b)
+{
+    if (lcd == NULL || lcd->rgb_addr_7bit == 0U) return HAL_ERROR;
+
+    uint8_t pwm[3];
+    GroveLCD_RgbPayload(r, g, b, pwm);
+    return rgb_write(lcd, lcd->rgb_addr_7bit, GROVE_RGB_REG_PWM_BLUE, pwm, sizeof(pwm));
+}
+
+#if GROVE_LCD_ENABLE_BENCHMARK
+void GroveLCD_Benchmark(GroveLCD_t *lcd)
+{
+    static const char text[] = "0123456789ABCDEF";
+    uint32_t t0, perByteUs, burstUs;
+
+    /* Per-byte path: one transaction per character (previous GroveLCD_Print). */
+    GroveLCD_SetCursor(lcd, 0, 0);
+    t0 = Timebase_Micros();
+    for (uint8_t i = 0; i < GROVE_LCD_COLS; i++) {
+        lcd_write_data(lcd, (uint8_t)text[i]);
+    }
+    perByteUs = Timebase_Micros() - t0;
+
+    /* Burst path: one transaction for the whole row. */
+    GroveLCD_SetCursor(lcd, 0, 0);
+    t0 = Timebase_Micros();
+    lcd_write_data_buf(lcd, (const uint8_t *)text, GROVE_LCD_COLS);
+    burstUs = Timebase_Micros() - t0;
+
+    printf("GroveLCD 16 chars: per-byte %lu us, burst %lu us\r\n",
+           (unsigned long)perByteUs, (unsigned long)burstUs);
+
+    /* Leave the panel blank, as the framebuffer (LcdFb_Init()) expects it */
+    GroveLCD_Clear(lcd);
+}
+#endif
+
 /* --- Optional helpers (display/cursor/blink) --- */
 
 HAL_StatusTypeDef GroveLCD_DisplayOn(GroveLCD_t *lcd)
@@ -0,0 +1,106 @@
+#include "held_notes.h"
+#include <string.h>
+
+/**
+ * @file held_notes.c
+ * @brief Held-key state (see held_notes.h).
+ *
+ * Only the main loop calls into this module, so no locking is needed.
+ * Onsets are compared with signed differences, which is wrap-safe for a
+ * 32-bit microsecond clock as long as keys are not held for 35 minutes.
+ */
+
+static NoteMask128_t held;
+static uint32_t onset[128];
+static uint8_t pcHeld[12];       /* held keys per pitch class */
+static uint32_t pcOnset[12];     /* latest onset among them */
+static uint16_t heldPcs = 0;
+static uint8_t heldCount = 0;
+
+void HeldNotes_Reset(void)
+{
+    NoteMask_Clear(&held);
+    memset(pcHeld, 0, sizeof(pcHeld));
+    heldPcs = 0;
+    heldCount = 0;
+}
+
+void HeldNotes_On(uint8_t note, uint32_t t_us)
+{
+    if (note > 127U) return;
+
+    uint8_t pc = (uint8_t)(note % 12U);
+    if (!NoteMask_Test(&held, note))
+    {
+        NoteMask_Set(&held, note);
+        pcHeld[pc]++;
+        heldCount++;
+        heldPcs |= (uint16_t)(1U << pc);
+    }
+
+    onset[note] = t_us;
+    pcOnset[pc] = t_us;    /* newest key of its pitch class */
+}
+
+void HeldNotes_Off(uint8_t note)
+{
+    if (note > 127U || !NoteMask_Test(&held, note)) return;
+
+    uint8_t pc = (uint8_t)(note % 12U);
+    NoteMask_Reset(&held, note);
+    heldCount--;
+
+    if (--pcHeld[pc] == 0U) {
+        heldPcs &= (uint16_t)~(1U << pc);
+        return;
+    }
+
+    /* Another octave of this pitch class is still down: its latest onset counts now. */
+    bool first = true;
+    for (uint8_t n = pc; n < 128U; n = (uint8_t)(n + 12U))
+    {
+        if (!NoteMask_Test(&held, n)) continue;
+        if (first || (int32_t)(onset[n] - pcOnset[pc]) > 0) pcOnset[pc] = onset[n];
+        first = false;
+    }
+}
+
+const NoteMask128_t *HeldNotes_Mask(void)
+{
+    return &held;
+}
+
+uint16_t HeldNotes_PitchClasses(void)
+{
+    return heldPcs;
+}
+
+uint8_t HeldNotes_Count(void)
+{
+    return heldCount;
+}
+
+uint32_t HeldNotes_Onset(uint8_t note)
+{
+    return onset[note & 0x7FU];
+}
+
+bool HeldNotes_Spread(uint16_t pcs, uint32_t *spread_us)
+{
+    pcs &= PC_MASK_ALL;
+    if (pcs == 0U || (pcs & (uint16_t)~heldPcs) != 0U) return false;
+
+    uint32_t ref = pcOnset[__builtin_ctz(pcs)];
+    int32_t lo = 0;
+    int32_t hi = 0;
+
+    for (uint32_t bits = pcs; bits != 0U; bits &= bits - 1U)
+    {
+        int32_t d = (int32_t)(pcOnset[__builtin_ctz(bits)] - ref);
+        if (d < lo) lo = d;
+        if (d > hi) hi = d;
+    }
+
+    if (spread_us != NULL) *spread_us = (uint32_t)(hi - lo);
+    return true;
+}
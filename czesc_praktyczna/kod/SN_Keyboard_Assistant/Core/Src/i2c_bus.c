@@ -0,0 +1,152 @@
+#include "i2c_bus.h"
+#include "timebase.h"
+
+/**
+ * @file i2c_bus.c
+ * @brief I2C1 bus health tracking (see i2c_bus.h).
+ *
+ * 'breakerOpen', 'consecutive' and the counters are written from the I2C/DMA
+ * interrupts (I2cBus_Report()) and from the main loop; every write is a
+ * single aligned word, and the main loop only acts on the breaker state.
+ */
+
+/* Half period of the recovery clock: 5 us = 100 kHz, the bus speed. */
+#define RECOVERY_HALF_PERIOD_US   (5U)
+
+/* A slave holding SDA releases it after at most 8 data bits + ACK. */
+#define RECOVERY_MAX_PULSES       (9U)
+
+static I2C_HandleTypeDef *bus = NULL;
+static uint8_t probeAddr = 0;
+
+static volatile bool breakerOpen = false;
+static volatile uint32_t consecutive = 0;
+static volatile uint32_t nextProbeMs = 0;
+static uint32_t backoffMs = I2C_BUS_PROBE_MIN_MS;
+static I2cBusStats_t stats;
+
+void I2cBus_Init(I2C_HandleTypeDef *hi2c, uint8_t probe_addr_7bit)
+{
+    bus = hi2c;
+    probeAddr = probe_addr_7bit;
+    breakerOpen = false;
+    consecutive = 0;
+    backoffMs = I2C_BUS_PROBE_MIN_MS;
+    stats = (I2cBusStats_t){0};
+}
+
+bool I2cBus_Allow(void)
+{
+    return !breakerOpen;
+}
+
+/* Opens the breaker; the first probe follows after delayMs. */
+static void OpenBreaker(uint32_t delayMs)
+{
+    nextProbeMs = HAL_GetTick() + delayMs;
+    if (!breakerOpen) stats.trips++;
+    breakerOpen = true;
+}
+
+void I2cBus_Report(HAL_StatusTypeDef st)
+{
+    if (bus == NULL) return;
+
+    if (st == HAL_OK) {
+        consecutive = 0;
+        return;
+    }
+
+    stats.failures++;
+    consecutive++;
+    if (!breakerOpen && consecutive >= I2C_BUS_FAIL_THRESHOLD) OpenBreaker(backoffMs);
+}
+
+void I2cBus_Trip(void)
+{
+    if (bus == NULL) return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    OpenBreaker(0);
+    __set_PRIMASK(primask);
+}
+
+bool I2cBus_Process(void)
+{
+    if (bus == NULL || !breakerOpen) return false;
+    if ((int32_t)(HAL_GetTick() - nextProbeMs) < 0) return false;
+
+    (void)I2cBus_Recover();
+
+    if (HAL_I2C_IsDeviceReady(bus, (uint16_t)(probeAddr << 1), 1, I2C_BUS_PROBE_TIMEOUT_MS) == HAL_OK) {
+        consecutive = 0;
+        backoffMs = I2C_BUS_PROBE_MIN_MS;
+        stats.recoveries++;
+        breakerOpen = false;
+        return true;
+    }
+
+    /* Still gone: back off so a missing display costs almost nothing. */
+    backoffMs = (backoffMs >= I2C_BUS_PROBE_MAX_MS / 2U) ? I2C_BUS_PROBE_MAX_MS : backoffMs * 2U;
+    nextProbeMs = HAL_GetTick() + backoffMs;
+    return false;
+}
+
+static void LineWrite(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState level)
+{
+    HAL_GPIO_WritePin(port, pin, level);
+    Timebase_DelayUs(RECOVERY_HALF_PERIOD_US);
+}
+
+HAL_StatusTypeDef I2cBus_Recover(void)
+{
+    if (bus == NULL) return HAL_ERROR;
+
+    /* Releases the pins, the DMA channel and the interrupts (HAL_I2C_MspDeInit()). */
+    HAL_I2C_DeInit(bus);
+
+    /* Both lines as open-drain GPIOs, released (high). The pull-ups keep
+       them defined when the module, and its pull-ups, are unplugged. */
+    GPIO_InitTypeDef gpio = {0};
+    gpio.Mode = GPIO_MODE_OUTPUT_OD;
+    gpio.Pull = GPIO_PULLUP;
+    gpio.Speed = GPIO_SPEED_FREQ_LOW;
+
+    HAL_GPIO_WritePin(I2C_BUS_SCL_GPIO_Port, I2C_BUS_SCL_Pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(I2C_BUS_SDA_GPIO_Port, I2C_BUS_SDA_Pin, GPIO_PIN_SET);
+    gpio.Pin = I2C_BUS_SCL_Pin;
+    HAL_GPIO_Init(I2C_BUS_SCL_GPIO_Port, &gpio);
+    gpio.Pin = I2C_BUS_SDA_Pin;
+    HAL_GPIO_Init(I2C_BUS_SDA_GPIO_Port, &gpio);
+    Timebase_DelayUs(RECOVERY_HALF_PERIOD_US);
+
+    /* Clock out whatever byte the slave is still sending. */
+    for (uint8_t i = 0; i < RECOVERY_MAX_PULSES; i++)
+    {
+        if (HAL_GPIO_ReadPin(I2C_BUS_SDA_GPIO_Port, I2C_BUS_SDA_Pin) == GPIO_PIN_SET) break;
+        LineWrite(I2C_BUS_SCL_GPIO_Port, I2C_BUS_SCL_Pin, GPIO_PIN_RESET);
+        LineWrite(I2C_BUS_SCL_GPIO_Port, I2C_BUS_SCL_Pin, GPIO_PIN_SET);
+    }
+
+    /* STOP: SDA rises while SCL is high; every slave returns to idle. */
+    LineWrite(I2C_BUS_SCL_GPIO_Port, I2C_BUS_SCL_Pin, GPIO_PIN_RESET);
+    LineWrite(I2C_BUS_SDA_GPIO_Port, I2C_BUS_SDA_Pin, GPIO_PIN_RESET);
+    LineWrite(I2C_BUS_SCL_GPIO_Port, I2C_BUS_SCL_Pin, GPIO_PIN_SET);
+    LineWrite(I2C_BUS_SDA_GPIO_Port, I2C_BUS_SDA_Pin, GPIO_PIN_SET);
+
+    bool released = (HAL_GPIO_ReadPin(I2C_BUS_SDA_GPIO_Port, I2C_BUS_SDA_Pin) == GPIO_PIN_SET);
+
+    /* Same settings as MX_I2C1_Init() (kept in bus->Init); MspInit restores pins and DMA. */
+    HAL_StatusTypeDef st = HAL_I2C_Init(bus);
+    if (st == HAL_OK) st = HAL_I2CEx_ConfigAnalogFilter(bus, I2C_ANALOGFILTER_ENABLE);
+    if (st == HAL_OK) st = HAL_I2CEx_ConfigDigitalFilter(bus, 0);
+    if (st != HAL_OK) return st;
+
+    return released ? HAL_OK : HAL_BUSY;
+}
+
+I2cBusStats_t I2cBus_Stats(void)
+{
+    return stats;
+}
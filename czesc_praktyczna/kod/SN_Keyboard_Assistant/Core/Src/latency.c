@@ -0,0 +1,155 @@
+#include "latency.h"
+#include <stdio.h>   /* printf() over SWV/ITM */
+#include <string.h>
+
+/**
+ * @file latency.c
+ * @brief Stage histograms for the input-to-feedback path (see latency.h).
+ *
+ * Cost per recorded stage: one DWT read, one CLZ and a few increments, so the
+ * instrumentation is left enabled in normal builds.
+ */
+
+static LatencyHistogram_t histograms[LAT_STAGE_COUNT];
+
+static const char *const stageNames[LAT_STAGE_COUNT] = {
+    "DEQ", "EVAL", "LED", "LCD"
+};
+
+/* Currently open event: origin timestamp and stages already recorded. */
+static bool eventOpen = false;
+static uint32_t eventOrigin = 0;
+static uint8_t eventMarked = 0;
+
+/* Map a cycle count to its log2 bucket (0 -> 0, [2^(i-1), 2^i) -> i). */
+static uint32_t BucketOf(uint32_t cycles)
+{
+    uint32_t b = 32U - __CLZ(cycles);
+    return (b < LATENCY_BUCKETS) ? b : (LATENCY_BUCKETS - 1U);
+}
+
+static void Record(LatencyStage stage, uint32_t cycles)
+{
+    LatencyHistogram_t *h = &histograms[stage];
+
+    if (h->count == 0U || cycles < h->minCycles) h->minCycles = cycles;
+    if (cycles > h->maxCycles) h->maxCycles = cycles;
+    h->count++;
+    h->bucket[BucketOf(cycles)]++;
+}
+
+void Latency_Init(void)
+{
+    /* Enable trace and the cycle counter (also works without a debugger attached). */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    Latency_Reset();
+}
+
+void Latency_Reset(void)
+{
+    memset(histograms, 0, sizeof(histograms));
+    eventOpen = false;
+    eventMarked = 0;
+}
+
+void Latency_BeginEvent(uint32_t urbStamp)
+{
+    eventOpen = true;
+    eventOrigin = urbStamp;
+    eventMarked = 0;
+    Latency_Mark(LAT_STAGE_DEQUEUED);
+}
+
+void Latency_Mark(LatencyStage stage)
+{
+    if (!eventOpen || stage >= LAT_STAGE_COUNT) return;
+
+    uint8_t bit = (uint8_t)(1U << stage);
+    if (eventMarked & bit) return;
+    eventMarked |= bit;
+
+    Record(stage, Latency_Now() - eventOrigin);
+}
+
+bool Latency_Defer(LatencyStage stage, uint32_t *origin)
+{
+    if (!eventOpen || stage >= LAT_STAGE_COUNT || origin == NULL) return false;
+
+    uint8_t bit = (uint8_t)(1U << stage);
+    if (eventMarked & bit) return false;
+    eventMarked |= bit;
+
+    *origin = eventOrigin;
+    return true;
+}
+
+void Latency_RecordSince(LatencyStage stage, uint32_t origin)
+{
+    if (stage >= LAT_STAGE_COUNT) return;
+    Record(stage, Latency_Now() - origin);
+}
+
+void Latency_EndEvent(void)
+{
+    eventOpen = false;
+}
+
+const LatencyHistogram_t *Latency_GetHistogram(LatencyStage stage)
+{
+    if (stage >= LAT_STAGE_COUNT) return NULL;
+    return &histograms[stage];
+}
+
+const char *Latency_StageName(LatencyStage stage)
+{
+    if (stage >= LAT_STAGE_COUNT) return "?";
+    return stageNames[stage];
+}
+
+uint32_t Latency_PercentileUs(LatencyStage stage, uint8_t percent)
+{
+    if (stage >= LAT_STAGE_COUNT || percent == 0U) return 0;
+
+    const LatencyHistogram_t *h = &histograms[stage];
+    if (h->count == 0U) return 0;
+    if (percent > 100U) percent = 100U;
+
+    /* Rank of the requested sample (1-based, rounded up). */
+    uint32_t rank = (uint32_t)(((uint64_t)h->count * percent + 99U) / 100U);
+    uint32_t seen = 0;
+    uint32_t edge = h->maxCycles;
+
+    for (uint32_t i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += h->bucket[i];
+        if (seen >= rank) {
+            edge = (i == 0U) ? 0U : ((i >= 31U) ? 0xFFFFFFFFUL : (1UL << i));
+            break;
+        }
+    }
+    if (edge > h->maxCycles) edge = h->maxCycles;
+
+    uint32_t cyclesPerUs = SystemCoreClock / 1000000UL;
+    if (cyclesPerUs == 0U) cyclesPerUs = 1U;
+    return edge / cyclesPerUs;
+}
+
+void Latency_Dump(void)
+{
+    for (uint32_t s = 0; s < LAT_STAGE_COUNT; s++) {
+        const LatencyHistogram_t *h = &histograms[s];
+
+        printf("LAT %s hz=%lu n=%lu min=%lu max=%lu h=",
+               stageNames[s],
+               (unsigned long)SystemCoreClock,
+               (unsigned long)h->count,
+               (unsigned long)h->minCycles,
+               (unsigned long)h->maxCycles);
+
+        for (uint32_t i = 0; i < LATENCY_BUCKETS; i++) {
+            printf((i + 1U < LATENCY_BUCKETS) ? "%lu," : "%lu\r\n", (unsigned long)h->bucket[i]);
+        }
+    }
+}
@@ -0,0 +1,192 @@
+#include "lcd_framebuffer.h"
+#include <stdbool.h>
+#include <string.h>
+
+/**
+ * @file lcd_framebuffer.c
+ * @brief Shadow framebuffer for the 16x2 LCD (see lcd_framebuffer.h).
+ *
+ * Two buffers are kept:
+ * - frame[][] : what the UI wants to show (written by LcdFb_* calls);
+ *               codes below 0x20 are glyph IDs
+ * - panel[][] : bytes last handed to the display (CGRAM slots or ASCII)
+ *
+ * A frame cell is compared with the panel after resolving glyph IDs to their
+ * current slot. If a slot is re-uploaded with a different glyph, cells that
+ * still show the old glyph are not wanted by the new frame, so they differ
+ * and get rewritten in the same flush.
+ *
+ * fullRedraw forces every cell to be treated as changed (unknown panel state,
+ * e.g. after the display reported lost writes).
+ *
+ * Has no HAL dependencies, so it also builds on the host (Tools/display_bench.c).
+ */
+
+static Display_t *fbDisplay = NULL;
+
+static uint8_t frame[LCDFB_ROWS][LCDFB_COLS];
+static uint8_t panel[LCDFB_ROWS][LCDFB_COLS];
+static bool fullRedraw = false;
+
+/* Glyph set given by LcdFb_Load(); valid until the frame is edited cell by cell. */
+static uint32_t loadedGlyphs = 0;
+static bool glyphsKnown = false;
+
+static uint8_t curRow = 0;
+static uint8_t curCol = 0;
+
+#define GLYPH_CODE_LIMIT   (0x20U)
+
+/* Byte that represents a frame cell on the panel. */
+static uint8_t Resolve(uint8_t cell)
+{
+    return (cell < GLYPH_CODE_LIMIT) ? Glyphs_Code(cell) : cell;
+}
+
+/* Returns true if a cell must be (re)sent. */
+static bool CellDirty(uint8_t row, uint8_t col)
+{
+    return fullRedraw || (Resolve(frame[row][col]) != panel[row][col]);
+}
+
+/* Writes frame[row][first..last] as one address command + data burst. */
+static HAL_StatusTypeDef SendRun(uint8_t row, uint8_t first, uint8_t last)
+{
+    uint8_t out[LCDFB_COLS];
+    uint8_t len = (uint8_t)(last - first + 1U);
+
+    for (uint8_t i = 0; i < len; i++) out[i] = Resolve(frame[row][first + i]);
+
+    HAL_StatusTypeDef st = Display_WriteAt(fbDisplay, row, first, out, len);
+    if (st != HAL_OK) return st;
+
+    memcpy(&panel[row][first], out, len);
+    return HAL_OK;
+}
+
+/* Bit g set for every glyph g in the frame. */
+static uint32_t GlyphsInFrame(void)
+{
+    uint32_t mask = 0;
+    for (uint8_t row = 0; row < LCDFB_ROWS; row++) {
+        for (uint8_t col = 0; col < LCDFB_COLS; col++) {
+            if (frame[row][col] < GLYPH_COUNT) mask |= (1UL << frame[row][col]);
+        }
+    }
+    return mask;
+}
+
+void LcdFb_Init(Display_t *display)
+{
+    fbDisplay = display;
+
+    /* GroveLCD_Init() ends with a clear command: the panel shows spaces. */
+    memset(panel, ' ', sizeof(panel));
+    fullRedraw = false;
+    Glyphs_Init();
+    LcdFb_Clear();
+}
+
+void LcdFb_Clear(void)
+{
+    memset(frame, ' ', sizeof(frame));
+    glyphsKnown = false;
+    curRow = 0;
+    curCol = 0;
+}
+
+void LcdFb_ClearRow(uint8_t row)
+{
+    if (row >= LCDFB_ROWS) return;
+    memset(frame[row], ' ', LCDFB_COLS);
+    glyphsKnown = false;
+}
+
+void LcdFb_SetCursor(uint8_t row, uint8_t col)
+{
+    curRow = (row < LCDFB_ROWS) ? row : (LCDFB_ROWS - 1U);
+    curCol = col;
+}
+
+void LcdFb_WriteChar(char c)
+{
+    if (curCol >= LCDFB_COLS) return;
+    frame[curRow][curCol++] = (uint8_t)c;
+    glyphsKnown = false;
+}
+
+void LcdFb_WriteGlyph(GlyphId glyph)
+{
+    LcdFb_WriteChar((char)glyph);
+}
+
+void LcdFb_Print(const char *s)
+{
+    if (s == NULL) return;
+    while (*s && curCol < LCDFB_COLS) {
+        frame[curRow][curCol++] = (uint8_t)*s++;
+    }
+    glyphsKnown = false;
+}
+
+void LcdFb_Load(const uint8_t cells[LCDFB_ROWS][LCDFB_COLS], uint32_t glyphMask)
+{
+    memcpy(frame, cells, sizeof(frame));
+    loadedGlyphs = glyphMask;
+    glyphsKnown = true;
+    curRow = 0;
+    curCol = 0;
+}
+
+HAL_StatusTypeDef LcdFb_Flush(void)
+{
+    if (fbDisplay == NULL) return HAL_ERROR;
+
+    if (Display_TakeErrors(fbDisplay) != 0U) LcdFb_Invalidate();
+
+    /* CGRAM first, so the cells below can refer to the final slots. */
+    HAL_StatusTypeDef st = Glyphs_Prepare(fbDisplay, glyphsKnown ? loadedGlyphs : GlyphsInFrame());
+    if (st != HAL_OK) return st;
+
+    for (uint8_t row = 0; row < LCDFB_ROWS; row++)
+    {
+        uint8_t col = 0;
+        while (col < LCDFB_COLS)
+        {
+            if (!CellDirty(row, col)) {
+                col++;
+                continue;
+            }
+
+            /* Extend the run while the next dirty cell is within the merge gap. */
+            uint8_t first = col;
+            uint8_t last = col;
+            uint8_t probe = (uint8_t)(col + 1U);
+            while (probe < LCDFB_COLS && (uint8_t)(probe - last) <= (LCDFB_MERGE_GAP + 1U))
+            {
+                if (CellDirty(row, probe)) last = probe;
+                probe++;
+            }
+
+            st = SendRun(row, first, last);
+            if (st != HAL_OK) return st;
+
+            col = (uint8_t)(last + 1U);
+        }
+    }
+
+    fullRedraw = false;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef LcdFb_Fence(DisplayCallback callback, void *arg)
+{
+    if (fbDisplay == NULL) return HAL_ERROR;
+    return Display_Fence(fbDisplay, callback, arg);
+}
+
+void LcdFb_Invalidate(void)
+{
+    fullRedraw = true;
+    Glyphs_Invalidate();
+}
@@ -1,75 +1,172 @@
 #include "main.h"
 #include "lcd_hd44780.h"
-#include "stm32l4xx_hal.h"
-
-/* --- proste opóźnienie w us (dla LCD wystarczy) --- */
-static void lcd_delay_us(volatile uint32_t us)
+#include "timebase.h"
+
+/**
+ * @file lcd_hd44780.c
+ * @brief Parallel HD44780 driver (see lcd_hd44780.h).
+ *
+ * Timing (HD44780U datasheet, 5 V, with margin):
+ * - E pulse width >= 450 ns, E cycle >= 1000 ns,
+ * - command / data execution 37 us, clear / home 1.52 ms.
+ *
+ * All waits use the TIM2 microsecond timebase, so they do not depend on the
+ * core clock. Timebase_DelayUs(n) guarantees more than n-1 us, therefore the
+ * sub-microsecond E timings use 2.
+ *
+ * Per character this costs 2 nibbles (~6 us) + execution time: ~45 us with
+ * fixed delays, or only as long as the controller is actually busy when the
+ * busy flag is polled (previously ~154 us: 50 us after every nibble and byte).
+ */
+
+#define LCD_T_E_US            (2U)      /* E high / low phase (>= 450 ns)  */
+#define LCD_EXEC_US           (40U)     /* most commands and data: 37 us   */
+#define LCD_EXEC_LONG_US      (1600U)   /* clear / home: 1.52 ms           */
+#define LCD_POWERUP_US        (50000U)  /* > 40 ms after VDD rises         */
+#define LCD_BUSY_TIMEOUT_US   (5000U)   /* give up if the panel never answers */
+
+#define LCD_CMD_CLEAR         (0x01)
+#define LCD_CMD_HOME          (0x02)
+#define LCD_CMD_SET_CGRAM     (0x40)
+#define LCD_CMD_SET_DDRAM     (0x80)
+
+#define LCD_DATA_MASK         (0x0FUL << LCD_DATA_PIN_POS)
+
+/* Put a nibble on D4..D7 in one store: set bits in BSRR[15:0], reset bits in BSRR[31:16]. */
+static inline void lcd_put_nibble(uint8_t nibble)
 {
-    while (us--)
-    {
-        /* ~1us-ish przy typowych zegarach; LCD nie jest wymagający */
-        for (volatile uint32_t i = 0; i < 8; i++) { __NOP(); }
-    }
+    uint32_t set = ((uint32_t)nibble & 0x0FU) << LCD_DATA_PIN_POS;
+    LCD_DATA_GPIO_Port->BSRR = set | ((LCD_DATA_MASK & ~set) << 16);
 }
 
-/* Impuls E: min ~450ns, dajemy kilka us */
 static void lcd_pulse_enable(void)
 {
-    HAL_GPIO_WritePin(LCD_E_GPIO_Port, LCD_E_Pin, GPIO_PIN_SET);
-    lcd_delay_us(2);
-    HAL_GPIO_WritePin(LCD_E_GPIO_Port, LCD_E_Pin, GPIO_PIN_RESET);
-    lcd_delay_us(50);  // czas na “zlapanie” danych
+    LCD_E_GPIO_Port->BSRR = LCD_E_Pin;
+    Timebase_DelayUs(LCD_T_E_US);
+    LCD_E_GPIO_Port->BRR = LCD_E_Pin;
+    Timebase_DelayUs(LCD_T_E_US);
 }
 
-/* >>> NAJWAŻNIEJSZA POPRAWKA: bit0->D4 ... bit3->D7 <<< */
+/* bit0 -> D4 ... bit3 -> D7 */
 static void lcd_write4(uint8_t nibble)
 {
-    HAL_GPIO_WritePin(LCD_D4_GPIO_Port, LCD_D4_Pin, (nibble & 0x01) ? GPIO_PIN_SET : GPIO_PIN_RESET);
-    HAL_GPIO_WritePin(LCD_D5_GPIO_Port, LCD_D5_Pin, (nibble & 0x02) ? GPIO_PIN_SET : GPIO_PIN_RESET);
-    HAL_GPIO_WritePin(LCD_D6_GPIO_Port, LCD_D6_Pin, (nibble & 0x04) ? GPIO_PIN_SET : GPIO_PIN_RESET);
-    HAL_GPIO_WritePin(LCD_D7_GPIO_Port, LCD_D7_Pin, (nibble & 0x08) ? GPIO_PIN_SET : GPIO_PIN_RESET);
-
+    lcd_put_nibble(nibble);
     lcd_pulse_enable();
 }
 
-static void lcd_send_byte(uint8_t byte, uint8_t isData)
+#if LCD_USE_BUSY_FLAG
+/* Switch D4..D7 between output (00 -> 01) and input (00) with one MODER write. */
+static void lcd_data_dir(int output)
 {
-    HAL_GPIO_WritePin(LCD_RS_GPIO_Port, LCD_RS_Pin, isData ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    uint32_t moder = LCD_DATA_GPIO_Port->MODER;
+    moder &= ~(0xFFUL << (LCD_DATA_PIN_POS * 2U));
+    if (output) moder |= (0x55UL << (LCD_DATA_PIN_POS * 2U));
+    LCD_DATA_GPIO_Port->MODER = moder;
+}
 
-    lcd_write4((byte >> 4) & 0x0F);
-    lcd_write4(byte & 0x0F);
+/* Poll BF (D7 of the high nibble) until the controller accepts the next byte. */
+static void lcd_wait_ready(void)
+{
+    uint32_t start = Timebase_Micros();
 
-    /* typowe czasy wykonania wg HD44780: ~37us, a clear/home ~1.52ms */
-    if (!isData && (byte == 0x01 || byte == 0x02))
-        HAL_Delay(2);
-    else
-        lcd_delay_us(50);
+    lcd_data_dir(0);
+    LCD_RS_GPIO_Port->BRR = LCD_RS_Pin;
+    LCD_RW_GPIO_Port->BSRR = LCD_RW_Pin;
+
+    for (;;)
+    {
+        LCD_E_GPIO_Port->BSRR = LCD_E_Pin;
+        Timebase_DelayUs(LCD_T_E_US);                 /* tDDR 360 ns */
+        uint32_t busy = LCD_DATA_GPIO_Port->IDR & (0x08UL << LCD_DATA_PIN_POS);
+        LCD_E_GPIO_Port->BRR = LCD_E_Pin;
+        Timebase_DelayUs(LCD_T_E_US);
+
+        lcd_pulse_enable();                           /* low nibble, ignored */
+
+        if (!busy) break;
+        if ((uint32_t)(Timebase_Micros() - start) >= LCD_BUSY_TIMEOUT_US) break;
+    }
+
+    LCD_RW_GPIO_Port->BRR = LCD_RW_Pin;
+    lcd_data_dir(1);
 }
+#endif
 
-void LCD_Init(void)
+static void lcd_send_byte(uint8_t byte, uint8_t isData)
 {
-    /* WAŻNE: wywołaj po HAL_Init() i po MX_GPIO_Init() */
-    HAL_Delay(50); // >40ms po starcie zasilania LCD
+#if LCD_USE_BUSY_FLAG
+    /* Wait before the write: the CPU can work while the previous one executes. */
+    lcd_wait_ready();
+#endif
 
-    HAL_GPIO_WritePin(LCD_RS_GPIO_Port, LCD_RS_Pin, GPIO_PIN_RESET);
-    HAL_GPIO_WritePin(LCD_E_GPIO_Port,  LCD_E_Pin,  GPIO_PIN_RESET);
+    if (isData) LCD_RS_GPIO_Port->BSRR = LCD_RS_Pin;
+    else        LCD_RS_GPIO_Port->BRR  = LCD_RS_Pin;
 
-    /* Sekwencja wejścia w 4-bit */
-    lcd_write4(0x03); HAL_Delay(5);
-    lcd_write4(0x03); lcd_delay_us(150);
-    lcd_write4(0x03); lcd_delay_us(150);
-    lcd_write4(0x02); lcd_delay_us(150);
+    lcd_write4((uint8_t)(byte >> 4));
+    lcd_write4((uint8_t)(byte & 0x0F));
 
-    /* Konfiguracja */
-    lcd_send_byte(0x28, 0); // 4-bit, 2 linie, 5x8
+#if !LCD_USE_BUSY_FLAG
+    if (!isData && (byte == LCD_CMD_CLEAR || byte == LCD_CMD_HOME))
+        Timebase_DelayUs(LCD_EXEC_LONG_US);
+    else
+        Timebase_DelayUs(LCD_EXEC_US);
+#endif
+}
+
+static void lcd_gpio_init(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    /* The L476 has GPIOA..H; enable all ports the LCD could be mapped to. */
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+
+    GPIO_InitStruct.Pin = LCD_RS_Pin;
+    HAL_GPIO_Init(LCD_RS_GPIO_Port, &GPIO_InitStruct);
+    GPIO_InitStruct.Pin = LCD_E_Pin;
+    HAL_GPIO_Init(LCD_E_GPIO_Port, &GPIO_InitStruct);
+    GPIO_InitStruct.Pin = (uint32_t)LCD_DATA_MASK;
+    HAL_GPIO_Init(LCD_DATA_GPIO_Port, &GPIO_InitStruct);
+#if LCD_USE_BUSY_FLAG
+    GPIO_InitStruct.Pin = LCD_RW_Pin;
+    HAL_GPIO_Init(LCD_RW_GPIO_Port, &GPIO_InitStruct);
+    LCD_RW_GPIO_Port->BRR = LCD_RW_Pin;
+#endif
+
+    LCD_RS_GPIO_Port->BRR = LCD_RS_Pin;
+    LCD_E_GPIO_Port->BRR = LCD_E_Pin;
+}
+
+void LCD_Init(void)
+{
+    /* Call after HAL_Init(), SystemClock_Config() and Timebase_Init(). */
+    lcd_gpio_init();
+    Timebase_DelayUs(LCD_POWERUP_US);
+
+    /*
+     * 4-bit entry sequence (datasheet "initializing by instruction").
+     * BF cannot be checked yet, so fixed delays are used here.
+     */
+    lcd_write4(0x03); Timebase_DelayUs(4500);
+    lcd_write4(0x03); Timebase_DelayUs(150);
+    lcd_write4(0x03); Timebase_DelayUs(150);
+    lcd_write4(0x02); Timebase_DelayUs(150);
+
+    /* Configuration */
+    lcd_send_byte(0x28, 0); // 4-bit, 2 lines, 5x8
     lcd_send_byte(0x0C, 0); // display on
     lcd_send_byte(0x06, 0); // entry mode inc
-    lcd_send_byte(0x01, 0); // clear
+    lcd_send_byte(LCD_CMD_CLEAR, 0);
 }
 
 void LCD_Clear(void)
 {
-    lcd_send_byte(0x01, 0);
+    lcd_send_byte(LCD_CMD_CLEAR, 0);
 }
 
 void LCD_SetCursor(uint8_t row, uint8_t col)
@@ -80,7 +177,7 @@ void LCD_SetCursor(uint8_t row, uint8_t col)
     uint8_t addr = (row == 0) ? 0x00 : 0x40;
     addr += col;
 
-    lcd_send_byte(0x80 | addr, 0);
+    lcd_send_byte(LCD_CMD_SET_DDRAM | addr, 0);
 }
 
 void LCD_Print(const char *str)
@@ -89,3 +186,23 @@ void LCD_Print(const char *str)
     while (*str)
         lcd_send_byte((uint8_t)*str++, 1);
 }
+
+void LCD_Write(const uint8_t *buf, uint16_t len)
+{
+    if (!buf) return;
+    while (len--)
+        lcd_send_byte(*buf++, 1);
+}
+
+void LCD_CreateChars(uint8_t firstSlot, const uint8_t patterns[][8], uint8_t count)
+{
+    if (!patterns || firstSlot > 7) return;
+    if (count > (uint8_t)(8 - firstSlot)) count = (uint8_t)(8 - firstSlot);
+
+    lcd_send_byte((uint8_t)(LCD_CMD_SET_CGRAM | (firstSlot << 3)), 0);
+    for (uint8_t c = 0; c < count; c++)
+        for (uint8_t i = 0; i < 8; i++)
+            lcd_send_byte((uint8_t)(patterns[c][i] & 0x1F), 1);
+
+    lcd_send_byte(LCD_CMD_SET_DDRAM, 0);
+}
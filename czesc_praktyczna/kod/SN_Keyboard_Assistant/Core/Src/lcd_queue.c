@@ -0,0 +1,451 @@
+#include "lcd_queue.h"
+#include "i2c_bus.h"
+#include "timebase.h"
+#include <string.h>
+
+/**
+ * @file lcd_queue.c
+ * @brief Interrupt-driven LCD command queue (see lcd_queue.h).
+ *
+ * Single producer (main loop) / single consumer (interrupts):
+ * - the producer fills q[head] and then advances head,
+ * - the consumer sends q[tail] and advances tail when the transfer is done,
+ *   so an entry's buffer stays valid while DMA reads it.
+ *
+ * head/tail are free-running counters (index = counter % LCDQ_DEPTH).
+ * 'busy' is true while a transfer or an execution-time wait is in progress;
+ * it is only changed with the LCD interrupts masked or from those interrupts.
+ *
+ * Backlight slot: rgbNext/rgbPending are written by the producer with the
+ * interrupts masked; the consumer copies rgbNext into rgbTx (the DMA source)
+ * when it starts the write, so a newer color can be requested meanwhile.
+ *
+ * Bus health: every LCD transfer is reported to i2c_bus.c. While its breaker
+ * is open, producers get HAL_ERROR and the consumer drops whatever is queued
+ * (counted as errors, so the UI redraws everything once the panel is back;
+ * dropped fences run their callbacks).
+ * 'xferActive' marks a DMA transfer in flight; a completion that arrives after
+ * LcdQueue_Watchdog() gave up on the transfer is ignored.
+ */
+
+typedef enum {
+    LCDQ_KIND_CMD = 0,
+    LCDQ_KIND_DATA,
+    LCDQ_KIND_FENCE
+} LcdQueueKind;
+
+typedef struct {
+    uint8_t kind;                   /* LcdQueueKind */
+    uint8_t len;                    /* bytes in data[] */
+    uint16_t delayUs;               /* execution time after the transfer */
+    uint8_t data[LCDQ_MAX_DATA];
+    LcdQueueCallback callback;      /* LCDQ_KIND_FENCE only */
+    void *arg;
+} LcdQueueEntry;
+
+static GroveLCD_t *qLcd = NULL;
+
+static LcdQueueEntry q[LCDQ_DEPTH];
+static volatile uint32_t head = 0;
+static volatile uint32_t tail = 0;
+static volatile bool busy = false;
+static volatile uint32_t errors = 0;
+
+static uint8_t rgbNext[3];
+static uint8_t rgbTx[3];
+static volatile bool rgbPending = false;
+static volatile bool rgbInFlight = false;
+static bool rgbValid = false;
+
+static volatile bool xferActive = false;
+static volatile uint32_t xferStartMs = 0;
+
+/* ------------------------------------------------------------------------- */
+/* Consumer side (interrupt context, or producer with interrupts masked)     */
+/* ------------------------------------------------------------------------- */
+
+static void StartNext(void);
+
+static void MarkTransfer(void)
+{
+    xferStartMs = HAL_GetTick();
+    xferActive = true;
+}
+
+/*
+ * Breaker open: nothing queued can reach the panel. Fences still run (as
+ * the OLED driver does for a failed batch), so nobody waits for them forever.
+ */
+static void DropAll(void)
+{
+    while (tail != head) {
+        LcdQueueEntry *e = &q[tail % LCDQ_DEPTH];
+        tail++;
+
+        if (e->kind != LCDQ_KIND_FENCE) {
+            errors++;
+        } else if (e->callback != NULL) {
+            e->callback(e->arg);
+        }
+    }
+}
+
+static void DelayDone(void)
+{
+    StartNext();
+}
+
+/* Retire q[tail] and continue with the next entry (after its delay, if any). */
+static void Retire(void)
+{
+    uint16_t delayUs = q[tail % LCDQ_DEPTH].delayUs;
+    tail++;
+
+    if (delayUs != 0U) {
+        Timebase_SetAlarmUs(delayUs, DelayDone);
+    } else {
+        StartNext();
+    }
+}
+
+/* Sends the requested backlight color; returns true if a transfer was started. */
+static bool StartBacklight(void)
+{
+    if (!rgbPending || !I2cBus_Allow()) return false;
+
+    rgbPending = false;
+    memcpy(rgbTx, rgbNext, sizeof(rgbTx));
+
+    if (HAL_I2C_Mem_Write_DMA(qLcd->hi2c, (uint16_t)(qLcd->rgb_addr_7bit << 1),
+                              GROVE_RGB_REG_PWM_BLUE | GROVE_RGB_AUTO_INC,
+                              I2C_MEMADD_SIZE_8BIT, rgbTx, sizeof(rgbTx)) != HAL_OK) {
+        return false;   /* lost color: harmless, the next request resends */
+    }
+    rgbInFlight = true;
+    MarkTransfer();
+    return true;
+}
+
+static void StartNext(void)
+{
+    /* Backlight first: it is feedback for the note just played. */
+    if (StartBacklight()) {
+        busy = true;
+        return;
+    }
+
+    while (tail != head)
+    {
+        if (!I2cBus_Allow()) {
+            DropAll();
+            break;
+        }
+
+        LcdQueueEntry *e = &q[tail % LCDQ_DEPTH];
+
+        if (e->kind == LCDQ_KIND_FENCE) {
+            if (e->callback != NULL) e->callback(e->arg);
+            tail++;
+            continue;
+        }
+
+        uint16_t reg = (e->kind == LCDQ_KIND_CMD) ? GROVE_LCD_REG_CMD : GROVE_LCD_REG_DATA;
+        HAL_StatusTypeDef st = HAL_I2C_Mem_Write_DMA(qLcd->hi2c, (uint16_t)(qLcd->addr_7bit << 1), reg,
+                                                     I2C_MEMADD_SIZE_8BIT, e->data, e->len);
+        if (st == HAL_OK) {
+            MarkTransfer();
+            busy = true;
+            return;
+        }
+
+        /* Could not start (bus busy / error): drop the entry, keep going. */
+        I2cBus_Report(st);
+        errors++;
+        tail++;
+    }
+
+    busy = false;
+}
+
+void LcdQueue_I2cTxDone(I2C_HandleTypeDef *hi2c)
+{
+    if (qLcd == NULL || hi2c != qLcd->hi2c || !xferActive) return;
+    xferActive = false;
+
+    if (rgbInFlight) {
+        rgbInFlight = false;
+        StartNext();
+        return;
+    }
+    I2cBus_Report(HAL_OK);
+    Retire();
+}
+
+void LcdQueue_I2cError(I2C_HandleTypeDef *hi2c)
+{
+    if (qLcd == NULL || hi2c != qLcd->hi2c || !xferActive) return;
+    xferActive = false;
+
+    if (rgbInFlight) {
+        /* Backlight only: the LCD contents are not affected. */
+        rgbInFlight = false;
+        StartNext();
+        return;
+    }
+
+    /* The panel state is unknown now; LcdQueue_TakeErrors() lets the UI redraw. */
+    errors++;
+    I2cBus_Report(HAL_ERROR);
+    Retire();
+}
+
+/* ------------------------------------------------------------------------- */
+/* Producer side (main loop)                                                 */
+/* ------------------------------------------------------------------------- */
+
+static uint32_t FreeEntries(void)
+{
+    return LCDQ_DEPTH - (head - tail);
+}
+
+/* Start draining if idle; masks the LCD interrupts so 'busy' cannot race. */
+static void Kick(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (!busy && qLcd != NULL) {
+        StartNext();
+    }
+    __set_PRIMASK(primask);
+}
+
+/* Fills the next free entry; the caller has checked FreeEntries(). */
+static LcdQueueEntry *Push(LcdQueueKind kind, const uint8_t *data, uint8_t len, uint16_t delayUs)
+{
+    LcdQueueEntry *e = &q[head % LCDQ_DEPTH];
+    e->kind = (uint8_t)kind;
+    e->len = len;
+    e->delayUs = delayUs;
+    e->callback = NULL;
+    e->arg = NULL;
+    if (len != 0U) memcpy(e->data, data, len);
+    return e;
+}
+
+/* Publishes the entry filled by Push(). */
+static void Commit(void)
+{
+    __DMB();
+    head++;
+}
+
+void LcdQueue_Init(GroveLCD_t *lcd)
+{
+    qLcd = lcd;
+    head = 0;
+    tail = 0;
+    busy = false;
+    errors = 0;
+    rgbPending = false;
+    rgbInFlight = false;
+    rgbValid = false;
+    xferActive = false;
+}
+
+HAL_StatusTypeDef LcdQueue_Command(uint8_t cmd, uint16_t delay_us)
+{
+    if (qLcd == NULL || !I2cBus_Allow()) return HAL_ERROR;
+    if (FreeEntries() < 1U) return HAL_BUSY;
+
+    Push(LCDQ_KIND_CMD, &cmd, 1, delay_us);
+    Commit();
+    Kick();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef LcdQueue_Clear(void)
+{
+    return LcdQueue_Command(GROVE_LCD_CMD_CLEAR, GROVE_LCD_EXEC_LONG_US);
+}
+
+HAL_StatusTypeDef LcdQueue_Home(void)
+{
+    return LcdQueue_Command(GROVE_LCD_CMD_HOME, GROVE_LCD_EXEC_LONG_US);
+}
+
+HAL_StatusTypeDef LcdQueue_SetCursor(uint8_t row, uint8_t col)
+{
+    return LcdQueue_Command(GroveLCD_CursorCmd(row, col), 0);
+}
+
+HAL_StatusTypeDef LcdQueue_Write(const uint8_t *buf, uint16_t len)
+{
+    if (qLcd == NULL || buf == NULL || !I2cBus_Allow()) return HAL_ERROR;
+    if (len == 0U) return HAL_OK;
+
+    uint32_t needed = ((uint32_t)len + LCDQ_MAX_DATA - 1U) / LCDQ_MAX_DATA;
+    if (FreeEntries() < needed) return HAL_BUSY;
+
+    while (len > 0U) {
+        uint8_t chunk = (uint8_t)((len > LCDQ_MAX_DATA) ? LCDQ_MAX_DATA : len);
+        Push(LCDQ_KIND_DATA, buf, chunk, 0);
+        Commit();
+        buf += chunk;
+        len = (uint16_t)(len - chunk);
+    }
+
+    Kick();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef LcdQueue_CreateChars(uint8_t firstSlot, const uint8_t patterns[][8], uint8_t count)
+{
+    if (qLcd == NULL || patterns == NULL || !I2cBus_Allow()) return HAL_ERROR;
+    if (count == 0U || firstSlot > 7U || (uint8_t)(firstSlot + count) > 8U) return HAL_ERROR;
+
+    /* CGRAM address + pattern bursts + return to DDRAM. */
+    uint32_t needed = 2U + (((uint32_t)count * 8U + LCDQ_MAX_DATA - 1U) / LCDQ_MAX_DATA);
+    if (FreeEntries() < needed) return HAL_BUSY;
+
+    uint8_t cmd = (uint8_t)(GROVE_LCD_CMD_SET_CGRAM | (firstSlot << 3));
+    Push(LCDQ_KIND_CMD, &cmd, 1, 0);
+    Commit();
+
+    uint8_t rows[LCDQ_MAX_DATA];
+    uint8_t n = 0;
+    for (uint8_t c = 0; c < count; c++) {
+        for (uint8_t i = 0; i < 8U; i++) {
+            rows[n++] = (uint8_t)(patterns[c][i] & 0x1F);
+            if (n == LCDQ_MAX_DATA) {
+                Push(LCDQ_KIND_DATA, rows, n, 0);
+                Commit();
+                n = 0;
+            }
+        }
+    }
+    if (n != 0U) {
+        Push(LCDQ_KIND_DATA, rows, n, 0);
+        Commit();
+    }
+
+    cmd = GROVE_LCD_CMD_SET_DDRAM;
+    Push(LCDQ_KIND_CMD, &cmd, 1, 0);
+    Commit();
+
+    Kick();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef LcdQueue_Fence(LcdQueueCallback callback, void *arg)
+{
+    if (qLcd == NULL || !I2cBus_Allow()) return HAL_ERROR;
+    if (FreeEntries() < 1U) return HAL_BUSY;
+
+    LcdQueueEntry *e = Push(LCDQ_KIND_FENCE, NULL, 0, 0);
+    e->callback = callback;
+    e->arg = arg;
+    Commit();
+    Kick();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef LcdQueue_SetBacklight(uint8_t r, uint8_t g, uint8_t b)
+{
+    if (qLcd == NULL || qLcd->rgb_addr_7bit == 0U) return HAL_ERROR;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    GroveLCD_RgbPayload(r, g, b, rgbNext);
+    rgbPending = true;      /* kept while the breaker is open, sent after recovery */
+    rgbValid = true;
+    __set_PRIMASK(primask);
+
+    Kick();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef LcdQueue_Reinit(void)
+{
+    if (qLcd == NULL || !I2cBus_Allow()) return HAL_ERROR;
+    if (FreeEntries() < 5U) return HAL_BUSY;
+
+    /*
+     * Same sequence as GroveLCD_Init(), without blocking: a re-plugged module
+     * may still be powering up and ignore the first function set, so it is
+     * repeated after the power-up time.
+     */
+    uint8_t cmd = GROVE_LCD_CMD_FUNCTION_2LINE;
+    Push(LCDQ_KIND_CMD, &cmd, 1, (uint16_t)GROVE_LCD_POWERUP_US);
+    Commit();
+    Push(LCDQ_KIND_CMD, &cmd, 1, 0);
+    Commit();
+    cmd = GROVE_LCD_CMD_DISPLAY_ON;
+    Push(LCDQ_KIND_CMD, &cmd, 1, 0);
+    Commit();
+    cmd = GROVE_LCD_CMD_CLEAR;
+    Push(LCDQ_KIND_CMD, &cmd, 1, GROVE_LCD_EXEC_LONG_US);
+    Commit();
+    cmd = GROVE_LCD_CMD_ENTRY_INC;
+    Push(LCDQ_KIND_CMD, &cmd, 1, 0);
+    Commit();
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    /* DDRAM and CGRAM are blank now: make the UI redraw and re-upload its glyphs. */
+    errors++;
+    /* The backlight controller was reset to white as well (GroveLCD_InitBacklight()). */
+    rgbPending = rgbValid;
+    __set_PRIMASK(primask);
+
+    Kick();
+    return HAL_OK;
+}
+
+bool LcdQueue_Watchdog(uint32_t timeout_ms)
+{
+    bool hung = false;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (xferActive && (HAL_GetTick() - xferStartMs) >= timeout_ms) {
+        /* Abandon the transfer; I2cBus_Recover() resets the peripheral and DMA. */
+        xferActive = false;
+        rgbInFlight = false;
+        I2cBus_Trip();
+        DropAll();          /* includes the abandoned entry */
+        busy = false;
+        hung = true;
+    }
+    __set_PRIMASK(primask);
+
+    return hung;
+}
+
+uint32_t LcdQueue_Free(void)
+{
+    return FreeEntries();
+}
+
+bool LcdQueue_IsIdle(void)
+{
+    return !busy && (head == tail) && !rgbPending;
+}
+
+HAL_StatusTypeDef LcdQueue_WaitIdle(uint32_t timeout_ms)
+{
+    uint32_t start = HAL_GetTick();
+    while (!LcdQueue_IsIdle()) {
+        if ((HAL_GetTick() - start) >= timeout_ms) return HAL_TIMEOUT;
+    }
+    return HAL_OK;
+}
+
+uint32_t LcdQueue_TakeErrors(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t n = errors;
+    errors = 0;
+    __set_PRIMASK(primask);
+    return n;
+}
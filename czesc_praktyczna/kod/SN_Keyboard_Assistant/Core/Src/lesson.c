@@ -1,8 +1,19 @@
 #include "lesson.h"
-#include "grove_lcd16x2_i2c.h"
-#include "main.h"   /* GPIO macros and HAL_GetTick() */
-
-#include <stdio.h>  /* snprintf() */
+#include "lcd_framebuffer.h"
+#include "lesson_render.h"
+#include "lesson_frames.h"
+#include "oled_staff.h"
+#include "backlight.h"
+#include "main.h"   /* GPIO macros */
+#include "timer_wheel.h"
+#include "latency.h"
+#include "note_mask.h"
+#include "held_notes.h"
+#include "song_pack.h"
+
+#include <stdio.h>  /* snprintf(), printf() */
+#include <stdint.h> /* uintptr_t */
+#include <string.h> /* strlen(), memcpy() */
 
 /*
  * lesson.c
@@ -11,28 +22,77 @@
  *
  * Two modes are supported:
  * 1) Song mode:
- *    - Each step defines one to three exact MIDI notes to be played (match by MIDI number).
+ *    - Each step defines exact MIDI notes to be played (match by MIDI number),
+ *      in any order; a note listed twice must be played twice.
  *    - The display shows note names with accidentals and octave, plus duration icons.
  *
- * 2) Chord mode:
- *    - Each step defines one chord (up to three notes).
+ * 2) Rhythm mode (song mode + timing):
+ *    - Pitch is matched exactly as in song mode.
+ *    - Each correct note is also scored against its expected time: the note's
+ *      onset tick, converted with the song tempo, after the song clock. The
+ *      clock starts with the first correct note (which defines tick 0 + its
+ *      onset) and restarts after going back a step.
+ *    - Played times are the held-key onsets (held_notes.c), taken by main.c
+ *      on the 1 MHz TIM2 timebase and back-dated to the USB packet
+ *      completion, so the measurement error is the USB frame jitter, not
+ *      the main-loop latency.
+ *    - Early / on-time / late counts and the deviation sums are updated per
+ *      note (no sample buffer); the summary shows them.
+ *    - Articulation: a matched key remembers its NoteEntry and step
+ *      articulation in a 128-entry table indexed by MIDI note. On release
+ *      (Lesson_HandleRelease()) the hold time - release minus the held-key
+ *      onset - is compared with the written duration at the song tempo;
+ *      holds outside the articulation's range count as too short or too
+ *      long (overlapping the next note).
+ *
+ * 3) Chord mode:
+ *    - Each step defines one chord (any number of tones: triads, 7ths, 9ths).
  *    - Matching is done by pitch class (note % 12), allowing any octave.
+ *    - The chord counts only when all its tones are held at the same time
+ *      (held_notes.c, fed by main.c from NOTE ON / NOTE OFF) and their onsets
+ *      lie within the onset window (Lesson_SetOnsetWindowMs()). The onset
+ *      spread of each chord is collected for the summary.
+ *
+ * Matching works on bit masks (note_mask.h) built once when a step starts:
+ * - song mode: 128-bit MIDI note masks, one layer per repetition, so a step
+ *   "E E E" expects E in layers 0, 1 and 2,
+ * - chord mode: one 12-bit pitch-class mask, compared with the held keys.
+ * Song hits are kept in parallel masks and 'stepMissing' counts what is
+ * left, so handling a note costs a few AND/OR operations whatever the step size.
+ * Packed songs (song_pack.h) may carry the step masks precomputed.
+ *
+ * Song steps are always read through Song_Step(), which decodes packed songs
+ * on demand; step pointers are not kept across calls.
  *
  * Feedback:
- * - Green LED blinks on correct input, red LED blinks on wrong input.
+ * - Green LED blinks on correct input, red LED blinks on wrong input
+ *   (turned off by one-shot timer-wheel timers, no polling needed).
+ * - On RGB LCD modules the backlight flashes green/red as well, and between
+ *   flashes shows the running accuracy as a red-yellow-green gradient.
  * - After finishing all steps, a summary screen is shown (OK/Total and percentage).
  *
  * Notes:
  * - This file does not read USB/MIDI directly; it only processes inputs passed in
  *   via Lesson_HandleInput().
- * - LCD instance is created and initialized in main.c (exported as extern).
+ * - Screens are composed in the LCD shadow framebuffer (lcd_framebuffer.c) and
+ *   flushed once per screen, so only changed cells are sent to the display.
+ *   With the Grove backend the flush only queues I2C transfers (lcd_queue.c),
+ *   so MIDI handling never waits for the bus.
+ * - Step screens are pre-rendered at build time (lesson_frames.c, generated by
+ *   Tools/gen_lesson_frames.c), so showing a step is one frame copy + flush.
+ *   Lessons without a matching table are rendered on the fly with the same
+ *   layout code (lesson_render.c).
+ * - With a graphics display (Lesson_SetStaffCanvas()) the current and the next
+ *   two steps are also drawn on a staff (oled_staff.c).
  */
 
-/* LCD instance lives in main.c */
-extern GroveLCD_t lcd;
-
 /* --- Tunables --- */
 #define LED_BLINK_MS   (120U)
+#define NOTE_LAYERS    (4U)    /* max. repetitions of one note within a song step */
+#define MIN_TEMPO_BPM  (20U)   /* keeps the tick length in 32 bits (Q16.16 us) */
+
+_Static_assert(LESSON_FRAME_ROWS == LCDFB_ROWS && LESSON_FRAME_COLS == LCDFB_COLS,
+               "lesson frames must match the framebuffer size");
 
 /* --- Lesson internal state --- */
 typedef enum {
@@ -40,134 +100,284 @@ typedef enum {
     LESSON_STATE_SUMMARY
 } LessonState;
 
-static Song *currentSong = NULL;
-static ChordPack *currentChordPack = NULL;
+static const Song *currentSong = NULL;
+static const ChordPack *currentChordPack = NULL;
 static uint8_t currentStepIndex = 0;
 static uint8_t totalSteps = 0;
+static const LessonFrame_t *stepFrames = NULL;   /* pre-rendered screens, or NULL */
+static OledGfx_t *staffCanvas = NULL;             /* notation view, or NULL */
 static bool lessonActive = false;
 static LessonState lessonState = LESSON_STATE_RUNNING;
 
-/* Step hit slots (max 3 notes per step/chord in this project) */
-static bool stepHit[3] = { false, false, false };
+/* Expected / hit notes of the current step (see the file comment) */
+static NoteMask128_t expectedNotes[NOTE_LAYERS];
+static NoteMask128_t hitNotes[NOTE_LAYERS];
+static uint8_t noteLayers = 0;      /* layers used by the current song step */
+static uint16_t expectedPcs = 0;    /* chord mode */
+static uint16_t hitPcs = 0;         /* chord mode: tones already counted in this step */
+static bool chordRetry = false;     /* chord mode: struck again after a "not together" red blink */
+static uint32_t stepMissing = 0;    /* song mode: expected notes not hit yet */
+
+/* Chord mode: onset window and spread statistics of the played chords */
+static uint32_t onsetWindowUs = LESSON_ONSET_WINDOW_MS * 1000U;
+static uint32_t chordsTimed = 0;
+static uint32_t spreadSumUs = 0;
+static uint32_t spreadMaxUs = 0;
+
+/* Rhythm mode: song clock and timing statistics */
+static bool rhythmMode = false;
+static uint32_t rhythmWindowUs = LESSON_RHYTHM_WINDOW_MS * 1000U;
+static uint32_t usPerTickQ16 = 0;   /* tick length, Q16.16 microseconds */
+static bool clockRunning = false;
+static uint32_t songStartUs = 0;    /* timebase value of tick 0 */
+static uint32_t notesTimed = 0;
+static uint32_t notesEarly = 0;
+static uint32_t notesLate = 0;
+static int64_t devSumUs = 0;        /* signed: mean shows a rushing / dragging tendency */
+static uint64_t absDevSumUs = 0;
+static uint32_t absDevMaxUs = 0;
+static uint16_t absDevMaxTick = 0;  /* onset tick of the worst note */
+
+/* Rhythm mode: written duration of each sounding key (0 = not scored on release) */
+static uint16_t soundingTicks[128];
+static Articulation soundingArtic[128];
+static uint32_t notesReleased = 0;
+static uint32_t notesShort = 0;
+static uint32_t notesLong = 0;
+
+/* Accepted hold time per articulation: percent of the written duration, plus overlap */
+typedef struct {
+    uint8_t minPercent;
+    uint8_t maxPercent;
+    uint8_t overlapMs;   /* allowed beyond maxPercent (finger change, legato overlap) */
+} HoldRange;
+
+static const HoldRange holdRanges[] = {
+    [ARTIC_NORMAL]   = { 50U, 100U, 30U },
+    [ARTIC_LEGATO]   = { 85U, 100U, 80U },
+    [ARTIC_STACCATO] = {  0U,  50U,  0U },
+};
 
 /* Session statistics */
 static uint32_t correctPlayed = 0;
 static uint32_t wrongPlayed = 0;
 static uint32_t totalPlayed = 0;
 
-/* LED blink state (non-blocking) */
-static bool greenLedOn = false;
-static bool redLedOn = false;
-static uint32_t greenLedTick = 0;
-static uint32_t redLedTick = 0;
+/* LCD latency of a screen not completely queued yet (see FlushScreen()) */
+static bool screenFencePending = false;
+static uint32_t screenOrigin = 0;
+
+/* LED blink timers (LED is switched off from the timer callback) */
+static SoftTimer_t greenLedTimer;
+static SoftTimer_t redLedTimer;
 
 /* Forward declarations */
-static void DisplaySongStep(const SongStep *step);
-static void DisplayChordStep(const Chord *chord);
-static void ResetStepHit(void);
-static uint8_t GetCurrentSlotCount(void);
-static uint8_t CountMissingSlots(void);
+static void DisplayStep(void);
+static void BeginStep(void);
 static void AddMissingSlotsAsCorrect(void);
 static void EnterSummary(void);
 static void ShowSummary(void);
 static void LedBlinkGreen(void);
 static void LedBlinkRed(void);
+static void LedBlinkOffBeat(void);
+static void LedsOff(void);
+static uint32_t AccuracyPercent(void);
 static int8_t NoteToPitchClass(char letter, Accidental accidental);
+static int8_t MatchSongNote(uint8_t note);
+static bool ScoreOnset(uint8_t note, uint8_t layer);
+static void ForgetSounding(void);
+static void ResetStats(void);
 static bool IsStepComplete(void);
 static void AdvanceOrSummary(void);
 
 /* --- Local LCD helpers --- */
 
-/* Clears one LCD row by overwriting it with spaces. */
-static void LCD_ClearRow(uint8_t row)
+/* Display fence callback (may run in interrupt context): the new screen reached the panel. */
+static void ScreenShown(void *arg)
 {
-    GroveLCD_SetCursor(&lcd, row, 0);
-    GroveLCD_Print(&lcd, "                ");
+    Latency_RecordSince(LAT_STAGE_LCD, (uint32_t)(uintptr_t)arg);
 }
 
-/* Writes one custom character (CGRAM slot 0..7) to the LCD. */
-static void LCD_WriteCustom(uint8_t slot)
+/*
+ * Flushes the framebuffer; LCD latency is recorded when the transfer completes.
+ * The fence only goes in once every dirty cell is queued: a flush cut short
+ * by a full queue is finished by Lesson_Flush() from App_Update(), and the
+ * fence follows that one (until then the origin waits in screenOrigin; a
+ * newer screen keeps the older origin, which its transfer also completes).
+ */
+static void FlushScreen(void)
 {
-    GroveLCD_WriteChar(&lcd, (char)slot);
+    uint32_t origin;
+
+    if (Latency_Defer(LAT_STAGE_LCD, &origin) && !screenFencePending) {
+        screenOrigin = origin;
+        screenFencePending = true;
+    }
+    Lesson_Flush();
 }
 
-/*
- * Convert MIDI note number to octave character.
- * MIDI convention: C4=60 -> octave 4. Formula: octave = (midi/12) - 1.
- */
-static char MidiToOctaveChar(int8_t midi)
+void Lesson_Flush(void)
 {
-    if (midi < 0) return '?';
-    int octave = (midi / 12) - 1;
-    if (octave < 0 || octave > 9) return '?';
-    return (char)('0' + octave);
+    if (LcdFb_Flush() != HAL_OK || !screenFencePending) return;
+    if (LcdFb_Fence(ScreenShown, (void *)(uintptr_t)screenOrigin) == HAL_OK) {
+        screenFencePending = false;
+    }
 }
 
 /* --- Step/slot helpers --- */
 
-/* Resets per-step note hit flags. */
-static void ResetStepHit(void)
+/* Builds the expected masks of the current step and clears its hits. */
+static void BeginStep(void)
 {
-    stepHit[0] = false;
-    stepHit[1] = false;
-    stepHit[2] = false;
+    for (uint8_t k = 0; k < NOTE_LAYERS; k++) {
+        NoteMask_Clear(&expectedNotes[k]);
+        NoteMask_Clear(&hitNotes[k]);
+    }
+    noteLayers = 0;
+    expectedPcs = 0;
+    hitPcs = 0;
+    chordRetry = false;
+    stepMissing = 0;
+
+    if (currentSong != NULL)
+    {
+        const SongStep *step = Song_Step(currentSong, currentStepIndex);
+        if (step == NULL) return;
+
+        /* Precomputed mask of a packed step: usable as is when no note repeats. */
+        const PackedSong *packed = currentSong->packed;
+        if (packed != NULL && packed->masks != NULL &&
+            NoteMask_Count(&packed->masks[currentStepIndex]) == step->noteCount)
+        {
+            expectedNotes[0] = packed->masks[currentStepIndex];
+            noteLayers = (step->noteCount > 0U) ? 1U : 0U;
+            stepMissing = step->noteCount;
+            return;
+        }
+
+        for (uint8_t i = 0; i < step->noteCount; i++)
+        {
+            int8_t midi = step->notes[i].midiNote;
+            if (midi < 0) continue;
+
+            /* Repeated note: next layer (repetitions beyond NOTE_LAYERS are not required). */
+            uint8_t k = 0;
+            while (k < NOTE_LAYERS && NoteMask_Test(&expectedNotes[k], (uint8_t)midi)) k++;
+            if (k == NOTE_LAYERS) continue;
+
+            NoteMask_Set(&expectedNotes[k], (uint8_t)midi);
+            if (k >= noteLayers) noteLayers = (uint8_t)(k + 1U);
+            stepMissing++;
+        }
+    }
+    else if (currentChordPack != NULL)
+    {
+        const Chord *chord = &currentChordPack->chords[currentStepIndex];
+        for (uint8_t i = 0; i < chord->noteCount; i++)
+        {
+            int8_t pc = NoteToPitchClass(chord->notes[i].letter, chord->notes[i].accidental);
+            if (pc >= 0) expectedPcs |= (uint16_t)(1U << pc);
+        }
+    }
 }
 
-/* Returns number of required notes for the current step (capped by 3 in logic). */
-static uint8_t GetCurrentSlotCount(void)
+/* Marks a played note in the lowest layer still expecting it; returns the layer, or -1 if none does. */
+static int8_t MatchSongNote(uint8_t note)
 {
-    if (currentSong != NULL) {
-        return currentSong->steps[currentStepIndex].noteCount;
-    }
-    if (currentChordPack != NULL) {
-        return currentChordPack->chords[currentStepIndex].noteCount;
+    for (uint8_t k = 0; k < noteLayers; k++)
+    {
+        if (NoteMask_Test(&expectedNotes[k], note) && !NoteMask_Test(&hitNotes[k], note)) {
+            NoteMask_Set(&hitNotes[k], note);
+            stepMissing--;
+            return (int8_t)k;
+        }
     }
-    return 0;
+    return -1;
+}
+
+/* --- Rhythm helpers --- */
+
+/* Song time of a tick, in microseconds after tick 0. */
+static uint32_t TicksToUs(uint16_t ticks)
+{
+    return (uint32_t)(((uint64_t)ticks * usPerTickQ16) >> 16);
 }
 
-/* Counts remaining (not yet hit) required notes for the current step. */
-static uint8_t CountMissingSlots(void)
+/*
+ * Scores the onset of a matched song note. Layer k of a note is its k-th
+ * occurrence in the step (BeginStep() fills layers in list order), which
+ * gives the NoteEntry with the expected onset tick.
+ * Returns true if the note was on time (the first note always is).
+ */
+static bool ScoreOnset(uint8_t note, uint8_t layer)
 {
-    uint8_t cnt = 0;
-    uint8_t slots = GetCurrentSlotCount();
-    if (slots > 3) slots = 3;
+    const SongStep *step = Song_Step(currentSong, currentStepIndex);
+    const NoteEntry *entry = NULL;
+
+    if (step == NULL) return true;
+
+    for (uint8_t i = 0, seen = 0; i < step->noteCount; i++)
+    {
+        if (step->notes[i].midiNote != (int8_t)note) continue;
+        if (seen++ == layer) { entry = &step->notes[i]; break; }
+    }
+    if (entry == NULL) return true;
+
+    soundingTicks[note] = entry->durationTicks;
+    soundingArtic[note] = step->articulation;
+
+    uint32_t played = HeldNotes_Onset(note);
+    uint32_t expected = TicksToUs(entry->onsetTick);
+
+    if (!clockRunning) {
+        songStartUs = played - expected;
+        clockRunning = true;
+        return true;
+    }
+
+    int32_t dev = (int32_t)(played - (songStartUs + expected));
+    uint32_t absDev = (dev < 0) ? (uint32_t)(-dev) : (uint32_t)dev;
 
-    for (uint8_t i = 0; i < slots; i++) {
-        if (!stepHit[i]) cnt++;
+    notesTimed++;
+    devSumUs += dev;
+    absDevSumUs += absDev;
+    if (absDev > absDevMaxUs) {
+        absDevMaxUs = absDev;
+        absDevMaxTick = entry->onsetTick;
     }
-    return cnt;
+
+    if (absDev <= rhythmWindowUs) return true;
+    if (dev < 0) notesEarly++;
+    else notesLate++;
+    return false;
+}
+
+/* No key waits for its release to be scored (lesson start, clock restart). */
+static void ForgetSounding(void)
+{
+    for (uint8_t n = 0; n < 128U; n++) soundingTicks[n] = 0;
 }
 
 /*
- * Treats remaining slots as correct (used for "skip" via OK button).
- * This updates stats and marks all required notes as hit.
+ * Treats remaining notes as correct (used for "skip" via OK button).
+ * This updates stats; the step is left right after, so the hit masks stay as they are.
+ * In chord mode the tones not held right now are the missing ones.
  */
 static void AddMissingSlotsAsCorrect(void)
 {
-    uint8_t missing = CountMissingSlots();
-    if (missing == 0) return;
-
-    correctPlayed += missing;
-    totalPlayed += missing;
-
-    uint8_t slots = GetCurrentSlotCount();
-    if (slots > 3) slots = 3;
-    for (uint8_t i = 0; i < slots; i++) {
-        stepHit[i] = true;
+    if (currentChordPack != NULL) {
+        stepMissing = PcMask_Count(expectedPcs & (uint16_t)~hitPcs);
     }
+
+    correctPlayed += stepMissing;
+    totalPlayed += stepMissing;
+    stepMissing = 0;
 }
 
 /* Returns true if all required notes for the step have been hit. */
 static bool IsStepComplete(void)
 {
-    uint8_t slots = GetCurrentSlotCount();
-    if (slots == 0) return false;
-    if (slots > 3) slots = 3;
-
-    for (uint8_t i = 0; i < slots; i++) {
-        if (!stepHit[i]) return false;
-    }
-    return true;
+    return stepMissing == 0U;
 }
 
 /*
@@ -179,10 +389,9 @@ static void AdvanceOrSummary(void)
     if (currentStepIndex < (totalSteps - 1))
     {
         currentStepIndex++;
-        ResetStepHit();
+        BeginStep();
 
-        if (currentSong) DisplaySongStep(&currentSong->steps[currentStepIndex]);
-        else DisplayChordStep(&currentChordPack->chords[currentStepIndex]);
+        DisplayStep();
     }
     else
     {
@@ -192,20 +401,65 @@ static void AdvanceOrSummary(void)
 
 /* --- LED helpers --- */
 
-/* Turn on GREEN LED and record timestamp for non-blocking turn-off. */
+/* Timer callback: GREEN LED blink finished. */
+static void GreenLedOff(void *arg)
+{
+    (void)arg;
+    HAL_GPIO_WritePin(GREEN_LED_GPIO_Port, GREEN_LED_Pin, GPIO_PIN_RESET);
+}
+
+/* Timer callback: RED LED blink finished. */
+static void RedLedOff(void *arg)
+{
+    (void)arg;
+    HAL_GPIO_WritePin(RED_LED_GPIO_Port, RED_LED_Pin, GPIO_PIN_RESET);
+}
+
+/*
+ * Turn on GREEN LED and (re)start its one-shot turn-off timer; flash the
+ * backlight green (statistics are already updated, so the gradient it
+ * returns to includes this note).
+ */
 static void LedBlinkGreen(void)
 {
     HAL_GPIO_WritePin(GREEN_LED_GPIO_Port, GREEN_LED_Pin, GPIO_PIN_SET);
-    greenLedOn = true;
-    greenLedTick = HAL_GetTick();
+    Latency_Mark(LAT_STAGE_LED);
+    TimerWheel_Start(&greenLedTimer, LED_BLINK_MS, 0, GreenLedOff, NULL);
+
+    Backlight_Flash(BACKLIGHT_GREEN, BACKLIGHT_FLASH_MS);
+    Backlight_SetBase(Backlight_Accuracy(AccuracyPercent()));
 }
 
-/* Turn on RED LED and record timestamp for non-blocking turn-off. */
+/* Same as LedBlinkGreen() for a wrong note. */
 static void LedBlinkRed(void)
 {
     HAL_GPIO_WritePin(RED_LED_GPIO_Port, RED_LED_Pin, GPIO_PIN_SET);
-    redLedOn = true;
-    redLedTick = HAL_GetTick();
+    Latency_Mark(LAT_STAGE_LED);
+    TimerWheel_Start(&redLedTimer, LED_BLINK_MS, 0, RedLedOff, NULL);
+
+    Backlight_Flash(BACKLIGHT_RED, BACKLIGHT_FLASH_MS);
+    Backlight_SetBase(Backlight_Accuracy(AccuracyPercent()));
+}
+
+/* Right note at the wrong time (rhythm mode): green LED, yellow flash. */
+static void LedBlinkOffBeat(void)
+{
+    HAL_GPIO_WritePin(GREEN_LED_GPIO_Port, GREEN_LED_Pin, GPIO_PIN_SET);
+    Latency_Mark(LAT_STAGE_LED);
+    TimerWheel_Start(&greenLedTimer, LED_BLINK_MS, 0, GreenLedOff, NULL);
+
+    Backlight_Flash(BACKLIGHT_YELLOW, BACKLIGHT_FLASH_MS);
+    Backlight_SetBase(Backlight_Accuracy(AccuracyPercent()));
+}
+
+/* Switch both LEDs off immediately, cancel pending blink timers, neutral backlight. */
+static void LedsOff(void)
+{
+    TimerWheel_Cancel(&greenLedTimer);
+    TimerWheel_Cancel(&redLedTimer);
+    HAL_GPIO_WritePin(GREEN_LED_GPIO_Port, GREEN_LED_Pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(RED_LED_GPIO_Port, RED_LED_Pin, GPIO_PIN_RESET);
+    Backlight_SetBase(BACKLIGHT_WHITE);
 }
 
 /* --- Pitch class mapping for chord mode --- */
@@ -239,63 +493,99 @@ static int8_t NoteToPitchClass(char letter, Accidental accidental)
     return base;
 }
 
+/* --- Pre-rendered frames --- */
+
+/*
+ * Generated frames for a built-in song, or NULL if the song is not from the
+ * table or the table is out of date (step count or source hash differ).
+ */
+static const LessonFrame_t *FramesForSong(const Song *song)
+{
+    /* Packed songs bring their own frames (rendered with the data by the compiler). */
+    if (song->packed != NULL) return song->packed->frames;
+
+    if (song < songs || song >= songs + SONG_COUNT) return NULL;
+
+    uint32_t idx = (uint32_t)(song - songs);
+    if (idx >= SONG_FRAME_SET_COUNT) return NULL;
+
+    const LessonFrameSet_t *set = &songFrameSets[idx];
+    if (set->frameCount != song->stepCount || set->sourceHash != LessonRender_SongHash(song)) return NULL;
+    return set->frames;
+}
+
+/* Same as FramesForSong() for a built-in chord pack. */
+static const LessonFrame_t *FramesForChordPack(const ChordPack *pack)
+{
+    if (pack < chordPacks || pack >= chordPacks + CHORD_PACK_COUNT) return NULL;
+
+    uint32_t idx = (uint32_t)(pack - chordPacks);
+    if (idx >= CHORD_PACK_FRAME_SET_COUNT) return NULL;
+
+    const LessonFrameSet_t *set = &chordPackFrameSets[idx];
+    if (set->frameCount != pack->chordCount || set->sourceHash != LessonRender_ChordPackHash(pack)) return NULL;
+    return set->frames;
+}
+
 /* --- Lesson lifecycle --- */
 
-void Lesson_StartSong(Song *song)
+void Lesson_StartSong(const Song *song)
 {
+    rhythmMode = false;
     currentSong = song;
     currentChordPack = NULL;
     currentStepIndex = 0;
     totalSteps = (song != NULL) ? song->stepCount : 0;
     lessonActive = (song != NULL && totalSteps > 0);
+    stepFrames = lessonActive ? FramesForSong(song) : NULL;
 
-    /* Reset session statistics */
-    correctPlayed = 0;
-    wrongPlayed = 0;
-    totalPlayed = 0;
+    ResetStats();
 
     lessonState = LESSON_STATE_RUNNING;
-    ResetStepHit();
+    BeginStep();
 
     /* Reset LEDs */
-    HAL_GPIO_WritePin(GREEN_LED_GPIO_Port, GREEN_LED_Pin, GPIO_PIN_RESET);
-    HAL_GPIO_WritePin(RED_LED_GPIO_Port, RED_LED_Pin, GPIO_PIN_RESET);
-    greenLedOn = false;
-    redLedOn = false;
-    greenLedTick = 0;
-    redLedTick = 0;
+    LedsOff();
 
     if (lessonActive) {
-        DisplaySongStep(&song->steps[0]);
+        DisplayStep();
     }
 }
 
-void Lesson_StartChordExercise(ChordPack *pack)
+void Lesson_StartRhythm(const Song *song)
+{
+    Lesson_StartSong(song);
+    if (!lessonActive) return;
+
+    uint32_t bpm = (song->tempoBpm != 0U) ? song->tempoBpm : SONG_DEFAULT_BPM;
+    if (bpm < MIN_TEMPO_BPM) bpm = MIN_TEMPO_BPM;
+
+    usPerTickQ16 = (uint32_t)((60000000ULL << 16) / (bpm * SONG_PPQ));
+    clockRunning = false;
+    ForgetSounding();
+    rhythmMode = true;
+}
+
+void Lesson_StartChordExercise(const ChordPack *pack)
 {
+    rhythmMode = false;
     currentChordPack = pack;
     currentSong = NULL;
     currentStepIndex = 0;
     totalSteps = (pack != NULL) ? pack->chordCount : 0;
     lessonActive = (pack != NULL && totalSteps > 0);
+    stepFrames = lessonActive ? FramesForChordPack(pack) : NULL;
 
-    /* Reset session statistics */
-    correctPlayed = 0;
-    wrongPlayed = 0;
-    totalPlayed = 0;
+    ResetStats();
 
     lessonState = LESSON_STATE_RUNNING;
-    ResetStepHit();
+    BeginStep();
 
     /* Reset LEDs */
-    HAL_GPIO_WritePin(GREEN_LED_GPIO_Port, GREEN_LED_Pin, GPIO_PIN_RESET);
-    HAL_GPIO_WritePin(RED_LED_GPIO_Port, RED_LED_Pin, GPIO_PIN_RESET);
-    greenLedOn = false;
-    redLedOn = false;
-    greenLedTick = 0;
-    redLedTick = 0;
+    LedsOff();
 
     if (lessonActive) {
-        DisplayChordStep(&pack->chords[0]);
+        DisplayStep();
     }
 }
 
@@ -304,37 +594,144 @@ bool Lesson_IsActive(void)
     return lessonActive;
 }
 
+void Lesson_SetStaffCanvas(OledGfx_t *canvas)
+{
+    staffCanvas = canvas;
+}
+
+void Lesson_SetOnsetWindowMs(uint16_t ms)
+{
+    onsetWindowUs = (uint32_t)ms * 1000U;
+}
+
+void Lesson_SetRhythmWindowMs(uint16_t ms)
+{
+    rhythmWindowUs = (uint32_t)ms * 1000U;
+}
+
 /* --- Summary --- */
 
-/* Renders summary screen (correct/total and percent). */
+/* Clears the session statistics. */
+static void ResetStats(void)
+{
+    correctPlayed = 0;
+    wrongPlayed = 0;
+    totalPlayed = 0;
+    chordsTimed = 0;
+    spreadSumUs = 0;
+    spreadMaxUs = 0;
+    notesTimed = 0;
+    notesEarly = 0;
+    notesLate = 0;
+    devSumUs = 0;
+    absDevSumUs = 0;
+    absDevMaxUs = 0;
+    absDevMaxTick = 0;
+    notesReleased = 0;
+    notesShort = 0;
+    notesLong = 0;
+}
+
+/* Rounded share of correct notes (100 before the first note). */
+static uint32_t AccuracyPercent(void)
+{
+    if (totalPlayed == 0) return 100U;
+    return (uint32_t)(((uint64_t)correctPlayed * 100ULL + (totalPlayed / 2U)) / totalPlayed);
+}
+
+/*
+ * Rhythm summary: on-time share, early / late / too short / too long counts;
+ * mean deviation and details over SWO.
+ */
+static void RhythmSummaryLines(char *line1, char *line2, size_t size)
+{
+    uint32_t onTime = notesTimed - notesEarly - notesLate;
+    uint32_t onTimePercent = (notesTimed > 0U) ? (onTime * 100U + notesTimed / 2U) / notesTimed : 100U;
+    int32_t meanUs = (notesTimed > 0U) ? (int32_t)(devSumUs / (int64_t)notesTimed) : 0;
+    int32_t meanMs = (meanUs >= 0) ? (meanUs + 500) / 1000 : (meanUs - 500) / 1000;
+
+    snprintf(line1, size, "OK:%lu/%lu T:%lu%%", (unsigned long)correctPlayed,
+             (unsigned long)totalPlayed, (unsigned long)onTimePercent);
+    snprintf(line2, size, "E%lu L%lu S%lu O%lu", (unsigned long)notesEarly,
+             (unsigned long)notesLate, (unsigned long)notesShort, (unsigned long)notesLong);
+
+    if (notesTimed > 0U)
+    {
+        /* Position of the worst note in bars and beats of the time signature */
+        uint32_t unit = (currentSong->beatUnit != 0U) ? currentSong->beatUnit : 4U;
+        uint32_t beats = (currentSong->beatsPerBar != 0U) ? currentSong->beatsPerBar : 4U;
+        uint32_t ticksPerBeat = SONG_PPQ * 4U / unit;
+        uint32_t beat = absDevMaxTick / ticksPerBeat;
+
+        printf("Rhythm: %lu timed, early %lu, late %lu, mean %+ld us, mean abs %lu us, "
+               "worst %lu us at bar %lu beat %lu\r\n",
+               (unsigned long)notesTimed, (unsigned long)notesEarly, (unsigned long)notesLate,
+               (long)meanUs, (unsigned long)(absDevSumUs / notesTimed), (unsigned long)absDevMaxUs,
+               (unsigned long)(beat / beats + 1U), (unsigned long)(beat % beats + 1U));
+        printf("Rhythm: mean %+ld ms; held %lu, too short %lu, too long %lu\r\n",
+               (long)meanMs, (unsigned long)notesReleased, (unsigned long)notesShort,
+               (unsigned long)notesLong);
+    }
+}
+
+/* Puts " cut" at the end of a summary line; a full line loses its last cells to it. */
+static void AppendCutMarker(char *line, size_t size)
+{
+    static const char marker[] = " cut";
+    size_t at = strlen(line);
+
+    if (at > size - sizeof(marker)) at = size - sizeof(marker);
+    memcpy(&line[at], marker, sizeof(marker));
+}
+
+/*
+ * Renders summary screen (correct/total and percent, "cut" if the song file
+ * was longer than a song can hold). Chord exercises show the average / worst
+ * onset spread instead of the "any key" hint, rhythm lessons the timing
+ * result.
+ */
 static void ShowSummary(void)
 {
-    GroveLCD_Clear(&lcd);
-    LCD_ClearRow(0);
-    LCD_ClearRow(1);
+    LcdFb_Clear();
 
     char line1[17];
     char line2[17];
 
-    uint32_t percent = 0;
-    if (totalPlayed > 0) {
-        /* Rounded percentage */
-        percent = (uint32_t)(((uint64_t)correctPlayed * 100ULL + (totalPlayed / 2U)) / totalPlayed);
-    }
+    uint32_t percent = (totalPlayed > 0) ? AccuracyPercent() : 0U;
 
     snprintf(line1, sizeof(line1), "OK: %lu/%lu", (unsigned long)correctPlayed, (unsigned long)totalPlayed);
-    snprintf(line2, sizeof(line2), "P: %lu%% any key", (unsigned long)percent);
+    if (rhythmMode) {
+        RhythmSummaryLines(line1, line2, sizeof(line1));
+    } else if (currentChordPack != NULL && chordsTimed > 0U) {
+        uint32_t avgMs = (spreadSumUs / chordsTimed + 500U) / 1000U;
+        uint32_t maxMs = (spreadMaxUs + 500U) / 1000U;
+        snprintf(line2, sizeof(line2), "P:%lu%% %lu/%lums", (unsigned long)percent,
+                 (unsigned long)avgMs, (unsigned long)maxMs);
+        printf("Chords: %lu timed, spread avg %lu us, max %lu us\r\n", (unsigned long)chordsTimed,
+               (unsigned long)(spreadSumUs / chordsTimed), (unsigned long)spreadMaxUs);
+    } else {
+        snprintf(line2, sizeof(line2), "P: %lu%% any key", (unsigned long)percent);
+    }
 
-    GroveLCD_SetCursor(&lcd, 0, 0);
-    GroveLCD_Print(&lcd, line1);
-    GroveLCD_SetCursor(&lcd, 1, 0);
-    GroveLCD_Print(&lcd, line2);
+    /* A file longer than a song can hold was cut: say so after the score (any mode) */
+    if (currentSong != NULL && SongPack_IsTruncated(currentSong)) AppendCutMarker(line1, sizeof(line1));
+
+    LcdFb_SetCursor(0, 0);
+    LcdFb_Print(line1);
+    LcdFb_SetCursor(1, 0);
+    LcdFb_Print(line2);
+
+    FlushScreen();
 }
 
 /* Switches lesson state into summary and shows the summary screen. */
 static void EnterSummary(void)
 {
     lessonState = LESSON_STATE_SUMMARY;
+    if (staffCanvas != NULL) OledStaff_Clear(staffCanvas);
+    if (currentSong != NULL && SongPack_IsTruncated(currentSong)) {
+        printf("Song cut: only the first %u steps were played\r\n", (unsigned)currentSong->stepCount);
+    }
     ShowSummary();
 }
 
@@ -357,87 +754,88 @@ void Lesson_HandleInput(uint8_t input)
 
         lessonActive = false;
         lessonState = LESSON_STATE_RUNNING;
-        ResetStepHit();
-        HAL_GPIO_WritePin(GREEN_LED_GPIO_Port, GREEN_LED_Pin, GPIO_PIN_RESET);
-        HAL_GPIO_WritePin(RED_LED_GPIO_Port, RED_LED_Pin, GPIO_PIN_RESET);
-        greenLedOn = false;
-        redLedOn = false;
+        BeginStep();
+        LedsOff();
         return;
     }
 
     /* --- MIDI note (0..127) --- */
     if (input <= 0x7F)
     {
-        totalPlayed++;
-
-        if (currentSong != NULL)
-        {
-            SongStep *step = &currentSong->steps[currentStepIndex];
-            uint8_t slots = step->noteCount;
-            if (slots > 3) slots = 3;
-
-            bool matched = false;
-            for (uint8_t i = 0; i < slots; i++)
-            {
-                if (!stepHit[i] && (uint8_t)step->notes[i].midiNote == input)
-                {
-                    stepHit[i] = true;
-                    matched = true;
-                    break;
-                }
+        if (currentSong == NULL && currentChordPack == NULL) return;
+
+        bool matched;
+        bool complete;
+        bool together = true;
+        bool onTime = true;
+        bool repeat = false;   /* chord tone already counted in this step */
+
+        if (currentSong != NULL) {
+            int8_t layer = MatchSongNote(input);
+            matched = (layer >= 0);
+            complete = matched && IsStepComplete();
+            if (matched && rhythmMode) onTime = ScoreOnset(input, (uint8_t)layer);
+        } else {
+            /*
+             * A chord tone is correct the first time it is hit in the step;
+             * the chord needs all tones held at once. Striking a tone again
+             * is wrong, except when the chord is struck again after a "not
+             * together" red blink (its tones were counted the first time).
+             */
+            uint16_t pc = PcMask_OfNote(input);
+            uint32_t spread = 0;
+            matched = (expectedPcs & pc) != 0U;
+            repeat = matched && (hitPcs & pc) != 0U;
+            if (matched) hitPcs |= pc;
+            complete = matched && HeldNotes_Spread(expectedPcs, &spread);
+            together = complete && spread <= onsetWindowUs;
+
+            if (together) {
+                chordsTimed++;
+                spreadSumUs += spread;
+                if (spread > spreadMaxUs) spreadMaxUs = spread;
             }
+        }
 
-            if (matched) {
-                correctPlayed++;
-                LedBlinkGreen();
+        Latency_Mark(LAT_STAGE_EVALUATED);
 
-                /* Auto-advance when all required notes are hit */
-                if (IsStepComplete()) {
-                    AdvanceOrSummary();
-                }
-            } else {
+        if (matched && repeat) {
+            /* Chord tone again: not counted in a retry, wrong otherwise */
+            if (!chordRetry) {
+                totalPlayed++;
                 wrongPlayed++;
-                LedBlinkRed();
             }
 
-            return;
-        }
-
-        if (currentChordPack != NULL)
-        {
-            Chord *chord = &currentChordPack->chords[currentStepIndex];
-            uint8_t slots = chord->noteCount;
-            if (slots > 3) slots = 3;
-
-            uint8_t playedPC = (uint8_t)(input % 12U);
-            bool matched = false;
-
-            for (uint8_t i = 0; i < slots; i++)
-            {
-                if (stepHit[i]) continue;
-                int8_t expectedPC = NoteToPitchClass(chord->notes[i].letter, chord->notes[i].accidental);
-                if (expectedPC >= 0 && (uint8_t)expectedPC == playedPC)
-                {
-                    stepHit[i] = true;
-                    matched = true;
-                    break;
-                }
+            if (complete && !together) {
+                chordRetry = true;
+                LedBlinkRed();
             }
+            else if (complete || chordRetry) LedBlinkGreen();
+            else LedBlinkRed();
 
-            if (matched) {
-                correctPlayed++;
-                LedBlinkGreen();
+            if (complete && together) {
+                AdvanceOrSummary();
+            }
+        } else if (matched) {
+            totalPlayed++;
+            correctPlayed++;
 
-                /* Auto-advance when chord tones are all hit */
-                if (IsStepComplete()) {
-                    AdvanceOrSummary();
-                }
-            } else {
-                wrongPlayed++;
+            /* All tones down but not struck together: red, release and strike again. */
+            if (complete && !together) {
+                chordRetry = true;
                 LedBlinkRed();
             }
+            else if (!onTime) LedBlinkOffBeat();
+            else LedBlinkGreen();
 
-            return;
+            /* Auto-advance when all required notes / chord tones are hit */
+            if (complete && together) {
+                AdvanceOrSummary();
+            }
+        } else {
+            totalPlayed++;
+            wrongPlayed++;
+            LedBlinkRed();
         }
 
         return;
@@ -446,155 +844,101 @@ void Lesson_HandleInput(uint8_t input)
     /* --- Buttons --- */
     if (input == LESSON_INPUT_BTN_OK)
     {
-        /* Skip current step: count remaining slots as correct and move forward */
+        /* Skip current step: count remaining notes as correct and move forward */
         AddMissingSlotsAsCorrect();
         AdvanceOrSummary();
     }
     else if (input == LESSON_INPUT_BTN_NEXT)
     {
         /* Go to previous step; if already at step 0 -> exit lesson */
+        clockRunning = false;   /* rhythm: the next note restarts the song clock */
+        ForgetSounding();
         if (currentStepIndex > 0)
         {
             currentStepIndex--;
-            ResetStepHit();
-            if (currentSong) DisplaySongStep(&currentSong->steps[currentStepIndex]);
-            else DisplayChordStep(&currentChordPack->chords[currentStepIndex]);
+            BeginStep();
+            DisplayStep();
         }
         else
         {
             lessonActive = false;
-            ResetStepHit();
-            HAL_GPIO_WritePin(GREEN_LED_GPIO_Port, GREEN_LED_Pin, GPIO_PIN_RESET);
-            HAL_GPIO_WritePin(RED_LED_GPIO_Port, RED_LED_Pin, GPIO_PIN_RESET);
-            greenLedOn = false;
-            redLedOn = false;
+            BeginStep();
+            LedsOff();
+            if (staffCanvas != NULL) OledStaff_Clear(staffCanvas);
         }
     }
     else if (input == LESSON_INPUT_BTN_RESET)
     {
         /* Reset to step 0; if already at step 0 -> exit lesson */
+        clockRunning = false;
+        ForgetSounding();
         if (currentStepIndex != 0)
         {
             currentStepIndex = 0;
-            ResetStepHit();
-            if (currentSong) DisplaySongStep(&currentSong->steps[0]);
-            else DisplayChordStep(&currentChordPack->chords[0]);
+            BeginStep();
+            DisplayStep();
         }
         else
         {
             lessonActive = false;
-            ResetStepHit();
-            HAL_GPIO_WritePin(GREEN_LED_GPIO_Port, GREEN_LED_Pin, GPIO_PIN_RESET);
-            HAL_GPIO_WritePin(RED_LED_GPIO_Port, RED_LED_Pin, GPIO_PIN_RESET);
-            greenLedOn = false;
-            redLedOn = false;
+            BeginStep();
+            LedsOff();
+            if (staffCanvas != NULL) OledStaff_Clear(staffCanvas);
         }
     }
 }
 
-/*
- * Periodic non-blocking update for LED blink timing.
- * Turns LEDs off after LED_BLINK_MS.
- */
-void Lesson_Update(void)
+void Lesson_HandleRelease(uint8_t note, uint32_t t_us)
 {
-    uint32_t now = HAL_GetTick();
+    if (!lessonActive || !rhythmMode || note > 0x7FU) return;
 
-    if (greenLedOn && (uint32_t)(now - greenLedTick) >= LED_BLINK_MS) {
-        HAL_GPIO_WritePin(GREEN_LED_GPIO_Port, GREEN_LED_Pin, GPIO_PIN_RESET);
-        greenLedOn = false;
-    }
+    uint16_t writtenTicks = soundingTicks[note];
+    if (writtenTicks == 0U) return;
+    soundingTicks[note] = 0;
 
-    if (redLedOn && (uint32_t)(now - redLedTick) >= LED_BLINK_MS) {
-        HAL_GPIO_WritePin(RED_LED_GPIO_Port, RED_LED_Pin, GPIO_PIN_RESET);
-        redLedOn = false;
-    }
+    const HoldRange *range = &holdRanges[soundingArtic[note]];
+    uint32_t heldUs = t_us - HeldNotes_Onset(note);
+    uint32_t writtenUs = TicksToUs(writtenTicks);
+    uint32_t minUs = (uint32_t)(((uint64_t)writtenUs * range->minPercent) / 100U);
+    uint32_t maxUs = (uint32_t)(((uint64_t)writtenUs * range->maxPercent) / 100U) + range->overlapMs * 1000U;
+
+    notesReleased++;
+    if (heldUs < minUs) notesShort++;
+    else if (heldUs > maxUs) notesLong++;
+    else return;
+
+    /* The last note is released after the summary appeared: refresh it. */
+    if (lessonState == LESSON_STATE_SUMMARY) ShowSummary();
 }
 
 /* --- LCD rendering --- */
 
-static void DisplaySongStep(const SongStep *step)
+/* Shows the current step: pre-rendered frame if available, otherwise rendered now. */
+static void DisplayStep(void)
 {
-    GroveLCD_Clear(&lcd);
-    LCD_ClearRow(0);
-    LCD_ClearRow(1);
-
-    uint8_t col = 0;
-    uint8_t startCol[3] = {0};
-
-    /* Row 0: notes (e.g. C#4, Db4, E4) */
-    for (uint8_t i = 0; i < step->noteCount; i++)
-    {
-        if (i >= 3) break;
-        startCol[i] = col;
-
-        /* Letter */
-        GroveLCD_SetCursor(&lcd, 0, col);
-        GroveLCD_WriteChar(&lcd, step->notes[i].letter);
-        col++;
-
-        /* Accidental */
-        if (step->notes[i].accidental == ACC_SHARP) {
-            LCD_WriteCustom(5);
-            col++;
-        } else if (step->notes[i].accidental == ACC_FLAT) {
-            LCD_WriteCustom(6);
-            col++;
-        }
-
-        /* Octave (derived from MIDI note) */
-        char oct = MidiToOctaveChar(step->notes[i].midiNote);
-        GroveLCD_WriteChar(&lcd, oct);
-        col++;
-
-        /* Separator */
-        if (i < (step->noteCount - 1) && col < 16) {
-            GroveLCD_WriteChar(&lcd, ' ');
-            col++;
+    LessonFrame_t rendered;
+    const LessonFrame_t *frame;
+
+    if (stepFrames != NULL) {
+        frame = &stepFrames[currentStepIndex];
+    } else {
+        if (currentSong != NULL) {
+            const SongStep *step = Song_Step(currentSong, currentStepIndex);
+            if (step == NULL) return;
+            LessonRender_SongStep(step, currentStepIndex, totalSteps, &rendered);
+        } else {
+            LessonRender_ChordStep(&currentChordPack->chords[currentStepIndex], currentStepIndex, totalSteps, &rendered);
         }
-
-        if (col >= 16) break;
+        frame = &rendered;
     }
 
-    /* Row 1: duration icons under the first character of each note */
-    for (uint8_t i = 0; i < step->noteCount; i++)
-    {
-        if (i >= 3) break;
-        if (startCol[i] < 16) {
-            GroveLCD_SetCursor(&lcd, 1, startCol[i]);
-            LCD_WriteCustom(step->notes[i].lengthIcon); /* 0..4 */
-        }
-    }
-}
+    LcdFb_Load(frame->cells, frame->glyphs);
 
-static void DisplayChordStep(const Chord *chord)
-{
-    GroveLCD_Clear(&lcd);
-    LCD_ClearRow(0);
-    LCD_ClearRow(1);
-
-    /* Row 0: chord name */
-    GroveLCD_SetCursor(&lcd, 0, 0);
-    GroveLCD_Print(&lcd, "Chord:");
-    GroveLCD_Print(&lcd, chord->name);
-
-    /* Row 1: chord tones (no durations) */
-    GroveLCD_SetCursor(&lcd, 1, 0);
-
-    for (uint8_t i = 0; i < chord->noteCount; i++)
-    {
-        if (i >= 3) break;
-
-        GroveLCD_WriteChar(&lcd, chord->notes[i].letter);
-
-        if (chord->notes[i].accidental == ACC_SHARP) {
-            LCD_WriteCustom(5);
-        } else if (chord->notes[i].accidental == ACC_FLAT) {
-            LCD_WriteCustom(6);
-        }
-
-        if (i < (chord->noteCount - 1)) {
-            GroveLCD_WriteChar(&lcd, ' ');
-        }
+    /* Staff first: the text flush below also starts sending the changed OLED pages. */
+    if (staffCanvas != NULL) {
+        if (currentSong != NULL) OledStaff_DrawSong(staffCanvas, currentSong, currentStepIndex);
+        else OledStaff_DrawChords(staffCanvas, currentChordPack, currentStepIndex);
     }
+
+    FlushScreen();
 }
@@ -0,0 +1,182 @@
+#include "lesson_frames.h"
+
+/*
+ * lesson_frames.c
+ *
+ * GENERATED by Tools/gen_lesson_frames.c - do not edit.
+ *
+ * One 2x16 frame + glyph mask per lesson step (see lesson_frames.h).
+ * Layout version 2.
+ */
+
+/* Twinkle Twinkle */
+static const LessonFrame_t songFrames0[4] = {
+    { {
+        { 0x43, 0x34, 0x20, 0x43, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |C4 C4           | */
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |~  ~            | */
+      }, 0x00000004UL },
+    { {
+        { 0x47, 0x34, 0x20, 0x47, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |G4 G4           | */
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x0F, 0x20, 0x20 },   /* |~  ~         ~  | */
+      }, 0x00008004UL },
+    { {
+        { 0x41, 0x34, 0x20, 0x41, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |A4 A4           | */
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x0E, 0x20 },   /* |~  ~         ~~ | */
+      }, 0x00024004UL },
+    { {
+        { 0x47, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |G4              | */
+        { 0x01, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x11, 0x0D },   /* |~            ~~~| */
+      }, 0x00022002UL },
+};
+
+/* Mary Had a Lamb */
+static const LessonFrame_t songFrames1[3] = {
+    { {
+        { 0x45, 0x34, 0x20, 0x44, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |E4 D4           | */
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |~  ~            | */
+      }, 0x00000004UL },
+    { {
+        { 0x43, 0x34, 0x20, 0x44, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |C4 D4           | */
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x20, 0x20 },   /* |~  ~         ~  | */
+      }, 0x00020004UL },
+    { {
+        { 0x45, 0x34, 0x20, 0x45, 0x34, 0x20, 0x45, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |E4 E4 E4        | */
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x01, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x11, 0x20 },   /* |~  ~  ~      ~~ | */
+      }, 0x00020006UL },
+};
+
+/* Chroma Study */
+static const LessonFrame_t songFrames2[7] = {
+    { {
+        { 0x43, 0x34, 0x20, 0x44, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |C4 D4           | */
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |~  ~            | */
+      }, 0x00000004UL },
+    { {
+        { 0x45, 0x34, 0x20, 0x46, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |E4 F4           | */
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x0E, 0x20, 0x20 },   /* |~  ~         ~  | */
+      }, 0x00004004UL },
+    { {
+        { 0x46, 0x05, 0x34, 0x20, 0x47, 0x34, 0x20, 0x41, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |F~4 G4 A4       | */
+        { 0x03, 0x20, 0x20, 0x20, 0x03, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x20, 0x20, 0x10, 0x20, 0x20 },   /* |~   ~  ~     ~  | */
+      }, 0x0001002CUL },
+    { {
+        { 0x42, 0x06, 0x34, 0x20, 0x41, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |B~4 A4          | */
+        { 0x02, 0x20, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x0D, 0x20 },   /* |~   ~        ~~ | */
+      }, 0x00022044UL },
+    { {
+        { 0x47, 0x34, 0x20, 0x46, 0x05, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |G4 F~4          | */
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x0F, 0x20 },   /* |~  ~         ~~ | */
+      }, 0x00028024UL },
+    { {
+        { 0x46, 0x05, 0x34, 0x20, 0x42, 0x06, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |F~4 B~4         | */
+        { 0x02, 0x20, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x11, 0x20 },   /* |~   ~        ~~ | */
+      }, 0x00020064UL },
+    { {
+        { 0x43, 0x35, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |C5              | */
+        { 0x01, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x11, 0x0E },   /* |~            ~~~| */
+      }, 0x00024002UL },
+};
+
+/* Basic chords */
+static const LessonFrame_t chordPackFrames0[6] = {
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x43, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |Chord:C         | */
+        { 0x43, 0x20, 0x45, 0x20, 0x47, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |C E G           | */
+      }, 0x00000000UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x47, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x0E, 0x20, 0x20 },   /* |Chord:G      ~  | */
+        { 0x47, 0x20, 0x42, 0x20, 0x44, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |G B D           | */
+      }, 0x00004000UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x41, 0x6D, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x20, 0x20 },   /* |Chord:Am     ~  | */
+        { 0x41, 0x20, 0x43, 0x20, 0x45, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |A C E           | */
+      }, 0x00020000UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x46, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x0E, 0x20 },   /* |Chord:F      ~~ | */
+        { 0x46, 0x20, 0x41, 0x20, 0x43, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |F A C           | */
+      }, 0x00024000UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x44, 0x6D, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x11, 0x20 },   /* |Chord:Dm     ~~ | */
+        { 0x44, 0x20, 0x46, 0x20, 0x41, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |D F A           | */
+      }, 0x00020000UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x45, 0x6D, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x11, 0x0E },   /* |Chord:Em     ~~~| */
+        { 0x45, 0x20, 0x47, 0x20, 0x42, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |E G B           | */
+      }, 0x00024000UL },
+};
+
+/* Advanced chords */
+static const LessonFrame_t chordPackFrames1[6] = {
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x46, 0x23, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |Chord:F#        | */
+        { 0x46, 0x05, 0x20, 0x41, 0x05, 0x20, 0x43, 0x05, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |F~ A~ C~        | */
+      }, 0x00000020UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x42, 0x62, 0x20, 0x20, 0x20, 0x20, 0x20, 0x0E, 0x20, 0x20 },   /* |Chord:Bb     ~  | */
+        { 0x42, 0x06, 0x20, 0x44, 0x20, 0x46, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |B~ D F          | */
+      }, 0x00004040UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x47, 0x6D, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x20, 0x20 },   /* |Chord:Gm     ~  | */
+        { 0x47, 0x20, 0x42, 0x06, 0x20, 0x44, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |G B~ D          | */
+      }, 0x00020040UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x41, 0x62, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x0E, 0x20 },   /* |Chord:Ab     ~~ | */
+        { 0x41, 0x06, 0x20, 0x43, 0x20, 0x45, 0x06, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |A~ C E~         | */
+      }, 0x00024040UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x43, 0x23, 0x6D, 0x20, 0x20, 0x20, 0x20, 0x11, 0x11, 0x20 },   /* |Chord:C#m    ~~ | */
+        { 0x43, 0x05, 0x20, 0x45, 0x20, 0x47, 0x05, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |C~ E G~         | */
+      }, 0x00020020UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x45, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x11, 0x0E },   /* |Chord:E      ~~~| */
+        { 0x45, 0x20, 0x47, 0x05, 0x20, 0x42, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |E G~ B          | */
+      }, 0x00024020UL },
+};
+
+/* 7th/9th chords */
+static const LessonFrame_t chordPackFrames2[7] = {
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x43, 0x6D, 0x61, 0x6A, 0x37, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |Chord:Cmaj7     | */
+        { 0x43, 0x20, 0x45, 0x20, 0x47, 0x20, 0x42, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |C E G B         | */
+      }, 0x00000000UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x47, 0x37, 0x20, 0x20, 0x20, 0x20, 0x20, 0x0E, 0x20, 0x20 },   /* |Chord:G7     ~  | */
+        { 0x47, 0x20, 0x42, 0x20, 0x44, 0x20, 0x46, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |G B D F         | */
+      }, 0x00004000UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x41, 0x6D, 0x37, 0x20, 0x20, 0x20, 0x20, 0x10, 0x20, 0x20 },   /* |Chord:Am7    ~  | */
+        { 0x41, 0x20, 0x43, 0x20, 0x45, 0x20, 0x47, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |A C E G         | */
+      }, 0x00010000UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x44, 0x6D, 0x37, 0x20, 0x20, 0x20, 0x20, 0x11, 0x0D, 0x20 },   /* |Chord:Dm7    ~~ | */
+        { 0x44, 0x20, 0x46, 0x20, 0x41, 0x20, 0x43, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |D F A C         | */
+      }, 0x00022000UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x42, 0x62, 0x37, 0x20, 0x20, 0x20, 0x20, 0x11, 0x0F, 0x20 },   /* |Chord:Bb7    ~~ | */
+        { 0x42, 0x06, 0x20, 0x44, 0x20, 0x46, 0x20, 0x41, 0x06, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |B~ D F A~       | */
+      }, 0x00028040UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x43, 0x39, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x11, 0x20 },   /* |Chord:C9     ~~ | */
+        { 0x43, 0x20, 0x45, 0x20, 0x47, 0x20, 0x42, 0x06, 0x20, 0x44, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |C E G B~ D      | */
+      }, 0x00020040UL },
+    { {
+        { 0x43, 0x68, 0x6F, 0x72, 0x64, 0x3A, 0x47, 0x39, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x11, 0x0E },   /* |Chord:G9     ~~~| */
+        { 0x47, 0x20, 0x42, 0x20, 0x44, 0x20, 0x46, 0x20, 0x41, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },   /* |G B D F A       | */
+      }, 0x00024000UL },
+};
+
+const LessonFrameSet_t songFrameSets[] = {
+    { 0xF4BDDEF1UL, 4, songFrames0 },
+    { 0xC6F37445UL, 3, songFrames1 },
+    { 0x8589681EUL, 7, songFrames2 },
+};
+
+const uint8_t SONG_FRAME_SET_COUNT = (uint8_t)(sizeof(songFrameSets) / sizeof(songFrameSets[0]));
+
+const LessonFrameSet_t chordPackFrameSets[] = {
+    { 0xFEC300C4UL, 6, chordPackFrames0 },
+    { 0x19EF4FECUL, 6, chordPackFrames1 },
+    { 0x37A16158UL, 7, chordPackFrames2 },
+};
+
+const uint8_t CHORD_PACK_FRAME_SET_COUNT = (uint8_t)(sizeof(chordPackFrameSets) / sizeof(chordPackFrameSets[0]));
@@ -0,0 +1,201 @@
+#include "lesson_render.h"
+#include <string.h>
+
+/**
+ * @file lesson_render.c
+ * @brief Lesson step screen layout (see lesson_render.h).
+ *
+ * HAL-free, so it also builds on the host (Tools/gen_lesson_frames.c).
+ */
+
+#define PROGRESS_CELLS   (3U)    /* lesson progress bar width (5 steps per cell) */
+
+/* FNV-1a, 32-bit */
+#define FNV_OFFSET   (2166136261UL)
+#define FNV_PRIME    (16777619UL)
+
+/* Write cursor over a frame being rendered. */
+typedef struct
+{
+    LessonFrame_t *frame;
+    uint8_t row;
+    uint8_t col;
+} Pen;
+
+static void PenMove(Pen *pen, uint8_t row, uint8_t col)
+{
+    pen->row = row;
+    pen->col = col;
+}
+
+/* Writes one cell and advances; writes past the row end are dropped. */
+static void PenPut(Pen *pen, uint8_t c)
+{
+    if (pen->col >= LESSON_FRAME_COLS) return;
+    pen->frame->cells[pen->row][pen->col++] = c;
+}
+
+static void PenPrint(Pen *pen, const char *s)
+{
+    if (s == NULL) return;
+    while (*s) PenPut(pen, (uint8_t)*s++);
+}
+
+static void PenBegin(Pen *pen, LessonFrame_t *out)
+{
+    memset(out->cells, ' ', sizeof(out->cells));
+    out->glyphs = 0;
+    pen->frame = out;
+    PenMove(pen, 0, 0);
+}
+
+/* Collects the glyph mask once the layout is final (later writes may cover cells). */
+static void PenEnd(Pen *pen)
+{
+    LessonFrame_t *f = pen->frame;
+    for (uint8_t row = 0; row < LESSON_FRAME_ROWS; row++) {
+        for (uint8_t col = 0; col < LESSON_FRAME_COLS; col++) {
+            if (f->cells[row][col] < GLYPH_COUNT) f->glyphs |= (1UL << f->cells[row][col]);
+        }
+    }
+}
+
+/*
+ * Convert MIDI note number to octave character.
+ * MIDI convention: C4=60 -> octave 4. Formula: octave = (midi/12) - 1.
+ */
+static char MidiToOctaveChar(int8_t midi)
+{
+    if (midi < 0) return '?';
+    int octave = (midi / 12) - 1;
+    if (octave < 0 || octave > 9) return '?';
+    return (char)('0' + octave);
+}
+
+static void PutAccidental(Pen *pen, Accidental accidental)
+{
+    if (accidental == ACC_SHARP) PenPut(pen, GLYPH_SHARP);
+    else if (accidental == ACC_FLAT) PenPut(pen, GLYPH_FLAT);
+}
+
+/*
+ * Draws a PROGRESS_CELLS wide bar at the right edge of a row showing done/total.
+ * Uses at most two glyphs (full cell + one partial cell).
+ */
+static void PutProgress(Pen *pen, uint8_t row, uint32_t done, uint32_t total)
+{
+    uint32_t units = PROGRESS_CELLS * 5U;
+    uint32_t filled = (total == 0U) ? 0U : (done * units) / total;
+
+    PenMove(pen, row, (uint8_t)(LESSON_FRAME_COLS - PROGRESS_CELLS));
+    for (uint8_t i = 0; i < PROGRESS_CELLS; i++)
+    {
+        uint32_t cell = (filled >= 5U) ? 5U : filled;
+        filled -= cell;
+
+        PenPut(pen, (cell == 0U) ? (uint8_t)' ' : (uint8_t)(GLYPH_BAR_1 + cell - 1U));
+    }
+}
+
+void LessonRender_SongStep(const SongStep *step, uint8_t index, uint8_t total, LessonFrame_t *out)
+{
+    Pen pen;
+    uint8_t startCol[LESSON_FRAME_COLS];   /* a note takes at least 2 cells */
+    uint8_t shown = 0;
+
+    PenBegin(&pen, out);
+
+    /* Row 0: notes (e.g. C#4, Db4, E4); notes that do not fit are not shown */
+    for (uint8_t i = 0; i < step->noteCount && pen.col < LESSON_FRAME_COLS; i++)
+    {
+        startCol[shown++] = pen.col;
+
+        PenPut(&pen, (uint8_t)step->notes[i].letter);
+        PutAccidental(&pen, step->notes[i].accidental);
+        PenPut(&pen, (uint8_t)MidiToOctaveChar(step->notes[i].midiNote));
+
+        if (i + 1U < step->noteCount) PenPut(&pen, ' ');
+    }
+
+    /*
+     * Row 1: duration icons under the first character of each note, left of
+     * the progress bar (a fifth note starts under it and gets no icon)
+     */
+    for (uint8_t i = 0; i < shown && startCol[i] < LESSON_FRAME_COLS - PROGRESS_CELLS; i++)
+    {
+        PenMove(&pen, 1, startCol[i]);
+        PenPut(&pen, step->notes[i].lengthIcon);   /* GLYPH_WHOLE..GLYPH_SIXTEENTH */
+    }
+
+    /* Row 1, right edge: lesson progress (columns 13-15) */
+    PutProgress(&pen, 1, index, total);
+    PenEnd(&pen);
+}
+
+void LessonRender_ChordStep(const Chord *chord, uint8_t index, uint8_t total, LessonFrame_t *out)
+{
+    Pen pen;
+
+    PenBegin(&pen, out);
+
+    /* Row 0: chord name (the progress bar overwrites the last cells if it is long) */
+    PenPrint(&pen, "Chord:");
+    PenPrint(&pen, chord->name);
+    PutProgress(&pen, 0, index, total);
+
+    /* Row 1: chord tones (no durations; five tones with accidentals still fit) */
+    PenMove(&pen, 1, 0);
+    for (uint8_t i = 0; i < chord->noteCount; i++)
+    {
+        PenPut(&pen, (uint8_t)chord->notes[i].letter);
+        PutAccidental(&pen, chord->notes[i].accidental);
+        if (i + 1U < chord->noteCount) PenPut(&pen, ' ');
+    }
+    PenEnd(&pen);
+}
+
+/* --- Source hashes (field by field, so struct padding never leaks in) --- */
+
+static uint32_t HashByte(uint32_t h, uint8_t b)
+{
+    return (h ^ b) * FNV_PRIME;
+}
+
+static uint32_t HashNotes(uint32_t h, uint8_t noteCount, const NoteEntry *notes)
+{
+    h = HashByte(h, noteCount);
+    for (uint8_t i = 0; i < noteCount; i++)
+    {
+        h = HashByte(h, (uint8_t)notes[i].letter);
+        h = HashByte(h, (uint8_t)notes[i].accidental);
+        h = HashByte(h, (uint8_t)notes[i].midiNote);
+        h = HashByte(h, notes[i].lengthIcon);
+    }
+    return h;
+}
+
+uint32_t LessonRender_SongHash(const Song *song)
+{
+    uint32_t h = HashByte(FNV_OFFSET, LESSON_RENDER_VERSION);
+
+    h = HashByte(h, song->stepCount);
+    for (uint8_t i = 0; i < song->stepCount; i++) {
+        h = HashNotes(h, song->steps[i].noteCount, song->steps[i].notes);
+    }
+    return h;
+}
+
+uint32_t LessonRender_ChordPackHash(const ChordPack *pack)
+{
+    uint32_t h = HashByte(FNV_OFFSET, LESSON_RENDER_VERSION);
+
+    h = HashByte(h, pack->chordCount);
+    for (uint8_t i = 0; i < pack->chordCount; i++)
+    {
+        const char *name = pack->chords[i].name;
+        while (name != NULL && *name) h = HashByte(h, (uint8_t)*name++);
+        h = HashByte(h, 0);
+        h = HashNotes(h, pack->chords[i].noteCount, pack->chords[i].notes);
+    }
+    return h;
+}
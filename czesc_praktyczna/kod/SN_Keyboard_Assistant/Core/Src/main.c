@@ -26,8 +26,28 @@
 #include "usbh_midi.h"          /* USB Host MIDI class: reading 4-byte MIDI packets */
 #include "lesson.h"             /* Lesson engine: verifies incoming notes */
 #include "grove_lcd16x2_i2c.h"  /* Grove 16x2 LCD driver over I2C */
+#include "lcd_framebuffer.h"    /* Shadow framebuffer with diff-based flush */
+#include "display_grove.h"      /* Display backend: Grove LCD via async DMA queue */
+#include "display_hd44780.h"    /* Display backend: parallel HD44780 */
+#include "display_oled.h"       /* Display backend: 128x64 OLED text rows */
+#include "lcd_queue.h"          /* Async Grove LCD queue (I2C callbacks) */
+#include "i2c_bus.h"            /* I2C1 circuit breaker + bus recovery */
+#include "held_notes.h"         /* Held keys + onset times (chord detection) */
+#include "freeplay.h"           /* Free play: live chord naming */
+#include "oled_ssd1306.h"       /* SSD1306/SH1106 OLED driver (I2C, DMA) */
+#include "backlight.h"          /* RGB backlight feedback colors */
+#include "lcd_hd44780.h"        /* Parallel HD44780 driver */
 #include "button.h"             /* Button debouncing and edge detection */
 #include "app.h"                /* Application UI/menu state machine */
+#include "timebase.h"           /* Free-running microsecond timebase (TIM2) */
+#include "timer_wheel.h"        /* Software timers dispatched from the main loop */
+#include "latency.h"            /* Input-to-feedback latency histograms (DWT) */
+#include "spi_nor.h"            /* External SPI NOR flash (SPI1 + DMA) */
+#include "nor_store.h"          /* Log-structured content store on the NOR flash */
+#include "usbh_msc.h"           /* USB Host Mass Storage class: USB stick sectors */
+#include "fat_reader.h"         /* Read-only FAT file system on the stick */
+#include "song_import.h"        /* Stick folder -> content store */
+#include "store_songs.h"        /* Imported songs in the song list */
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -36,6 +56,23 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+/* Display backend: 0 = Grove 16x2 over I2C, 1 = parallel HD44780 (pins in lcd_hd44780.h). */
+#ifndef DISPLAY_USE_HD44780
+#define DISPLAY_USE_HD44780   0
+#endif
+
+/* 1 = 128x64 OLED on I2C1 instead of the Grove LCD (text rows + notation view). */
+#ifndef DISPLAY_USE_OLED
+#define DISPLAY_USE_OLED      0
+#endif
+
+/* OLED controller: OLED_SSD1306 or OLED_SH1106 (the common 1.3" modules). */
+#ifndef OLED_CONTROLLER
+#define OLED_CONTROLLER       OLED_SSD1306
+#endif
+
+/* Folder on a USB stick whose songs are imported into the store (the root if it is missing). */
+#define STICK_SONG_FOLDER     "SONGS"
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -61,80 +98,33 @@ static void MX_I2C1_Init(void);
 void MX_USB_HOST_Process(void);
 
 /* USER CODE BEGIN PFP */
+#if STORE_USE_SPI_NOR
+static void ImportFromStick(void);
+#endif
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
-/* Global LCD instance (used by the UI layer through 'extern GroveLCD_t lcd;'). */
+/* Global LCD instance and the display interface the UI framebuffer flushes to. */
 GroveLCD_t lcd;
-
-/*
- * Custom LCD characters (HD44780 CGRAM slots 0..7).
- * The project uploads music symbols to improve the UI on a 16x2 display.
- */
-
-/* Slot 0: Whole note */
-static const uint8_t CH_WHOLE[8] = {
-    0b00000, 0b00110, 0b01001, 0b01001, 0b01001, 0b00110, 0b00000, 0b00000
-};
-
-/* Slot 1: Half note */
-static const uint8_t CH_HALF[8] = {
-    0b00001, 0b00001, 0b00111, 0b01001, 0b01001, 0b00111, 0b00000, 0b00000
-};
-
-/* Slot 2: Quarter note */
-static const uint8_t CH_QUARTER[8] = {
-    0b00001, 0b00001, 0b00111, 0b01111, 0b01111, 0b00111, 0b00000, 0b00000
-};
-
-/* Slot 3: Eighth note */
-static const uint8_t CH_EIGHTH[8] = {
-    0b00011,
-    0b00101,
-    0b00011,
-    0b00001,
-    0b01111,
-    0b01111,
-    0b00110,
-    0b00000
-};
-
-/* Slot 4: Sixteenth note */
-static const uint8_t CH_SIXTEENTH[8] = {
-    0b00011,
-    0b00101,
-    0b00011,
-    0b00101,
-    0b01111,
-    0b01111,
-    0b00110,
-    0b00000
-};
-
-/* Slot 5: Sharp (#) */
-static const uint8_t CH_SHARP[8] = {
-    0b00100,
-    0b01110,
-    0b00100,
-    0b01110,
-    0b00100,
-    0b00000,
-    0b00000,
-    0b00000
-};
-
-/* Slot 6: Flat (b) */
-static const uint8_t CH_FLAT[8] = {
-    0b00100,
-    0b00100,
-    0b00110,
-    0b00101,
-    0b00110,
-    0b00000,
-    0b00000,
-    0b00000
-};
+static Display_t display;
+
+#if DISPLAY_USE_OLED
+/* OLED driver, its 1 KB framebuffer and the character layer on top of it. */
+static Oled_t oled;
+static OledGfx_t oledGfx;
+static DisplayOled_t oledText;
+#endif
+
+#if STORE_USE_SPI_NOR
+/* Content store on the SPI NOR chip (16 KB index + 1 KB read cache). */
+static NorStore store;
+static bool storeMounted = false;
+
+/* USB stick: its FAT volume (2 KB sector cache); songs are imported once per plug-in. */
+static FatVolume stick;
+static bool stickImported = false;
+#endif
 /* USER CODE END 0 */
 
 /**
@@ -169,17 +159,80 @@ int main(void)
   /* SWV/ITM banner (visible in CubeIDE ITM Data Console). */
   printf("\r\n==== SN_Keyboard_assistant started (SWV printf active) ====\r\n");
 
+  /* Microsecond timebase + timer wheel (used by LCD, buttons and lesson LEDs). */
+  Timebase_Init();
+  TimerWheel_Init();
+
+  /* DWT cycle counter for latency statistics (URB done -> LED/LCD). */
+  Latency_Init();
+
+  /* No keys held until the first NOTE ON. */
+  HeldNotes_Reset();
+
+#if STORE_USE_SPI_NOR
+  /* Content store: mount (index built from the record headers), format a blank chip. */
+  if (SpiNor_Init())
+  {
+    NorDevice nor;
+    SpiNor_Device(&nor);
+    NorStoreStatus st = NorStore_Mount(&store, &nor);
+    if (st == NOR_STORE_ERR_UNFORMATTED)
+    {
+      printf("SPI NOR %06lX: formatting\r\n", (unsigned long)SpiNor_JedecId());
+      st = NorStore_Format(&store, &nor);
+      if (st == NOR_STORE_OK) st = NorStore_Mount(&store, &nor);
+    }
+    printf("Store: %u items, %lu bytes free (status %u)\r\n", (unsigned)NorStore_Count(&store),
+           (unsigned long)NorStore_FreeBytes(&store), (unsigned)st);
+    storeMounted = (st == NOR_STORE_OK);
+    if (storeMounted) StoreSongs_Attach(&store);
+  }
+  else
+  {
+    printf("SPI NOR flash not found\r\n");
+  }
+#endif
+
+#if DISPLAY_USE_HD44780
+  /* LCD initialization (parallel HD44780, blocking writes). */
+  LCD_Init();
+  DisplayHd44780_Init(&display);
+#elif DISPLAY_USE_OLED
+  /* OLED initialization (blocking clear), then incremental DMA page updates. */
+  Oled_Init(&oled, &hi2c1, OLED_I2C_ADDR_7BIT_DEFAULT, OLED_CONTROLLER, &oledGfx);
+  DisplayOled_Init(&display, &oledText, &oledGfx);
+
+  /* Lessons draw the staff into the free pages between the two text rows. */
+  Lesson_SetStaffCanvas(&oledGfx);
+#else
+  /* Bus health: after repeated failures LCD writes fail fast and the bus is
+     recovered / re-probed in the background (DisplayGrove_Service()). */
+  I2cBus_Init(&hi2c1, GROVE_LCD_I2C_ADDR_7BIT_DEFAULT);
+
   /* LCD initialization (Grove 16x2 over I2C). */
-  GroveLCD_Init(&lcd, &hi2c1, GROVE_LCD_I2C_ADDR_7BIT_DEFAULT);
+  if (GroveLCD_Init(&lcd, &hi2c1, GROVE_LCD_I2C_ADDR_7BIT_DEFAULT) != HAL_OK)
+  {
+    printf("LCD not responding, retrying in the background\r\n");
+  }
+
+  /* RGB modules only; on a plain Grove LCD this fails and the backlight stays unused. */
+  GroveLCD_InitBacklight(&lcd, GROVE_RGB_I2C_ADDR_7BIT_DEFAULT);
 
-  /* Upload custom chars into CGRAM slots 0..6. */
-  GroveLCD_CreateChar(&lcd, 0, CH_WHOLE);
-  GroveLCD_CreateChar(&lcd, 1, CH_HALF);
-  GroveLCD_CreateChar(&lcd, 2, CH_QUARTER);
-  GroveLCD_CreateChar(&lcd, 3, CH_EIGHTH);
-  GroveLCD_CreateChar(&lcd, 4, CH_SIXTEENTH);
-  GroveLCD_CreateChar(&lcd, 5, CH_SHARP);
-  GroveLCD_CreateChar(&lcd, 6, CH_FLAT);
+#if GROVE_LCD_ENABLE_BENCHMARK
+  /* Per-byte vs burst I2C timing, printed over SWO. */
+  GroveLCD_Benchmark(&lcd);
+#endif
+
+  /* From here on, LCD traffic is queued and sent by DMA/interrupts. */
+  DisplayGrove_Init(&display, &lcd);
+
+  /* Backlight colors go through the same queue (one coalesced write per change). */
+  Backlight_Init();
+#endif
+
+  /* UI screens are composed in RAM and flushed as diffs; custom symbols are
+     uploaded to CGRAM on demand by the glyph manager (glyphs.c). */
+  LcdFb_Init(&display);
 
   /* Start the application UI state machine (welcome screen etc.). */
   App_Init();
@@ -201,10 +254,17 @@ int main(void)
           printf("State: APPLICATION_START (device connected)\r\n");
           break;
         case APPLICATION_READY:
-          printf("State: APPLICATION_READY (MIDI class active)\r\n");
+          printf("State: APPLICATION_READY (%s class active)\r\n",
+                 (hUsbHostFS.pActiveClass != NULL) ? hUsbHostFS.pActiveClass->Name : "no");
           break;
         case APPLICATION_DISCONNECT:
           printf("State: APPLICATION_DISCONNECT (device disconnected)\r\n");
+          /* No NOTE OFF will come for keys held at unplug time. */
+          HeldNotes_Reset();
+          FreePlay_Update();
+#if STORE_USE_SPI_NOR
+          stickImported = false;
+#endif
           break;
         default:
           printf("State: %d\r\n", Appli_state);
@@ -217,31 +277,77 @@ int main(void)
     if (Appli_state == APPLICATION_READY || Appli_state == APPLICATION_START)
     {
       uint8_t midi_event[4];
-      if (USBH_MIDI_GetEvent(&hUsbHostFS, midi_event) == USBH_OK)
+      uint32_t urbStamp;
+      if (USBH_MIDI_GetEventStamped(&hUsbHostFS, midi_event, &urbStamp) == USBH_OK)
       {
         uint8_t status  = midi_event[1] & 0xF0;
         uint8_t note    = midi_event[2];
         uint8_t vel     = midi_event[3];
 
+        /* Key time on the TIM2 timebase, back-dated to the USB packet
+           completion (DWT stamp from the channel interrupt): rhythm scoring
+           must not see how long the event waited for the main loop. */
+        uint32_t eventUs = Timebase_Micros() - (Latency_Now() - urbStamp) / (SystemCoreClock / 1000000U);
+
         if (status == 0x90 && vel != 0)  /* NOTE ON */
         {
+          /* Held-key state first: chord mode judges the keys sounding together. */
+          HeldNotes_On(note, eventUs);
+
           if (Lesson_IsActive())
           {
+            /* Latency stages after DEQUEUED are marked inside the lesson engine. */
+            Latency_BeginEvent(urbStamp);
+
             /* Lesson_HandleInput treats 0..127 as MIDI notes. */
             Lesson_HandleInput(note);
+
+            Latency_EndEvent();
           }
+
+          /* Free play names the held chord (no-op in other modes). */
+          FreePlay_Update();
+        }
+        else if (status == 0x80 || status == 0x90)  /* NOTE OFF (or NOTE ON, velocity 0) */
+        {
+          /* Rhythm lessons score the hold time (needs the onset, so before HeldNotes_Off()). */
+          if (Lesson_IsActive()) Lesson_HandleRelease(note, eventUs);
+
+          HeldNotes_Off(note);
+          FreePlay_Update();
         }
         else
         {
-          /* NOTE OFF / other messages are ignored in this file. */
+          /* Other messages are ignored in this file. */
         }
       }
     }
 
-    /* Poll buttons (debounce/edge) and run UI/menu logic. */
-    Button_Update();
+#if STORE_USE_SPI_NOR
+    /* USB stick ready (start-up commands done): copy its songs into the store. */
+    if (storeMounted && !stickImported && USBH_MSC_IsReady(&hUsbHostFS))
+    {
+      stickImported = true;
+      ImportFromStick();
+    }
+#endif
+
+    /* Run expired software timers (button sampling, LED blink off, ...). */
+    TimerWheel_Process();
+
+    /* Run UI/menu logic on debounced button events; flushes the LCD framebuffer. */
     App_Update();
 
+#if !DISPLAY_USE_HD44780 && !DISPLAY_USE_OLED
+    /* Hung transfers, bus recovery and LCD re-init after a cable fault. */
+    DisplayGrove_Service();
+#endif
+
+#if DISPLAY_USE_OLED
+    /* Send OLED pages changed since the last flush (staff view, leftovers). */
+    Oled_Flush();
+#endif
+
     /* USER CODE END WHILE */
     /* USER CODE BEGIN 3 */
   }
@@ -360,6 +466,92 @@ int __io_putchar(int ch)
 {
     return ITM_SendChar(ch);
 }
+
+/**
+ * @brief I2C DMA transfer done: the display drivers sharing I2C1 each check
+ *        whether the transfer was theirs.
+ */
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    LcdQueue_I2cTxDone(hi2c);
+    Oled_I2cTxDone(hi2c);
+}
+
+/** @brief I2C error: forwarded like HAL_I2C_MemTxCpltCallback(). */
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    LcdQueue_I2cError(hi2c);
+    Oled_I2cError(hi2c);
+}
+
+#if STORE_USE_SPI_NOR
+/* The USB stick as a FatDisk: blocking reads, or started and polled (pipelined import). */
+static bool StickRead(void *ctx, uint32_t lba, uint8_t *buf, uint16_t count)
+{
+    (void)ctx;
+    return USBH_MSC_Read(&hUsbHostFS, lba, buf, count) == USBH_OK;
+}
+
+static bool StickStart(void *ctx, uint32_t lba, uint8_t *buf, uint16_t count)
+{
+    (void)ctx;
+    return USBH_MSC_ReadStart(&hUsbHostFS, lba, buf, count) == USBH_OK;
+}
+
+static FatDiskState StickPoll(void *ctx)
+{
+    (void)ctx;
+    switch (USBH_MSC_ReadPoll(&hUsbHostFS))
+    {
+        case USBH_BUSY: return FAT_DISK_BUSY;
+        case USBH_OK:   return FAT_DISK_DONE;
+        default:        return FAT_DISK_FAILED;
+    }
+}
+
+/**
+ * @brief Import the songs of the stick's STICK_SONG_FOLDER (or its root).
+ *
+ * Blocks the main loop while it runs (a few seconds for a large folder);
+ * no keyboard can be played meanwhile anyway: the single USB host port
+ * has no hub support, so the stick and the keyboard are never connected
+ * together.
+ */
+static void ImportFromStick(void)
+{
+    static const FatDisk disk = { StickRead, StickStart, StickPoll, NULL };
+    static FatFile folder;
+    FatEntry entry;
+    SongImportReport report;
+    uint32_t start = HAL_GetTick();
+
+    FatStatus st = Fat_Mount(&stick, &disk);
+    if (st != FAT_OK)
+    {
+        printf("USB stick: no FAT volume (status %u)\r\n", (unsigned)st);
+        return;
+    }
+
+    Fat_OpenRoot(&stick, &folder);
+    if (Fat_Find(&folder, STICK_SONG_FOLDER, &entry) == FAT_OK && (entry.attr & FAT_ATTR_DIRECTORY) != 0U) {
+        Fat_Open(&stick, &entry, &folder);
+    } else {
+        Fat_OpenRoot(&stick, &folder);
+    }
+
+    bool complete = SongImport_Folder(&store, &folder, &report);
+    StoreSongs_Refresh();
+
+    printf("USB stick (FAT%u): %u songs, %u imported, %u unchanged, %u skipped, %u failed%s\r\n",
+           (unsigned)stick.type, (unsigned)report.files, (unsigned)report.imported,
+           (unsigned)report.unchanged, (unsigned)report.skipped, (unsigned)report.failed,
+           complete ? "" : " (stopped)");
+    printf("  %lu bytes in %lu ms, %lu data reads (%lu sectors), %lu FAT/dir reads, store status %u\r\n",
+           (unsigned long)report.bytes, (unsigned long)(HAL_GetTick() - start),
+           (unsigned long)report.reads, (unsigned long)report.sectors,
+           (unsigned long)stick.reads, (unsigned)report.storeStatus);
+}
+#endif
 /* USER CODE END 4 */
 
 void Error_Handler(void)
@@ -0,0 +1,658 @@
+#include "nor_store.h"
+#include <string.h>
+
+/**
+ * @file nor_store.c
+ * @brief Log-structured NOR content store (see nor_store.h).
+ *
+ * The segments in use always form one run of the ring, tail .. head, in
+ * the order they were opened (segment seq). Mount finds the run by its
+ * lowest seq, reads the record headers in log order and appends every
+ * committed record to the index; the index is then sorted by key and log
+ * position and only the last record of each key is kept (delete records
+ * drop the key). If the index fills up during mount it is compacted the
+ * same way and mount goes on.
+ */
+
+#define SEGMENT_MAGIC    (0x5254534EUL)    /* "NSTR" */
+#define KIND_DATA        (0x01U)
+#define KIND_DELETE      (0x02U)
+#define COMMITTED        (0x00U)
+#define DELETED_FLAG     (0x80000000UL)    /* index entry is a delete record (mount only) */
+#define PAD4(n)          (((n) + 3UL) & ~3UL)
+
+#define OFS_DATA_CRC     (12U)
+#define OFS_COMMIT       (19U)
+
+typedef struct {
+    uint32_t key;
+    uint32_t length;
+    uint32_t seq;
+    uint32_t dataCrc;
+    uint8_t kind;
+    uint8_t commit;
+    bool valid;              /* header CRC matches */
+    bool blank;              /* erased flash: end of the segment's records */
+} RecordHeader;
+
+/* Payload copy buffer for collection and verification (too big for the stack). */
+static uint8_t copyBuf[NOR_STORE_BLOCK];
+
+/* --- CRC-32 (IEEE, reflected), 16-entry table --- */
+
+static const uint32_t crcNibble[16] = {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+};
+
+static uint32_t Crc32(uint32_t crc, const uint8_t *p, uint32_t len)
+{
+    crc = ~crc;
+    while (len-- > 0U)
+    {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ crcNibble[crc & 0x0FU];
+        crc = (crc >> 4) ^ crcNibble[crc & 0x0FU];
+    }
+    return ~crc;
+}
+
+static uint32_t Get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void Put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/* --- Block cache --- */
+
+static void CacheInvalidate(NorStore *s, uint32_t addr, uint32_t len)
+{
+    for (uint8_t i = 0; i < NOR_STORE_CACHE_BLOCKS; i++)
+    {
+        NorStoreBlock *b = &s->cache[i];
+        if (b->addr != UINT32_MAX && b->addr < addr + len && addr < b->addr + NOR_STORE_BLOCK) {
+            b->addr = UINT32_MAX;
+        }
+    }
+}
+
+static bool CacheRead(NorStore *s, uint32_t addr, uint8_t *buf, uint32_t len)
+{
+    while (len > 0U)
+    {
+        uint32_t blockAddr = addr & ~(uint32_t)(NOR_STORE_BLOCK - 1U);
+        NorStoreBlock *hit = NULL;
+        NorStoreBlock *victim = &s->cache[0];
+
+        for (uint8_t i = 0; i < NOR_STORE_CACHE_BLOCKS; i++)
+        {
+            NorStoreBlock *b = &s->cache[i];
+            if (b->addr == blockAddr) { hit = b; break; }
+            if (b->addr == UINT32_MAX || b->lastUse < victim->lastUse) victim = b;
+        }
+        if (hit == NULL)
+        {
+            hit = victim;
+            hit->addr = UINT32_MAX;
+            if (!s->dev.read(s->dev.ctx, blockAddr, hit->data, NOR_STORE_BLOCK)) return false;
+            hit->addr = blockAddr;
+        }
+        hit->lastUse = ++s->useClock;
+
+        uint32_t off = addr - blockAddr;
+        uint32_t n = NOR_STORE_BLOCK - off;
+        if (n > len) n = len;
+        memcpy(buf, &hit->data[off], n);
+        buf += n;
+        addr += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool Program(NorStore *s, uint32_t addr, const uint8_t *buf, uint32_t len)
+{
+    CacheInvalidate(s, addr, len);
+    return s->dev.program(s->dev.ctx, addr, buf, len);
+}
+
+/* --- Segments --- */
+
+static uint32_t SegAddr(const NorStore *s, uint16_t seg)
+{
+    return (uint32_t)seg * s->dev.segmentSize;
+}
+
+/* Erase a segment and mark it free with its new erase count. */
+static bool EraseSegment(NorStore *s, uint16_t seg, uint32_t eraseCount)
+{
+    uint8_t hdr[8];
+
+    CacheInvalidate(s, SegAddr(s, seg), s->dev.segmentSize);
+    if (!s->dev.erase(s->dev.ctx, SegAddr(s, seg))) return false;
+
+    /* Erase count before the magic: a header with its magic is complete */
+    Put32(&hdr[0], SEGMENT_MAGIC);
+    Put32(&hdr[4], eraseCount);
+    if (eraseCount > s->maxEraseCount) s->maxEraseCount = eraseCount;
+    return Program(s, SegAddr(s, seg) + 4U, &hdr[4], 4U) &&
+           Program(s, SegAddr(s, seg), &hdr[0], 4U);
+}
+
+typedef enum { SEG_DIRTY = 0, SEG_FREE, SEG_USED } SegState;
+
+static SegState ReadSegment(NorStore *s, uint16_t seg, uint32_t *seq, uint32_t *eraseCount)
+{
+    uint8_t hdr[NOR_STORE_SEGMENT_HEADER];
+
+    if (!CacheRead(s, SegAddr(s, seg), hdr, sizeof(hdr)) || Get32(&hdr[0]) != SEGMENT_MAGIC) return SEG_DIRTY;
+    *eraseCount = Get32(&hdr[4]);
+    *seq = Get32(&hdr[8]);
+    if (*seq == UINT32_MAX && Get32(&hdr[12]) == UINT32_MAX) return SEG_FREE;
+    return (*seq == ~Get32(&hdr[12])) ? SEG_USED : SEG_DIRTY;
+}
+
+/* Open the next segment of the ring as the head. */
+static NorStoreStatus OpenSegment(NorStore *s)
+{
+    uint16_t seg = (s->used == 0U) ? s->head : (uint16_t)((s->head + 1U) % s->dev.segmentCount);
+    uint32_t seq;
+    uint32_t eraseCount = s->maxEraseCount;
+    uint8_t hdr[8];
+
+    if (ReadSegment(s, seg, &seq, &eraseCount) != SEG_FREE) {
+        if (!EraseSegment(s, seg, eraseCount + 1U)) return NOR_STORE_ERR_IO;
+    }
+
+    Put32(&hdr[0], s->nextSegSeq);
+    Put32(&hdr[4], ~s->nextSegSeq);
+    if (!Program(s, SegAddr(s, seg) + 8U, hdr, sizeof(hdr))) return NOR_STORE_ERR_IO;
+
+    s->nextSegSeq++;
+    if (s->used == 0U) s->tail = seg;
+    s->head = seg;
+    s->used++;
+    s->headOffset = NOR_STORE_SEGMENT_HEADER;
+    return NOR_STORE_OK;
+}
+
+/* --- Records --- */
+
+static uint16_t HeadCrc(const uint8_t *hdr)
+{
+    uint32_t crc = Crc32(0, hdr, 12U);
+    crc = Crc32(crc, &hdr[18], 1U);
+    return (uint16_t)crc;
+}
+
+static bool ReadRecord(NorStore *s, uint32_t addr, RecordHeader *r)
+{
+    uint8_t hdr[NOR_STORE_RECORD_HEADER];
+
+    if (!CacheRead(s, addr, hdr, sizeof(hdr))) return false;
+    r->key = Get32(&hdr[0]);
+    r->length = Get32(&hdr[4]);
+    r->seq = Get32(&hdr[8]);
+    r->dataCrc = Get32(&hdr[OFS_DATA_CRC]);
+    r->kind = hdr[18];
+    r->commit = hdr[OFS_COMMIT];
+    r->blank = (r->key == UINT32_MAX && r->length == UINT32_MAX && r->kind == 0xFFU);
+    r->valid = !r->blank && (uint16_t)(hdr[16] | (hdr[17] << 8)) == HeadCrc(hdr);
+    return true;
+}
+
+/* Record header with dataCrc and commit still erased. */
+static bool WriteRecordHeader(NorStore *s, uint32_t addr, uint32_t key, uint32_t length, uint8_t kind)
+{
+    uint8_t hdr[NOR_STORE_RECORD_HEADER];
+
+    Put32(&hdr[0], key);
+    Put32(&hdr[4], length);
+    Put32(&hdr[8], s->nextSeq++);
+    Put32(&hdr[OFS_DATA_CRC], UINT32_MAX);
+    hdr[18] = kind;
+    hdr[OFS_COMMIT] = 0xFFU;
+    uint16_t crc = HeadCrc(hdr);
+    hdr[16] = (uint8_t)crc;
+    hdr[17] = (uint8_t)(crc >> 8);
+    return Program(s, addr, hdr, sizeof(hdr));
+}
+
+static bool CommitRecord(NorStore *s, uint32_t addr, uint32_t dataCrc)
+{
+    uint8_t crc[4];
+    uint8_t commit = COMMITTED;
+
+    Put32(crc, dataCrc);
+    return Program(s, addr + OFS_DATA_CRC, crc, sizeof(crc)) &&
+           Program(s, addr + OFS_COMMIT, &commit, 1U);
+}
+
+/* --- Index --- */
+
+/* First entry with key >= key */
+static uint16_t LowerBound(const NorStore *s, uint32_t key)
+{
+    uint16_t lo = 0;
+    uint16_t hi = s->count;
+    while (lo < hi)
+    {
+        uint16_t mid = (uint16_t)((lo + hi) / 2U);
+        if (s->index[mid].key < key) lo = (uint16_t)(mid + 1U);
+        else hi = mid;
+    }
+    return lo;
+}
+
+static bool IndexSet(NorStore *s, uint32_t key, uint32_t addr)
+{
+    uint16_t i = LowerBound(s, key);
+    if (i < s->count && s->index[i].key == key) {
+        s->index[i].addr = addr;
+        return true;
+    }
+    if (s->count >= NOR_STORE_INDEX_MAX) return false;
+    memmove(&s->index[i + 1U], &s->index[i], (size_t)(s->count - i) * sizeof(NorStoreEntry));
+    s->index[i].key = key;
+    s->index[i].addr = addr;
+    s->count++;
+    return true;
+}
+
+static void IndexRemove(NorStore *s, uint32_t key)
+{
+    uint16_t i = LowerBound(s, key);
+    if (i < s->count && s->index[i].key == key) {
+        memmove(&s->index[i], &s->index[i + 1U], (size_t)(s->count - i - 1U) * sizeof(NorStoreEntry));
+        s->count--;
+    }
+}
+
+/* Position of a record in the log (tail segment first) */
+static uint32_t LogPos(const NorStore *s, uint32_t addr)
+{
+    uint32_t a = addr & ~DELETED_FLAG;
+    uint16_t seg = (uint16_t)(a / s->dev.segmentSize);
+    uint16_t age = (uint16_t)((seg + s->dev.segmentCount - s->tail) % s->dev.segmentCount);
+    return (uint32_t)age * s->dev.segmentSize + a % s->dev.segmentSize;
+}
+
+static bool Before(const NorStore *s, const NorStoreEntry *a, const NorStoreEntry *b)
+{
+    if (a->key != b->key) return a->key < b->key;
+    return LogPos(s, a->addr) < LogPos(s, b->addr);
+}
+
+static void SiftDown(NorStore *s, uint16_t i, uint16_t n)
+{
+    for (;;)
+    {
+        uint16_t c = (uint16_t)(2U * i + 1U);
+        if (c >= n) return;
+        if (c + 1U < n && Before(s, &s->index[c], &s->index[c + 1U])) c++;
+        if (!Before(s, &s->index[i], &s->index[c])) return;
+        NorStoreEntry t = s->index[i];
+        s->index[i] = s->index[c];
+        s->index[c] = t;
+        i = c;
+    }
+}
+
+/* Sort by key and log position (heapsort), keep the last record per key, drop deletes. */
+static void Compact(NorStore *s)
+{
+    uint16_t n = s->count;
+
+    for (uint16_t i = n / 2U; i-- > 0U; ) SiftDown(s, i, n);
+    for (uint16_t end = n; end-- > 1U; )
+    {
+        NorStoreEntry t = s->index[0];
+        s->index[0] = s->index[end];
+        s->index[end] = t;
+        SiftDown(s, 0, end);
+    }
+
+    uint16_t out = 0;
+    for (uint16_t i = 0; i < n; i++)
+    {
+        if (i + 1U < n && s->index[i + 1U].key == s->index[i].key) continue;
+        if ((s->index[i].addr & DELETED_FLAG) != 0U) continue;
+        s->index[out++] = s->index[i];
+    }
+    s->count = out;
+}
+
+/* --- Space --- */
+
+/* Move the current items out of the tail segment and free it. */
+static NorStoreStatus Collect(NorStore *s);
+
+/* Room for a record of `size` bytes at the head (collecting when allowed). */
+static NorStoreStatus Reserve(NorStore *s, uint32_t size, bool collect)
+{
+    if (s->used > 0U && s->headOffset + size <= s->dev.segmentSize) return NOR_STORE_OK;
+
+    /* Collect until the reserve is back. A tail that is all current only
+       moves to the head; once every segment has been collected without
+       freeing one, the store is full. */
+    uint16_t tries = s->dev.segmentCount;
+    while (collect && (uint16_t)(s->dev.segmentCount - s->used) <= NOR_STORE_RESERVE)
+    {
+        if (tries-- == 0U) return NOR_STORE_ERR_FULL;
+        NorStoreStatus st = Collect(s);
+        if (st != NOR_STORE_OK) return st;
+    }
+    if (s->used > 0U && s->headOffset + size <= s->dev.segmentSize) return NOR_STORE_OK;
+    if (s->used >= s->dev.segmentCount) return NOR_STORE_ERR_FULL;
+    return OpenSegment(s);
+}
+
+static NorStoreStatus Collect(NorStore *s)
+{
+    uint16_t seg = s->tail;
+    uint32_t base = SegAddr(s, seg);
+    uint32_t offset = NOR_STORE_SEGMENT_HEADER;
+    uint32_t seq;
+    uint32_t eraseCount = s->maxEraseCount;
+    RecordHeader r;
+
+    if (s->used <= 1U) return NOR_STORE_ERR_FULL;
+
+    while (offset + NOR_STORE_RECORD_HEADER <= s->dev.segmentSize)
+    {
+        uint32_t addr = base + offset;
+        if (!ReadRecord(s, addr, &r)) return NOR_STORE_ERR_IO;
+        if (r.blank || !r.valid || r.length > s->dev.segmentSize - offset - NOR_STORE_RECORD_HEADER) break;
+        offset += NOR_STORE_RECORD_HEADER + PAD4(r.length);
+
+        uint16_t i = LowerBound(s, r.key);
+        if (r.commit != COMMITTED || r.kind != KIND_DATA || i >= s->count ||
+            s->index[i].key != r.key || s->index[i].addr != addr) continue;
+
+        /* Still current: copy it to the head */
+        uint32_t size = NOR_STORE_RECORD_HEADER + PAD4(r.length);
+        NorStoreStatus st = Reserve(s, size, false);
+        if (st != NOR_STORE_OK) return st;
+
+        uint32_t to = SegAddr(s, s->head) + s->headOffset;
+        if (!WriteRecordHeader(s, to, r.key, r.length, KIND_DATA)) return NOR_STORE_ERR_IO;
+        for (uint32_t done = 0; done < r.length; )
+        {
+            uint32_t n = r.length - done;
+            if (n > sizeof(copyBuf)) n = sizeof(copyBuf);
+            if (!s->dev.read(s->dev.ctx, addr + NOR_STORE_RECORD_HEADER + done, copyBuf, n) ||
+                !Program(s, to + NOR_STORE_RECORD_HEADER + done, copyBuf, n)) return NOR_STORE_ERR_IO;
+            done += n;
+        }
+        if (!CommitRecord(s, to, r.dataCrc)) return NOR_STORE_ERR_IO;
+        s->headOffset += size;
+        s->index[i].addr = to;
+    }
+
+    (void)ReadSegment(s, seg, &seq, &eraseCount);
+    if (!EraseSegment(s, seg, eraseCount + 1U)) return NOR_STORE_ERR_IO;
+    s->tail = (uint16_t)((seg + 1U) % s->dev.segmentCount);
+    s->used--;
+    return NOR_STORE_OK;
+}
+
+/* --- API --- */
+
+static void Reset(NorStore *s, const NorDevice *dev)
+{
+    memset(s, 0, sizeof(*s));
+    s->dev = *dev;
+    for (uint8_t i = 0; i < NOR_STORE_CACHE_BLOCKS; i++) s->cache[i].addr = UINT32_MAX;
+}
+
+NorStoreStatus NorStore_Format(NorStore *s, const NorDevice *dev)
+{
+    Reset(s, dev);
+    if (dev->segmentCount < 2U + NOR_STORE_RESERVE) return NOR_STORE_ERR_FULL;
+
+    for (uint16_t seg = 0; seg < dev->segmentCount; seg++)
+    {
+        uint32_t seq;
+        uint32_t eraseCount = 0;
+        if (ReadSegment(s, seg, &seq, &eraseCount) == SEG_DIRTY) eraseCount = 0;
+        if (!EraseSegment(s, seg, eraseCount + 1U)) return NOR_STORE_ERR_IO;
+    }
+    return NOR_STORE_OK;
+}
+
+NorStoreStatus NorStore_Mount(NorStore *s, const NorDevice *dev)
+{
+    uint32_t minSeq = UINT32_MAX;
+    bool formatted = false;
+
+    Reset(s, dev);
+    if (dev->segmentCount < 2U + NOR_STORE_RESERVE) return NOR_STORE_ERR_FULL;
+
+    /* Segment headers: the run in use starts at the lowest seq */
+    for (uint16_t seg = 0; seg < dev->segmentCount; seg++)
+    {
+        uint32_t seq = 0;
+        uint32_t eraseCount = 0;
+        SegState st = ReadSegment(s, seg, &seq, &eraseCount);
+        if (st == SEG_DIRTY) continue;
+        formatted = true;
+        if (eraseCount > s->maxEraseCount) s->maxEraseCount = eraseCount;
+        if (st == SEG_USED)
+        {
+            if (seq < minSeq) { minSeq = seq; s->tail = seg; }
+            if (seq >= s->nextSegSeq) s->nextSegSeq = seq + 1U;
+        }
+    }
+    if (!formatted) return NOR_STORE_ERR_UNFORMATTED;
+
+    s->head = s->tail;
+    if (minSeq != UINT32_MAX)
+    {
+        for (uint16_t n = 0; n < dev->segmentCount; n++)
+        {
+            uint16_t seg = (uint16_t)((s->tail + n) % dev->segmentCount);
+            uint32_t seq;
+            uint32_t eraseCount;
+            if (ReadSegment(s, seg, &seq, &eraseCount) != SEG_USED || seq != minSeq + n) break;
+            s->head = seg;
+            s->used++;
+        }
+    }
+
+    /* Records of the run, in log order */
+    for (uint16_t n = 0; n < s->used; n++)
+    {
+        uint16_t seg = (uint16_t)((s->tail + n) % dev->segmentCount);
+        uint32_t base = SegAddr(s, seg);
+        uint32_t offset = NOR_STORE_SEGMENT_HEADER;
+        RecordHeader r;
+
+        while (offset + NOR_STORE_RECORD_HEADER <= dev->segmentSize)
+        {
+            if (!ReadRecord(s, base + offset, &r)) return NOR_STORE_ERR_IO;
+            if (r.blank) break;
+            if (!r.valid || r.length > dev->segmentSize - offset - NOR_STORE_RECORD_HEADER) {
+                offset = dev->segmentSize;      /* torn header: rest of the segment unused */
+                break;
+            }
+            if (r.seq >= s->nextSeq) s->nextSeq = r.seq + 1U;
+
+            if (r.commit == COMMITTED && (r.kind == KIND_DATA || r.kind == KIND_DELETE))
+            {
+                if (s->count >= NOR_STORE_INDEX_MAX) {
+                    Compact(s);
+                    if (s->count >= NOR_STORE_INDEX_MAX) return NOR_STORE_ERR_INDEX_FULL;
+                }
+                s->index[s->count].key = r.key;
+                s->index[s->count].addr = (base + offset) | ((r.kind == KIND_DELETE) ? DELETED_FLAG : 0U);
+                s->count++;
+            }
+            offset += NOR_STORE_RECORD_HEADER + PAD4(r.length);
+        }
+        if (seg == s->head) s->headOffset = offset;
+    }
+    Compact(s);
+
+    /* Segments outside the run that are not cleanly free: erase them again */
+    for (uint16_t n = s->used; n < dev->segmentCount; n++)
+    {
+        uint16_t seg = (uint16_t)((s->tail + n) % dev->segmentCount);
+        uint32_t seq;
+        uint32_t eraseCount = s->maxEraseCount;
+        if (ReadSegment(s, seg, &seq, &eraseCount) != SEG_FREE) {
+            if (!EraseSegment(s, seg, eraseCount + 1U)) return NOR_STORE_ERR_IO;
+        }
+    }
+    return NOR_STORE_OK;
+}
+
+NorStoreStatus NorStore_Find(NorStore *s, uint32_t key, NorStoreItem *item)
+{
+    RecordHeader r;
+    uint16_t i = LowerBound(s, key);
+
+    if (i >= s->count || s->index[i].key != key) return NOR_STORE_ERR_NOT_FOUND;
+    if (!ReadRecord(s, s->index[i].addr, &r)) return NOR_STORE_ERR_IO;
+
+    item->store = s;
+    item->key = key;
+    item->data = s->index[i].addr + NOR_STORE_RECORD_HEADER;
+    item->length = r.length;
+    item->crc = r.dataCrc;
+    return NOR_STORE_OK;
+}
+
+bool NorStore_Read(const NorStoreItem *item, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    if (offset > item->length || len > item->length - offset) return false;
+    return CacheRead(item->store, item->data + offset, buf, len);
+}
+
+NorStoreStatus NorStore_Verify(const NorStoreItem *item)
+{
+    NorStore *s = item->store;
+    uint32_t crc = 0;
+
+    for (uint32_t done = 0; done < item->length; )
+    {
+        uint32_t n = item->length - done;
+        if (n > sizeof(copyBuf)) n = sizeof(copyBuf);
+        if (!s->dev.read(s->dev.ctx, item->data + done, copyBuf, n)) return NOR_STORE_ERR_IO;
+        crc = Crc32(crc, copyBuf, n);
+        done += n;
+    }
+    return (crc == item->crc) ? NOR_STORE_OK : NOR_STORE_ERR_CRC;
+}
+
+static bool SourceRead(void *ctx, uint32_t offset, uint8_t *buf, uint16_t len)
+{
+    return NorStore_Read((const NorStoreItem *)ctx, offset, buf, len);
+}
+
+void NorStore_Source(NorStoreItem *item, SmfSource *src)
+{
+    src->base = NULL;
+    src->read = SourceRead;
+    src->ctx = item;
+    src->size = item->length;
+}
+
+NorStoreStatus NorStore_Begin(NorStore *s, uint32_t key, uint32_t length)
+{
+    s->writing = false;     /* an unfinished record is left uncommitted */
+
+    if (length > NOR_STORE_MAX_PAYLOAD(s->dev.segmentSize)) return NOR_STORE_ERR_TOO_LARGE;
+    uint16_t i = LowerBound(s, key);
+    if (s->count >= NOR_STORE_INDEX_MAX && (i >= s->count || s->index[i].key != key)) return NOR_STORE_ERR_INDEX_FULL;
+
+    uint32_t size = NOR_STORE_RECORD_HEADER + PAD4(length);
+    NorStoreStatus st = Reserve(s, size, true);
+    if (st != NOR_STORE_OK) return st;
+
+    uint32_t addr = SegAddr(s, s->head) + s->headOffset;
+    if (!WriteRecordHeader(s, addr, key, length, KIND_DATA)) return NOR_STORE_ERR_IO;
+    s->headOffset += size;
+
+    s->writing = true;
+    s->writeAddr = addr;
+    s->writeKey = key;
+    s->writeLength = length;
+    s->written = 0;
+    s->writeCrc = 0;
+    return NOR_STORE_OK;
+}
+
+NorStoreStatus NorStore_Append(NorStore *s, const uint8_t *data, uint32_t length)
+{
+    if (!s->writing || length > s->writeLength - s->written) return NOR_STORE_ERR_STATE;
+    if (length == 0U) return NOR_STORE_OK;
+
+    if (!Program(s, s->writeAddr + NOR_STORE_RECORD_HEADER + s->written, data, length)) {
+        s->writing = false;
+        return NOR_STORE_ERR_IO;
+    }
+    s->writeCrc = Crc32(s->writeCrc, data, length);
+    s->written += length;
+    return NOR_STORE_OK;
+}
+
+NorStoreStatus NorStore_Commit(NorStore *s)
+{
+    if (!s->writing || s->written != s->writeLength) return NOR_STORE_ERR_STATE;
+    s->writing = false;
+
+    if (!CommitRecord(s, s->writeAddr, s->writeCrc)) return NOR_STORE_ERR_IO;
+    return IndexSet(s, s->writeKey, s->writeAddr) ? NOR_STORE_OK : NOR_STORE_ERR_INDEX_FULL;
+}
+
+NorStoreStatus NorStore_Write(NorStore *s, uint32_t key, const uint8_t *data, uint32_t length)
+{
+    NorStoreStatus st = NorStore_Begin(s, key, length);
+    if (st == NOR_STORE_OK) st = NorStore_Append(s, data, length);
+    if (st == NOR_STORE_OK) st = NorStore_Commit(s);
+    return st;
+}
+
+NorStoreStatus NorStore_Delete(NorStore *s, uint32_t key)
+{
+    uint16_t i = LowerBound(s, key);
+    if (i >= s->count || s->index[i].key != key) return NOR_STORE_ERR_NOT_FOUND;
+
+    s->writing = false;
+    NorStoreStatus st = Reserve(s, NOR_STORE_RECORD_HEADER, true);
+    if (st != NOR_STORE_OK) return st;
+
+    uint32_t addr = SegAddr(s, s->head) + s->headOffset;
+    if (!WriteRecordHeader(s, addr, key, 0, KIND_DELETE) || !CommitRecord(s, addr, 0)) return NOR_STORE_ERR_IO;
+    s->headOffset += NOR_STORE_RECORD_HEADER;
+    IndexRemove(s, key);
+    return NOR_STORE_OK;
+}
+
+uint32_t NorStore_KeyAt(const NorStore *s, uint16_t i)
+{
+    return (i < s->count) ? s->index[i].key : UINT32_MAX;
+}
+
+uint16_t NorStore_Count(const NorStore *s)
+{
+    return s->count;
+}
+
+uint32_t NorStore_FreeBytes(const NorStore *s)
+{
+    uint32_t perSegment = s->dev.segmentSize - NOR_STORE_SEGMENT_HEADER;
+    uint16_t free = (uint16_t)(s->dev.segmentCount - s->used);
+    uint32_t bytes = (free > NOR_STORE_RESERVE) ? (uint32_t)(free - NOR_STORE_RESERVE) * perSegment : 0U;
+    if (s->used > 0U) bytes += s->dev.segmentSize - s->headOffset;
+    return bytes;
+}
@@ -1,7 +1,6 @@
 #include "notes.h"
 #include <string.h>
 #include <stdio.h>
-#include <ctype.h>
 
 /**
  * @file notes.c
@@ -15,124 +14,92 @@
  * - Legacy names: CIS/DES, DIS/ES, FIS/GES, GIS/AS, AIS/BES/HES
  *
  * Octave is given as the last character (0..9). MIDI convention: C4 = 60.
- */
-
-
-/**
- * @brief Map an uppercase note root string to a semitone number.
  *
- * @param root Uppercase note root without octave (e.g. "C", "CIS", "DB", "F#").
- * @return Semitone number in range 0..11 on success, or -1 on failure.
+ * Names known when the firmware is built are resolved by the compiler
+ * instead (PITCH() in songs.h, table generated from this parser by
+ * Tools/gen_note_names.c). Tools/note_parse_bench.c times the parser.
  */
-static int8_t NoteName_MapRootToSemitone(const char *root)
-{
-    if (root == NULL || *root == '\0') {
-        return -1;
-    }
-
-    // --- New notation (preferred): English with # and b ---
-    // IMPORTANT:
-    //  - "B" means B natural (semitone 11)
-    //  - Flats are written as "Bb", "Db", etc.
-    //  - Input is already uppercased in NoteName_ToMidi(), so 'b' becomes 'B'
-    if (strcmp(root, "C") == 0) return 0;
-    if (strcmp(root, "D") == 0) return 2;
-    if (strcmp(root, "E") == 0) return 4;
-    if (strcmp(root, "F") == 0) return 5;
-    if (strcmp(root, "G") == 0) return 7;
-    if (strcmp(root, "A") == 0) return 9;
-    if (strcmp(root, "B") == 0) return 11;  // B natural
-
-    // Keep compatibility with older Polish/German notation:
-    if (strcmp(root, "H") == 0) return 11;  // H = B natural
-
-    // Two-character accidentals: "C#", "DB", "BB" (Bb), etc.
-    if (strlen(root) == 2)
-    {
-        char base = root[0];
-        char acc  = root[1];
-
-        int8_t baseSemi = -1;
-        switch (base)
-        {
-            case 'C': baseSemi = 0;  break;
-            case 'D': baseSemi = 2;  break;
-            case 'E': baseSemi = 4;  break;
-            case 'F': baseSemi = 5;  break;
-            case 'G': baseSemi = 7;  break;
-            case 'A': baseSemi = 9;  break;
-            case 'B': baseSemi = 11; break;  // base B
-            case 'H': baseSemi = 11; break;  // base H (compat)
-            default:  baseSemi = -1; break;
-        }
-        if (baseSemi < 0) return -1;
-
-        if (acc == '#') {
-            return (int8_t)((baseSemi + 1) % 12);
-        }
 
-        // Flat: user typed 'b' -> becomes 'B' after toupper()
-        if (acc == 'B') {
-            return (int8_t)((baseSemi + 11) % 12); // -1 mod 12
-        }
-    }
 
-    // --- Legacy compatibility: CIS/DES etc. ---
-    if (strcmp(root, "CIS") == 0 || strcmp(root, "DES") == 0)  return 1;
-    if (strcmp(root, "DIS") == 0 || strcmp(root, "ES")  == 0)  return 3;
-    if (strcmp(root, "FIS") == 0 || strcmp(root, "GES") == 0)  return 6;
-    if (strcmp(root, "GIS") == 0 || strcmp(root, "AS")  == 0)  return 8;
+/* Semitone of each letter 'A'..'H' (B and H are both B natural) */
+static const int8_t letterSemitone[8] = { 9, 11, 0, 2, 4, 5, 7, 11 };
 
-    // Old "AIS" and also "BES/HES" are Bb (semitone 10)
-    if (strcmp(root, "AIS") == 0 || strcmp(root, "BES") == 0 || strcmp(root, "HES") == 0) return 10;
+/* Letter bits for accidentalSuffixes[].letters: 1 << (letter - 'A') */
+#define LETTERS_ALL   (0xFFU)
+#define LETTERS_A_E   ((1U << ('A' - 'A')) | (1U << ('E' - 'A')))
 
-    return -1;
+/*
+ * Accidental suffixes after the letter (uppercase, the input is folded while
+ * matching). "B" after a letter is the flat sign ("Bb" -> "BB"). German
+ * names: "IS" raises any letter, "ES" lowers it, except A / E which take
+ * "S" alone (AS, ES).
+ */
+static const struct {
+    char text[3];
+    int8_t alter;
+    uint8_t letters;    /* letters the suffix may follow */
+} accidentalSuffixes[] = {
+    { "",    0, LETTERS_ALL },
+    { "#",  +1, LETTERS_ALL },
+    { "B",  -1, LETTERS_ALL },
+    { "IS", +1, LETTERS_ALL },
+    { "ES", -1, (uint8_t)(LETTERS_ALL & ~LETTERS_A_E) },
+    { "S",  -1, LETTERS_A_E },
+};
+
+/* ASCII uppercase without the locale lookup of toupper() */
+static inline char NoteName_Fold(char c)
+{
+    return (c >= 'a' && c <= 'z') ? (char)(c - ('a' - 'A')) : c;
 }
 
 /**
- * @brief Parse a note name string and convert it to a MIDI note number.
+ * @brief Parse a note name of known length and convert it to a MIDI note number.
  *
- * The input is case-insensitive. The last character must be an octave digit (0..9).
- * Returns a status code describing the first error encountered.
+ * Table-driven: the letter indexes letterSemitone[], the characters between
+ * the letter and the octave digit are matched against accidentalSuffixes[]
+ * (case-insensitively, in place). No copy, no strcmp; the octave belongs to
+ * the letter, so "Cb4" is 59 and "B#4" 72.
  */
-NoteParseStatus NoteName_ToMidi(const char *name, uint8_t *outNote) {
-    if (name == NULL || outNote == NULL) {
+NoteParseStatus NoteName_ToMidiN(const char *name, size_t len, uint8_t *outNote) {
+    if (name == NULL || outNote == NULL || len < 2 || len >= 8) {
         return NOTE_ERR_INVALID_FORMAT;
     }
 
-    // Make an uppercase copy of the input string (to handle case-insensitivity)
-    char temp[8];
-    size_t len = strlen(name);
-    if (len < 2 || len >= sizeof(temp)) {
-        // Need at least 2 characters (note + octave), and not exceed buffer
-        return NOTE_ERR_INVALID_FORMAT;
-    }
-    for (size_t i = 0; i < len; ++i) {
-        temp[i] = toupper((unsigned char)name[i]);
-    }
-    temp[len] = '\0';
-
     // The last character should be the octave digit (0–9)
-    char octaveChar = temp[len - 1];
+    char octaveChar = name[len - 1];
     if (octaveChar < '0' || octaveChar > '9') {
         return NOTE_ERR_INVALID_FORMAT;
     }
     int octave = octaveChar - '0';
 
-    // Everything before the last char is the note root
-    temp[len - 1] = '\0';  // isolate the root part
-    const char *root = temp;
-    if (*root == '\0') {
-        return NOTE_ERR_INVALID_FORMAT;
+    unsigned letter = (unsigned)NoteName_Fold(name[0]) - 'A';
+    if (letter >= sizeof(letterSemitone)) {
+        return NOTE_ERR_INVALID_NOTE;
     }
 
-    int8_t semitone = NoteName_MapRootToSemitone(root);
-    if (semitone < 0) {
+    // Accidental: everything between the letter and the octave
+    const char *suffix = &name[1];
+    size_t suffixLen = len - 2;
+    size_t i;
+    for (i = 0; i < sizeof(accidentalSuffixes) / sizeof(accidentalSuffixes[0]); ++i) {
+        const char *text = accidentalSuffixes[i].text;
+        size_t k = 0;
+        while (k < suffixLen && text[k] != '\0' && NoteName_Fold(suffix[k]) == text[k]) {
+            ++k;
+        }
+        if (k == suffixLen && text[k] == '\0') {
+            break;
+        }
+    }
+    if (i == sizeof(accidentalSuffixes) / sizeof(accidentalSuffixes[0]) ||
+        (accidentalSuffixes[i].letters & (1U << letter)) == 0U) {
         return NOTE_ERR_INVALID_NOTE;
     }
+    int alter = accidentalSuffixes[i].alter;
 
     // Compute MIDI note number: MIDI = 12 * (octave + 1) + semitone
-    int midi = 12 * (octave + 1) + semitone;
+    int midi = 12 * (octave + 1) + letterSemitone[letter] + alter;
     if (midi < 0 || midi > 127) {
         return NOTE_ERR_INVALID_OCTAVE;
     }
@@ -141,6 +108,24 @@ NoteParseStatus NoteName_ToMidi(const char *name, uint8_t *outNote) {
     return NOTE_OK;
 }
 
+/**
+ * @brief Parse a note name string and convert it to a MIDI note number.
+ *
+ * The input is case-insensitive. The last character must be an octave digit (0..9).
+ * Returns a status code describing the first error encountered.
+ */
+NoteParseStatus NoteName_ToMidi(const char *name, uint8_t *outNote) {
+    if (name == NULL) {
+        return NOTE_ERR_INVALID_FORMAT;
+    }
+    // Names longer than 7 characters are rejected without reading further
+    size_t len = 0;
+    while (len < 8 && name[len] != '\0') {
+        ++len;
+    }
+    return NoteName_ToMidiN(name, len, outNote);
+}
+
 /**
  * @brief Convert an array of note name strings into MIDI note numbers.
  *
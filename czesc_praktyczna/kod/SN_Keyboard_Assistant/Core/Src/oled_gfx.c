@@ -0,0 +1,221 @@
+#include "oled_gfx.h"
+#include <string.h>
+
+/**
+ * @file oled_gfx.c
+ * @brief 1-bit drawing primitives for the OLED framebuffer (see oled_gfx.h).
+ *
+ * All writes go through Store(), which compares with the current byte and
+ * only widens the page's dirty range on a real change. Redrawing a screen
+ * that is mostly identical therefore costs almost nothing on the bus.
+ *
+ * HAL-free, so it also builds on the host (Tools/oled_preview.c).
+ */
+
+/* Classic 5x7 font, ASCII 0x20..0x7E, column bytes (bit 0 = top row). */
+static const uint8_t font5x7[95][5] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, /*   ! */
+    { 0x00, 0x07, 0x00, 0x07, 0x00 }, { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, /* " # */
+    { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 }, /* $ % */
+    { 0x36, 0x49, 0x55, 0x22, 0x50 }, { 0x00, 0x05, 0x03, 0x00, 0x00 }, /* & ' */
+    { 0x00, 0x1C, 0x22, 0x41, 0x00 }, { 0x00, 0x41, 0x22, 0x1C, 0x00 }, /* ( ) */
+    { 0x14, 0x08, 0x3E, 0x08, 0x14 }, { 0x08, 0x08, 0x3E, 0x08, 0x08 }, /* * + */
+    { 0x00, 0x50, 0x30, 0x00, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, /* , - */
+    { 0x00, 0x60, 0x60, 0x00, 0x00 }, { 0x20, 0x10, 0x08, 0x04, 0x02 }, /* . / */
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 }, /* 0 1 */
+    { 0x42, 0x61, 0x51, 0x49, 0x46 }, { 0x21, 0x41, 0x45, 0x4B, 0x31 }, /* 2 3 */
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, { 0x27, 0x45, 0x45, 0x45, 0x39 }, /* 4 5 */
+    { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, { 0x01, 0x71, 0x09, 0x05, 0x03 }, /* 6 7 */
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x06, 0x49, 0x49, 0x29, 0x1E }, /* 8 9 */
+    { 0x00, 0x36, 0x36, 0x00, 0x00 }, { 0x00, 0x56, 0x36, 0x00, 0x00 }, /* : ; */
+    { 0x08, 0x14, 0x22, 0x41, 0x00 }, { 0x14, 0x14, 0x14, 0x14, 0x14 }, /* < = */
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x51, 0x09, 0x06 }, /* > ? */
+    { 0x32, 0x49, 0x79, 0x41, 0x3E }, { 0x7E, 0x11, 0x11, 0x11, 0x7E }, /* @ A */
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 }, /* B C */
+    { 0x7F, 0x41, 0x41, 0x22, 0x1C }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, /* D E */
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 }, { 0x3E, 0x41, 0x49, 0x49, 0x7A }, /* F G */
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 }, /* H I */
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 }, /* J K */
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 }, { 0x7F, 0x02, 0x0C, 0x02, 0x7F }, /* L M */
+    { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E }, /* N O */
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, /* P Q */
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 }, { 0x46, 0x49, 0x49, 0x49, 0x31 }, /* R S */
+    { 0x01, 0x01, 0x7F, 0x01, 0x01 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F }, /* T U */
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F }, /* V W */
+    { 0x63, 0x14, 0x08, 0x14, 0x63 }, { 0x07, 0x08, 0x70, 0x08, 0x07 }, /* X Y */
+    { 0x61, 0x51, 0x49, 0x45, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x00 }, /* Z [ */
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x7F, 0x00 }, /* \ ] */
+    { 0x04, 0x02, 0x01, 0x02, 0x04 }, { 0x40, 0x40, 0x40, 0x40, 0x40 }, /* ^ _ */
+    { 0x00, 0x01, 0x02, 0x04, 0x00 }, { 0x20, 0x54, 0x54, 0x54, 0x78 }, /* ` a */
+    { 0x7F, 0x48, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x20 }, /* b c */
+    { 0x38, 0x44, 0x44, 0x48, 0x7F }, { 0x38, 0x54, 0x54, 0x54, 0x18 }, /* d e */
+    { 0x08, 0x7E, 0x09, 0x01, 0x02 }, { 0x0C, 0x52, 0x52, 0x52, 0x3E }, /* f g */
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, /* h i */
+    { 0x20, 0x40, 0x44, 0x3D, 0x00 }, { 0x7F, 0x10, 0x28, 0x44, 0x00 }, /* j k */
+    { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x18, 0x04, 0x78 }, /* l m */
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 }, /* n o */
+    { 0x7C, 0x14, 0x14, 0x14, 0x08 }, { 0x08, 0x14, 0x14, 0x18, 0x7C }, /* p q */
+    { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x20 }, /* r s */
+    { 0x04, 0x3F, 0x44, 0x40, 0x20 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, /* t u */
+    { 0x1C, 0x20, 0x40, 0x20, 0x1C }, { 0x3C, 0x40, 0x30, 0x40, 0x3C }, /* v w */
+    { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x0C, 0x50, 0x50, 0x50, 0x3C }, /* x y */
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 }, /* z { */
+    { 0x00, 0x00, 0x7F, 0x00, 0x00 }, { 0x00, 0x41, 0x36, 0x08, 0x00 }, /* | } */
+    { 0x10, 0x08, 0x08, 0x10, 0x08 },                                   /* ~   */
+};
+
+/* Replaces the bits selected by mask in buf[page][x]; tracks the change. */
+static void Store(OledGfx_t *g, uint8_t page, uint8_t x, uint8_t mask, uint8_t bits)
+{
+    uint8_t old = g->buf[page][x];
+    uint8_t val = (uint8_t)((old & (uint8_t)~mask) | (bits & mask));
+    if (val == old) return;
+
+    g->buf[page][x] = val;
+    if (g->dirtyLo[page] > g->dirtyHi[page]) {
+        g->dirtyLo[page] = x;
+        g->dirtyHi[page] = x;
+    } else {
+        if (x < g->dirtyLo[page]) g->dirtyLo[page] = x;
+        if (x > g->dirtyHi[page]) g->dirtyHi[page] = x;
+    }
+}
+
+/* Empty range: lo > hi. */
+static void MarkClean(OledGfx_t *g, uint8_t page)
+{
+    g->dirtyLo[page] = 0xFFU;
+    g->dirtyHi[page] = 0;
+}
+
+void OledGfx_Init(OledGfx_t *g)
+{
+    memset(g->buf, 0, sizeof(g->buf));
+    for (uint8_t p = 0; p < OLED_PAGES; p++) MarkClean(g, p);
+}
+
+void OledGfx_MarkAllDirty(OledGfx_t *g)
+{
+    memset(g->dirtyLo, 0, sizeof(g->dirtyLo));
+    memset(g->dirtyHi, OLED_WIDTH - 1U, sizeof(g->dirtyHi));
+}
+
+bool OledGfx_TakeChanges(OledGfx_t *g, uint8_t shadow[OLED_PAGES][OLED_WIDTH],
+                         uint8_t page, uint8_t *lo, uint8_t *hi)
+{
+    if (page >= OLED_PAGES || g->dirtyLo[page] > g->dirtyHi[page]) return false;
+
+    uint8_t first = g->dirtyLo[page];
+    uint8_t last = g->dirtyHi[page];
+    MarkClean(g, page);
+
+    while (first <= last && g->buf[page][first] == shadow[page][first]) first++;
+    if (first > last) return false;
+    while (g->buf[page][last] == shadow[page][last]) last--;
+
+    memcpy(&shadow[page][first], &g->buf[page][first], (size_t)(last - first + 1U));
+    *lo = first;
+    *hi = last;
+    return true;
+}
+
+bool OledGfx_IsDirty(const OledGfx_t *g)
+{
+    for (uint8_t p = 0; p < OLED_PAGES; p++) {
+        if (g->dirtyLo[p] <= g->dirtyHi[p]) return true;
+    }
+    return false;
+}
+
+void OledGfx_SetPixel(OledGfx_t *g, int16_t x, int16_t y, bool on)
+{
+    if (x < 0 || y < 0 || x >= (int16_t)OLED_WIDTH || y >= (int16_t)OLED_HEIGHT) return;
+
+    uint8_t bit = (uint8_t)(1U << (y & 7));
+    Store(g, (uint8_t)(y >> 3), (uint8_t)x, bit, on ? bit : 0U);
+}
+
+bool OledGfx_GetPixel(const OledGfx_t *g, int16_t x, int16_t y)
+{
+    if (x < 0 || y < 0 || x >= (int16_t)OLED_WIDTH || y >= (int16_t)OLED_HEIGHT) return false;
+    return (g->buf[y >> 3][x] & (1U << (y & 7))) != 0U;
+}
+
+void OledGfx_FillRect(OledGfx_t *g, int16_t x, int16_t y, int16_t w, int16_t h, bool on)
+{
+    int16_t x1 = (int16_t)(x + w);
+    int16_t y1 = (int16_t)(y + h);
+
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 > (int16_t)OLED_WIDTH) x1 = (int16_t)OLED_WIDTH;
+    if (y1 > (int16_t)OLED_HEIGHT) y1 = (int16_t)OLED_HEIGHT;
+    if (x >= x1 || y >= y1) return;
+
+    /* Whole column bytes at a time: one Store() per page and column. */
+    for (int16_t py = y; py < y1; py = (int16_t)((py | 7) + 1))
+    {
+        uint8_t page = (uint8_t)(py >> 3);
+        int16_t end = (int16_t)((py | 7) + 1);
+        if (end > y1) end = y1;
+
+        uint8_t mask = (uint8_t)((0xFFU << (py & 7)) & (0xFFU >> (8 - (((end - 1) & 7) + 1))));
+        for (int16_t px = x; px < x1; px++) {
+            Store(g, page, (uint8_t)px, mask, on ? mask : 0U);
+        }
+    }
+}
+
+void OledGfx_HLine(OledGfx_t *g, int16_t x0, int16_t x1, int16_t y)
+{
+    if (x1 < x0) { int16_t t = x0; x0 = x1; x1 = t; }
+    OledGfx_FillRect(g, x0, y, (int16_t)(x1 - x0 + 1), 1, true);
+}
+
+void OledGfx_VLine(OledGfx_t *g, int16_t x, int16_t y0, int16_t y1)
+{
+    if (y1 < y0) { int16_t t = y0; y0 = y1; y1 = t; }
+    OledGfx_FillRect(g, x, y0, 1, (int16_t)(y1 - y0 + 1), true);
+}
+
+void OledGfx_DrawRows(OledGfx_t *g, int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *rows)
+{
+    for (uint8_t r = 0; r < h; r++) {
+        for (uint8_t c = 0; c < w; c++) {
+            if (rows[r] & (1U << (w - 1U - c))) OledGfx_SetPixel(g, (int16_t)(x + c), (int16_t)(y + r), true);
+        }
+    }
+}
+
+void OledGfx_DrawChar(OledGfx_t *g, int16_t x, int16_t y, char c)
+{
+    uint8_t idx = ((uint8_t)c >= 0x20U && (uint8_t)c <= 0x7EU) ? (uint8_t)((uint8_t)c - 0x20U) : (uint8_t)('?' - 0x20);
+
+    for (uint8_t col = 0; col < OLED_FONT_W; col++)
+    {
+        uint8_t bits = (col < 5U) ? font5x7[idx][col] : 0U;
+        for (uint8_t row = 0; row < OLED_FONT_H; row++) {
+            OledGfx_SetPixel(g, (int16_t)(x + col), (int16_t)(y + row), (bits & (1U << row)) != 0U);
+        }
+    }
+}
+
+void OledGfx_DrawPattern(OledGfx_t *g, int16_t x, int16_t y, const uint8_t pattern[8])
+{
+    for (uint8_t row = 0; row < OLED_FONT_H; row++) {
+        for (uint8_t col = 0; col < OLED_FONT_W; col++) {
+            bool on = (col < 5U) && (pattern[row] & (0x10U >> col)) != 0U;
+            OledGfx_SetPixel(g, (int16_t)(x + col), (int16_t)(y + row), on);
+        }
+    }
+}
+
+int16_t OledGfx_DrawText(OledGfx_t *g, int16_t x, int16_t y, const char *s)
+{
+    if (s == NULL) return x;
+    while (*s) {
+        OledGfx_DrawChar(g, x, y, *s++);
+        x = (int16_t)(x + OLED_FONT_W);
+    }
+    return x;
+}
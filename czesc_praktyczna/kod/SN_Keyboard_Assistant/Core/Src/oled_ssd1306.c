@@ -0,0 +1,299 @@
+#include "oled_ssd1306.h"
+#include "timebase.h"
+#include <string.h>
+
+/**
+ * @file oled_ssd1306.c
+ * @brief SSD1306 / SH1106 OLED driver (see oled_ssd1306.h).
+ *
+ * Flush = batch of page jobs:
+ * - Oled_Flush() (main loop, only when idle) takes the changes of each page
+ *   into 'panel', the driver's copy of the GDDRAM contents, and records
+ *   one job (page, first column, length) per changed page,
+ * - the interrupt side sends job by job: address command, then the data
+ *   burst straight out of panel[][] (untouched until the batch is done).
+ *
+ * 'busy' is set by Oled_Flush() and cleared from the interrupt that finishes
+ * the batch; fence state is only changed with interrupts masked or from
+ * those interrupts.
+ */
+
+#define OLED_POWERUP_US       (100000U)   /* VDD/VCC settle before the first command */
+#define OLED_SH1106_COL_OFS   (2U)        /* 132-column RAM, panel centered */
+#define OLED_SH1106_RAM_COLS  (132U)
+
+#define CMD_DISPLAY_OFF       (0xAEU)
+#define CMD_DISPLAY_ON        (0xAFU)
+#define CMD_SET_PAGE          (0xB0U)
+#define CMD_COL_LOW           (0x00U)
+#define CMD_COL_HIGH          (0x10U)
+
+typedef struct {
+    uint8_t page;
+    uint8_t col;
+    uint8_t len;
+} OledJob;
+
+static Oled_t *oDev = NULL;
+static OledGfx_t *oGfx = NULL;
+
+static uint8_t panel[OLED_PAGES][OLED_WIDTH];
+
+static OledJob jobs[OLED_PAGES];
+static uint8_t jobCount = 0;
+static volatile uint8_t jobIdx = 0;
+static volatile bool dataPhase = false;
+static uint8_t addrCmd[3];
+
+static volatile bool busy = false;
+static volatile bool resync = false;
+static volatile uint32_t errors = 0;
+
+static volatile uint32_t batchesStarted = 0;
+static volatile uint32_t batchesDone = 0;
+static OledCallback fenceCallback = NULL;
+static void *fenceArg = NULL;
+static uint32_t fenceBatch = 0;
+
+/* SSD1306 128x64, internal charge pump; SH1106 variant patched in Oled_Init(). */
+static const uint8_t initSsd1306[] = {
+    CMD_DISPLAY_OFF,
+    0xD5, 0x80,          /* clock divide / oscillator */
+    0xA8, 0x3F,          /* multiplex 64 */
+    0xD3, 0x00,          /* display offset 0 */
+    0x40,                /* start line 0 */
+    0x8D, 0x14,          /* charge pump on */
+    0x20, 0x02,          /* page addressing mode */
+    0xA1,                /* segment remap (column 127 = SEG0) */
+    0xC8,                /* COM scan descending */
+    0xDA, 0x12,          /* COM pins: alternative */
+    0x81, 0xCF,          /* contrast */
+    0xD9, 0xF1,          /* pre-charge */
+    0xDB, 0x40,          /* VCOMH */
+    0xA4,                /* output follows RAM */
+    0xA6,                /* normal (not inverted) */
+};
+
+static const uint8_t initSh1106[] = {
+    CMD_DISPLAY_OFF,
+    0xD5, 0x80,
+    0xA8, 0x3F,
+    0xD3, 0x00,
+    0x40,
+    0xAD, 0x8B,          /* DC-DC on */
+    0xA1,
+    0xC8,
+    0xDA, 0x12,
+    0x81, 0x80,
+    0xD9, 0x22,
+    0xDB, 0x35,
+    0xA4,
+    0xA6,
+};
+
+static void FillAddrCmd(uint8_t *cmd, uint8_t page, uint8_t col)
+{
+    if (oDev->controller == OLED_SH1106) col = (uint8_t)(col + OLED_SH1106_COL_OFS);
+    cmd[0] = (uint8_t)(CMD_SET_PAGE | page);
+    cmd[1] = (uint8_t)(CMD_COL_LOW | (col & 0x0FU));
+    cmd[2] = (uint8_t)(CMD_COL_HIGH | (col >> 4));
+}
+
+static HAL_StatusTypeDef WriteBlocking(uint8_t reg, const uint8_t *buf, uint16_t len)
+{
+    return HAL_I2C_Mem_Write(oDev->hi2c, (uint16_t)(oDev->addr_7bit << 1), reg,
+                             I2C_MEMADD_SIZE_8BIT, (uint8_t *)buf, len, oDev->timeout_ms);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Interrupt side                                                            */
+/* ------------------------------------------------------------------------- */
+
+static void FireFence(void)
+{
+    OledCallback cb = fenceCallback;
+    fenceCallback = NULL;
+    if (cb != NULL) cb(fenceArg);
+}
+
+static void FinishBatch(void)
+{
+    batchesDone++;
+    busy = false;
+    if (fenceCallback != NULL && (int32_t)(batchesDone - fenceBatch) >= 0) FireFence();
+}
+
+/* Starts the current phase of jobs[jobIdx]; on failure the batch is abandoned. */
+static void StartTransfer(void)
+{
+    const OledJob *j = &jobs[jobIdx];
+    HAL_StatusTypeDef st;
+    uint16_t dev = (uint16_t)(oDev->addr_7bit << 1);
+
+    if (!dataPhase) {
+        FillAddrCmd(addrCmd, j->page, j->col);
+        st = HAL_I2C_Mem_Write_DMA(oDev->hi2c, dev, OLED_REG_CMD, I2C_MEMADD_SIZE_8BIT, addrCmd, 3);
+    } else {
+        st = HAL_I2C_Mem_Write_DMA(oDev->hi2c, dev, OLED_REG_DATA, I2C_MEMADD_SIZE_8BIT,
+                                   &panel[j->page][j->col], j->len);
+    }
+
+    if (st != HAL_OK) {
+        /* panel[] is ahead of the real GDDRAM now: resend everything. */
+        errors++;
+        resync = true;
+        FinishBatch();
+    }
+}
+
+void Oled_I2cTxDone(I2C_HandleTypeDef *hi2c)
+{
+    if (oDev == NULL || hi2c != oDev->hi2c || !busy) return;
+
+    if (!dataPhase) {
+        dataPhase = true;
+    } else {
+        dataPhase = false;
+        jobIdx++;
+        if (jobIdx >= jobCount) {
+            FinishBatch();
+            return;
+        }
+    }
+    StartTransfer();
+}
+
+void Oled_I2cError(I2C_HandleTypeDef *hi2c)
+{
+    if (oDev == NULL || hi2c != oDev->hi2c || !busy) return;
+
+    errors++;
+    resync = true;
+    FinishBatch();
+}
+
+/* ------------------------------------------------------------------------- */
+/* Main loop side                                                            */
+/* ------------------------------------------------------------------------- */
+
+HAL_StatusTypeDef Oled_Init(Oled_t *oled, I2C_HandleTypeDef *hi2c, uint8_t addr_7bit,
+                            OledController controller, OledGfx_t *gfx)
+{
+    if (oled == NULL || hi2c == NULL || gfx == NULL) return HAL_ERROR;
+
+    oled->hi2c = hi2c;
+    oled->addr_7bit = addr_7bit;
+    oled->controller = controller;
+    oled->timeout_ms = 50;
+
+    oDev = oled;
+    oGfx = NULL;            /* no flushes until the panel is known to be blank */
+    busy = false;
+    resync = false;
+    errors = 0;
+    fenceCallback = NULL;
+
+    Timebase_DelayUs(OLED_POWERUP_US);
+
+    HAL_StatusTypeDef st = (controller == OLED_SH1106)
+        ? WriteBlocking(OLED_REG_CMD, initSh1106, sizeof(initSh1106))
+        : WriteBlocking(OLED_REG_CMD, initSsd1306, sizeof(initSsd1306));
+    if (st != HAL_OK) return st;
+
+    /* Clear all RAM columns (SH1106: including the two hidden ones on each side). */
+    static const uint8_t zeros[OLED_SH1106_RAM_COLS] = {0};
+    uint16_t ramCols = (controller == OLED_SH1106) ? OLED_SH1106_RAM_COLS : OLED_WIDTH;
+    for (uint8_t page = 0; page < OLED_PAGES; page++)
+    {
+        uint8_t cmd[3] = { (uint8_t)(CMD_SET_PAGE | page), CMD_COL_LOW, CMD_COL_HIGH };
+        st = WriteBlocking(OLED_REG_CMD, cmd, sizeof(cmd));
+        if (st != HAL_OK) return st;
+        st = WriteBlocking(OLED_REG_DATA, zeros, ramCols);
+        if (st != HAL_OK) return st;
+    }
+
+    uint8_t on = CMD_DISPLAY_ON;
+    st = WriteBlocking(OLED_REG_CMD, &on, 1);
+    if (st != HAL_OK) return st;
+
+    memset(panel, 0, sizeof(panel));
+    OledGfx_Init(gfx);
+    oGfx = gfx;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef Oled_Flush(void)
+{
+    if (oDev == NULL || oGfx == NULL) return HAL_ERROR;
+    if (busy) return HAL_BUSY;
+
+    if (resync) {
+        resync = false;
+        for (uint8_t p = 0; p < OLED_PAGES; p++) {
+            for (uint8_t x = 0; x < OLED_WIDTH; x++) panel[p][x] = (uint8_t)~oGfx->buf[p][x];
+        }
+        OledGfx_MarkAllDirty(oGfx);
+    }
+
+    jobCount = 0;
+    for (uint8_t page = 0; page < OLED_PAGES; page++)
+    {
+        uint8_t lo, hi;
+        if (!OledGfx_TakeChanges(oGfx, panel, page, &lo, &hi)) continue;
+
+        jobs[jobCount].page = page;
+        jobs[jobCount].col = lo;
+        jobs[jobCount].len = (uint8_t)(hi - lo + 1U);
+        jobCount++;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (jobCount == 0U) {
+        /* Idle and nothing new: everything drawn so far is on the panel. */
+        if (fenceCallback != NULL) FireFence();
+    } else {
+        jobIdx = 0;
+        dataPhase = false;
+        busy = true;
+        batchesStarted++;
+        StartTransfer();
+    }
+    __set_PRIMASK(primask);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef Oled_Fence(OledCallback callback, void *arg)
+{
+    if (oDev == NULL || oGfx == NULL) return HAL_ERROR;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (fenceCallback != NULL) {
+        __set_PRIMASK(primask);
+        return HAL_BUSY;
+    }
+    /* Changes made up to now go out with the next batch (a running one took its snapshot earlier). */
+    fenceCallback = callback;
+    fenceArg = arg;
+    fenceBatch = batchesStarted + 1U;
+    __set_PRIMASK(primask);
+
+    (void)Oled_Flush();
+    return HAL_OK;
+}
+
+bool Oled_IsIdle(void)
+{
+    return !busy;
+}
+
+uint32_t Oled_TakeErrors(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t n = errors;
+    errors = 0;
+    __set_PRIMASK(primask);
+    return n;
+}
@@ -0,0 +1,235 @@
+#include "oled_staff.h"
+#include "glyphs.h"   /* GLYPH_WHOLE..GLYPH_SIXTEENTH (NoteEntry.lengthIcon) */
+#include "song_pack.h"  /* Song_Step() */
+
+/**
+ * @file oled_staff.c
+ * @brief Staff renderer (see oled_staff.h).
+ *
+ * Vertical positions are diatonic: d = 0 is C4, one step (line <-> space)
+ * is 2 pixels, the bottom staff line is E4 (d = 2).
+ *
+ * HAL-free, so it also builds on the host (Tools/oled_preview.c).
+ */
+
+/* --- Layout --- */
+#define STAFF_BOTTOM_Y    (38)     /* E4 line */
+#define LINE_GAP          (4)
+#define STAFF_X0          (0)
+#define STAFF_X1          (127)
+#define CLEF_X            (2)
+#define CLEF_Y            (23)
+#define COLUMN_COUNT      (3U)
+#define MARKER_Y          (51)
+#define PROGRESS_Y        (53)
+
+#define D_MIN             (-3)     /* lowest drawable step (A3) */
+#define D_MAX             (16)     /* highest drawable step (E6) */
+#define D_MIDDLE_LINE     (6)      /* B4: stems flip at this note */
+#define STEM_LEN          (11)
+#define MAX_CHORD_TONES   (8U)     /* tones drawn per chord column */
+
+static const int16_t columnX[COLUMN_COUNT] = { 34, 68, 102 };
+
+/* --- Bitmaps (see OledGfx_DrawRows()) --- */
+static const uint8_t clefRows[] = {
+    0x0C, 0x12, 0x12, 0x14, 0x18, 0x30, 0x50, 0x4E,
+    0x59, 0x55, 0x45, 0x25, 0x1E, 0x04, 0x04, 0x24, 0x18,
+};
+static const uint8_t headFilled[3] = { 0x0E, 0x1F, 0x0E };   /* 5x3: fits one space */
+static const uint8_t headHollow[3] = { 0x0E, 0x11, 0x0E };
+static const uint8_t sharpRows[6]  = { 0x5, 0xF, 0x5, 0x5, 0xF, 0x5 };   /* 4 wide */
+static const uint8_t flatRows[6]   = { 0x4, 0x4, 0x4, 0x6, 0x5, 0x6 };   /* 3 wide */
+
+/* Semitones above C of the natural notes C..B. */
+static const uint8_t naturalSemitone[7] = { 0, 2, 4, 5, 7, 9, 11 };
+
+/* Diatonic position of a letter inside an octave (H = B), or -1. */
+static int8_t LetterStep(char letter)
+{
+    switch (letter)
+    {
+        case 'C': return 0;
+        case 'D': return 1;
+        case 'E': return 2;
+        case 'F': return 3;
+        case 'G': return 4;
+        case 'A': return 5;
+        case 'B':
+        case 'H': return 6;
+        default:  return -1;
+    }
+}
+
+/*
+ * Diatonic step of a note relative to C4. The octave comes from the MIDI
+ * number of the written (natural) note, so Cb4 / B#3 land on the right line;
+ * notes without a MIDI number (chords) are placed in octave 4.
+ */
+static bool NoteStep(const NoteEntry *n, int16_t *d)
+{
+    int8_t step = LetterStep(n->letter);
+    if (step < 0) return false;
+
+    int16_t octave = 4;
+    if (n->midiNote >= 0)
+    {
+        int16_t natural = n->midiNote;
+        if (n->accidental == ACC_SHARP) natural--;
+        else if (n->accidental == ACC_FLAT) natural++;
+        octave = (int16_t)(natural / 12 - 1);
+    }
+
+    int16_t v = (int16_t)((octave - 4) * 7 + step);
+    if (v < D_MIN) v = D_MIN;
+    if (v > D_MAX) v = D_MAX;
+    *d = v;
+    return true;
+}
+
+static int16_t StepY(int16_t d)
+{
+    return (int16_t)(STAFF_BOTTOM_Y + 4 - 2 * d);
+}
+
+static void DrawStaffLines(OledGfx_t *g)
+{
+    for (int16_t i = 0; i < 5; i++) {
+        OledGfx_HLine(g, STAFF_X0, STAFF_X1, (int16_t)(STAFF_BOTTOM_Y - i * LINE_GAP));
+    }
+    OledGfx_DrawRows(g, CLEF_X, CLEF_Y, 7, sizeof(clefRows), clefRows);
+}
+
+/* Short lines for notes below/above the staff (C4 and lower, A5 and higher). */
+static void DrawLedgers(OledGfx_t *g, int16_t x, int16_t d)
+{
+    for (int16_t l = 0; l >= d; l = (int16_t)(l - 2)) {
+        OledGfx_HLine(g, (int16_t)(x - 2), (int16_t)(x + 6), StepY(l));
+    }
+    for (int16_t l = 12; l <= d; l = (int16_t)(l + 2)) {
+        OledGfx_HLine(g, (int16_t)(x - 2), (int16_t)(x + 6), StepY(l));
+    }
+}
+
+/* One step: heads (seconds shifted right), accidentals, one shared stem + flags. */
+static void DrawColumn(OledGfx_t *g, int16_t x, const NoteEntry *notes, uint8_t count)
+{
+    int16_t lowest = D_MAX;
+    int16_t highest = D_MIN;
+    int16_t prevD = D_MIN - 2;
+    bool prevShifted = false;
+    uint8_t length = GLYPH_QUARTER;
+    bool any = false;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        int16_t d;
+        if (!NoteStep(&notes[i], &d)) continue;
+
+        if (!any) length = notes[i].lengthIcon;
+        any = true;
+        if (d < lowest) lowest = d;
+        if (d > highest) highest = d;
+
+        /* A second above/below the previous head goes beside it (alternating). */
+        bool shifted = (d == prevD + 1 || d == prevD - 1) && !prevShifted;
+        int16_t hx = shifted ? (int16_t)(x + 5) : x;
+        prevD = d;
+        prevShifted = shifted;
+
+        int16_t y = StepY(d);
+        DrawLedgers(g, hx, d);
+        OledGfx_DrawRows(g, hx, (int16_t)(y - 1), 5, 3,
+                         (notes[i].lengthIcon <= GLYPH_HALF) ? headHollow : headFilled);
+
+        if (notes[i].accidental == ACC_SHARP) {
+            OledGfx_DrawRows(g, (int16_t)(x - 6), (int16_t)(y - 3), 4, 6, sharpRows);
+        } else if (notes[i].accidental == ACC_FLAT) {
+            OledGfx_DrawRows(g, (int16_t)(x - 5), (int16_t)(y - 4), 3, 6, flatRows);
+        }
+    }
+
+    if (!any || length == GLYPH_WHOLE) return;
+
+    /* Stem up on the right for low notes, down on the left for high ones. */
+    bool up = ((lowest + highest) / 2) < D_MIDDLE_LINE;
+    int16_t sx = up ? (int16_t)(x + 4) : x;
+    int16_t from = up ? StepY(lowest) : StepY(highest);
+    int16_t tip = up ? (int16_t)(StepY(highest) - STEM_LEN) : (int16_t)(StepY(lowest) + STEM_LEN);
+    OledGfx_VLine(g, sx, from, tip);
+
+    uint8_t flags = (length == GLYPH_EIGHTH) ? 1U : (length == GLYPH_SIXTEENTH) ? 2U : 0U;
+    for (uint8_t f = 0; f < flags; f++)
+    {
+        int16_t fy = up ? (int16_t)(tip + 3 * f) : (int16_t)(tip - 3 * f);
+        int16_t dir = up ? 1 : -1;
+        OledGfx_SetPixel(g, (int16_t)(sx + 1), (int16_t)(fy + dir), true);
+        OledGfx_SetPixel(g, (int16_t)(sx + 2), (int16_t)(fy + 2 * dir), true);
+        OledGfx_SetPixel(g, (int16_t)(sx + 3), (int16_t)(fy + 3 * dir), true);
+    }
+}
+
+static void DrawMarkerAndProgress(OledGfx_t *g, uint8_t index, uint8_t total)
+{
+    OledGfx_HLine(g, (int16_t)(columnX[0] - 1), (int16_t)(columnX[0] + 5), MARKER_Y);
+
+    int16_t filled = (total == 0U) ? 0 : (int16_t)(((uint32_t)index * OLED_WIDTH) / total);
+    OledGfx_FillRect(g, 0, PROGRESS_Y, filled, 2, true);
+    OledGfx_VLine(g, (int16_t)(OLED_WIDTH - 1U), PROGRESS_Y, (int16_t)(PROGRESS_Y + 1));
+}
+
+void OledStaff_Clear(OledGfx_t *g)
+{
+    OledGfx_FillRect(g, 0, OLED_STAFF_Y, (int16_t)OLED_WIDTH, OLED_STAFF_HEIGHT, false);
+}
+
+void OledStaff_DrawSong(OledGfx_t *g, const Song *song, uint8_t index)
+{
+    OledStaff_Clear(g);
+    DrawStaffLines(g);
+
+    for (uint8_t c = 0; c < COLUMN_COUNT && (uint32_t)index + c < song->stepCount; c++) {
+        const SongStep *step = Song_Step(song, (uint8_t)(index + c));
+        if (step != NULL) DrawColumn(g, columnX[c], step->notes, step->noteCount);
+    }
+    DrawMarkerAndProgress(g, index, song->stepCount);
+}
+
+void OledStaff_DrawChords(OledGfx_t *g, const ChordPack *pack, uint8_t index)
+{
+    OledStaff_Clear(g);
+    DrawStaffLines(g);
+
+    for (uint8_t c = 0; c < COLUMN_COUNT && (uint32_t)index + c < pack->chordCount; c++)
+    {
+        const Chord *chord = &pack->chords[index + c];
+        NoteEntry tones[MAX_CHORD_TONES];
+        uint8_t count = (chord->noteCount > MAX_CHORD_TONES) ? MAX_CHORD_TONES : chord->noteCount;
+
+        /*
+         * Chord tones carry no length or octave: show them as a quarter-note
+         * stack, each tone above the previous one starting from the root in
+         * octave 4 (so 7ths and 9ths do not fold back onto the triad).
+         */
+        int16_t prevD = -1;
+        for (uint8_t i = 0; i < count; i++) {
+            tones[i] = chord->notes[i];
+            tones[i].midiNote = -1;
+            tones[i].lengthIcon = GLYPH_QUARTER;
+
+            int8_t step = LetterStep(tones[i].letter);
+            if (step < 0) continue;
+
+            int16_t d = step;
+            while (d <= prevD) d = (int16_t)(d + 7);
+            prevD = d;
+
+            int16_t midi = (int16_t)(60 + (d / 7) * 12 + naturalSemitone[d % 7]);
+            if (tones[i].accidental == ACC_SHARP) midi++;
+            else if (tones[i].accidental == ACC_FLAT) midi--;
+            tones[i].midiNote = (int8_t)midi;
+        }
+        DrawColumn(g, columnX[c], tones, count);
+    }
+    DrawMarkerAndProgress(g, index, pack->chordCount);
+}
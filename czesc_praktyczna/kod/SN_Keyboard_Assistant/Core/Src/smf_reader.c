@@ -0,0 +1,501 @@
+#include "smf_reader.h"
+#include <string.h>
+
+/**
+ * @file smf_reader.c
+ * @brief Streaming Standard MIDI File reader (see smf_reader.h).
+ *
+ * Each track cursor points at the status byte of its next event, with the
+ * event's absolute tick already decoded from the delta time. The heap root
+ * is the track whose event comes next; after reading it, that track's next
+ * delta is decoded and the root is sifted down (O(log tracks) per event).
+ */
+
+#define GRID_TICKS   (SONG_PPQ / 4U)   /* onset grid: sixteenth notes, as Tools/midi2song.c */
+
+/* --- Byte access --- */
+
+/* Copy bytes from the file; false if out of range or on a read error. */
+static bool ReadAt(SmfReader *r, uint32_t offset, uint8_t *buf, uint16_t len)
+{
+    if (offset > r->src.size || len > r->src.size - offset) {
+        r->status = SMF_ERR_DATA;
+        return false;
+    }
+    if (r->src.base != NULL) {
+        memcpy(buf, &r->src.base[offset], len);
+        return true;
+    }
+    if (r->src.read == NULL || !r->src.read(r->src.ctx, offset, buf, len)) {
+        r->status = SMF_ERR_READ;
+        return false;
+    }
+    return true;
+}
+
+/* Next byte of a track (through its cache when there is no mapped image). */
+static bool TrackByte(SmfReader *r, SmfTrack *t, uint8_t *b)
+{
+    if (t->pos >= t->end) {
+        r->status = SMF_ERR_DATA;
+        return false;
+    }
+    if (r->src.base != NULL) {
+        *b = r->src.base[t->pos++];
+        return true;
+    }
+    if (t->pos - t->cacheStart >= t->cacheLen)
+    {
+        uint32_t len = t->end - t->pos;
+        if (len > SMF_TRACK_CACHE) len = SMF_TRACK_CACHE;
+        if (!ReadAt(r, t->pos, t->cache, (uint16_t)len)) return false;
+        t->cacheStart = t->pos;
+        t->cacheLen = (uint8_t)len;
+    }
+    *b = t->cache[t->pos++ - t->cacheStart];
+    return true;
+}
+
+/* Variable-length quantity: 7 bits per byte, high bit = more follows (max 4 bytes). */
+static bool TrackVlq(SmfReader *r, SmfTrack *t, uint32_t *v)
+{
+    *v = 0;
+    for (uint8_t i = 0; i < 4U; i++)
+    {
+        uint8_t b;
+        if (!TrackByte(r, t, &b)) return false;
+        *v = (*v << 7) | (b & 0x7FU);
+        if ((b & 0x80U) == 0U) return true;
+    }
+    r->status = SMF_ERR_DATA;
+    return false;
+}
+
+static bool TrackSkip(SmfReader *r, SmfTrack *t, uint32_t n)
+{
+    if (n > t->end - t->pos) {
+        r->status = SMF_ERR_DATA;
+        return false;
+    }
+    t->pos += n;
+    return true;
+}
+
+static uint32_t BE32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint16_t BE16(const uint8_t *p)
+{
+    return (uint16_t)(((uint16_t)p[0] << 8) | p[1]);
+}
+
+/* --- Track heap --- */
+
+static bool Earlier(const SmfReader *r, uint8_t a, uint8_t b)
+{
+    uint32_t ta = r->tracks[a].tick;
+    uint32_t tb = r->tracks[b].tick;
+    return (ta < tb) || (ta == tb && a < b);
+}
+
+static void SiftDown(SmfReader *r, uint8_t i)
+{
+    for (;;)
+    {
+        uint8_t min = i;
+        uint8_t left = (uint8_t)(2U * i + 1U);
+        uint8_t right = (uint8_t)(2U * i + 2U);
+
+        if (left < r->heapSize && Earlier(r, r->heap[left], r->heap[min])) min = left;
+        if (right < r->heapSize && Earlier(r, r->heap[right], r->heap[min])) min = right;
+        if (min == i) return;
+
+        uint8_t tmp = r->heap[i];
+        r->heap[i] = r->heap[min];
+        r->heap[min] = tmp;
+        i = min;
+    }
+}
+
+static void HeapPush(SmfReader *r, uint8_t track)
+{
+    uint8_t i = r->heapSize++;
+    r->heap[i] = track;
+
+    while (i > 0U)
+    {
+        uint8_t parent = (uint8_t)((i - 1U) / 2U);
+        if (!Earlier(r, r->heap[i], r->heap[parent])) break;
+        uint8_t tmp = r->heap[i];
+        r->heap[i] = r->heap[parent];
+        r->heap[parent] = tmp;
+        i = parent;
+    }
+}
+
+/* --- Reader --- */
+
+SmfStatus SmfReader_Open(SmfReader *r, const SmfSource *src)
+{
+    uint8_t hdr[14];
+
+    memset(r, 0, sizeof(*r));
+    r->src = *src;
+    r->status = SMF_OK;
+    r->beatsPerBar = 4;
+    r->beatUnit = 4;
+
+    if (!ReadAt(r, 0, hdr, sizeof(hdr)) || memcmp(hdr, "MThd", 4) != 0 || BE32(&hdr[4]) < 6U) {
+        if (r->status != SMF_ERR_READ) r->status = SMF_ERR_HEADER;
+        return r->status;
+    }
+
+    r->format = BE16(&hdr[8]);
+    uint16_t declared = BE16(&hdr[10]);
+    r->division = BE16(&hdr[12]);
+
+    if (r->format > 1U) return r->status = SMF_ERR_FORMAT;
+    if ((r->division & 0x8000U) != 0U || r->division == 0U) return r->status = SMF_ERR_DIVISION;
+
+    /* Walk the chunk list; unknown chunks are skipped */
+    uint32_t offset = 8U + BE32(&hdr[4]);
+    while (r->trackCount < declared && r->trackCount < SMF_MAX_TRACKS &&
+           offset <= r->src.size && r->src.size - offset >= 8U)
+    {
+        uint8_t chunk[8];
+        if (!ReadAt(r, offset, chunk, sizeof(chunk))) return r->status;
+
+        uint32_t body = offset + 8U;
+        uint32_t len = BE32(&chunk[4]);
+        if (len > r->src.size - body) return r->status = SMF_ERR_DATA;
+        offset = body + len;
+
+        if (memcmp(chunk, "MTrk", 4) != 0) continue;
+
+        uint8_t index = r->trackCount++;
+        SmfTrack *t = &r->tracks[index];
+        t->pos = body;
+        t->end = body + len;
+        if (len == 0U) continue;
+
+        if (!TrackVlq(r, t, &t->tick)) return r->status;
+        HeapPush(r, index);
+    }
+    return r->status;
+}
+
+bool SmfReader_Read(SmfReader *r, uint32_t offset, uint8_t *buf, uint16_t len)
+{
+    return ReadAt(r, offset, buf, len);
+}
+
+/* Remember the first tempo / time / key signature. */
+static void NoteMeta(SmfReader *r, const SmfEvent *ev)
+{
+    uint8_t p[3];
+
+    if (ev->data1 == 0x51U && ev->length == 3U && r->tempoUsPerQuarter == 0U)
+    {
+        if (ReadAt(r, ev->offset, p, 3)) {
+            r->tempoUsPerQuarter = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+        }
+    }
+    else if (ev->data1 == 0x58U && ev->length >= 2U && !r->haveTimeSig)
+    {
+        if (ReadAt(r, ev->offset, p, 2) && p[0] > 0U && p[1] <= 5U) {
+            r->beatsPerBar = p[0];
+            r->beatUnit = (uint8_t)(1U << p[1]);
+            r->haveTimeSig = true;
+        }
+    }
+    else if (ev->data1 == 0x59U && ev->length >= 1U && !r->haveKeySig)
+    {
+        if (ReadAt(r, ev->offset, p, 1)) {
+            r->keySharps = (int8_t)p[0];
+            r->haveKeySig = true;
+        }
+    }
+}
+
+bool SmfReader_Next(SmfReader *r, SmfEvent *ev)
+{
+    while (r->heapSize > 0U && r->status == SMF_OK)
+    {
+        uint8_t index = r->heap[0];
+        SmfTrack *t = &r->tracks[index];
+        bool endOfTrack = false;
+        uint8_t b;
+
+        if (!TrackByte(r, t, &b)) break;
+
+        ev->tick = t->tick;
+        ev->track = index;
+        ev->data1 = 0;
+        ev->data2 = 0;
+        ev->offset = 0;
+        ev->length = 0;
+
+        if (b >= 0xF0U)
+        {
+            /* Meta and SysEx events cancel running status */
+            t->status = 0;
+            ev->status = b;
+
+            if (b == 0xFFU) {
+                if (!TrackByte(r, t, &ev->data1)) break;
+            } else if (b != 0xF0U && b != 0xF7U) {
+                r->status = SMF_ERR_DATA;   /* system common / real-time: not valid in files */
+                break;
+            }
+            if (!TrackVlq(r, t, &ev->length)) break;
+            ev->offset = t->pos;
+            if (!TrackSkip(r, t, ev->length)) break;
+
+            if (b == 0xFFU) {
+                endOfTrack = (ev->data1 == 0x2FU);
+                NoteMeta(r, ev);
+            }
+        }
+        else
+        {
+            if ((b & 0x80U) != 0U) {
+                t->status = b;
+                if (!TrackByte(r, t, &b)) break;
+            } else if (t->status == 0U) {
+                r->status = SMF_ERR_DATA;   /* data byte without a status */
+                break;
+            }
+            ev->status = t->status;
+            ev->data1 = b & 0x7FU;
+
+            uint8_t kind = ev->status & 0xF0U;
+            if (kind != 0xC0U && kind != 0xD0U)
+            {
+                if (!TrackByte(r, t, &b)) break;
+                ev->data2 = b & 0x7FU;
+            }
+        }
+
+        /* Advance the track to its next event, or drop it from the heap */
+        if (endOfTrack || t->pos >= t->end)
+        {
+            r->heap[0] = r->heap[--r->heapSize];
+        }
+        else
+        {
+            uint32_t delta;
+            if (!TrackVlq(r, t, &delta)) break;
+            t->tick += delta;
+        }
+        SiftDown(r, 0);
+
+        if (!endOfTrack) return true;
+    }
+    return false;
+}
+
+/* --- Lesson steps --- */
+
+/* Look-ahead reader for note durations (too big for the stack). */
+static SmfReader lookahead;
+
+static bool IsNoteOn(const SmfEvent *ev)
+{
+    return (ev->status & 0xF0U) == 0x90U && ev->data2 > 0U && (ev->status & 0x0FU) != SMF_DRUM_CHANNEL;
+}
+
+static bool IsNoteOff(const SmfEvent *ev)
+{
+    uint8_t kind = ev->status & 0xF0U;
+    return (kind == 0x80U || (kind == 0x90U && ev->data2 == 0U)) && (ev->status & 0x0FU) != SMF_DRUM_CHANNEL;
+}
+
+/* File ticks -> SONG_PPQ ticks */
+static uint32_t Scale(const SmfSteps *it, uint32_t ticks)
+{
+    uint16_t div = it->reader.division;
+    return (uint32_t)(((uint64_t)ticks * SONG_PPQ + div / 2U) / div);
+}
+
+static uint32_t Snap(uint32_t ticks)
+{
+    return (ticks + GRID_TICKS / 2U) / GRID_TICKS * GRID_TICKS;
+}
+
+/* Notes of the step being built, with what is needed to find their ends. */
+typedef struct {
+    uint8_t count;
+    uint8_t open;                            /* notes without an end yet */
+    uint8_t channel[SMF_STEP_MAX_NOTES];
+    uint32_t onTick[SMF_STEP_MAX_NOTES];     /* file ticks */
+    uint32_t offTick[SMF_STEP_MAX_NOTES];
+    bool ended[SMF_STEP_MAX_NOTES];
+} StepNotes;
+
+/* A NOTE OFF (or re-strike) ends the latest open step note of that key. */
+static void EndNote(StepNotes *s, const NoteEntry *notes, uint8_t note, uint8_t channel, uint32_t tick)
+{
+    for (uint8_t i = s->count; i-- > 0U; )
+    {
+        if (s->ended[i] || (uint8_t)notes[i].midiNote != note || s->channel[i] != channel) continue;
+        s->ended[i] = true;
+        s->offTick[i] = tick;
+        s->open--;
+        return;
+    }
+}
+
+SmfStatus SmfSteps_Begin(SmfSteps *it, const SmfSource *src, uint8_t maxNotes)
+{
+    SmfEvent ev;
+
+    memset(it, 0, sizeof(*it));
+    it->maxNotes = (maxNotes < 1U) ? 1U : (maxNotes > SMF_STEP_MAX_NOTES) ? SMF_STEP_MAX_NOTES : maxNotes;
+
+    /* Tempo and meter: the meta events before the first note */
+    if (SmfReader_Open(&it->reader, src) != SMF_OK) return it->reader.status;
+    while (SmfReader_Next(&it->reader, &ev)) {
+        if (IsNoteOn(&ev)) break;
+    }
+
+    const SmfReader *r = &it->reader;
+    it->tempoBpm = (r->tempoUsPerQuarter != 0U)
+                 ? (uint16_t)((60000000UL + r->tempoUsPerQuarter / 2U) / r->tempoUsPerQuarter) : 0U;
+    it->beatsPerBar = r->beatsPerBar;
+    it->beatUnit = r->beatUnit;
+    it->keySharps = r->keySharps;
+    it->barTicks = (uint32_t)SONG_PPQ * 4U * it->beatsPerBar / it->beatUnit;
+    if (it->barTicks == 0U) it->barTicks = SONG_PPQ * 4U;
+
+    return SmfReader_Open(&it->reader, src);
+}
+
+bool SmfSteps_Next(SmfSteps *it, SongStep *step, NoteEntry *notes, bool durations)
+{
+    StepNotes s;
+    SmfEvent ev;
+    uint32_t bar = 0;
+    uint32_t nextOnset = UINT32_MAX;   /* SONG_PPQ ticks of the next step's first note */
+
+    s.count = 0;
+    s.open = 0;
+
+    for (;;)
+    {
+        uint8_t note;
+        uint8_t channel;
+        uint32_t tick;
+
+        if (it->havePending) {
+            it->havePending = false;
+            note = it->pendingNote;
+            channel = it->pendingChannel;
+            tick = it->pendingTick;
+        } else {
+            if (!SmfReader_Next(&it->reader, &ev)) break;
+            if (IsNoteOff(&ev)) {
+                EndNote(&s, notes, ev.data1, ev.status & 0x0FU, ev.tick);
+                continue;
+            }
+            if (!IsNoteOn(&ev)) continue;
+            note = ev.data1;
+            channel = ev.status & 0x0FU;
+            tick = ev.tick;
+            EndNote(&s, notes, note, channel, tick);   /* re-strike */
+        }
+
+        uint32_t onset = Snap(Scale(it, tick));
+        if (onset > UINT16_MAX) {
+            it->tickOverflow = true;   /* onsetTick is 16-bit: the song ends here */
+            break;
+        }
+
+        if (s.count > 0U)
+        {
+            bool together = (onset == notes[s.count - 1U].onsetTick);
+            if (s.count >= SMF_STEP_MAX_NOTES ||
+                (!together && (s.count >= it->maxNotes || onset / it->barTicks != bar)))
+            {
+                /* First note of the next step */
+                it->havePending = true;
+                it->pendingNote = note;
+                it->pendingChannel = channel;
+                it->pendingTick = tick;
+                nextOnset = onset;
+                break;
+            }
+
+            /* The same key twice at one onset (doubled voices) counts once */
+            bool doubled = false;
+            for (uint8_t i = s.count; i-- > 0U && notes[i].onsetTick == onset; ) {
+                if ((uint8_t)notes[i].midiNote == note) doubled = true;
+            }
+            if (doubled) continue;
+        }
+        else
+        {
+            bar = onset / it->barTicks;
+        }
+
+        NoteEntry *n = &notes[s.count];
+        memset(n, 0, sizeof(*n));
+        n->midiNote = (int8_t)note;
+        n->onsetTick = (uint16_t)onset;
+        s.channel[s.count] = channel;
+        s.onTick[s.count] = tick;
+        s.ended[s.count] = false;
+        s.count++;
+        s.open++;
+    }
+
+    if (s.count == 0U) return false;
+
+    if (durations)
+    {
+        /* Find the remaining NOTE OFFs further on, within SMF_LOOKAHEAD_BARS */
+        uint32_t lastTick = s.onTick[s.count - 1U];
+        uint32_t limit = lastTick + (uint32_t)(((uint64_t)it->barTicks * SMF_LOOKAHEAD_BARS * it->reader.division) / SONG_PPQ);
+
+        if (s.open > 0U)
+        {
+            lookahead = it->reader;
+            while (s.open > 0U && SmfReader_Next(&lookahead, &ev) && ev.tick <= limit)
+            {
+                lastTick = ev.tick;
+                if (IsNoteOff(&ev) || IsNoteOn(&ev)) EndNote(&s, notes, ev.data1, ev.status & 0x0FU, ev.tick);
+            }
+        }
+
+        for (uint8_t i = 0; i < s.count; i++)
+        {
+            NoteEntry *n = &notes[i];
+            uint32_t off = s.ended[i] ? s.offTick[i] : lastTick;
+            uint32_t duration = Scale(it, off - s.onTick[i]);
+
+            /* Released slightly early: written as lasting to the next onset */
+            uint32_t next = nextOnset;
+            for (uint8_t k = (uint8_t)(i + 1U); k < s.count; k++) {
+                if (notes[k].onsetTick > n->onsetTick) {
+                    next = notes[k].onsetTick;
+                    break;
+                }
+            }
+            if (next != UINT32_MAX && next > n->onsetTick)
+            {
+                uint32_t ioi = next - n->onsetTick;
+                if (duration < ioi && duration * 4U >= ioi * 3U) duration = ioi;
+            }
+
+            if (duration == 0U) duration = GRID_TICKS;
+            n->durationTicks = (uint16_t)((duration > UINT16_MAX) ? UINT16_MAX : duration);
+        }
+    }
+
+    step->noteCount = s.count;
+    step->notes = notes;
+    step->articulation = ARTIC_NORMAL;
+    it->index++;
+    return true;
+}
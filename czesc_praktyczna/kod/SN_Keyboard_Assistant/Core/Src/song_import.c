@@ -0,0 +1,275 @@
+#include "song_import.h"
+#include <string.h>
+
+/**
+ * @file song_import.c
+ * @brief Song import from a FAT folder (see song_import.h).
+ *
+ * Two chunk buffers alternate: chunk n is written (or compared) while
+ * chunk n+1 is read. The next read is only queued once the previous one
+ * is complete, because a disk takes one command at a time and Fat_Run()
+ * may have to read a FAT sector itself.
+ */
+
+typedef enum {
+    STREAM_OK = 0,
+    STREAM_DIFFERENT,            /* compare: the stored item differs */
+    STREAM_BROKEN,               /* cluster chain broken: this file cannot be read */
+    STREAM_DISK_ERROR,           /* a read command failed */
+    STREAM_STORE_ERROR
+} StreamResult;
+
+/* One chunk read, queued or complete */
+typedef struct {
+    uint32_t offset;             /* file offset of the chunk */
+    uint32_t length;             /* file bytes in it */
+    bool busy;
+    bool ok;
+} ChunkRead;
+
+/* Chunk buffers and the compare buffer (too big for the stack) */
+static uint8_t chunks[2][SONG_IMPORT_CHUNK];
+static uint8_t compareBuf[SONG_IMPORT_PIECE];
+
+static char Upper(char c)
+{
+    return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c;
+}
+
+uint32_t SongImport_Id(const char *name)
+{
+    /* FNV-1a, folded to 24 bits */
+    uint32_t h = 2166136261UL;
+    while (*name != '\0')
+    {
+        h ^= (uint8_t)Upper(*name++);
+        h *= 16777619UL;
+    }
+    return ((h >> 24) ^ h) & 0x00FFFFFFUL;
+}
+
+void SongImport_Title(const char *name, char title[SONG_IMPORT_TITLE_MAX + 1U])
+{
+    const char *dot = strrchr(name, '.');
+    size_t n = (dot != NULL && dot != name) ? (size_t)(dot - name) : strlen(name);
+
+    if (n > SONG_IMPORT_TITLE_MAX) n = SONG_IMPORT_TITLE_MAX;
+    memcpy(title, name, n);
+    title[n] = '\0';
+}
+
+/* Song type of a file, from its 8.3 extension (".midi" is "MID" there too); 0 = not a song */
+static uint8_t SongType(const FatEntry *entry)
+{
+    const char *dot = strrchr(entry->shortName, '.');
+    char ext[4] = { 0 };
+
+    if (dot == NULL || strlen(dot + 1) > 3U) return 0;
+    for (uint8_t i = 0; dot[1 + i] != '\0'; i++) ext[i] = Upper(dot[1 + i]);
+    if (strcmp(ext, "MID") == 0) return NOR_STORE_SONG_SMF;
+    if (strcmp(ext, "TXT") == 0) return NOR_STORE_SONG_TEXT;
+    return 0;
+}
+
+/* --- Pipelined file reading --- */
+
+/* Queue the read of the chunk at offset: up to SONG_IMPORT_CHUNK bytes of one contiguous run. */
+static bool StartChunk(FatFile *f, uint32_t offset, uint8_t *buf, ChunkRead *r, SongImportReport *report)
+{
+    const FatDisk *disk = &f->vol->disk;
+    uint32_t lba;
+    uint32_t run = Fat_Run(f, offset, &lba);
+    uint32_t sectors = (f->size - offset + FAT_SECTOR_SIZE - 1U) / FAT_SECTOR_SIZE;
+
+    if (run == 0U) return false;
+    if (sectors > run) sectors = run;
+    if (sectors > SONG_IMPORT_CHUNK / FAT_SECTOR_SIZE) sectors = SONG_IMPORT_CHUNK / FAT_SECTOR_SIZE;
+
+    r->offset = offset;
+    r->length = sectors * FAT_SECTOR_SIZE;
+    if (r->length > f->size - offset) r->length = f->size - offset;
+    report->reads++;
+    report->sectors += sectors;
+
+    if (disk->start != NULL && disk->poll != NULL)
+    {
+        r->ok = disk->start(disk->ctx, lba, buf, (uint16_t)sectors);
+        r->busy = r->ok;
+    }
+    else
+    {
+        r->ok = disk->read(disk->ctx, lba, buf, (uint16_t)sectors);
+        r->busy = false;
+    }
+    return true;
+}
+
+static void PollChunk(const FatFile *f, ChunkRead *r)
+{
+    if (r->busy)
+    {
+        FatDiskState st = f->vol->disk.poll(f->vol->disk.ctx);
+        if (st != FAT_DISK_BUSY)
+        {
+            r->busy = false;
+            r->ok = (st == FAT_DISK_DONE);
+        }
+    }
+}
+
+/*
+ * Reads the whole file and appends it to the record begun in the store
+ * (old == NULL), or compares it with the stored item old.
+ */
+static StreamResult Stream(NorStore *store, FatFile *f, const NorStoreItem *old, SongImportReport *report)
+{
+    ChunkRead reads[2] = { { 0, 0, false, false }, { 0, 0, false, false } };
+    StreamResult result = STREAM_OK;
+    uint8_t cur = 0;
+
+    if (!StartChunk(f, 0, chunks[0], &reads[0], report)) return STREAM_BROKEN;
+
+    for (;;)
+    {
+        ChunkRead *r = &reads[cur];
+        ChunkRead *next = &reads[cur ^ 1U];
+
+        while (r->busy) PollChunk(f, r);
+        if (!r->ok) {
+            result = STREAM_DISK_ERROR;
+            break;
+        }
+
+        uint32_t nextOffset = r->offset + r->length;
+        bool more = nextOffset < f->size;
+        if (more && !StartChunk(f, nextOffset, chunks[cur ^ 1U], next, report)) {
+            result = STREAM_BROKEN;
+            break;
+        }
+
+        for (uint32_t done = 0; done < r->length && result == STREAM_OK; )
+        {
+            const uint8_t *piece = &chunks[cur][done];
+            uint32_t n = r->length - done;
+            if (n > SONG_IMPORT_PIECE) n = SONG_IMPORT_PIECE;
+
+            if (old != NULL)
+            {
+                if (!NorStore_Read(old, r->offset + done, compareBuf, n)) result = STREAM_STORE_ERROR;
+                else if (memcmp(compareBuf, piece, n) != 0) result = STREAM_DIFFERENT;
+            }
+            else
+            {
+                report->storeStatus = NorStore_Append(store, piece, n);
+                if (report->storeStatus != NOR_STORE_OK) result = STREAM_STORE_ERROR;
+            }
+            done += n;
+            if (more) PollChunk(f, next);
+        }
+
+        if (result != STREAM_OK || !more) break;
+        cur ^= 1U;
+    }
+
+    /* A read still on its way must finish before the disk takes the next command */
+    while (reads[0].busy || reads[1].busy)
+    {
+        PollChunk(f, &reads[0]);
+        PollChunk(f, &reads[1]);
+    }
+    return result;
+}
+
+/* Store the title item of id unless it is already there. */
+static NorStoreStatus WriteTitle(NorStore *store, uint32_t id, const char *name)
+{
+    char title[SONG_IMPORT_TITLE_MAX + 1U];
+    uint32_t key = NOR_STORE_KEY(NOR_STORE_SONG_TITLE, id);
+    NorStoreItem item;
+
+    SongImport_Title(name, title);
+    uint32_t length = (uint32_t)strlen(title);
+    if (NorStore_Find(store, key, &item) == NOR_STORE_OK && item.length == length &&
+        NorStore_Read(&item, 0, compareBuf, length) && memcmp(compareBuf, title, length) == 0) {
+        return NOR_STORE_OK;
+    }
+    return NorStore_Write(store, key, (const uint8_t *)title, length);
+}
+
+bool SongImport_File(NorStore *store, FatVolume *vol, const FatEntry *entry, SongImportReport *report)
+{
+    uint8_t type = SongType(entry);
+    FatFile file;
+    NorStoreItem old;
+    StreamResult result = STREAM_DIFFERENT;
+
+    if (type == 0U || (entry->attr & (FAT_ATTR_DIRECTORY | FAT_ATTR_VOLUME_ID)) != 0U) return true;
+    /* "._name.mid" and the like: metadata other systems leave next to the file */
+    if (entry->name[0] == '.') return true;
+
+    report->files++;
+    if (entry->size == 0U || entry->size > UINT16_MAX || entry->size > NOR_STORE_MAX_PAYLOAD(store->dev.segmentSize)) {
+        report->skipped++;
+        return true;
+    }
+
+    uint32_t id = SongImport_Id(entry->name);
+    uint32_t key = NOR_STORE_KEY(type, id);
+    Fat_Open(vol, entry, &file);
+
+    /* Same length already stored: compare first, write only if a byte differs */
+    if (NorStore_Find(store, key, &old) == NOR_STORE_OK && old.length == entry->size)
+    {
+        result = Stream(store, &file, &old, report);
+        if (result == STREAM_OK) report->unchanged++;
+    }
+    if (result == STREAM_DIFFERENT)
+    {
+        report->storeStatus = NorStore_Begin(store, key, entry->size);
+        if (report->storeStatus != NOR_STORE_OK) return false;
+        result = Stream(store, &file, NULL, report);
+        if (result == STREAM_OK)
+        {
+            report->storeStatus = NorStore_Commit(store);
+            if (report->storeStatus != NOR_STORE_OK) return false;
+            report->imported++;
+            report->bytes += entry->size;
+        }
+    }
+
+    if (result == STREAM_STORE_ERROR)
+    {
+        if (report->storeStatus == NOR_STORE_OK) report->storeStatus = NOR_STORE_ERR_IO;
+        return false;
+    }
+    if (result == STREAM_DISK_ERROR)
+    {
+        /* The stick was pulled or stopped answering */
+        report->failed++;
+        report->diskStatus = FAT_ERR_IO;
+        return false;
+    }
+    if (result == STREAM_BROKEN)
+    {
+        report->failed++;
+        return true;
+    }
+
+    report->storeStatus = WriteTitle(store, id, entry->name);
+    return report->storeStatus == NOR_STORE_OK;
+}
+
+bool SongImport_Folder(NorStore *store, FatFile *dir, SongImportReport *report)
+{
+    FatEntry entry;
+    FatStatus st;
+
+    memset(report, 0, sizeof(*report));
+    Fat_Rewind(dir);
+    while ((st = Fat_NextEntry(dir, &entry)) == FAT_OK)
+    {
+        if (!SongImport_File(store, dir->vol, &entry, report)) return false;
+    }
+    report->diskStatus = (st == FAT_END) ? FAT_OK : st;
+    return st == FAT_END;
+}
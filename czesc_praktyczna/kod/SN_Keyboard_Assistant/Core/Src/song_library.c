@@ -0,0 +1,75 @@
+#include "song_library.h"
+
+/*
+ * song_library.c
+ *
+ * GENERATED by Tools/midi2song.c - do not edit.
+ *
+ * Songs compiled from MIDI files, in the packed format of song_pack.h.
+ */
+
+/* "Ode to Joy": 8 steps, 30 notes, 4/4, 108 bpm */
+static const uint8_t song0Data[51] = {
+    0x01, 0x06, 0x00, 0x00, 0x00, 0x00, 0x43, 0x00, 0x04, 0x08, 0x50, 0x00,
+    0x54, 0x02, 0x54, 0x04, 0x80, 0x54, 0x04, 0x00, 0x54, 0x03, 0x54, 0x01,
+    0x03, 0x00, 0x10, 0x04, 0x03, 0x54, 0x00, 0x0F, 0x01, 0x54, 0x03, 0x00,
+    0x00, 0x64, 0x03, 0x36, 0x00, 0x72, 0x04, 0x04, 0x58, 0x05, 0x21, 0x16,
+    0x03, 0x21, 0x02,
+};
+
+static const NoteMask128_t song0Masks[8] = {
+    { { 0x00000000UL, 0x00000000UL, 0x0000000BUL, 0x00000000UL } },
+    { { 0x00000000UL, 0x40000000UL, 0x0000000BUL, 0x00000000UL } },
+    { { 0x00000000UL, 0x50000000UL, 0x00000001UL, 0x00000000UL } },
+    { { 0x00000000UL, 0x40000000UL, 0x00000001UL, 0x00000000UL } },
+    { { 0x00000000UL, 0x00000000UL, 0x0000000BUL, 0x00000000UL } },
+    { { 0x00000000UL, 0x40000000UL, 0x0000000BUL, 0x00000000UL } },
+    { { 0x00000000UL, 0x50000000UL, 0x00000001UL, 0x00000000UL } },
+    { { 0x00000000UL, 0x50000000UL, 0x00000000UL, 0x00000000UL } },
+};
+
+static const LessonFrame_t song0Frames[8] = {
+    { {
+        { 0x45, 0x34, 0x20, 0x45, 0x34, 0x20, 0x46, 0x34, 0x20, 0x47, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20 },
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },
+      }, 0x00000004UL },
+    { {
+        { 0x47, 0x34, 0x20, 0x46, 0x34, 0x20, 0x45, 0x34, 0x20, 0x44, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20 },
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x0D, 0x20, 0x20 },
+      }, 0x00002004UL },
+    { {
+        { 0x43, 0x34, 0x20, 0x43, 0x34, 0x20, 0x44, 0x34, 0x20, 0x45, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20 },
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x0F, 0x20, 0x20 },
+      }, 0x00008004UL },
+    { {
+        { 0x45, 0x34, 0x20, 0x44, 0x34, 0x20, 0x44, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },
+        { 0x02, 0x20, 0x20, 0x03, 0x20, 0x20, 0x01, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x20, 0x20 },
+      }, 0x0002000EUL },
+    { {
+        { 0x45, 0x34, 0x20, 0x45, 0x34, 0x20, 0x46, 0x34, 0x20, 0x47, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20 },
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x11, 0x0E, 0x20 },
+      }, 0x00024004UL },
+    { {
+        { 0x47, 0x34, 0x20, 0x46, 0x34, 0x20, 0x45, 0x34, 0x20, 0x44, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20 },
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x11, 0x10, 0x20 },
+      }, 0x00030004UL },
+    { {
+        { 0x43, 0x34, 0x20, 0x43, 0x34, 0x20, 0x44, 0x34, 0x20, 0x45, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20 },
+        { 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x02, 0x20, 0x20, 0x20, 0x11, 0x11, 0x0D },
+      }, 0x00022004UL },
+    { {
+        { 0x44, 0x34, 0x20, 0x43, 0x34, 0x20, 0x43, 0x34, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },
+        { 0x02, 0x20, 0x20, 0x03, 0x20, 0x20, 0x01, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x11, 0x11, 0x0F },
+      }, 0x0002800EUL },
+};
+
+static const PackedSong song0Body = {
+    song0Data, sizeof(song0Data), 30, 0x04,
+    song0Masks, song0Frames
+};
+
+const Song librarySongs[] = {
+    { "Ode to Joy", 8, NULL, 108, 4, 4, &song0Body },
+};
+
+const uint8_t LIBRARY_SONG_COUNT = 1;
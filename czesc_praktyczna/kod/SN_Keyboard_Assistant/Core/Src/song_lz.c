@@ -0,0 +1,174 @@
+#include "song_lz.h"
+#include "song_pack.h"
+
+/**
+ * @file song_lz.c
+ * @brief Compressed song decoder (see song_lz.h).
+ *
+ * One block is kept inflated, with a cursor after the last decoded step, so
+ * walking a song forward inflates each block once and decodes each step
+ * once. Going back within the block restarts at the block start.
+ */
+
+/* The inflated block and the position after the last decoded step */
+static uint8_t raw[SONG_LZ_BLOCK_MAX];
+static struct {
+    const uint8_t *data;    /* NULL = nothing inflated */
+    uint8_t block;
+    uint16_t rawLen;
+    uint8_t step;           /* song step at pos */
+    uint16_t pos;
+    uint8_t pitch;
+    uint32_t tick;
+} cur;
+
+bool SongLz_Inflate(const uint8_t *src, uint16_t srcLen, uint8_t *dst, uint16_t dstLen)
+{
+    uint16_t in = 0;
+    uint16_t out = 0;
+    uint8_t flags = 0;
+    uint8_t items = 0;
+
+    while (out < dstLen)
+    {
+        if (items == 0U) {
+            if (in >= srcLen) return false;
+            flags = src[in++];
+            items = 8;
+        }
+
+        if ((flags & 1U) != 0U)
+        {
+            if ((uint16_t)(srcLen - in) < 2U) return false;
+            uint16_t dist = (uint16_t)(src[in] + 1U);
+            uint16_t len = (uint16_t)(src[in + 1U] + SONG_LZ_MIN_MATCH);
+            in += 2U;
+            if (dist > out || len > dstLen - out) return false;
+            while (len-- > 0U) {
+                dst[out] = dst[out - dist];
+                out++;
+            }
+        }
+        else
+        {
+            if (in >= srcLen) return false;
+            dst[out++] = src[in++];
+        }
+        flags >>= 1;
+        items--;
+    }
+    return true;
+}
+
+static uint16_t Read16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+/* VLQ from the inflated block (7 bits per byte, high bit = more follows). */
+static bool ReadVlq(uint32_t *v)
+{
+    *v = 0;
+    for (uint8_t i = 0; i < 3U; i++)
+    {
+        if (cur.pos >= cur.rawLen) return false;
+        uint8_t b = raw[cur.pos++];
+        *v = (*v << 7) | (b & 0x7FU);
+        if ((b & 0x80U) == 0U) return true;
+    }
+    return false;
+}
+
+/* Inflate block b and put the cursor at its first step. */
+static bool OpenBlock(const uint8_t *data, uint16_t size, uint8_t b)
+{
+    uint8_t blocks = data[0];
+    const uint8_t *entry = &data[1U + SONG_LZ_INDEX_ENTRY * b];
+    uint16_t start = Read16(&entry[0]);
+    uint16_t end = (b + 1U < blocks) ? Read16(&entry[SONG_LZ_INDEX_ENTRY]) : size;
+
+    cur.data = NULL;
+    if (start >= end || end > size) return false;
+
+    uint16_t rawLen = (uint16_t)(data[start] + 1U);
+    if (!SongLz_Inflate(&data[start + 1U], (uint16_t)(end - start - 1U), raw, rawLen)) return false;
+
+    cur.data = data;
+    cur.block = b;
+    cur.rawLen = rawLen;
+    cur.step = entry[4];
+    cur.pos = 0;
+    cur.pitch = SONG_LZ_BASE_PITCH;
+    cur.tick = Read16(&entry[2]);
+    return true;
+}
+
+/* Decode the step at the cursor (notes may be NULL to skip it). */
+static bool NextStep(SongStep *step, NoteEntry *notes)
+{
+    if (cur.pos >= cur.rawLen) return false;
+    uint8_t count = raw[cur.pos++];
+    if (count > SONG_PACK_MAX_STEP_NOTES) return false;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        uint32_t zz;
+        if (!ReadVlq(&zz) || cur.pos >= cur.rawLen) return false;
+
+        int32_t dp = (int32_t)(zz >> 1) ^ -(int32_t)(zz & 1U);
+        cur.pitch = (uint8_t)((int32_t)cur.pitch + dp);
+
+        uint8_t b = raw[cur.pos++];
+        uint32_t delta = b & 0x0FU;
+        if (delta == 15U) {
+            uint32_t more;
+            if (!ReadVlq(&more)) return false;
+            delta += more;
+        }
+        cur.tick += delta * SONG_PACK_GRID_TICKS;
+
+        if (notes != NULL)
+        {
+            NoteEntry *note = &notes[i];
+            note->midiNote = (int8_t)(cur.pitch & 0x7FU);
+            note->durationTicks = songPackDurations[b >> 4];
+            note->lengthIcon = SongPack_LengthIcon(note->durationTicks);
+            note->onsetTick = (uint16_t)cur.tick;
+        }
+    }
+
+    if (step != NULL)
+    {
+        step->noteCount = count;
+        step->notes = notes;
+        step->articulation = ARTIC_NORMAL;
+    }
+    cur.step++;
+    return true;
+}
+
+bool SongLz_DecodeStep(const uint8_t *data, uint16_t size, uint8_t index, SongStep *step, NoteEntry *notes)
+{
+    if (size < 1U + SONG_LZ_INDEX_ENTRY) return false;
+    uint8_t blocks = data[0];
+    if (blocks == 0U || size < 1U + SONG_LZ_INDEX_ENTRY * blocks) return false;
+
+    /* Last block starting at or before the step (binary search on firstStep) */
+    uint8_t lo = 0;
+    uint8_t hi = (uint8_t)(blocks - 1U);
+    while (lo < hi)
+    {
+        uint8_t mid = (uint8_t)((lo + hi + 1U) / 2U);
+        if (data[1U + SONG_LZ_INDEX_ENTRY * mid + 4U] <= index) lo = mid;
+        else hi = (uint8_t)(mid - 1U);
+    }
+
+    if (cur.data != data || cur.block != lo || cur.step > index) {
+        if (!OpenBlock(data, size, lo)) return false;
+    }
+
+    while (cur.step < index) {
+        if (!NextStep(NULL, NULL)) return false;
+    }
+    return NextStep(step, notes);
+}
@@ -0,0 +1,410 @@
+#include "song_pack.h"
+#include "glyphs.h"
+#include "song_lz.h"
+#include "song_text.h"
+
+/*
+ * song_pack.c
+ *
+ * Step access for hand-written and packed songs (see song_pack.h).
+ *
+ * Packed steps are decoded with a cursor that remembers where the last
+ * decoded step ended (byte offset + absolute tick), so walking a song forward
+ * decodes each step once. Going back restarts from the beginning of the
+ * stream, which costs one pass over a few hundred bytes.
+ *
+ * SMF songs are decoded the same way with a step iterator over the file
+ * (smf_reader.h); skipped steps are read without the duration look-ahead.
+ * Text songs likewise keep one parser (song_text.h).
+ */
+
+#if SMF_STEP_MAX_NOTES > SONG_PACK_MAX_STEP_NOTES
+#error "window slots must hold a full SMF step"
+#endif
+#if SONG_TEXT_MAX_NOTES > SONG_PACK_MAX_STEP_NOTES
+#error "window slots must hold a full text step"
+#endif
+
+const uint16_t songPackDurations[16] = {
+    SONG_PPQ / 8U,           /* 32nd */
+    SONG_PPQ / 4U,           /* 16th */
+    SONG_PPQ * 3U / 8U,      /* dotted 16th */
+    SONG_PPQ / 2U,           /* 8th */
+    SONG_PPQ * 3U / 4U,      /* dotted 8th */
+    SONG_PPQ,                /* quarter */
+    SONG_PPQ * 3U / 2U,      /* dotted quarter */
+    SONG_PPQ * 2U,           /* half */
+    SONG_PPQ * 3U,           /* dotted half */
+    SONG_PPQ * 4U,           /* whole */
+    SONG_PPQ * 6U,           /* dotted whole */
+    SONG_PPQ * 8U,           /* two whole notes (tied over a bar) */
+    SONG_PPQ / 6U,           /* 16th triplet */
+    SONG_PPQ / 3U,           /* 8th triplet */
+    SONG_PPQ * 2U / 3U,      /* quarter triplet */
+    SONG_PPQ * 4U / 3U,      /* half triplet */
+};
+
+/* One decoded step */
+typedef struct {
+    const Song *song;        /* NULL = free */
+    uint8_t index;
+    uint32_t lastUse;
+    SongStep step;
+    NoteEntry notes[SONG_PACK_MAX_STEP_NOTES];
+} WindowSlot;
+
+static WindowSlot window[SONG_PACK_WINDOW];
+static uint32_t useClock = 0;
+
+/* Position after the last decoded step */
+static struct {
+    const PackedSong *src;
+    uint8_t step;
+    uint16_t offset;
+    uint32_t tick;
+} cursor;
+
+/* Step iterator of the SMF song decoded last */
+static SmfSteps smfSteps;
+static const PackedSong *smfSource;
+
+/* Parser of the text song decoded last */
+static SongText textSteps;
+static const PackedSong *textSource;
+
+static const char sharpLetters[12]  = { 'C', 'C', 'D', 'D', 'E', 'F', 'F', 'G', 'G', 'A', 'A', 'B' };
+static const char flatLetters[12]   = { 'C', 'D', 'D', 'E', 'E', 'F', 'G', 'G', 'A', 'A', 'B', 'B' };
+static const uint16_t blackKeys     = 0x054AU;   /* C#, D#, F#, G#, A# */
+
+void SongPack_Spell(NoteEntry *note, bool flats)
+{
+    uint8_t pc = (uint8_t)((uint8_t)note->midiNote % 12U);
+    bool black = (blackKeys & (1U << pc)) != 0U;
+
+    note->letter = flats ? flatLetters[pc] : sharpLetters[pc];
+    note->accidental = !black ? ACC_NONE : (flats ? ACC_FLAT : ACC_SHARP);
+}
+
+uint8_t SongPack_DurationCode(uint32_t ticks)
+{
+    uint8_t best = 0;
+    uint32_t bestDiff = UINT32_MAX;
+
+    for (uint8_t c = 0; c < 16U; c++)
+    {
+        uint32_t d = songPackDurations[c];
+        uint32_t diff = (d > ticks) ? d - ticks : ticks - d;
+        if (diff < bestDiff) {
+            best = c;
+            bestDiff = diff;
+        }
+    }
+    return best;
+}
+
+uint8_t SongPack_LengthIcon(uint32_t ticks)
+{
+    if (ticks >= SONG_PPQ * 4U) return GLYPH_WHOLE;
+    if (ticks >= SONG_PPQ * 2U) return GLYPH_HALF;
+    if (ticks >= SONG_PPQ) return GLYPH_QUARTER;
+    if (ticks >= SONG_PPQ / 2U) return GLYPH_EIGHTH;
+    return GLYPH_SIXTEENTH;
+}
+
+static uint16_t ReadEntry(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+/* Where an SMF / text body is read from */
+static SmfSource BodySource(const PackedSong *p)
+{
+    if (p->source != NULL) return *p->source;
+    SmfSource src = { p->data, NULL, NULL, p->size };
+    return src;
+}
+
+/* Decodes step 'index' of an SMF song into slot; false on a read error. */
+static bool DecodeSmf(const Song *song, uint8_t index, WindowSlot *slot)
+{
+    const PackedSong *p = song->packed;
+
+    if (smfSource != p || index < smfSteps.index)
+    {
+        SmfSource src = BodySource(p);
+        smfSource = NULL;
+        if (SmfSteps_Begin(&smfSteps, &src, SONG_PACK_SMF_STEP_NOTES) != SMF_OK) return false;
+        smfSource = p;
+    }
+
+    while (smfSteps.index < index) {
+        if (!SmfSteps_Next(&smfSteps, &slot->step, slot->notes, false)) return false;
+    }
+    if (!SmfSteps_Next(&smfSteps, &slot->step, slot->notes, true)) return false;
+
+    /* Written values, as the compiler would store them */
+    for (uint8_t i = 0; i < slot->step.noteCount; i++)
+    {
+        NoteEntry *note = &slot->notes[i];
+        note->durationTicks = songPackDurations[SongPack_DurationCode(note->durationTicks)];
+        note->lengthIcon = SongPack_LengthIcon(note->durationTicks);
+        SongPack_Spell(note, (p->flags & SONG_PACK_FLATS) != 0U);
+    }
+
+    slot->song = song;
+    slot->index = index;
+    return true;
+}
+
+/* Decodes step 'index' of a text song into slot; false on a parse error. */
+static bool DecodeText(const Song *song, uint8_t index, WindowSlot *slot)
+{
+    const PackedSong *p = song->packed;
+
+    if (textSource != p || index < textSteps.index)
+    {
+        SmfSource src = BodySource(p);
+        textSource = NULL;
+        if (SongText_Begin(&textSteps, &src, SONG_PACK_TEXT_STEP_NOTES) != SONG_TEXT_OK) return false;
+        textSource = p;
+    }
+
+    while (textSteps.index < index) {
+        if (!SongText_Next(&textSteps, &slot->step, slot->notes)) return false;
+    }
+    if (!SongText_Next(&textSteps, &slot->step, slot->notes)) return false;
+
+    for (uint8_t i = 0; i < slot->step.noteCount; i++) {
+        slot->notes[i].lengthIcon = SongPack_LengthIcon(slot->notes[i].durationTicks);
+    }
+    slot->song = song;
+    slot->index = index;
+    return true;
+}
+
+/* Decodes step 'index' of a compressed song into slot; false on corrupt data. */
+static bool DecodeLz(const Song *song, uint8_t index, WindowSlot *slot)
+{
+    const PackedSong *p = song->packed;
+
+    if (!SongLz_DecodeStep(p->data, p->size, index, &slot->step, slot->notes)) return false;
+
+    for (uint8_t i = 0; i < slot->step.noteCount; i++) {
+        SongPack_Spell(&slot->notes[i], (p->flags & SONG_PACK_FLATS) != 0U);
+    }
+    slot->song = song;
+    slot->index = index;
+    return true;
+}
+
+/* Decodes step 'index' of a packed song into slot; false on corrupt data. */
+static bool Decode(const Song *song, uint8_t index, WindowSlot *slot)
+{
+    const PackedSong *p = song->packed;
+
+    if ((p->flags & SONG_PACK_SMF) != 0U) return DecodeSmf(song, index, slot);
+    if ((p->flags & SONG_PACK_LZ) != 0U) return DecodeLz(song, index, slot);
+    if ((p->flags & SONG_PACK_TEXT) != 0U) return DecodeText(song, index, slot);
+
+    if (cursor.src != p || index < cursor.step) {
+        cursor.src = p;
+        cursor.step = 0;
+        cursor.offset = 0;
+        cursor.tick = 0;
+    }
+
+    /* Skip to the step: only the onset deltas matter. */
+    while (cursor.step < index)
+    {
+        if (cursor.offset >= p->size) return false;
+        uint8_t count = p->data[cursor.offset];
+        uint32_t end = cursor.offset + 1U + 2U * count;
+        if (end > p->size) return false;
+
+        for (uint32_t o = cursor.offset + 1U; o < end; o += 2U) {
+            cursor.tick += SONG_PACK_DELTA(ReadEntry(&p->data[o])) * SONG_PACK_GRID_TICKS;
+        }
+        cursor.offset = (uint16_t)end;
+        cursor.step++;
+    }
+
+    if (cursor.offset >= p->size) return false;
+    uint8_t count = p->data[cursor.offset];
+    uint32_t end = cursor.offset + 1U + 2U * count;
+    if (count > SONG_PACK_MAX_STEP_NOTES || end > p->size) return false;
+
+    uint8_t n = 0;
+    for (uint32_t o = cursor.offset + 1U; o < end; o += 2U)
+    {
+        uint16_t e = ReadEntry(&p->data[o]);
+        cursor.tick += SONG_PACK_DELTA(e) * SONG_PACK_GRID_TICKS;
+        if (SONG_PACK_PITCH(e) == SONG_PACK_REST) continue;
+
+        NoteEntry *note = &slot->notes[n++];
+        uint16_t ticks = songPackDurations[SONG_PACK_DUR(e)];
+        note->midiNote = (int8_t)SONG_PACK_PITCH(e);
+        note->lengthIcon = SongPack_LengthIcon(ticks);
+        note->onsetTick = (uint16_t)cursor.tick;
+        note->durationTicks = ticks;
+        SongPack_Spell(note, (p->flags & SONG_PACK_FLATS) != 0U);
+    }
+    cursor.offset = (uint16_t)end;
+    cursor.step++;
+
+    slot->song = song;
+    slot->index = index;
+    slot->step.noteCount = n;
+    slot->step.notes = slot->notes;
+    slot->step.articulation = ARTIC_NORMAL;
+    return true;
+}
+
+const SongStep *Song_Step(const Song *song, uint8_t index)
+{
+    if (song == NULL || index >= song->stepCount) return NULL;
+    if (song->packed == NULL) return (song->steps != NULL) ? &song->steps[index] : NULL;
+
+    WindowSlot *victim = &window[0];
+    for (uint8_t i = 0; i < SONG_PACK_WINDOW; i++)
+    {
+        WindowSlot *slot = &window[i];
+        if (slot->song == song && slot->index == index) {
+            slot->lastUse = ++useClock;
+            return &slot->step;
+        }
+        if (slot->song == NULL || slot->lastUse < victim->lastUse) victim = slot;
+    }
+
+    if (!Decode(song, index, victim)) {
+        victim->song = NULL;
+        return NULL;
+    }
+    victim->lastUse = ++useClock;
+    return &victim->step;
+}
+
+/* The song / body may be reused for another file: drop what was decoded from it */
+static void Forget(const Song *song)
+{
+    smfSource = NULL;
+    textSource = NULL;
+    cursor.src = NULL;
+    for (uint8_t i = 0; i < SONG_PACK_WINDOW; i++) {
+        if (window[i].song == song) window[i].song = NULL;
+    }
+}
+
+/* src is copied for the step count; body keeps a pointer to it only when it has no base */
+static bool OpenSmf(Song *song, PackedSong *body, const SmfSource *src, const char *title)
+{
+    SongStep step;
+    NoteEntry notes[SMF_STEP_MAX_NOTES];
+    uint16_t stepCount = 0;
+    uint16_t noteCount = 0;
+
+    if (src->size > UINT16_MAX) return false;
+
+    Forget(song);
+
+    if (SmfSteps_Begin(&smfSteps, src, SONG_PACK_SMF_STEP_NOTES) != SMF_OK) return false;
+    while (stepCount < UINT8_MAX && SmfSteps_Next(&smfSteps, &step, notes, false))
+    {
+        stepCount++;
+        noteCount = (uint16_t)(noteCount + step.noteCount);
+    }
+    if (stepCount == 0U) return false;
+    /*
+     * Song.stepCount is 8-bit and onsets are 16-bit ticks: a file longer than
+     * either is played up to there and flagged
+     */
+    bool truncated = (stepCount == UINT8_MAX) && SmfSteps_Next(&smfSteps, &step, notes, false);
+    truncated = truncated || smfSteps.tickOverflow;
+
+    body->data = src->base;
+    body->size = (uint16_t)src->size;
+    body->noteCount = noteCount;
+    body->flags = (uint8_t)(SONG_PACK_SMF | ((smfSteps.keySharps < 0) ? SONG_PACK_FLATS : 0U) |
+                            (truncated ? SONG_PACK_TRUNCATED : 0U));
+    body->masks = NULL;
+    body->frames = NULL;
+    body->source = (src->base == NULL) ? src : NULL;
+
+    song->title = title;
+    song->stepCount = (uint8_t)stepCount;
+    song->steps = NULL;
+    song->tempoBpm = smfSteps.tempoBpm;
+    song->beatsPerBar = smfSteps.beatsPerBar;
+    song->beatUnit = smfSteps.beatUnit;
+    song->packed = body;
+    return true;
+}
+
+bool SongPack_OpenSmf(Song *song, PackedSong *body, const uint8_t *file, uint32_t size, const char *title)
+{
+    SmfSource src = { file, NULL, NULL, size };
+    return OpenSmf(song, body, &src, title);
+}
+
+bool SongPack_OpenSmfSource(Song *song, PackedSong *body, const SmfSource *src, const char *title)
+{
+    return OpenSmf(song, body, src, title);
+}
+
+static bool OpenText(Song *song, PackedSong *body, const SmfSource *src,
+                     const char *title, uint16_t *errorLine)
+{
+    SongStep step;
+    NoteEntry notes[SONG_TEXT_MAX_NOTES];
+    uint16_t stepCount = 0;
+    uint16_t noteCount = 0;
+
+    if (src->size > UINT16_MAX) return false;
+    Forget(song);
+
+    if (SongText_Begin(&textSteps, src, SONG_PACK_TEXT_STEP_NOTES) == SONG_TEXT_OK)
+    {
+        while (stepCount < UINT8_MAX && SongText_Next(&textSteps, &step, notes))
+        {
+            stepCount++;
+            noteCount = (uint16_t)(noteCount + step.noteCount);
+        }
+    }
+    if (errorLine != NULL) *errorLine = (textSteps.status != SONG_TEXT_OK) ? textSteps.at.line : 0U;
+    if (textSteps.status != SONG_TEXT_OK || stepCount == 0U) return false;
+    bool truncated = (stepCount == UINT8_MAX) && SongText_Next(&textSteps, &step, notes);
+
+    body->data = src->base;
+    body->size = (uint16_t)src->size;
+    body->noteCount = noteCount;
+    body->flags = (uint8_t)(SONG_PACK_TEXT | (truncated ? SONG_PACK_TRUNCATED : 0U));
+    body->masks = NULL;
+    body->frames = NULL;
+    body->source = (src->base == NULL) ? src : NULL;
+
+    song->title = title;
+    song->stepCount = (uint8_t)stepCount;
+    song->steps = NULL;
+    song->tempoBpm = textSteps.tempoBpm;
+    song->beatsPerBar = textSteps.beatsPerBar;
+    song->beatUnit = textSteps.beatUnit;
+    song->packed = body;
+    return true;
+}
+
+bool SongPack_OpenText(Song *song, PackedSong *body, const char *text, uint32_t size,
+                       const char *title, uint16_t *errorLine)
+{
+    SmfSource src = { (const uint8_t *)text, NULL, NULL, size };
+    return OpenText(song, body, &src, title, errorLine);
+}
+
+bool SongPack_OpenTextSource(Song *song, PackedSong *body, const SmfSource *src,
+                             const char *title, uint16_t *errorLine)
+{
+    return OpenText(song, body, src, title, errorLine);
+}
+
+bool SongPack_IsTruncated(const Song *song)
+{
+    return song->packed != NULL && (song->packed->flags & SONG_PACK_TRUNCATED) != 0U;
+}
@@ -0,0 +1,491 @@
+#include "song_text.h"
+#include "notes.h"
+#include <string.h>
+
+/**
+ * @file song_text.c
+ * @brief Text song parser (see song_text.h).
+ *
+ * ReadEvent() is the tokenizer: it consumes whitespace, comments and header
+ * fields and returns the next note group (one note or a chord), rest or bar
+ * line. SongText_Next() collects note groups into a step; when a group does
+ * not fit, the cursor is set back to before it, so every character is
+ * parsed once per step (twice for the first group of the next step).
+ * A tie looks ahead on a copy of the parser for the note it continues into.
+ */
+
+#define DEFAULT_UNIT   (SONG_PPQ)
+
+/* Note group: one note, or the notes of a chord */
+typedef struct {
+    uint8_t count;
+    uint16_t advance;               /* ticks to the next group: the first note's length */
+    struct {
+        uint8_t pitch;
+        char letter;
+        uint8_t accidental;
+        bool tie;
+        uint16_t ticks;
+    } note[SONG_TEXT_MAX_NOTES];
+} Group;
+
+typedef enum { EV_END = 0, EV_NOTES, EV_REST, EV_BAR } EventKind;
+
+/* Tie look-ahead parser (too big for the stack). */
+static SongText lookahead;
+
+/* --- Characters --- */
+
+/* Character at pos, '\0' at the end of the text or on a read error (status). */
+static char At(SongText *it, uint32_t pos)
+{
+    if (pos >= it->src.size) return '\0';
+    if (it->src.base != NULL) return (char)it->src.base[pos];
+
+    if (pos - it->cacheStart >= it->cacheLen)
+    {
+        uint32_t len = it->src.size - pos;
+        if (len > SONG_TEXT_CACHE) len = SONG_TEXT_CACHE;
+        if (it->src.read == NULL || !it->src.read(it->src.ctx, pos, (uint8_t *)it->cache, (uint16_t)len)) {
+            it->status = SONG_TEXT_ERR_READ;
+            it->src.size = 0;
+            return '\0';
+        }
+        it->cacheStart = pos;
+        it->cacheLen = (uint8_t)len;
+    }
+    return it->cache[pos - it->cacheStart];
+}
+
+static char Peek(SongText *it)
+{
+    return At(it, it->at.pos);
+}
+
+static char Take(SongText *it)
+{
+    char c = At(it, it->at.pos);
+    if (c != '\0') {
+        it->at.pos++;
+        if (c == '\n') it->at.line++;
+    }
+    return c;
+}
+
+static bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/* Decimal number (at most 65535); false if there is no digit. */
+static bool ReadNumber(SongText *it, uint32_t *v)
+{
+    if (!IsDigit(Peek(it))) return false;
+    *v = 0;
+    while (IsDigit(Peek(it))) {
+        *v = *v * 10U + (uint32_t)(Take(it) - '0');
+        if (*v > UINT16_MAX) *v = UINT16_MAX + 1U;
+    }
+    return true;
+}
+
+static void SkipLine(SongText *it)
+{
+    char c;
+    do { c = Take(it); } while (c != '\0' && c != '\n');
+}
+
+/* --- Header fields --- */
+
+/* "a/b" (false if not there) */
+static bool ReadFraction(SongText *it, uint32_t *a, uint32_t *b)
+{
+    if (!ReadNumber(it, a) || Peek(it) != '/') return false;
+    Take(it);
+    return ReadNumber(it, b) && *b != 0U;
+}
+
+/* Field value after "X:"; song values only before the first note. */
+static void ReadField(SongText *it, char field, bool header)
+{
+    uint32_t a;
+    uint32_t b;
+
+    while (Peek(it) == ' ' || Peek(it) == '\t') Take(it);
+
+    switch (field)
+    {
+        case 'L':
+            if (ReadFraction(it, &a, &b)) {
+                uint32_t ticks = SONG_PPQ * 4U * a / b;
+                if (ticks > 0U && ticks <= UINT16_MAX) it->at.unitTicks = (uint16_t)ticks;
+            }
+            break;
+
+        case 'M':
+            if (!header) break;
+            if (Peek(it) == 'C') {
+                Take(it);
+                bool cut = (Peek(it) == '|');
+                it->beatsPerBar = cut ? 2U : 4U;
+                it->beatUnit = cut ? 2U : 4U;
+            } else if (ReadFraction(it, &a, &b) && a > 0U && a <= UINT8_MAX && b <= UINT8_MAX) {
+                it->beatsPerBar = (uint8_t)a;
+                it->beatUnit = (uint8_t)b;
+            }
+            break;
+
+        case 'Q':
+            if (!header) break;
+            /* "120" or "1/4=120" */
+            if (!ReadNumber(it, &a)) a = 0;
+            if (Peek(it) == '/') {
+                Take(it);
+                if (!ReadNumber(it, &b) || Peek(it) != '=') break;
+                Take(it);
+                if (!ReadNumber(it, &a)) a = 0;
+            }
+            if (a > 0U && a <= UINT16_MAX) it->tempoBpm = (uint16_t)a;
+            break;
+
+        case 'T':
+            if (!header || it->titleLen != 0U) break;
+            it->titlePos = it->at.pos;
+            while (Peek(it) != '\0' && Peek(it) != '\n' && Peek(it) != '\r' && it->titleLen < UINT8_MAX) {
+                Take(it);
+                it->titleLen++;
+            }
+            while (it->titleLen > 0U && IsSpace(At(it, it->titlePos + it->titleLen - 1U))) it->titleLen--;
+            break;
+
+        default:
+            break;
+    }
+    SkipLine(it);
+}
+
+/* --- Notes --- */
+
+/* Length suffix: *mul, /div, dots */
+typedef struct {
+    uint32_t mul;
+    uint32_t div;
+    uint8_t dots;
+} Length;
+
+static void ReadLength(SongText *it, Length *len)
+{
+    len->mul = 1;
+    len->div = 1;
+    len->dots = 0;
+
+    if (Peek(it) == '*') {
+        Take(it);
+        if (!ReadNumber(it, &len->mul)) len->mul = 0;
+    }
+    if (Peek(it) == '/') {
+        Take(it);
+        if (!ReadNumber(it, &len->div)) len->div = 2;
+    }
+    while (Peek(it) == '.' && len->dots < 3U) {
+        Take(it);
+        len->dots++;
+    }
+}
+
+/* ticks * len (0 if out of range) */
+static uint16_t ApplyLength(uint32_t ticks, const Length *len)
+{
+    if (len->div == 0U) return 0;
+    ticks = ticks * len->mul / len->div;
+    uint32_t add = ticks;
+    for (uint8_t d = 0; d < len->dots; d++) {
+        add /= 2U;
+        ticks += add;
+    }
+    return (ticks <= UINT16_MAX) ? (uint16_t)ticks : 0U;
+}
+
+/* Note name + length + tie into g->note[g->count]; false on an error (status). */
+static bool ReadNote(SongText *it, Group *g)
+{
+    char name[8];
+    uint8_t len = 0;
+    uint8_t midi;
+    Length length;
+
+    if (g->count >= SONG_TEXT_MAX_NOTES) {
+        it->status = SONG_TEXT_ERR_CHORD;
+        return false;
+    }
+
+    /* Letter, accidental letters / '#', octave digit */
+    name[len++] = Take(it);
+    for (;;)
+    {
+        char c = Peek(it);
+        bool alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        if ((!alpha && c != '#') || len >= 4U) break;
+        name[len++] = Take(it);
+    }
+    if (IsDigit(Peek(it))) name[len++] = Take(it);
+    if (NoteName_ToMidiN(name, len, &midi) != NOTE_OK) {
+        it->status = SONG_TEXT_ERR_NOTE;
+        return false;
+    }
+
+    ReadLength(it, &length);
+    uint16_t ticks = ApplyLength(it->at.unitTicks, &length);
+    if (ticks == 0U) {
+        it->status = SONG_TEXT_ERR_LENGTH;
+        return false;
+    }
+
+    /* Spelling as written: H is B; the accidental is what the name adds to the letter */
+    char letter = (char)(name[0] & ~0x20);
+    if (letter == 'H') letter = 'B';
+    uint8_t alter = (uint8_t)((midi + 12U - (uint8_t)NOTE_LETTER_PC(letter)) % 12U);
+
+    g->note[g->count].pitch = midi;
+    g->note[g->count].letter = letter;
+    g->note[g->count].accidental = (alter == 1U) ? ACC_SHARP : (alter == 11U) ? ACC_FLAT : ACC_NONE;
+    g->note[g->count].ticks = ticks;
+    g->note[g->count].tie = (Peek(it) == '-');
+    if (g->note[g->count].tie) Take(it);
+    g->count++;
+    return true;
+}
+
+static bool IsNoteLetter(char c)
+{
+    char u = (char)(c & ~0x20);
+    return u >= 'A' && u <= 'H';
+}
+
+/* Next event; EV_END at the end of the text or on an error (status). */
+static EventKind ReadEvent(SongText *it, Group *g, bool header)
+{
+    g->count = 0;
+    g->advance = 0;
+
+    for (;;)
+    {
+        char c = Peek(it);
+
+        if (it->status != SONG_TEXT_OK || c == '\0') return EV_END;
+        if (IsSpace(c)) { Take(it); continue; }
+        if (c == '%') { SkipLine(it); continue; }
+
+        /* Header field "X:" */
+        if (c >= 'A' && c <= 'Z' && At(it, it->at.pos + 1U) == ':')
+        {
+            Take(it);
+            Take(it);
+            ReadField(it, c, header);
+            continue;
+        }
+
+        if (c == '|' || c == ':')
+        {
+            while (Peek(it) == '|' || Peek(it) == ':' || Peek(it) == ']') Take(it);
+            return EV_BAR;
+        }
+
+        if (c == 'z')
+        {
+            Length length;
+            Take(it);
+            ReadLength(it, &length);
+            g->advance = ApplyLength(it->at.unitTicks, &length);
+            if (g->advance == 0U) {
+                it->status = SONG_TEXT_ERR_LENGTH;
+                return EV_END;
+            }
+            return EV_REST;
+        }
+
+        if (c == '[')
+        {
+            Length length;
+            Take(it);
+            for (;;)
+            {
+                while (IsSpace(Peek(it))) Take(it);
+                c = Peek(it);
+                if (c == ']') break;
+                if (!IsNoteLetter(c)) {
+                    it->status = SONG_TEXT_ERR_CHORD;
+                    return EV_END;
+                }
+                if (!ReadNote(it, g)) return EV_END;
+            }
+            Take(it);
+            if (g->count == 0U) {
+                it->status = SONG_TEXT_ERR_CHORD;
+                return EV_END;
+            }
+
+            /* Length and tie of the whole chord */
+            ReadLength(it, &length);
+            bool tie = (Peek(it) == '-');
+            if (tie) Take(it);
+            for (uint8_t i = 0; i < g->count; i++)
+            {
+                g->note[i].ticks = ApplyLength(g->note[i].ticks, &length);
+                if (g->note[i].ticks == 0U) {
+                    it->status = SONG_TEXT_ERR_LENGTH;
+                    return EV_END;
+                }
+                g->note[i].tie = g->note[i].tie || tie;
+            }
+            g->advance = g->note[0].ticks;
+            return EV_NOTES;
+        }
+
+        if (IsNoteLetter(c))
+        {
+            if (!ReadNote(it, g)) return EV_END;
+            g->advance = g->note[0].ticks;
+            return EV_NOTES;
+        }
+
+        it->status = SONG_TEXT_ERR_SYNTAX;
+        return EV_END;
+    }
+}
+
+/*
+ * Ticks a tie from the current position adds to a note of this pitch: the
+ * lengths of the next notes of that pitch while they are tied on, within
+ * SONG_TEXT_TIE_BARS bar lines (0 = nothing to tie into).
+ */
+static uint32_t TiedTicks(const SongText *it, uint8_t pitch)
+{
+    Group g;
+    uint32_t ticks = 0;
+    uint8_t bars = 0;
+
+    lookahead = *it;
+    for (;;)
+    {
+        EventKind ev = ReadEvent(&lookahead, &g, false);
+        if (ev == EV_END) return ticks;
+        if (ev == EV_BAR && ++bars > SONG_TEXT_TIE_BARS) return ticks;
+        if (ev != EV_NOTES) continue;
+
+        for (uint8_t i = 0; i < g.count; i++)
+        {
+            if (g.note[i].pitch != pitch) continue;
+            ticks += g.note[i].ticks;
+            if (!g.note[i].tie) return ticks;
+            bars = 0;
+            break;
+        }
+    }
+}
+
+SongTextStatus SongText_Begin(SongText *it, const SmfSource *src, uint8_t maxNotes)
+{
+    memset(it, 0, sizeof(*it));
+    it->src = *src;
+    it->maxNotes = (maxNotes < 1U) ? 1U : (maxNotes > SONG_TEXT_MAX_NOTES) ? SONG_TEXT_MAX_NOTES : maxNotes;
+    it->at.line = 1;
+    it->at.unitTicks = DEFAULT_UNIT;
+    it->beatsPerBar = 4;
+    it->beatUnit = 4;
+
+    /* Header fields up to the first event (read again by SongText_Next()) */
+    SongTextCursor start = it->at;
+    Group g;
+    (void)ReadEvent(it, &g, true);
+    it->at = start;
+
+    return it->status;
+}
+
+bool SongText_Next(SongText *it, SongStep *step, NoteEntry *notes)
+{
+    Group g;
+    uint8_t count = 0;
+
+    while (it->status == SONG_TEXT_OK)
+    {
+        SongTextCursor before = it->at;
+        EventKind ev = ReadEvent(it, &g, false);
+
+        if (ev == EV_END) break;
+        if (ev == EV_BAR) {
+            if (count > 0U) break;
+            continue;
+        }
+
+        uint32_t onset = it->at.tick;
+        it->at.tick += g.advance;
+        if (ev == EV_REST) continue;
+
+        /* Continuations of ties are held, not played */
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < g.count; i++)
+        {
+            uint8_t pitch = g.note[i].pitch;
+            if (NoteMask_Test(&it->at.tied, pitch))
+            {
+                if (!g.note[i].tie || TiedTicks(it, pitch) == 0U) NoteMask_Reset(&it->at.tied, pitch);
+                continue;
+            }
+            g.note[n++] = g.note[i];
+        }
+        if (n == 0U) continue;
+
+        if (count + n > it->maxNotes && count > 0U) {
+            it->at = before;          /* the group starts the next step */
+            break;
+        }
+        if (onset > UINT16_MAX) {
+            it->status = SONG_TEXT_ERR_TOO_LONG;
+            break;
+        }
+
+        for (uint8_t i = 0; i < n && count < SONG_TEXT_MAX_NOTES; i++)
+        {
+            NoteEntry *note = &notes[count++];
+            uint32_t ticks = g.note[i].ticks;
+
+            if (g.note[i].tie) {
+                uint32_t more = TiedTicks(it, g.note[i].pitch);
+                if (more > 0U) NoteMask_Set(&it->at.tied, g.note[i].pitch);
+                ticks += more;
+            }
+
+            memset(note, 0, sizeof(*note));
+            note->letter = g.note[i].letter;
+            note->accidental = g.note[i].accidental;
+            note->midiNote = (int8_t)g.note[i].pitch;
+            note->onsetTick = (uint16_t)onset;
+            note->durationTicks = (ticks <= UINT16_MAX) ? (uint16_t)ticks : UINT16_MAX;
+        }
+    }
+
+    if (count == 0U) return false;
+
+    step->noteCount = count;
+    step->notes = notes;
+    step->articulation = ARTIC_NORMAL;
+    it->index++;
+    return true;
+}
+
+bool SongText_Title(SongText *it, char *buf, uint8_t size)
+{
+    if (it->titleLen == 0U || size == 0U) return false;
+
+    uint8_t len = (it->titleLen < size - 1U) ? it->titleLen : (uint8_t)(size - 1U);
+    for (uint8_t i = 0; i < len; i++) buf[i] = At(it, it->titlePos + i);
+    buf[len] = '\0';
+    return true;
+}
@@ -4,82 +4,88 @@
  * songs.c
  *
  * This module provides a small registry of built-in songs for the lesson mode.
- * Each song is defined as an array of SongStep items. A step can require up to
- * 3 notes (NoteEntry), and each note carries an LCD icon index describing the
- * note duration (whole/half/quarter/etc.).
+ * Each song is defined as an array of SongStep items. A step can require any
+ * number of notes (NoteEntry, listed with NOTES()), and each note carries an
+ * LCD icon index describing the note duration (whole/half/quarter/etc.) plus
+ * its onset and duration in ticks (SONG_PPQ per quarter) for rhythm lessons.
+ * Notes are written with PITCH() (pitch by name, e.g. Fs4 = F#4), which
+ * rejects invalid values at compile time.
+ * A step may add its articulation after the note list (default non-legato).
  *
  * NOTE: This file contains only constant data definitions (no runtime logic).
  */
 
-/* Note length icon indices (match LCD CGRAM slots configured in main.c) */
+/* Note length icon indices (glyph IDs GLYPH_WHOLE..GLYPH_SIXTEENTH, glyphs.h) */
 #define LEN_WHOLE      0
 #define LEN_HALF       1
 #define LEN_QUARTER    2
 #define LEN_EIGHTH     3
 #define LEN_SIXTEENTH  4
 
+/* Note durations in ticks */
+#define T_HALF         (2U * SONG_PPQ)
+#define T_QUARTER      (SONG_PPQ)
+#define T_EIGHTH       (SONG_PPQ / 2U)
+
 /* "Twinkle Twinkle Little Star" (first phrase) */
-static SongStep twinkleSteps[] = {
-    { 2, { { 'C', ACC_NONE, 60, LEN_QUARTER }, { 'C', ACC_NONE, 60, LEN_QUARTER } } },
-    { 2, { { 'G', ACC_NONE, 67, LEN_QUARTER }, { 'G', ACC_NONE, 67, LEN_QUARTER } } },
-    { 2, { { 'A', ACC_NONE, 69, LEN_QUARTER }, { 'A', ACC_NONE, 69, LEN_QUARTER } } },
-    { 1, { { 'G', ACC_NONE, 67, LEN_HALF    } } }
+static const SongStep twinkleSteps[] = {
+    { NOTES(PITCH(C4, LEN_QUARTER,    0, T_QUARTER), PITCH(C4, LEN_QUARTER,   96, T_QUARTER)) },
+    { NOTES(PITCH(G4, LEN_QUARTER,  192, T_QUARTER), PITCH(G4, LEN_QUARTER,  288, T_QUARTER)) },
+    { NOTES(PITCH(A4, LEN_QUARTER,  384, T_QUARTER), PITCH(A4, LEN_QUARTER,  480, T_QUARTER)) },
+    { NOTES(PITCH(G4, LEN_HALF,     576, T_HALF)) }
 };
 
-/* "Mary Had a Little Lamb" (first phrases) */
-static SongStep marySteps[] = {
-    { 2, { { 'E', ACC_NONE, 64, LEN_QUARTER }, { 'D', ACC_NONE, 62, LEN_QUARTER } } },
-    { 2, { { 'C', ACC_NONE, 60, LEN_QUARTER }, { 'D', ACC_NONE, 62, LEN_QUARTER } } },
-    { 3, { { 'E', ACC_NONE, 64, LEN_QUARTER }, { 'E', ACC_NONE, 64, LEN_QUARTER }, { 'E', ACC_NONE, 64, LEN_HALF } } }
+/* "Mary Had a Little Lamb" (first phrases, legato) */
+static const SongStep marySteps[] = {
+    { NOTES(PITCH(E4, LEN_QUARTER,    0, T_QUARTER), PITCH(D4, LEN_QUARTER,   96, T_QUARTER)), ARTIC_LEGATO },
+    { NOTES(PITCH(C4, LEN_QUARTER,  192, T_QUARTER), PITCH(D4, LEN_QUARTER,  288, T_QUARTER)), ARTIC_LEGATO },
+    { NOTES(PITCH(E4, LEN_QUARTER,  384, T_QUARTER), PITCH(E4, LEN_QUARTER,  480, T_QUARTER), PITCH(E4, LEN_HALF,     576, T_HALF)), ARTIC_LEGATO }
 };
 
 /* "Chromatic Study" – longer exercise with sharps and flats */
-static SongStep chromaticSteps[] = {
+static const SongStep chromaticSteps[] = {
     /* C – D */
-    { 2, { { 'C', ACC_NONE, 60, LEN_QUARTER },
-           { 'D', ACC_NONE, 62, LEN_QUARTER } } },
+    { NOTES(PITCH(C4,  LEN_QUARTER,    0, T_QUARTER),
+            PITCH(D4,  LEN_QUARTER,   96, T_QUARTER)) },
 
     /* E – F */
-    { 2, { { 'E', ACC_NONE, 64, LEN_QUARTER },
-           { 'F', ACC_NONE, 65, LEN_QUARTER } } },
+    { NOTES(PITCH(E4,  LEN_QUARTER,  192, T_QUARTER),
+            PITCH(F4,  LEN_QUARTER,  288, T_QUARTER)) },
 
-    /* F# – G – A */
-    { 3, { { 'F', ACC_SHARP, 66, LEN_EIGHTH },
-           { 'G', ACC_NONE,  67, LEN_EIGHTH },
-           { 'A', ACC_NONE,  69, LEN_QUARTER } } },
+    /* F# – G – A (staccato) */
+    { NOTES(PITCH(Fs4, LEN_EIGHTH,   384, T_EIGHTH),
+            PITCH(G4,  LEN_EIGHTH,   432, T_EIGHTH),
+            PITCH(A4,  LEN_QUARTER,  480, T_QUARTER)), ARTIC_STACCATO },
 
     /* Bb – A */
-    { 2, { { 'B', ACC_FLAT, 70, LEN_QUARTER },
-           { 'A', ACC_NONE, 69, LEN_QUARTER } } },
+    { NOTES(PITCH(Bb4, LEN_QUARTER,  576, T_QUARTER),
+            PITCH(A4,  LEN_QUARTER,  672, T_QUARTER)) },
 
     /* G – F# */
-    { 2, { { 'G', ACC_NONE,  67, LEN_QUARTER },
-           { 'F', ACC_SHARP, 66, LEN_QUARTER } } },
+    { NOTES(PITCH(G4,  LEN_QUARTER,  768, T_QUARTER),
+            PITCH(Fs4, LEN_QUARTER,  864, T_QUARTER)) },
 
     /* Step with both SHARP and FLAT */
-    { 2, { { 'F', ACC_SHARP, 66, LEN_QUARTER },
-           { 'B', ACC_FLAT,  70, LEN_QUARTER } } },
+    { NOTES(PITCH(Fs4, LEN_QUARTER,  960, T_QUARTER),
+            PITCH(Bb4, LEN_QUARTER, 1056, T_QUARTER)) },
 
     /* Final C */
-    { 1, { { 'C', ACC_NONE, 72, LEN_HALF } } }
+    { NOTES(PITCH(C5,  LEN_HALF,    1152, T_HALF)) }
 };
 
 /*
  * Exported songs registry.
  * IMPORTANT: direct initialization is a constant initializer.
  */
-Song songs[] = {
+const Song songs[] = {
     { "Twinkle Twinkle",
-      (uint8_t)(sizeof(twinkleSteps) / sizeof(twinkleSteps[0])),
-      twinkleSteps },
+      STEPS(twinkleSteps), 100, 4, 4 },
 
     { "Mary Had a Lamb",
-      (uint8_t)(sizeof(marySteps) / sizeof(marySteps[0])),
-      marySteps },
+      STEPS(marySteps), 100, 4, 4 },
 
     { "Chroma Study",
-          (uint8_t)(sizeof(chromaticSteps) / sizeof(chromaticSteps[0])),
-          chromaticSteps }
+          STEPS(chromaticSteps), 80, 4, 4 }
 
 };
 
@@ -0,0 +1,259 @@
+#include "spi_nor.h"
+#include "stm32l4xx_hal.h"
+
+/**
+ * @file spi_nor.c
+ * @brief SPI NOR flash driver (see spi_nor.h).
+ *
+ * SPI1 and the two DMA channels are programmed directly through their
+ * registers, so the HAL SPI module does not have to be enabled in
+ * stm32l4xx_hal_conf.h (same approach as timebase.c). The channels are
+ * not shared: DMA1 channel 6 belongs to I2C1 TX.
+ */
+
+#define CS_PORT             GPIOA
+#define CS_PIN              GPIO_PIN_8
+
+#define CMD_WRITE_ENABLE    (0x06U)
+#define CMD_READ_STATUS     (0x05U)
+#define CMD_READ            (0x03U)
+#define CMD_PAGE_PROGRAM    (0x02U)
+#define CMD_BLOCK_ERASE     (0xD8U)
+#define CMD_JEDEC_ID        (0x9FU)
+
+#define STATUS_BUSY         (0x01U)
+
+/* DMA data phase: timeout per transfer (at 20 MHz 64 KB take ~26 ms) */
+#define DMA_TIMEOUT_MS      (100U)
+#define DMA_MAX_LEN         (0xFFFFU)
+
+static uint32_t jedecId;
+static uint32_t chipSize;
+
+/* Dummy bytes for the direction that carries no data */
+static const uint8_t txFill = 0xFFU;
+static uint8_t rxSink;
+
+static inline void Select(void)   { CS_PORT->BSRR = (uint32_t)CS_PIN << 16; }
+static inline void Deselect(void) { CS_PORT->BSRR = CS_PIN; }
+
+/* One byte each way, polled (command and address phase) */
+static uint8_t Exchange(uint8_t b)
+{
+    while ((SPI1->SR & SPI_SR_TXE) == 0U) { }
+    *(volatile uint8_t *)&SPI1->DR = b;
+    while ((SPI1->SR & SPI_SR_RXNE) == 0U) { }
+    return *(volatile uint8_t *)&SPI1->DR;
+}
+
+static void SendCommand(uint8_t cmd, uint32_t addr, bool withAddr)
+{
+    Select();
+    (void)Exchange(cmd);
+    if (withAddr)
+    {
+        (void)Exchange((uint8_t)(addr >> 16));
+        (void)Exchange((uint8_t)(addr >> 8));
+        (void)Exchange((uint8_t)addr);
+    }
+}
+
+/*
+ * Data phase on DMA: tx == NULL clocks out 0xFF, rx == NULL drops the
+ * received bytes. RX is enabled before TX so no byte is missed.
+ */
+static bool DmaTransfer(const uint8_t *tx, uint8_t *rx, uint16_t len)
+{
+    DMA1_Channel2->CCR = 0;
+    DMA1_Channel3->CCR = 0;
+    DMA1->IFCR = DMA_IFCR_CGIF2 | DMA_IFCR_CGIF3;
+
+    DMA1_Channel2->CPAR = (uint32_t)(uintptr_t)&SPI1->DR;
+    DMA1_Channel2->CMAR = (uint32_t)(uintptr_t)((rx != NULL) ? rx : &rxSink);
+    DMA1_Channel2->CNDTR = len;
+    DMA1_Channel2->CCR = DMA_CCR_PL_1 | ((rx != NULL) ? DMA_CCR_MINC : 0U);
+
+    DMA1_Channel3->CPAR = (uint32_t)(uintptr_t)&SPI1->DR;
+    DMA1_Channel3->CMAR = (uint32_t)(uintptr_t)((tx != NULL) ? tx : &txFill);
+    DMA1_Channel3->CNDTR = len;
+    DMA1_Channel3->CCR = DMA_CCR_DIR | ((tx != NULL) ? DMA_CCR_MINC : 0U);
+
+    SPI1->CR2 |= SPI_CR2_RXDMAEN;
+    DMA1_Channel2->CCR |= DMA_CCR_EN;
+    DMA1_Channel3->CCR |= DMA_CCR_EN;
+    SPI1->CR2 |= SPI_CR2_TXDMAEN;
+
+    /* RX completes last: then every byte has been clocked */
+    bool ok = true;
+    uint32_t start = HAL_GetTick();
+    while ((DMA1->ISR & DMA_ISR_TCIF2) == 0U)
+    {
+        if ((DMA1->ISR & (DMA_ISR_TEIF2 | DMA_ISR_TEIF3)) != 0U || (HAL_GetTick() - start) > DMA_TIMEOUT_MS) {
+            ok = false;
+            break;
+        }
+    }
+
+    SPI1->CR2 &= ~(SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+    DMA1_Channel2->CCR = 0;
+    DMA1_Channel3->CCR = 0;
+    DMA1->IFCR = DMA_IFCR_CGIF2 | DMA_IFCR_CGIF3;
+    while ((SPI1->SR & SPI_SR_BSY) != 0U) { }
+    while ((SPI1->SR & SPI_SR_FRLVL) != 0U) (void)*(volatile uint8_t *)&SPI1->DR;
+    return ok;
+}
+
+static bool WaitReady(uint32_t timeoutMs)
+{
+    uint32_t start = HAL_GetTick();
+    uint8_t status;
+
+    SendCommand(CMD_READ_STATUS, 0, false);
+    do {
+        status = Exchange(0xFFU);
+    } while ((status & STATUS_BUSY) != 0U && (HAL_GetTick() - start) <= timeoutMs);
+    Deselect();
+    return (status & STATUS_BUSY) == 0U;
+}
+
+static void WriteEnable(void)
+{
+    SendCommand(CMD_WRITE_ENABLE, 0, false);
+    Deselect();
+}
+
+bool SpiNor_Init(void)
+{
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_SPI1_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    Deselect();
+    gpio.Pin = CS_PIN;
+    gpio.Mode = GPIO_MODE_OUTPUT_PP;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    HAL_GPIO_Init(CS_PORT, &gpio);
+
+    gpio.Pin = GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7;
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Alternate = GPIO_AF5_SPI1;
+    HAL_GPIO_Init(GPIOA, &gpio);
+
+    /* Mode 0, master, software NSS, 8-bit frames, RXNE at one byte */
+    SPI1->CR1 = 0;
+    SPI1->CR2 = (7U << SPI_CR2_DS_Pos) | SPI_CR2_FRXTH;
+    SPI1->CR1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI | (SPI_NOR_BAUD_DIV << SPI_CR1_BR_Pos);
+    SPI1->CR1 |= SPI_CR1_SPE;
+
+    /* Request 1 = SPI1 on channels 2 (RX) and 3 (TX) */
+    DMA1_CSELR->CSELR = (DMA1_CSELR->CSELR & ~(DMA_CSELR_C2S | DMA_CSELR_C3S)) |
+                        (1U << DMA_CSELR_C2S_Pos) | (1U << DMA_CSELR_C3S_Pos);
+
+    /* A chip busy with a write from before the reset finishes first */
+    (void)WaitReady(SPI_NOR_ERASE_TIMEOUT_MS);
+
+    SendCommand(CMD_JEDEC_ID, 0, false);
+    jedecId = (uint32_t)Exchange(0xFFU) << 16;
+    jedecId |= (uint32_t)Exchange(0xFFU) << 8;
+    jedecId |= Exchange(0xFFU);
+    Deselect();
+
+    uint8_t capacity = (uint8_t)jedecId;
+    if (jedecId == 0U || jedecId == 0xFFFFFFUL || capacity < 16U || capacity > 31U) {
+        jedecId = 0;
+        chipSize = 0;
+        return false;
+    }
+    chipSize = (capacity > 24U) ? (1UL << 24) : (1UL << capacity);
+    return true;
+}
+
+uint32_t SpiNor_JedecId(void)
+{
+    return jedecId;
+}
+
+uint32_t SpiNor_Size(void)
+{
+    return chipSize;
+}
+
+bool SpiNor_Read(uint32_t addr, uint8_t *buf, uint32_t len)
+{
+    bool ok = true;
+
+    if (addr > chipSize || len > chipSize - addr) return false;
+    SendCommand(CMD_READ, addr, true);
+    while (ok && len > 0U)
+    {
+        uint16_t n = (len > DMA_MAX_LEN) ? (uint16_t)DMA_MAX_LEN : (uint16_t)len;
+        ok = DmaTransfer(NULL, buf, n);
+        buf += n;
+        len -= n;
+    }
+    Deselect();
+    return ok;
+}
+
+bool SpiNor_Program(uint32_t addr, const uint8_t *buf, uint32_t len)
+{
+    if (addr > chipSize || len > chipSize - addr) return false;
+    while (len > 0U)
+    {
+        uint32_t n = SPI_NOR_PAGE_SIZE - (addr % SPI_NOR_PAGE_SIZE);
+        if (n > len) n = len;
+
+        WriteEnable();
+        SendCommand(CMD_PAGE_PROGRAM, addr, true);
+        bool ok = DmaTransfer(buf, NULL, (uint16_t)n);
+        Deselect();
+        if (!ok || !WaitReady(SPI_NOR_PROGRAM_TIMEOUT_MS)) return false;
+
+        addr += n;
+        buf += n;
+        len -= n;
+    }
+    return true;
+}
+
+bool SpiNor_EraseBlock(uint32_t addr)
+{
+    if (addr % SPI_NOR_BLOCK_SIZE != 0U || addr >= chipSize) return false;
+    WriteEnable();
+    SendCommand(CMD_BLOCK_ERASE, addr, true);
+    Deselect();
+    return WaitReady(SPI_NOR_ERASE_TIMEOUT_MS);
+}
+
+/* --- NorDevice --- */
+
+static bool DevRead(void *ctx, uint32_t addr, uint8_t *buf, uint32_t len)
+{
+    (void)ctx;
+    return SpiNor_Read(addr, buf, len);
+}
+
+static bool DevProgram(void *ctx, uint32_t addr, const uint8_t *buf, uint32_t len)
+{
+    (void)ctx;
+    return SpiNor_Program(addr, buf, len);
+}
+
+static bool DevErase(void *ctx, uint32_t addr)
+{
+    (void)ctx;
+    return SpiNor_EraseBlock(addr);
+}
+
+void SpiNor_Device(NorDevice *dev)
+{
+    dev->read = DevRead;
+    dev->program = DevProgram;
+    dev->erase = DevErase;
+    dev->ctx = NULL;
+    dev->segmentSize = SPI_NOR_BLOCK_SIZE;
+    dev->segmentCount = (uint16_t)(chipSize / SPI_NOR_BLOCK_SIZE);
+}
@@ -21,6 +21,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 /* USER CODE BEGIN Includes */
+#include "lcd_queue.h"
 
 /* USER CODE END Includes */
 
@@ -41,6 +42,8 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN PV */
+/* I2C1 TX DMA (LCD command queue). */
+DMA_HandleTypeDef hdma_i2c1_tx;
 
 /* USER CODE END PV */
 
@@ -118,6 +121,32 @@ void HAL_I2C_MspInit(I2C_HandleTypeDef* hi2c)
     __HAL_RCC_I2C1_CLK_ENABLE();
     /* USER CODE BEGIN I2C1_MspInit 1 */
 
+    /* I2C1_TX: DMA1 Channel 6, request 3 (RM0351 DMA1 request mapping). */
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    hdma_i2c1_tx.Instance = DMA1_Channel6;
+    hdma_i2c1_tx.Init.Request = DMA_REQUEST_3;
+    hdma_i2c1_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_i2c1_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_i2c1_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_i2c1_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_i2c1_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_i2c1_tx.Init.Mode = DMA_NORMAL;
+    hdma_i2c1_tx.Init.Priority = DMA_PRIORITY_LOW;
+    if (HAL_DMA_Init(&hdma_i2c1_tx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+    __HAL_LINKDMA(hi2c, hdmatx, hdma_i2c1_tx);
+
+    /* DMA and I2C event/error interrupts drive the LCD queue. */
+    HAL_NVIC_SetPriority(DMA1_Channel6_IRQn, LCDQ_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel6_IRQn);
+    HAL_NVIC_SetPriority(I2C1_EV_IRQn, LCDQ_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+    HAL_NVIC_SetPriority(I2C1_ER_IRQn, LCDQ_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
+
     /* USER CODE END I2C1_MspInit 1 */
 
   }
@@ -149,6 +178,10 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef* hi2c)
     HAL_GPIO_DeInit(GPIOB, GPIO_PIN_7);
 
     /* USER CODE BEGIN I2C1_MspDeInit 1 */
+    HAL_DMA_DeInit(hi2c->hdmatx);
+    HAL_NVIC_DisableIRQ(DMA1_Channel6_IRQn);
+    HAL_NVIC_DisableIRQ(I2C1_EV_IRQn);
+    HAL_NVIC_DisableIRQ(I2C1_ER_IRQn);
 
     /* USER CODE END I2C1_MspDeInit 1 */
   }
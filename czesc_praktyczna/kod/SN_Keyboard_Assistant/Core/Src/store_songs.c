@@ -0,0 +1,92 @@
+#include "store_songs.h"
+#include "song_pack.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * store_songs.c
+ *
+ * Song keys are type << 24 | id and the index is sorted by key, so the
+ * SMF songs (type 1) and then the text songs (type 2) are the first items
+ * of the store; the list is just that range of the index.
+ */
+
+static NorStore *songStore = NULL;
+static uint16_t songCount = 0;
+
+/* The open song: item, its source and the Song made of it */
+static NorStoreItem openItem;
+static SmfSource openSource;
+static PackedSong openBody;
+static Song openSong;
+static char openTitle[STORE_SONG_TITLE_MAX + 1U];
+
+static char listTitle[STORE_SONG_TITLE_MAX + 1U];
+
+static bool IsSongKey(uint32_t key)
+{
+    uint8_t type = NOR_STORE_KEY_TYPE(key);
+    return type == NOR_STORE_SONG_SMF || type == NOR_STORE_SONG_TEXT;
+}
+
+void StoreSongs_Attach(NorStore *store)
+{
+    songStore = store;
+    StoreSongs_Refresh();
+}
+
+void StoreSongs_Refresh(void)
+{
+    songCount = 0;
+    if (songStore == NULL) return;
+
+    while (songCount < NorStore_Count(songStore) && IsSongKey(NorStore_KeyAt(songStore, songCount))) {
+        songCount++;
+    }
+}
+
+uint16_t StoreSongs_Count(void)
+{
+    return songCount;
+}
+
+static void ReadTitle(uint32_t key, char *title)
+{
+    NorStoreItem item;
+    uint32_t length = 0;
+
+    if (NorStore_Find(songStore, NOR_STORE_KEY(NOR_STORE_SONG_TITLE, NOR_STORE_KEY_ID(key)), &item) == NOR_STORE_OK)
+    {
+        length = (item.length > STORE_SONG_TITLE_MAX) ? STORE_SONG_TITLE_MAX : item.length;
+        if (!NorStore_Read(&item, 0, (uint8_t *)title, length)) length = 0;
+    }
+    title[length] = '\0';
+    if (length == 0U) {
+        snprintf(title, STORE_SONG_TITLE_MAX + 1U, "Song %06lX", (unsigned long)NOR_STORE_KEY_ID(key));
+    }
+}
+
+const char *StoreSongs_Title(uint16_t index)
+{
+    if (index >= songCount) return "";
+    ReadTitle(NorStore_KeyAt(songStore, index), listTitle);
+    return listTitle;
+}
+
+const Song *StoreSongs_Open(uint16_t index)
+{
+    bool ok;
+
+    if (index >= songCount) return NULL;
+    uint32_t key = NorStore_KeyAt(songStore, index);
+    if (NorStore_Find(songStore, key, &openItem) != NOR_STORE_OK) return NULL;
+
+    ReadTitle(key, openTitle);
+    NorStore_Source(&openItem, &openSource);
+    if (NOR_STORE_KEY_TYPE(key) == NOR_STORE_SONG_SMF) {
+        ok = SongPack_OpenSmfSource(&openSong, &openBody, &openSource, openTitle);
+    } else {
+        ok = SongPack_OpenTextSource(&openSong, &openBody, &openSource, openTitle, NULL);
+    }
+    return ok ? &openSong : NULL;
+}
@@ -0,0 +1,81 @@
+#include "text_songs.h"
+#include "song_pack.h"
+#include "song_text.h"
+#include <string.h>
+
+/*
+ * text_songs.c
+ *
+ * Exercise texts (one string per exercise, as a teacher would write the
+ * file) and the Song objects made of them. Only the Song / PackedSong
+ * headers and titles live in RAM; the notes are read from the text.
+ */
+
+static const char scaleText[] =
+    "T:C Major Scale\n"
+    "Q:90\n"
+    "M:4/4\n"
+    "% up one octave and back\n"
+    "C4 D4 E4 F4 | G4 A4 B4 C5 | C5 B4 A4 G4 | F4 E4 D4 C4*4 ||\n";
+
+static const char chordsText[] =
+    "T:Chords I-IV-V\n"
+    "Q:72\n"
+    "M:4/4\n"
+    "% C, F/C, G/B, each held for two beats\n"
+    "[C4 E4 G4]*2 [C4 E4 G4]*2 | [C4 F4 A4]*2 [C4 F4 A4]*2 |\n"
+    "[B3 D4 G4]*2 [B3 D4 G4]*2 | [C4 E4 G4]*4 ||\n";
+
+static const char jacquesText[] =
+    "T:Frere Jacques\n"
+    "Q:100\n"
+    "M:4/4\n"
+    "C4 D4 E4 C4 | C4 D4 E4 C4 | E4 F4 G4*2 | E4 F4 G4*2 |\n"
+    "G4/ A4/ G4/ F4/ E4 C4 | G4/ A4/ G4/ F4/ E4 C4 |\n"
+    "C4 G3 C4*2 | C4 G3 C4*2 ||\n";
+
+static const char accidentalsText[] =
+    "T:Sharps and Flats\n"
+    "Q:80\n"
+    "M:3/4\n"
+    "L:1/8\n"
+    "% the last G is tied over the bar line: hold it, do not strike again\n"
+    "F#4*2 G4*2 A4*2 | Bb4*4 A4*2 | G4*2 F#4*2 G4*2- | G4*6 ||\n";
+
+static const char *const texts[] = { scaleText, chordsText, jacquesText, accidentalsText };
+
+#define TEXT_COUNT  (sizeof(texts) / sizeof(texts[0]))
+
+static Song textSongs[TEXT_COUNT];
+static PackedSong textBodies[TEXT_COUNT];
+static char titles[TEXT_COUNT][TEXT_SONG_TITLE_MAX + 1U];
+static uint8_t count = 0;
+
+void TextSongs_Init(void)
+{
+    static SongText header;
+
+    count = 0;
+    for (uint8_t i = 0; i < TEXT_COUNT; i++)
+    {
+        SmfSource src = { (const uint8_t *)texts[i], NULL, NULL, (uint32_t)strlen(texts[i]) };
+
+        if (SongText_Begin(&header, &src, SONG_PACK_TEXT_STEP_NOTES) != SONG_TEXT_OK) continue;
+        if (!SongText_Title(&header, titles[count], sizeof(titles[count]))) {
+            strcpy(titles[count], "Exercise");
+        }
+        if (SongPack_OpenText(&textSongs[count], &textBodies[count], texts[i], src.size, titles[count], NULL)) {
+            count++;
+        }
+    }
+}
+
+uint8_t TextSongs_Count(void)
+{
+    return count;
+}
+
+const Song *TextSongs_At(uint8_t index)
+{
+    return (index < count) ? &textSongs[index] : NULL;
+}
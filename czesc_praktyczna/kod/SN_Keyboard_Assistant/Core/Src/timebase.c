@@ -0,0 +1,89 @@
+#include "timebase.h"
+#include "stm32l4xx_hal.h"
+
+/**
+ * @file timebase.c
+ * @brief Microsecond timebase on TIM2.
+ *
+ * The timer is programmed directly through its registers, so the HAL TIM
+ * module does not have to be enabled in stm32l4xx_hal_conf.h.
+ *
+ * Clock tree note:
+ * - TIM2 sits on APB1. If the APB1 prescaler is not 1, the timer kernel clock
+ *   is 2 x PCLK1 (RM0351, "Timer clock"). The prescaler below accounts for it.
+ */
+
+#define TIMEBASE_TICK_HZ   (1000000UL)
+
+static volatile TimebaseAlarmCallback alarmCallback = NULL;
+
+void Timebase_Init(void)
+{
+    uint32_t timclk = HAL_RCC_GetPCLK1Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_HCLK_DIV1) {
+        timclk *= 2U;
+    }
+
+    __HAL_RCC_TIM2_CLK_ENABLE();
+
+    TIM2->CR1 = 0;                                   /* stop, up-counting */
+    TIM2->PSC = (timclk / TIMEBASE_TICK_HZ) - 1U;    /* 1 count = 1 us */
+    TIM2->ARR = 0xFFFFFFFFUL;                        /* full 32-bit range */
+    TIM2->CNT = 0;
+    TIM2->EGR = TIM_EGR_UG;                          /* latch PSC now */
+    TIM2->SR  = 0;
+    TIM2->DIER = 0;                                  /* CC1 alarm armed on demand */
+    TIM2->CR1 = TIM_CR1_CEN;
+
+    HAL_NVIC_SetPriority(TIM2_IRQn, TIMEBASE_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(TIM2_IRQn);
+}
+
+uint32_t Timebase_Micros(void)
+{
+    return TIM2->CNT;
+}
+
+void Timebase_DelayUs(uint32_t us)
+{
+    uint32_t start = TIM2->CNT;
+    while ((uint32_t)(TIM2->CNT - start) < us) {
+        /* spin */
+    }
+}
+
+void Timebase_SetAlarmUs(uint32_t delay_us, TimebaseAlarmCallback callback)
+{
+    if (delay_us == 0U) delay_us = 1U;
+
+    TIM2->DIER &= ~TIM_DIER_CC1IE;
+    alarmCallback = callback;
+
+    uint32_t start = TIM2->CNT;
+    TIM2->CCR1 = start + delay_us;
+    TIM2->SR = ~(uint32_t)TIM_SR_CC1IF;
+    TIM2->DIER |= TIM_DIER_CC1IE;
+
+    /*
+     * The compare only fires on CNT == CCR1. If the counter already ran past
+     * it while arming, raise the event by software instead of waiting a wrap.
+     */
+    if ((uint32_t)(TIM2->CNT - start) >= delay_us && (TIM2->SR & TIM_SR_CC1IF) == 0U) {
+        TIM2->EGR = TIM_EGR_CC1G;
+    }
+}
+
+void Timebase_IRQHandler(void)
+{
+    if ((TIM2->SR & TIM_SR_CC1IF) == 0U || (TIM2->DIER & TIM_DIER_CC1IE) == 0U) {
+        TIM2->SR = ~(uint32_t)TIM_SR_CC1IF;
+        return;
+    }
+
+    TIM2->DIER &= ~TIM_DIER_CC1IE;
+    TIM2->SR = ~(uint32_t)TIM_SR_CC1IF;
+
+    TimebaseAlarmCallback cb = alarmCallback;
+    alarmCallback = NULL;
+    if (cb != NULL) cb();
+}
@@ -0,0 +1,175 @@
+#include "timer_wheel.h"
+#include "timebase.h"
+#include <stddef.h>
+
+/**
+ * @file timer_wheel.c
+ * @brief Two-level hierarchical timer wheel (see timer_wheel.h).
+ *
+ * Each slot is the head of a singly-linked list; every timer also keeps a
+ * pointer to the link that points at it (pprev), so unlinking needs no search.
+ *
+ * Slot selection for a timer expiring at tick 'e' while the wheel is at 'now':
+ * - e - now <  256         -> level 0, slot e & 0xFF
+ * - e - now <  256 * 64    -> level 1, slot (e >> 8) & 0x3F
+ * - otherwise              -> farthest level 1 slot, re-hashed on cascade
+ *
+ * Whenever the level 0 index wraps to 0, the matching level 1 slot is emptied
+ * and its timers are re-inserted (they land in level 0 by then).
+ */
+
+#define WHEEL_L0_BITS   8U
+#define WHEEL_L1_BITS   6U
+#define WHEEL_L0_SIZE   (1UL << WHEEL_L0_BITS)
+#define WHEEL_L1_SIZE   (1UL << WHEEL_L1_BITS)
+#define WHEEL_L0_MASK   (WHEEL_L0_SIZE - 1U)
+#define WHEEL_L1_MASK   (WHEEL_L1_SIZE - 1U)
+#define WHEEL_SPAN      (WHEEL_L0_SIZE * WHEEL_L1_SIZE)
+
+static SoftTimer_t *wheelL0[WHEEL_L0_SIZE];
+static SoftTimer_t *wheelL1[WHEEL_L1_SIZE];
+
+/* Last processed tick and the timebase timestamp it corresponds to. */
+static uint32_t wheelNow = 0;
+static uint32_t wheelLastUs = 0;
+
+/* Push a timer at the front of a slot list. */
+static void list_push(SoftTimer_t **head, SoftTimer_t *t)
+{
+    t->next = *head;
+    if (t->next != NULL) {
+        t->next->pprev = &t->next;
+    }
+    *head = t;
+    t->pprev = head;
+}
+
+/* Remove a timer from whatever list it is on. */
+static void list_unlink(SoftTimer_t *t)
+{
+    *t->pprev = t->next;
+    if (t->next != NULL) {
+        t->next->pprev = t->pprev;
+    }
+    t->next = NULL;
+    t->pprev = NULL;
+}
+
+/* Hash a timer into the proper wheel slot relative to wheelNow. */
+static void wheel_insert(SoftTimer_t *t)
+{
+    uint32_t delta = t->expires - wheelNow;
+
+    if (delta < WHEEL_L0_SIZE) {
+        list_push(&wheelL0[t->expires & WHEEL_L0_MASK], t);
+    } else if (delta < WHEEL_SPAN) {
+        list_push(&wheelL1[(t->expires >> WHEEL_L0_BITS) & WHEEL_L1_MASK], t);
+    } else {
+        /* Beyond the horizon: park in the farthest slot, re-hashed on cascade. */
+        uint32_t park = wheelNow + WHEEL_SPAN - 1U;
+        list_push(&wheelL1[(park >> WHEEL_L0_BITS) & WHEEL_L1_MASK], t);
+    }
+}
+
+/* Move all timers of one level 1 slot down to level 0. */
+static void wheel_cascade(uint32_t l1Index)
+{
+    SoftTimer_t *t = wheelL1[l1Index];
+    wheelL1[l1Index] = NULL;
+
+    while (t != NULL) {
+        SoftTimer_t *next = t->next;
+        wheel_insert(t);
+        t = next;
+    }
+}
+
+/* Process one tick: cascade if needed, then fire everything in the current slot. */
+static void wheel_run_tick(void)
+{
+    uint32_t l0Index = wheelNow & WHEEL_L0_MASK;
+
+    if (l0Index == 0U) {
+        wheel_cascade((wheelNow >> WHEEL_L0_BITS) & WHEEL_L1_MASK);
+    }
+
+    /*
+     * Detach the slot into a local list first: callbacks may start or cancel
+     * any timer (including ones still waiting in this list).
+     */
+    SoftTimer_t *expired = wheelL0[l0Index];
+    wheelL0[l0Index] = NULL;
+    if (expired != NULL) {
+        expired->pprev = &expired;
+    }
+
+    while (expired != NULL) {
+        SoftTimer_t *t = expired;
+        list_unlink(t);
+
+        /* Re-arm periodic timers before the callback so it may cancel them. */
+        if (t->period != 0U) {
+            t->expires = wheelNow + t->period;
+            wheel_insert(t);
+        }
+
+        if (t->callback != NULL) {
+            t->callback(t->arg);
+        }
+    }
+}
+
+void TimerWheel_Init(void)
+{
+    for (uint32_t i = 0; i < WHEEL_L0_SIZE; i++) wheelL0[i] = NULL;
+    for (uint32_t i = 0; i < WHEEL_L1_SIZE; i++) wheelL1[i] = NULL;
+
+    wheelNow = 0;
+    wheelLastUs = Timebase_Micros();
+}
+
+void TimerWheel_Start(SoftTimer_t *timer, uint32_t delay_ms, uint32_t period_ms,
+                      SoftTimerCallback callback, void *arg)
+{
+    if (timer == NULL) return;
+
+    if (timer->pprev != NULL) {
+        list_unlink(timer);
+    }
+
+    if (delay_ms == 0U) delay_ms = 1U;
+
+    timer->callback = callback;
+    timer->arg = arg;
+    timer->period = period_ms;
+    timer->expires = wheelNow + delay_ms;
+    wheel_insert(timer);
+}
+
+void TimerWheel_Cancel(SoftTimer_t *timer)
+{
+    if (timer == NULL || timer->pprev == NULL) return;
+    list_unlink(timer);
+}
+
+bool TimerWheel_IsActive(const SoftTimer_t *timer)
+{
+    return (timer != NULL) && (timer->pprev != NULL);
+}
+
+uint32_t TimerWheel_Now(void)
+{
+    return wheelNow;
+}
+
+void TimerWheel_Process(void)
+{
+    uint32_t elapsed = Timebase_Micros() - wheelLastUs;
+
+    while (elapsed >= TIMER_WHEEL_TICK_US) {
+        elapsed -= TIMER_WHEEL_TICK_US;
+        wheelLastUs += TIMER_WHEEL_TICK_US;
+        wheelNow++;
+        wheel_run_tick();
+    }
+}
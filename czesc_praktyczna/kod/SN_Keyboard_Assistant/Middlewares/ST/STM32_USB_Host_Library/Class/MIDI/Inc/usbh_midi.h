@@ -62,6 +62,7 @@ typedef enum {
  * - OutPipe/OutEp/OutEpSize: optional host->device endpoint (not used by this IN-only API)
  * - RxBuffer: one USB packet buffer used by USBH_BulkReceiveData()
  * - EventFIFO: queue storing 4-byte USB-MIDI event packets
+ * - EventStamp: DWT cycle timestamp of the URB that delivered each FIFO event
  * - EventFIFOHead/Tail: circular buffer indices (in bytes, step = 4)
  */
 typedef struct {
@@ -74,6 +75,7 @@ typedef struct {
     MIDI_StateTypeDef state;        /* Current class state */
     uint8_t  RxBuffer[USBH_MIDI_MAX_PACKET_SIZE];       /* Buffer for one incoming USB packet */
     uint8_t  EventFIFO[USBH_MIDI_EVENT_FIFO_SIZE];      /* FIFO of 4-byte USB-MIDI events */
+    uint32_t EventStamp[USBH_MIDI_EVENT_FIFO_SIZE / 4]; /* URB-done timestamp per event (cycles) */
     uint16_t EventFIFOHead;         /* FIFO write index (byte offset) */
     uint16_t EventFIFOTail;         /* FIFO read index (byte offset) */
 } MIDI_HandleTypeDef;
@@ -93,6 +95,17 @@ extern USBH_ClassTypeDef MIDI_Class;
  */
 USBH_StatusTypeDef USBH_MIDI_GetEvent(USBH_HandleTypeDef *phost, uint8_t *event_buf);
 
+/**
+ * @brief Same as USBH_MIDI_GetEvent(), also returns the arrival timestamp.
+ *
+ * @param stamp Output: DWT cycle count (Latency_Now()) captured when the USB
+ *              packet carrying this event completed, in the host channel
+ *              interrupt (USBH_LL_GetURBDoneStamp()), so the time until the
+ *              main loop polls the class is not in it. May be NULL.
+ */
+USBH_StatusTypeDef USBH_MIDI_GetEventStamped(USBH_HandleTypeDef *phost, uint8_t *event_buf,
+                                             uint32_t *stamp);
+
 /* Note: No explicit send function is provided in this minimal IN-only driver. */
 
 #ifdef __cplusplus
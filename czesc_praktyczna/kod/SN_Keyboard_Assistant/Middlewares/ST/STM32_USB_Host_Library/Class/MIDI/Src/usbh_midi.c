@@ -245,7 +245,8 @@ static USBH_StatusTypeDef USBH_MIDI_Process(USBH_HandleTypeDef *phost)
       urb_state = USBH_LL_GetURBState(phost, MIDI_Handle->InPipe);
       if (urb_state == USBH_URB_DONE)
       {
-        /* One USB packet received */
+        /* One USB packet received: its completion time, stamped in the channel interrupt */
+        uint32_t stamp = USBH_LL_GetURBDoneStamp(MIDI_Handle->InPipe);
         length = USBH_LL_GetLastXferSize(phost, MIDI_Handle->InPipe);
         printf("USBH_MIDI_Process: URB done, received %lu bytes\r\n", (unsigned long)length);
 
@@ -264,6 +265,7 @@ static USBH_StatusTypeDef USBH_MIDI_Process(USBH_HandleTypeDef *phost)
 
             memcpy(&MIDI_Handle->EventFIFO[MIDI_Handle->EventFIFOHead],
                    &MIDI_Handle->RxBuffer[i], 4);
+            MIDI_Handle->EventStamp[MIDI_Handle->EventFIFOHead / 4] = stamp;
             MIDI_Handle->EventFIFOHead = nextHead;
             i += 4;
           }
@@ -349,6 +351,21 @@ static USBH_StatusTypeDef USBH_MIDI_SOFProcess(USBH_HandleTypeDef *phost)
  */
 USBH_StatusTypeDef USBH_MIDI_GetEvent(USBH_HandleTypeDef *phost, uint8_t *event_buf)
 {
+  return USBH_MIDI_GetEventStamped(phost, event_buf, NULL);
+}
+
+/**
+ * @brief Public API: pop one 4-byte event and its URB-done timestamp.
+ */
+USBH_StatusTypeDef USBH_MIDI_GetEventStamped(USBH_HandleTypeDef *phost, uint8_t *event_buf,
+                                             uint32_t *stamp)
+{
+  /* Another class (e.g. a USB stick) may be the active one: its pData is not a MIDI handle */
+  if (phost->pActiveClass != &MIDI_Class)
+  {
+    return USBH_FAIL;
+  }
+
   MIDI_HandleTypeDef *MIDI_Handle = (MIDI_HandleTypeDef *)phost->pActiveClass->pData;
   if (MIDI_Handle == NULL)
   {
@@ -366,6 +383,10 @@ USBH_StatusTypeDef USBH_MIDI_GetEvent(USBH_HandleTypeDef *phost, uint8_t *event_
   {
     event_buf[j] = MIDI_Handle->EventFIFO[MIDI_Handle->EventFIFOTail + j];
   }
+  if (stamp != NULL)
+  {
+    *stamp = MIDI_Handle->EventStamp[MIDI_Handle->EventFIFOTail / 4];
+  }
 
   /* Advance tail by 4 (one event) */
   MIDI_Handle->EventFIFOTail = (MIDI_Handle->EventFIFOTail + 4) % USBH_MIDI_EVENT_FIFO_SIZE;
@@ -0,0 +1,170 @@
+/**
+  ******************************************************************************
+  * @file    usbh_msc.h
+  * @brief   USB Host Mass Storage Class driver header (Bulk-Only, read only).
+  * @details Minimal driver for USB sticks: Bulk-Only Transport with the SCSI
+  *          commands needed to read sectors (LUN 0 only).
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBH_MSC_H
+#define __USBH_MSC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_core.h"   /* USBH core structures and definitions */
+
+/*
+ * Bulk-Only Transport (BOT): every command is
+ *   CBW  (31 bytes, Bulk OUT)  command block wrapper with a SCSI command
+ *   data (Bulk IN, optional)   the sectors / the command's reply
+ *   CSW  (13 bytes, Bulk IN)   command status wrapper
+ *
+ * After connection the class process runs INQUIRY, TEST UNIT READY (with
+ * REQUEST SENSE while the stick is not ready yet) and READ CAPACITY(10);
+ * then USBH_MSC_IsReady() returns 1 and sectors can be read.
+ *
+ * Reads can be started and polled (USBH_MSC_ReadStart() / _ReadPoll()):
+ * the data phase is one bulk IN transfer of all sectors, which the host
+ * controller interrupt completes packet by packet, so the caller can do
+ * other work (e.g. program flash) while the sectors arrive. Polling only
+ * advances the CBW -> data -> CSW steps. USBH_MSC_Read() is the blocking
+ * form.
+ *
+ * Transport errors (stalled CBW, bad CSW, phase error, timeout) end the
+ * command with USBH_FAIL after a Bulk-Only Mass Storage Reset and clearing
+ * both endpoints, so the next command starts clean.
+ */
+
+/* Class code, subclass (SCSI transparent command set) and protocol (BOT) */
+#define USB_MSC_CLASS_CODE          0x08
+#define USB_MSC_SUBCLASS_SCSI       0x06
+#define USB_MSC_PROTOCOL_BOT        0x50
+
+/* Bulk endpoint buffer size (Full Speed); short replies are received into buffers this large */
+#define USBH_MSC_MAX_PACKET_SIZE    64
+
+/* Only 512-byte sectors are supported */
+#define USBH_MSC_BLOCK_SIZE         512U
+
+/* Most sectors per read command (one bulk IN transfer, length field is 16-bit) */
+#define USBH_MSC_MAX_READ_BLOCKS    64U
+
+/* One command (CBW to CSW) must finish within this time */
+#define USBH_MSC_COMMAND_TIMEOUT_MS 5000U
+
+/* A stick still not ready after this long is given up */
+#define USBH_MSC_READY_TIMEOUT_MS   10000U
+
+/* Class state (start-up sequence) */
+typedef enum {
+    MSC_INIT_INQUIRY = 0,
+    MSC_INIT_TEST_READY,
+    MSC_INIT_SENSE,
+    MSC_INIT_CAPACITY,
+    MSC_READY,                /* sectors can be read */
+    MSC_ERROR                 /* unsupported or not responding (replug to retry) */
+} MSC_StateTypeDef;
+
+/* Bulk-Only Transport steps of the current command */
+typedef enum {
+    MSC_BOT_IDLE = 0,
+    MSC_BOT_SEND_CBW,
+    MSC_BOT_CBW_WAIT,
+    MSC_BOT_DATA_IN,
+    MSC_BOT_DATA_IN_WAIT,
+    MSC_BOT_CLEAR_IN,         /* data or CSW stage stalled: clear, then read the CSW */
+    MSC_BOT_CSW,
+    MSC_BOT_CSW_WAIT,
+    MSC_BOT_RESET,            /* reset recovery after a transport error */
+    MSC_BOT_RESET_CLEAR_IN,
+    MSC_BOT_RESET_CLEAR_OUT
+} MSC_BotStateTypeDef;
+
+/**
+ * @brief USBH MSC Class runtime handle.
+ *
+ * Fields:
+ * - InPipe/InEp/InEpSize, OutPipe/OutEp/OutEpSize: the two bulk endpoints
+ * - Interface: interface number (class requests)
+ * - MaxLun: from GET MAX LUN (only LUN 0 is used)
+ * - cbw/csw: wrappers of the current command; Tag: its tag
+ * - Data/DataLength: data stage buffer of the current command
+ * - ReadPending/ReadResult: the read started by the application
+ * - BlockCount/BlockSize: from READ CAPACITY(10)
+ */
+typedef struct {
+    uint8_t  InPipe;
+    uint8_t  OutPipe;
+    uint8_t  InEp;
+    uint8_t  OutEp;
+    uint16_t InEpSize;
+    uint16_t OutEpSize;
+    uint8_t  Interface;
+    uint8_t  MaxLun;
+
+    MSC_StateTypeDef state;
+    MSC_BotStateTypeDef bot;
+    USBH_StatusTypeDef botResult;   /* result kept through reset recovery */
+    uint8_t  cswStalls;             /* CSW stage retries after a stall */
+    uint32_t Tag;
+    uint32_t CommandStart;          /* HAL_GetTick() when the CBW was queued */
+    uint32_t ReadyStart;            /* first TEST UNIT READY */
+    uint8_t  ReadPending;           /* a USBH_MSC_ReadStart() read is not collected yet */
+    USBH_StatusTypeDef ReadResult;  /* its result (USBH_BUSY while running) */
+
+    uint8_t  cbw[32];
+    uint8_t  csw[USBH_MSC_MAX_PACKET_SIZE];
+    uint8_t  reply[USBH_MSC_MAX_PACKET_SIZE];  /* INQUIRY / REQUEST SENSE / READ CAPACITY */
+    uint8_t  *Data;
+    uint32_t DataLength;
+
+    uint32_t BlockCount;
+    uint32_t BlockSize;
+    uint8_t  SenseKey;              /* last REQUEST SENSE */
+    uint8_t  Asc;
+} MSC_HandleTypeDef;
+
+/* External variable for the MSC class driver */
+extern USBH_ClassTypeDef MSC_Class;
+#define USBH_MSC_CLASS    &MSC_Class
+
+/**
+ * @brief 1 when a stick is connected, has answered READ CAPACITY and no
+ *        command is running.
+ */
+uint8_t USBH_MSC_IsReady(USBH_HandleTypeDef *phost);
+
+/** @brief Number of 512-byte sectors (0 when not ready). */
+uint32_t USBH_MSC_GetBlockCount(USBH_HandleTypeDef *phost);
+
+/**
+ * @brief Start reading count sectors at lba into buf (count * 512 bytes).
+ *
+ * @retval USBH_OK   command queued; poll with USBH_MSC_ReadPoll()
+ * @retval USBH_BUSY another command is running
+ * @retval USBH_FAIL not ready, or count is 0 / above USBH_MSC_MAX_READ_BLOCKS
+ */
+USBH_StatusTypeDef USBH_MSC_ReadStart(USBH_HandleTypeDef *phost, uint32_t lba, uint8_t *buf, uint16_t count);
+
+/**
+ * @brief Advance the running read.
+ *
+ * @retval USBH_BUSY still running
+ * @retval USBH_OK   all sectors are in the buffer
+ * @retval USBH_FAIL the command failed or the stick was removed
+ */
+USBH_StatusTypeDef USBH_MSC_ReadPoll(USBH_HandleTypeDef *phost);
+
+/** @brief Blocking read (ReadStart, then ReadPoll until done). */
+USBH_StatusTypeDef USBH_MSC_Read(USBH_HandleTypeDef *phost, uint32_t lba, uint8_t *buf, uint16_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USBH_MSC_H */
@@ -0,0 +1,747 @@
+/**
+  * @file    usbh_msc.c
+  * @brief   USB Host Mass Storage Class driver (Bulk-Only, SCSI, read only).
+  */
+#include "usbh_msc.h"
+#include <string.h>
+#include <stdio.h>
+
+/*
+ * This file implements a minimal USB Host class for USB sticks.
+ *
+ * Key points:
+ * - Interface selection: Mass Storage class (0x08), SCSI transparent
+ *   subclass (0x06), Bulk-Only protocol (0x50)
+ * - One Bulk IN and one Bulk OUT endpoint are required
+ * - Only reading is implemented: the stick is a song source, nothing on it
+ *   is ever changed.
+ *
+ * NOTE (implementation detail):
+ * - The host controller re-sends IN tokens on NAK by itself, so a data stage
+ *   of many packets completes without polling. A NAK on OUT ends the URB
+ *   with URB_NOTREADY and the CBW has to be sent again.
+ * - The controller rounds IN transfers up to whole packets, so every IN
+ *   buffer (CSW, replies) is one full packet long.
+ */
+
+#define BOT_CBW_SIGNATURE       0x43425355UL   /* "USBC" */
+#define BOT_CSW_SIGNATURE       0x53425355UL   /* "USBS" */
+#define BOT_CBW_LENGTH          31U
+#define BOT_CSW_LENGTH          13U
+
+#define BOT_CSW_PASSED          0x00U
+#define BOT_CSW_FAILED          0x01U
+
+/* Class-specific requests */
+#define BOT_REQ_RESET           0xFFU
+#define BOT_REQ_GET_MAX_LUN     0xFEU
+
+/* SCSI commands */
+#define SCSI_TEST_UNIT_READY    0x00U
+#define SCSI_REQUEST_SENSE      0x03U
+#define SCSI_INQUIRY            0x12U
+#define SCSI_READ_CAPACITY10    0x25U
+#define SCSI_READ10             0x28U
+
+#define INQUIRY_LENGTH          36U
+#define SENSE_LENGTH            18U
+#define CAPACITY10_LENGTH       8U
+
+/* Internal function prototypes (USBH class callbacks) */
+static USBH_StatusTypeDef USBH_MSC_Init(USBH_HandleTypeDef *phost);
+static USBH_StatusTypeDef USBH_MSC_ClassRequest(USBH_HandleTypeDef *phost);
+static USBH_StatusTypeDef USBH_MSC_Process(USBH_HandleTypeDef *phost);
+static USBH_StatusTypeDef USBH_MSC_SOFProcess(USBH_HandleTypeDef *phost);
+static USBH_StatusTypeDef USBH_MSC_DeInit(USBH_HandleTypeDef *phost);
+
+/* MSC Class structure for USB host */
+USBH_ClassTypeDef MSC_Class = {
+    "MSC",
+    USB_MSC_CLASS_CODE,
+    USBH_MSC_Init,
+    USBH_MSC_DeInit,
+    USBH_MSC_ClassRequest,
+    USBH_MSC_Process,
+    USBH_MSC_SOFProcess
+};
+
+static void PutBE32(uint8_t *p, uint32_t v)
+{
+  p[0] = (uint8_t)(v >> 24);
+  p[1] = (uint8_t)(v >> 16);
+  p[2] = (uint8_t)(v >> 8);
+  p[3] = (uint8_t)v;
+}
+
+static uint32_t GetBE32(const uint8_t *p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void PutLE32(uint8_t *p, uint32_t v)
+{
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t GetLE32(const uint8_t *p)
+{
+  return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief The MSC handle, or NULL if the active class is not MSC.
+ *
+ * The application may call the public functions while a MIDI keyboard is
+ * connected, so the class is checked before pData is used.
+ */
+static MSC_HandleTypeDef *MSC_GetHandle(USBH_HandleTypeDef *phost)
+{
+  if (phost->pActiveClass != &MSC_Class)
+  {
+    return NULL;
+  }
+  return (MSC_HandleTypeDef *)phost->pActiveClass->pData;
+}
+
+/**
+ * @brief USBH MSC Init callback (called when a matching device is connected).
+ *
+ * Finds the SCSI / Bulk-Only interface and opens its two bulk pipes.
+ */
+static USBH_StatusTypeDef USBH_MSC_Init(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle;
+
+  /* Find the interface first, so nothing has to be undone when there is none */
+  uint8_t interface = 0xFF;
+  for (uint8_t idx = 0; idx < phost->device.CfgDesc.bNumInterfaces && idx < USBH_MAX_NUM_INTERFACES; idx++)
+  {
+    USBH_InterfaceDescTypeDef *itf = &phost->device.CfgDesc.Itf_Desc[idx];
+    if ((itf->bInterfaceClass == USB_MSC_CLASS_CODE) &&
+        (itf->bInterfaceSubClass == USB_MSC_SUBCLASS_SCSI) &&
+        (itf->bInterfaceProtocol == USB_MSC_PROTOCOL_BOT))
+    {
+      interface = idx;
+      break;
+    }
+  }
+  if (interface == 0xFF)
+  {
+    printf("USBH_MSC_Init: No SCSI Bulk-Only interface found\r\n");
+    return USBH_FAIL;
+  }
+
+  MSC_Handle = (MSC_HandleTypeDef *)USBH_malloc(sizeof(MSC_HandleTypeDef));
+  if (MSC_Handle == NULL)
+  {
+    printf("USBH_MSC_Init: Failed to allocate MSC class handle\r\n");
+    return USBH_FAIL;
+  }
+  memset(MSC_Handle, 0, sizeof(MSC_HandleTypeDef));
+  phost->pActiveClass->pData = (void *)MSC_Handle;
+
+  USBH_InterfaceDescTypeDef *itf_desc = &phost->device.CfgDesc.Itf_Desc[interface];
+  MSC_Handle->Interface = itf_desc->bInterfaceNumber;
+  for (uint8_t ep_idx = 0; ep_idx < itf_desc->bNumEndpoints && ep_idx < USBH_MAX_NUM_ENDPOINTS; ep_idx++)
+  {
+    USBH_EpDescTypeDef *ep_desc = &itf_desc->Ep_Desc[ep_idx];
+    uint8_t ep_addr = ep_desc->bEndpointAddress;
+    uint8_t ep_type = ep_desc->bmAttributes & 0x03U;
+
+    if (ep_type != 0x02U)
+    {
+      continue;
+    }
+    if (ep_addr & 0x80U)
+    {
+      MSC_Handle->InEp = ep_addr;
+      MSC_Handle->InEpSize = ep_desc->wMaxPacketSize;
+    }
+    else
+    {
+      MSC_Handle->OutEp = ep_addr;
+      MSC_Handle->OutEpSize = ep_desc->wMaxPacketSize;
+    }
+  }
+
+  /* Replies are received into one-packet buffers, so larger packets are refused */
+  if (MSC_Handle->InEp == 0U || MSC_Handle->OutEp == 0U ||
+      MSC_Handle->InEpSize > USBH_MSC_MAX_PACKET_SIZE || MSC_Handle->OutEpSize > USBH_MSC_MAX_PACKET_SIZE)
+  {
+    printf("USBH_MSC_Init: Bulk endpoints missing or unsupported\r\n");
+    USBH_free(MSC_Handle);
+    phost->pActiveClass->pData = NULL;
+    return USBH_FAIL;
+  }
+
+  MSC_Handle->OutPipe = USBH_AllocPipe(phost, MSC_Handle->OutEp);
+  MSC_Handle->InPipe = USBH_AllocPipe(phost, MSC_Handle->InEp);
+  USBH_OpenPipe(phost, MSC_Handle->OutPipe, MSC_Handle->OutEp,
+                phost->device.address, phost->device.speed,
+                USBH_EP_BULK, MSC_Handle->OutEpSize);
+  USBH_OpenPipe(phost, MSC_Handle->InPipe, MSC_Handle->InEp,
+                phost->device.address, phost->device.speed,
+                USBH_EP_BULK, MSC_Handle->InEpSize);
+  USBH_LL_SetToggle(phost, MSC_Handle->OutPipe, 0);
+  USBH_LL_SetToggle(phost, MSC_Handle->InPipe, 0);
+
+  printf("USBH_MSC_Init: Bulk IN 0x%02X (pipe %d), Bulk OUT 0x%02X (pipe %d), max packet %d bytes\r\n",
+         MSC_Handle->InEp, MSC_Handle->InPipe, MSC_Handle->OutEp, MSC_Handle->OutPipe,
+         MSC_Handle->InEpSize);
+
+  MSC_Handle->state = MSC_INIT_INQUIRY;
+  MSC_Handle->bot = MSC_BOT_IDLE;
+  return USBH_OK;
+}
+
+/**
+ * @brief USBH MSC DeInit callback (called on device disconnection).
+ */
+static USBH_StatusTypeDef USBH_MSC_DeInit(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle = (MSC_HandleTypeDef *)phost->pActiveClass->pData;
+  if (MSC_Handle != NULL)
+  {
+    if (MSC_Handle->InPipe)
+    {
+      USBH_ClosePipe(phost, MSC_Handle->InPipe);
+      USBH_FreePipe(phost, MSC_Handle->InPipe);
+      MSC_Handle->InPipe = 0;
+    }
+    if (MSC_Handle->OutPipe)
+    {
+      USBH_ClosePipe(phost, MSC_Handle->OutPipe);
+      USBH_FreePipe(phost, MSC_Handle->OutPipe);
+      MSC_Handle->OutPipe = 0;
+    }
+
+    USBH_free(MSC_Handle);
+    phost->pActiveClass->pData = NULL;
+    printf("USBH_MSC_DeInit: De-initialization complete\r\n");
+  }
+  return USBH_OK;
+}
+
+/**
+ * @brief Class-specific request stage: GET MAX LUN.
+ *
+ * Sticks with a single LUN may stall the request; that means LUN 0.
+ */
+static USBH_StatusTypeDef USBH_MSC_ClassRequest(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle = (MSC_HandleTypeDef *)phost->pActiveClass->pData;
+  USBH_StatusTypeDef status;
+
+  if (phost->RequestState == CMD_SEND)
+  {
+    phost->Control.setup.b.bmRequestType = USB_D2H | USB_REQ_TYPE_CLASS | USB_REQ_RECIPIENT_INTERFACE;
+    phost->Control.setup.b.bRequest = BOT_REQ_GET_MAX_LUN;
+    phost->Control.setup.b.wValue.w = 0U;
+    phost->Control.setup.b.wIndex.w = MSC_Handle->Interface;
+    phost->Control.setup.b.wLength.w = 1U;
+  }
+
+  status = USBH_CtlReq(phost, &MSC_Handle->MaxLun, 1U);
+  if (status == USBH_NOT_SUPPORTED)
+  {
+    MSC_Handle->MaxLun = 0;
+    status = USBH_OK;
+  }
+  if (status == USBH_OK)
+  {
+    printf("USBH_MSC_ClassRequest: Max LUN %d (LUN 0 is used)\r\n", MSC_Handle->MaxLun);
+  }
+  return status;
+}
+
+/**
+ * @brief Queue one SCSI command (cb, cbLength bytes) with an optional IN data stage.
+ */
+static void MSC_BOT_Command(MSC_HandleTypeDef *MSC_Handle, const uint8_t *cb, uint8_t cbLength,
+                            uint8_t *data, uint32_t dataLength)
+{
+  uint8_t *cbw = MSC_Handle->cbw;
+
+  memset(cbw, 0, sizeof(MSC_Handle->cbw));
+  MSC_Handle->Tag++;
+  PutLE32(&cbw[0], BOT_CBW_SIGNATURE);
+  PutLE32(&cbw[4], MSC_Handle->Tag);
+  PutLE32(&cbw[8], dataLength);
+  cbw[12] = (dataLength > 0U) ? 0x80U : 0x00U;   /* data direction: IN */
+  cbw[13] = 0U;                                   /* LUN 0 */
+  cbw[14] = cbLength;
+  memcpy(&cbw[15], cb, cbLength);
+
+  MSC_Handle->Data = data;
+  MSC_Handle->DataLength = dataLength;
+  MSC_Handle->cswStalls = 0;
+  MSC_Handle->botResult = USBH_FAIL;
+  MSC_Handle->CommandStart = HAL_GetTick();
+  MSC_Handle->bot = MSC_BOT_SEND_CBW;
+}
+
+/**
+ * @brief Clear a halted endpoint; its data toggle starts again from DATA0.
+ */
+static USBH_StatusTypeDef MSC_ClearHalt(USBH_HandleTypeDef *phost, uint8_t ep, uint8_t pipe)
+{
+  USBH_StatusTypeDef status = USBH_ClrFeature(phost, ep);
+  if (status == USBH_OK)
+  {
+    USBH_LL_SetToggle(phost, pipe, 0);
+  }
+  return status;
+}
+
+/**
+ * @brief Bulk-Only Transport state machine of the current command.
+ *
+ * Steps:
+ * - SEND_CBW/CBW_WAIT: send the CBW (again after a NAK)
+ * - DATA_IN/DATA_IN_WAIT: one bulk IN transfer of the whole data stage;
+ *   a stall is cleared and the CSW is read anyway
+ * - CSW/CSW_WAIT: read and check the CSW (one retry after a stall)
+ * - RESET*: reset recovery (class reset, clear both endpoints)
+ *
+ * @retval USBH_BUSY command still running
+ * @retval USBH_OK   CSW reported success
+ * @retval USBH_FAIL command or transport failed
+ */
+static USBH_StatusTypeDef MSC_BOT_Process(USBH_HandleTypeDef *phost, MSC_HandleTypeDef *MSC_Handle)
+{
+  USBH_URBStateTypeDef urb_state;
+  USBH_StatusTypeDef status;
+
+  if (!phost->device.is_connected)
+  {
+    MSC_Handle->bot = MSC_BOT_IDLE;
+    return USBH_FAIL;
+  }
+
+  /* A stick that stopped answering is reset (the pending transfer is halted first) */
+  if (MSC_Handle->bot >= MSC_BOT_SEND_CBW && MSC_Handle->bot <= MSC_BOT_CSW_WAIT &&
+      (HAL_GetTick() - MSC_Handle->CommandStart) > USBH_MSC_COMMAND_TIMEOUT_MS)
+  {
+    printf("USBH_MSC: command timeout, reset recovery\r\n");
+    USBH_ClosePipe(phost, MSC_Handle->InPipe);
+    USBH_ClosePipe(phost, MSC_Handle->OutPipe);
+    MSC_Handle->botResult = USBH_FAIL;
+    MSC_Handle->bot = MSC_BOT_RESET;
+  }
+
+  switch (MSC_Handle->bot)
+  {
+    case MSC_BOT_SEND_CBW:
+      USBH_BulkSendData(phost, MSC_Handle->cbw, BOT_CBW_LENGTH, MSC_Handle->OutPipe, 1U);
+      MSC_Handle->bot = MSC_BOT_CBW_WAIT;
+      break;
+
+    case MSC_BOT_CBW_WAIT:
+      urb_state = USBH_LL_GetURBState(phost, MSC_Handle->OutPipe);
+      if (urb_state == USBH_URB_DONE)
+      {
+        MSC_Handle->bot = (MSC_Handle->DataLength > 0U) ? MSC_BOT_DATA_IN : MSC_BOT_CSW;
+      }
+      else if (urb_state == USBH_URB_NOTREADY)
+      {
+        MSC_Handle->bot = MSC_BOT_SEND_CBW;
+      }
+      else if (urb_state == USBH_URB_STALL || urb_state == USBH_URB_ERROR)
+      {
+        /* The stick does not take commands: only reset recovery helps */
+        MSC_Handle->bot = MSC_BOT_RESET;
+      }
+      break;
+
+    case MSC_BOT_DATA_IN:
+      USBH_BulkReceiveData(phost, MSC_Handle->Data, (uint16_t)MSC_Handle->DataLength, MSC_Handle->InPipe);
+      MSC_Handle->bot = MSC_BOT_DATA_IN_WAIT;
+      break;
+
+    case MSC_BOT_DATA_IN_WAIT:
+      urb_state = USBH_LL_GetURBState(phost, MSC_Handle->InPipe);
+      if (urb_state == USBH_URB_DONE)
+      {
+        MSC_Handle->bot = MSC_BOT_CSW;
+      }
+      else if (urb_state == USBH_URB_STALL)
+      {
+        /* The device ended the data stage early; the CSW tells why */
+        MSC_Handle->bot = MSC_BOT_CLEAR_IN;
+      }
+      else if (urb_state == USBH_URB_ERROR)
+      {
+        MSC_Handle->bot = MSC_BOT_RESET;
+      }
+      break;
+
+    case MSC_BOT_CLEAR_IN:
+      status = MSC_ClearHalt(phost, MSC_Handle->InEp, MSC_Handle->InPipe);
+      if (status == USBH_OK)
+      {
+        MSC_Handle->bot = MSC_BOT_CSW;
+      }
+      else if (status != USBH_BUSY)
+      {
+        MSC_Handle->bot = MSC_BOT_RESET;
+      }
+      break;
+
+    case MSC_BOT_CSW:
+      USBH_BulkReceiveData(phost, MSC_Handle->csw, BOT_CSW_LENGTH, MSC_Handle->InPipe);
+      MSC_Handle->bot = MSC_BOT_CSW_WAIT;
+      break;
+
+    case MSC_BOT_CSW_WAIT:
+      urb_state = USBH_LL_GetURBState(phost, MSC_Handle->InPipe);
+      if (urb_state == USBH_URB_DONE)
+      {
+        const uint8_t *csw = MSC_Handle->csw;
+        if (USBH_LL_GetLastXferSize(phost, MSC_Handle->InPipe) != BOT_CSW_LENGTH ||
+            GetLE32(&csw[0]) != BOT_CSW_SIGNATURE || GetLE32(&csw[4]) != MSC_Handle->Tag ||
+            csw[12] > BOT_CSW_FAILED)
+        {
+          /* Invalid CSW or phase error */
+          MSC_Handle->bot = MSC_BOT_RESET;
+        }
+        else
+        {
+          MSC_Handle->bot = MSC_BOT_IDLE;
+          return (csw[12] == BOT_CSW_PASSED) ? USBH_OK : USBH_FAIL;
+        }
+      }
+      else if (urb_state == USBH_URB_STALL)
+      {
+        if (MSC_Handle->cswStalls++ == 0U)
+        {
+          MSC_Handle->bot = MSC_BOT_CLEAR_IN;
+        }
+        else
+        {
+          MSC_Handle->bot = MSC_BOT_RESET;
+        }
+      }
+      else if (urb_state == USBH_URB_ERROR)
+      {
+        MSC_Handle->bot = MSC_BOT_RESET;
+      }
+      break;
+
+    case MSC_BOT_RESET:
+      if (phost->RequestState == CMD_SEND)
+      {
+        phost->Control.setup.b.bmRequestType = USB_H2D | USB_REQ_TYPE_CLASS | USB_REQ_RECIPIENT_INTERFACE;
+        phost->Control.setup.b.bRequest = BOT_REQ_RESET;
+        phost->Control.setup.b.wValue.w = 0U;
+        phost->Control.setup.b.wIndex.w = MSC_Handle->Interface;
+        phost->Control.setup.b.wLength.w = 0U;
+      }
+      status = USBH_CtlReq(phost, NULL, 0U);
+      if (status != USBH_BUSY)
+      {
+        MSC_Handle->bot = MSC_BOT_RESET_CLEAR_IN;
+      }
+      break;
+
+    case MSC_BOT_RESET_CLEAR_IN:
+      if (MSC_ClearHalt(phost, MSC_Handle->InEp, MSC_Handle->InPipe) != USBH_BUSY)
+      {
+        MSC_Handle->bot = MSC_BOT_RESET_CLEAR_OUT;
+      }
+      break;
+
+    case MSC_BOT_RESET_CLEAR_OUT:
+      if (MSC_ClearHalt(phost, MSC_Handle->OutEp, MSC_Handle->OutPipe) != USBH_BUSY)
+      {
+        MSC_Handle->bot = MSC_BOT_IDLE;
+        return MSC_Handle->botResult;
+      }
+      break;
+
+    case MSC_BOT_IDLE:
+    default:
+      return USBH_FAIL;
+  }
+
+  return USBH_BUSY;
+}
+
+/**
+ * @brief Queue the SCSI command of a start-up state.
+ */
+static void MSC_StartInitCommand(MSC_HandleTypeDef *MSC_Handle)
+{
+  uint8_t cb[10];
+
+  memset(cb, 0, sizeof(cb));
+  switch (MSC_Handle->state)
+  {
+    case MSC_INIT_INQUIRY:
+      cb[0] = SCSI_INQUIRY;
+      cb[4] = INQUIRY_LENGTH;
+      MSC_BOT_Command(MSC_Handle, cb, 6, MSC_Handle->reply, INQUIRY_LENGTH);
+      break;
+
+    case MSC_INIT_TEST_READY:
+      cb[0] = SCSI_TEST_UNIT_READY;
+      MSC_BOT_Command(MSC_Handle, cb, 6, NULL, 0);
+      break;
+
+    case MSC_INIT_SENSE:
+      cb[0] = SCSI_REQUEST_SENSE;
+      cb[4] = SENSE_LENGTH;
+      MSC_BOT_Command(MSC_Handle, cb, 6, MSC_Handle->reply, SENSE_LENGTH);
+      break;
+
+    case MSC_INIT_CAPACITY:
+      cb[0] = SCSI_READ_CAPACITY10;
+      MSC_BOT_Command(MSC_Handle, cb, 10, MSC_Handle->reply, CAPACITY10_LENGTH);
+      break;
+
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Next start-up state after a command finished with result.
+ */
+static void MSC_InitCommandDone(MSC_HandleTypeDef *MSC_Handle, USBH_StatusTypeDef result)
+{
+  const uint8_t *reply = MSC_Handle->reply;
+  uint8_t notReadyTooLong = ((HAL_GetTick() - MSC_Handle->ReadyStart) > USBH_MSC_READY_TIMEOUT_MS) ? 1U : 0U;
+
+  switch (MSC_Handle->state)
+  {
+    case MSC_INIT_INQUIRY:
+      /* Only informative: some sticks answer INQUIRY badly but read fine */
+      if (result == USBH_OK)
+      {
+        printf("USBH_MSC: %.8s %.16s\r\n", (const char *)&reply[8], (const char *)&reply[16]);
+      }
+      MSC_Handle->ReadyStart = HAL_GetTick();
+      MSC_Handle->state = MSC_INIT_TEST_READY;
+      break;
+
+    case MSC_INIT_TEST_READY:
+      if (result == USBH_OK)
+      {
+        MSC_Handle->state = MSC_INIT_CAPACITY;
+      }
+      else if (notReadyTooLong)
+      {
+        printf("USBH_MSC: not ready (sense key 0x%X, ASC 0x%02X)\r\n", MSC_Handle->SenseKey, MSC_Handle->Asc);
+        MSC_Handle->state = MSC_ERROR;
+      }
+      else
+      {
+        /* Usually "unit attention" after power-up: reading the sense clears it */
+        MSC_Handle->state = MSC_INIT_SENSE;
+      }
+      break;
+
+    case MSC_INIT_SENSE:
+      if (result == USBH_OK)
+      {
+        MSC_Handle->SenseKey = reply[2] & 0x0FU;
+        MSC_Handle->Asc = reply[12];
+      }
+      MSC_Handle->state = MSC_INIT_TEST_READY;
+      break;
+
+    case MSC_INIT_CAPACITY:
+      if (result == USBH_OK)
+      {
+        MSC_Handle->BlockCount = GetBE32(&reply[0]) + 1U;
+        MSC_Handle->BlockSize = GetBE32(&reply[4]);
+        if (MSC_Handle->BlockSize != USBH_MSC_BLOCK_SIZE)
+        {
+          printf("USBH_MSC: %lu-byte sectors are not supported\r\n", (unsigned long)MSC_Handle->BlockSize);
+          MSC_Handle->state = MSC_ERROR;
+        }
+        else
+        {
+          printf("USBH_MSC: ready, %lu sectors (%lu MB)\r\n", (unsigned long)MSC_Handle->BlockCount,
+                 (unsigned long)(MSC_Handle->BlockCount / 2048U));
+          MSC_Handle->state = MSC_READY;
+        }
+      }
+      else
+      {
+        MSC_Handle->state = notReadyTooLong ? MSC_ERROR : MSC_INIT_TEST_READY;
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Advance the application's read (also called from ReadPoll).
+ *
+ * A read is only good when every sector arrived: a passed CSW with a
+ * residue (short data stage) counts as a failure.
+ */
+static void MSC_ReadStep(USBH_HandleTypeDef *phost, MSC_HandleTypeDef *MSC_Handle)
+{
+  if (MSC_Handle->ReadPending && MSC_Handle->ReadResult == USBH_BUSY)
+  {
+    USBH_StatusTypeDef result = MSC_BOT_Process(phost, MSC_Handle);
+    if (result == USBH_OK && GetLE32(&MSC_Handle->csw[8]) != 0U)
+    {
+      result = USBH_FAIL;
+    }
+    MSC_Handle->ReadResult = result;
+  }
+}
+
+/**
+ * @brief Main class process callback (polled by USBH core).
+ *
+ * Runs the start-up commands, then keeps the application's read moving.
+ */
+static USBH_StatusTypeDef USBH_MSC_Process(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle = (MSC_HandleTypeDef *)phost->pActiveClass->pData;
+  USBH_StatusTypeDef result;
+
+  if (MSC_Handle == NULL)
+  {
+    return USBH_FAIL;
+  }
+
+  switch (MSC_Handle->state)
+  {
+    case MSC_INIT_INQUIRY:
+    case MSC_INIT_TEST_READY:
+    case MSC_INIT_SENSE:
+    case MSC_INIT_CAPACITY:
+      if (MSC_Handle->bot == MSC_BOT_IDLE)
+      {
+        MSC_StartInitCommand(MSC_Handle);
+      }
+      result = MSC_BOT_Process(phost, MSC_Handle);
+      if (result != USBH_BUSY)
+      {
+        MSC_InitCommandDone(MSC_Handle, result);
+      }
+      return USBH_BUSY;
+
+    case MSC_READY:
+      MSC_ReadStep(phost, MSC_Handle);
+      return USBH_OK;
+
+    case MSC_ERROR:
+    default:
+      return USBH_FAIL;
+  }
+}
+
+/**
+ * @brief SOF callback (not used in this driver).
+ */
+static USBH_StatusTypeDef USBH_MSC_SOFProcess(USBH_HandleTypeDef *phost)
+{
+  (void)phost;
+  return USBH_OK;
+}
+
+/**
+ * @brief Public API: 1 when sectors can be read.
+ */
+uint8_t USBH_MSC_IsReady(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle = MSC_GetHandle(phost);
+
+  return (MSC_Handle != NULL && phost->device.is_connected &&
+          MSC_Handle->state == MSC_READY && !MSC_Handle->ReadPending) ? 1U : 0U;
+}
+
+/**
+ * @brief Public API: number of 512-byte sectors.
+ */
+uint32_t USBH_MSC_GetBlockCount(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle = MSC_GetHandle(phost);
+
+  return (MSC_Handle != NULL && MSC_Handle->state == MSC_READY) ? MSC_Handle->BlockCount : 0U;
+}
+
+/**
+ * @brief Public API: queue READ(10) of count sectors at lba.
+ */
+USBH_StatusTypeDef USBH_MSC_ReadStart(USBH_HandleTypeDef *phost, uint32_t lba, uint8_t *buf, uint16_t count)
+{
+  MSC_HandleTypeDef *MSC_Handle = MSC_GetHandle(phost);
+  uint8_t cb[10];
+
+  if (MSC_Handle == NULL || MSC_Handle->state != MSC_READY || !phost->device.is_connected)
+  {
+    return USBH_FAIL;
+  }
+  if (MSC_Handle->ReadPending)
+  {
+    return USBH_BUSY;
+  }
+  if (count == 0U || count > USBH_MSC_MAX_READ_BLOCKS ||
+      lba >= MSC_Handle->BlockCount || count > MSC_Handle->BlockCount - lba)
+  {
+    return USBH_FAIL;
+  }
+
+  memset(cb, 0, sizeof(cb));
+  cb[0] = SCSI_READ10;
+  PutBE32(&cb[2], lba);
+  cb[7] = (uint8_t)(count >> 8);
+  cb[8] = (uint8_t)count;
+  MSC_BOT_Command(MSC_Handle, cb, 10, buf, (uint32_t)count * USBH_MSC_BLOCK_SIZE);
+
+  MSC_Handle->ReadPending = 1;
+  MSC_Handle->ReadResult = USBH_BUSY;
+  MSC_ReadStep(phost, MSC_Handle);   /* the CBW goes out right away */
+  return USBH_OK;
+}
+
+/**
+ * @brief Public API: advance the read; OK / FAIL once it is over.
+ */
+USBH_StatusTypeDef USBH_MSC_ReadPoll(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle = MSC_GetHandle(phost);
+  USBH_StatusTypeDef result;
+
+  if (MSC_Handle == NULL || !MSC_Handle->ReadPending)
+  {
+    return USBH_FAIL;
+  }
+
+  MSC_ReadStep(phost, MSC_Handle);
+  result = MSC_Handle->ReadResult;
+  if (result != USBH_BUSY)
+  {
+    MSC_Handle->ReadPending = 0;
+  }
+  return result;
+}
+
+/**
+ * @brief Public API: blocking read.
+ */
+USBH_StatusTypeDef USBH_MSC_Read(USBH_HandleTypeDef *phost, uint32_t lba, uint8_t *buf, uint16_t count)
+{
+  USBH_StatusTypeDef status = USBH_MSC_ReadStart(phost, lba, buf, count);
+
+  if (status != USBH_OK)
+  {
+    return USBH_FAIL;
+  }
+  do
+  {
+    status = USBH_MSC_ReadPoll(phost);
+  } while (status == USBH_BUSY);
+  return status;
+}
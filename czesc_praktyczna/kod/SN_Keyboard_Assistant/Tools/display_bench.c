@@ -0,0 +1,223 @@
+/*
+ * display_bench.c
+ *
+ * Host test of the UI screens: drives the firmware's own app.c and lesson.c
+ * (button presses and played notes) into the virtual display and checks,
+ * for every screen change, the panel rows and what the framebuffer flush
+ * put on the bus. Exits with 1 if anything differs from the table below.
+ *
+ * app.c and lesson.c include main.h, so this tool is built against the
+ * project's HAL headers instead of -DDISPLAY_HOST_BUILD; the hardware calls
+ * they make (LEDs, backlight, timers, latency, buttons) are stubbed here.
+ *
+ * Build and run from the project directory (SN_Keyboard_Assistant):
+ *
+ *   gcc -std=gnu11 -Wall -DSTM32L476xx -DUSE_HAL_DRIVER -ICore/Inc \
+ *       -isystem Drivers/STM32L4xx_HAL_Driver/Inc \
+ *       -isystem Drivers/CMSIS/Device/ST/STM32L4xx/Include \
+ *       -isystem Drivers/CMSIS/Include \
+ *       Tools/display_bench.c Core/Src/app.c Core/Src/lesson.c \
+ *       Core/Src/lcd_framebuffer.c Core/Src/display_virtual.c Core/Src/glyphs.c \
+ *       Core/Src/lesson_render.c Core/Src/lesson_frames.c Core/Src/held_notes.c \
+ *       Core/Src/oled_staff.c Core/Src/oled_gfx.c Core/Src/songs.c Core/Src/chords.c \
+ *       Core/Src/song_library.c Core/Src/text_songs.c Core/Src/song_pack.c \
+ *       Core/Src/song_lz.c Core/Src/smf_reader.c Core/Src/song_text.c Core/Src/notes.c \
+ *       -o display_bench && ./display_bench
+ *
+ * Output per screen change: I2C transactions, bytes on the wire (including
+ * CGRAM uploads by the glyph manager) and the resulting panel rows (custom
+ * characters shown as '~'). At 100 kHz one byte takes 90 us.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "main.h"
+#include "app.h"
+#include "lesson.h"
+#include "held_notes.h"
+#include "lcd_framebuffer.h"
+#include "display_virtual.h"
+#include "backlight.h"
+#include "latency.h"
+#include "timer_wheel.h"
+#include "freeplay.h"
+#include "store_songs.h"
+
+/* ------------------------------------------------------------------------- */
+/* Stubs: hardware the screens do not depend on                              */
+/* ------------------------------------------------------------------------- */
+
+static int pendingButton = -1;    /* ButtonType reported once by Button_WasPressed() */
+
+void Button_Init(void) { pendingButton = -1; }
+
+bool Button_WasPressed(ButtonType button)
+{
+    if (pendingButton != (int)button) return false;
+    pendingButton = -1;
+    return true;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+    (void)port; (void)pin; (void)state;
+}
+
+void Backlight_SetBase(BacklightColor color) { (void)color; }
+void Backlight_Flash(BacklightColor color, uint32_t duration_ms) { (void)color; (void)duration_ms; }
+BacklightColor Backlight_Accuracy(uint32_t percent) { (void)percent; return BACKLIGHT_WHITE; }
+
+void TimerWheel_Start(SoftTimer_t *timer, uint32_t delay_ms, uint32_t period_ms,
+                      SoftTimerCallback callback, void *arg)
+{
+    (void)timer; (void)delay_ms; (void)period_ms; (void)callback; (void)arg;
+}
+void TimerWheel_Cancel(SoftTimer_t *timer) { (void)timer; }
+
+static const LatencyHistogram_t noSamples;
+void Latency_Mark(LatencyStage stage) { (void)stage; }
+bool Latency_Defer(LatencyStage stage, uint32_t *origin) { (void)stage; (void)origin; return false; }
+void Latency_RecordSince(LatencyStage stage, uint32_t origin) { (void)stage; (void)origin; }
+const LatencyHistogram_t *Latency_GetHistogram(LatencyStage stage) { (void)stage; return &noSamples; }
+const char *Latency_StageName(LatencyStage stage) { (void)stage; return "-"; }
+uint32_t Latency_PercentileUs(LatencyStage stage, uint8_t percent) { (void)stage; (void)percent; return 0; }
+void Latency_Dump(void) {}
+
+void FreePlay_Start(void) {}
+void FreePlay_Stop(void) {}
+
+/* No external flash on the host: the song list ends after the text exercises. */
+uint16_t StoreSongs_Count(void) { return 0; }
+const Song *StoreSongs_Open(uint16_t index) { (void)index; return NULL; }
+const char *StoreSongs_Title(uint16_t index) { (void)index; return ""; }
+
+/* ------------------------------------------------------------------------- */
+/* Script                                                                    */
+/* ------------------------------------------------------------------------- */
+
+typedef enum {
+    ACT_INIT = 0,    /* App_Init() */
+    ACT_BUTTON,      /* press arg (ButtonType), then App_Update() */
+    ACT_NOTE         /* key arg (MIDI note) down, as main.c forwards it */
+} Action;
+
+typedef struct {
+    const char *name;
+    uint8_t action;          /* Action */
+    uint8_t arg;
+    const char *row0;        /* expected panel rows ('~' = custom character) */
+    const char *row1;
+    uint16_t transactions;   /* expected I2C cost of the screen change */
+    uint16_t bytes;
+} Check;
+
+#define OK     BUTTON_OK
+#define NEXT   BUTTON_NEXT
+#define RESET  BUTTON_RESET
+
+static const Check script[] = {
+    { "welcome",        ACT_INIT,   0,     "   Welcome to   ", "    KeyGuide    ",  4,  28 },
+    { "menu: icons",    ACT_BUTTON, OK,    "Icons       MENU", "NEXT=Down OK=Sel",  4,  42 },
+    { "legend",         ACT_BUTTON, OK,    "A~  B~  C~      ", "~~~~~ RESET=Back",  7, 114 },
+    { "menu: icons",    ACT_BUTTON, RESET, "Icons       MENU", "NEXT=Down OK=Sel",  4,  42 },
+    { "menu: songs",    ACT_BUTTON, NEXT,  "Songs       MENU", "NEXT=Down OK=Sel",  2,   9 },
+    { "song list",      ACT_BUTTON, OK,    "Songs           ", "> Twinkle Twinkl",  4,  29 },
+    { "step 1",         ACT_BUTTON, OK,    "C4 C4           ", "~  ~            ",  4,  31 },
+    { "step 1: C4",     ACT_NOTE,   60,    "C4 C4           ", "~  ~            ",  0,   0 },
+    { "step 2",         ACT_NOTE,   60,    "G4 G4           ", "~  ~         ~  ",  7,  31 },
+    { "step 2: wrong",  ACT_NOTE,   61,    "G4 G4           ", "~  ~         ~  ",  0,   0 },
+    { "reset: step 1",  ACT_BUTTON, RESET, "C4 C4           ", "~  ~            ",  4,  15 },
+    { "skip: step 2",   ACT_BUTTON, OK,    "G4 G4           ", "~  ~         ~  ",  4,  15 },
+    { "skip: step 3",   ACT_BUTTON, OK,    "A4 A4           ", "~  ~         ~~ ",  7,  48 },
+    { "skip: step 4",   ACT_BUTTON, OK,    "G4              ", "~            ~~~",  9,  50 },
+    { "summary",        ACT_BUTTON, OK,    "OK: 9/10        ", "P: 90% any key  ",  4,  34 },
+    { "song list",      ACT_BUTTON, OK,    "Songs           ", "> Twinkle Twinkl",  4,  34 },
+    { "menu: songs",    ACT_BUTTON, RESET, "Songs       MENU", "NEXT=Down OK=Sel",  4,  29 },
+    { "menu: rhythm",   ACT_BUTTON, NEXT,  "Rhythm      MENU", "NEXT=Down OK=Sel",  2,  11 },
+    { "menu: chords",   ACT_BUTTON, NEXT,  "Chords      MENU", "NEXT=Down OK=Sel",  2,  11 },
+    { "pack list",      ACT_BUTTON, OK,    "Chord packs     ", "> Basic chords  ",  4,  37 },
+    { "chord C",        ACT_BUTTON, OK,    "Chord:C         ", "C E G           ",  4,  30 },
+    { "chord C: C",     ACT_NOTE,   60,    "Chord:C         ", "C E G           ",  0,   0 },
+    { "chord C: E",     ACT_NOTE,   64,    "Chord:C         ", "C E G           ",  0,   0 },
+    { "chord G",        ACT_NOTE,   67,    "Chord:G      ~  ", "G B D           ",  6,  22 },
+    { "reset: chord C", ACT_BUTTON, RESET, "Chord:C         ", "C E G           ",  6,  22 },
+    { "pack list",      ACT_BUTTON, RESET, "Chord packs     ", "> Basic chords  ",  4,  30 },
+};
+
+static void Run(const Check *c)
+{
+    switch (c->action)
+    {
+        case ACT_INIT:
+            App_Init();
+            break;
+
+        case ACT_BUTTON:
+            pendingButton = c->arg;
+            App_Update();
+            break;
+
+        case ACT_NOTE:
+            HeldNotes_On(c->arg, 0);
+            if (Lesson_IsActive()) Lesson_HandleInput(c->arg);
+            App_Update();
+            break;
+
+        default:
+            break;
+    }
+}
+
+int main(void)
+{
+    static DisplayVirtual_t panel;
+    Display_t display;
+    uint32_t totalBytes = 0;
+    uint32_t totalTransactions = 0;
+    unsigned failures = 0;
+
+    DisplayVirtual_Init(&display, &panel);
+    LcdFb_Init(&display);
+
+    printf("%-16s %5s %6s %8s  %-16s %-16s %s\n", "screen", "xfers", "bytes", "time@100k", "row 0", "row 1", "cgram");
+
+    for (size_t i = 0; i < sizeof(script) / sizeof(script[0]); i++)
+    {
+        const Check *c = &script[i];
+        char r0[DISPLAY_VIRTUAL_COLS + 1];
+        char r1[DISPLAY_VIRTUAL_COLS + 1];
+
+        DisplayVirtual_ResetStats(&panel);
+        Run(c);
+
+        DisplayVirtual_Row(&panel, 0, r0);
+        DisplayVirtual_Row(&panel, 1, r1);
+
+        printf("%-16s %5u %6u %6.2fms  %-16s %-16s %u\n", c->name,
+               (unsigned)panel.stats.transactions, (unsigned)panel.stats.busBytes,
+               panel.stats.busBytes * 0.09, r0, r1, (unsigned)panel.stats.cgramUploads);
+
+        if (strcmp(r0, c->row0) != 0 || strcmp(r1, c->row1) != 0) {
+            printf("  FAIL: expected \"%s\" / \"%s\"\n", c->row0, c->row1);
+            failures++;
+        }
+        if (panel.stats.transactions != c->transactions || panel.stats.busBytes != c->bytes) {
+            printf("  FAIL: expected %u transactions, %u bytes\n",
+                   (unsigned)c->transactions, (unsigned)c->bytes);
+            failures++;
+        }
+
+        totalBytes += panel.stats.busBytes;
+        totalTransactions += panel.stats.transactions;
+    }
+
+    printf("total: %u transactions, %u bytes\n", (unsigned)totalTransactions, (unsigned)totalBytes);
+
+    if (failures != 0U) {
+        printf("%u check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all passed\n");
+    return 0;
+}
@@ -0,0 +1,1053 @@
+/*
+ * fat_image_test.c
+ *
+ * Host test of the USB stick path: the FAT reader (fat_reader.h), songs
+ * played straight from the stick (SongPack_OpenSmfSource()), and the
+ * import into the content store (song_import.h, store_songs.h).
+ *
+ * Without arguments it builds disk images in memory: FAT12 (floppy layout,
+ * no partition table), FAT16 and FAT32 (behind an MBR), each with a SONGS
+ * folder of 100 generated songs. Every other file is allocated with gaps,
+ * so cluster chains are fragmented and interleaved; the names are long
+ * names, lower-case 8.3 names (NT flags) and plain 8.3 names, next to the
+ * usual clutter (deleted entries, an orphaned long name, a volume label,
+ * "._" files, an empty file, other file types, a subfolder). For each
+ * image it checks:
+ *   - the directory listing (names, sizes),
+ *   - random reads against the original bytes,
+ *   - a fragmented .mid opened from the image against the same file
+ *     opened from memory (every step),
+ *   - the import: every song and title in the store, nothing written on a
+ *     second import, one song written again after it changed, and every
+ *     store song opens (store_songs.h).
+ *
+ * The disk and the flash have a timing model (a full-speed USB stick: a
+ * fixed cost per command plus a cost per sector; a W25Q chip: page
+ * program and block erase times), so the import is timed with pipelined
+ * reads (FatDisk.start / poll) and with blocking reads.
+ *
+ * With IMAGE (e.g. dd if=/dev/sdX of=stick.img), the image is mounted, its
+ * SONGS folder (or the root) listed and imported the same way.
+ *
+ * Build and run from the project directory (SN_Keyboard_Assistant):
+ *
+ *   gcc -std=c11 -Wall -Wextra -DDISPLAY_HOST_BUILD -ICore/Inc \
+ *       Tools/fat_image_test.c Core/Src/fat_reader.c Core/Src/song_import.c \
+ *       Core/Src/store_songs.c Core/Src/nor_store.c Core/Src/song_pack.c \
+ *       Core/Src/song_lz.c Core/Src/smf_reader.c Core/Src/song_text.c \
+ *       Core/Src/notes.c Core/Src/lesson_render.c \
+ *       -o fat_image_test && ./fat_image_test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "fat_reader.h"
+#include "song_import.h"
+#include "store_songs.h"
+#include "nor_store.h"
+#include "song_pack.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+        if (!(cond)) { \
+            failures++; \
+            printf("  FAIL line %d: ", __LINE__); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+        } \
+    } while (0)
+
+/* ---- Timing model (milliseconds) ---- */
+
+#define USB_COMMAND_MS      (1.5)          /* CBW, CSW and the stick's own latency */
+#define USB_SECTOR_MS       (0.55)         /* ~930 KB/s bulk data at full speed */
+#define USB_POLL_MS         (0.01)         /* one poll of a queued read */
+#define NOR_READ_MS_BYTE    (0.0004)       /* 20 MHz SPI */
+#define NOR_PROGRAM_MS_PAGE (0.7)          /* 256-byte page program */
+#define NOR_ERASE_MS        (150.0)        /* 64 KB block erase */
+
+static double simNow = 0.0;
+
+/* ---- Simulated disk ---- */
+
+typedef struct {
+    const uint8_t *mem;          /* image in memory, or */
+    FILE *file;                  /* image file */
+    uint32_t sectors;
+
+    /* Queued read (start / poll) */
+    bool busy;
+    double doneAt;
+    uint32_t lba;
+    uint8_t *buf;
+    uint16_t count;
+
+    unsigned long commands;
+    unsigned long sectorsRead;
+    unsigned long overlaps;      /* a command while another one was queued (must not happen) */
+} Disk;
+
+static bool Disk_Copy(Disk *d, uint32_t lba, uint8_t *buf, uint16_t count)
+{
+    if (count == 0U || count > FAT_MAX_READ_SECTORS || lba >= d->sectors || count > d->sectors - lba) return false;
+    if (d->mem != NULL) {
+        memcpy(buf, &d->mem[(size_t)lba * FAT_SECTOR_SIZE], (size_t)count * FAT_SECTOR_SIZE);
+        return true;
+    }
+    if (fseek(d->file, (long)lba * (long)FAT_SECTOR_SIZE, SEEK_SET) != 0) return false;
+    return fread(buf, FAT_SECTOR_SIZE, count, d->file) == count;
+}
+
+static double Disk_Cost(uint16_t count)
+{
+    return USB_COMMAND_MS + USB_SECTOR_MS * count;
+}
+
+static bool Disk_Read(void *ctx, uint32_t lba, uint8_t *buf, uint16_t count)
+{
+    Disk *d = ctx;
+    if (d->busy) {
+        d->overlaps++;
+        return false;
+    }
+    d->commands++;
+    d->sectorsRead += count;
+    simNow += Disk_Cost(count);
+    return Disk_Copy(d, lba, buf, count);
+}
+
+static bool Disk_Start(void *ctx, uint32_t lba, uint8_t *buf, uint16_t count)
+{
+    Disk *d = ctx;
+    if (d->busy) {
+        d->overlaps++;
+        return false;
+    }
+    d->commands++;
+    d->sectorsRead += count;
+    d->busy = true;
+    d->doneAt = simNow + Disk_Cost(count);
+    d->lba = lba;
+    d->buf = buf;
+    d->count = count;
+    return true;
+}
+
+/* The data arrives at the end of the transfer: a caller reading the buffer early sees stale bytes. */
+static FatDiskState Disk_Poll(void *ctx)
+{
+    Disk *d = ctx;
+    if (!d->busy) {
+        d->overlaps++;
+        return FAT_DISK_FAILED;
+    }
+    simNow += USB_POLL_MS;
+    if (simNow < d->doneAt) return FAT_DISK_BUSY;
+    d->busy = false;
+    return Disk_Copy(d, d->lba, d->buf, d->count) ? FAT_DISK_DONE : FAT_DISK_FAILED;
+}
+
+static FatDisk Disk_Fat(Disk *d, bool pipelined)
+{
+    FatDisk disk = { Disk_Read, pipelined ? Disk_Start : NULL, pipelined ? Disk_Poll : NULL, d };
+    return disk;
+}
+
+/* ---- Simulated NOR chip ---- */
+
+typedef struct {
+    uint8_t *mem;
+    uint32_t segmentSize;
+    uint16_t segmentCount;
+    unsigned long programmed;    /* bytes */
+    unsigned long erases;
+} Chip;
+
+static bool Chip_Read(void *ctx, uint32_t addr, uint8_t *buf, uint32_t len)
+{
+    Chip *c = ctx;
+    if (addr + len > c->segmentSize * (uint32_t)c->segmentCount) return false;
+    memcpy(buf, &c->mem[addr], len);
+    simNow += NOR_READ_MS_BYTE * len;
+    return true;
+}
+
+static bool Chip_Program(void *ctx, uint32_t addr, const uint8_t *buf, uint32_t len)
+{
+    Chip *c = ctx;
+    if (addr + len > c->segmentSize * (uint32_t)c->segmentCount) return false;
+    for (uint32_t i = 0; i < len; i++) c->mem[addr + i] &= buf[i];
+    c->programmed += len;
+    simNow += NOR_PROGRAM_MS_PAGE * ((len + 255U) / 256U);
+    return true;
+}
+
+static bool Chip_Erase(void *ctx, uint32_t addr)
+{
+    Chip *c = ctx;
+    if (addr % c->segmentSize != 0U || addr >= c->segmentSize * (uint32_t)c->segmentCount) return false;
+    memset(&c->mem[addr], 0xFF, c->segmentSize);
+    c->erases++;
+    simNow += NOR_ERASE_MS;
+    return true;
+}
+
+static void Chip_Init(Chip *c, uint32_t segmentSize, uint16_t segmentCount)
+{
+    memset(c, 0, sizeof(*c));
+    c->segmentSize = segmentSize;
+    c->segmentCount = segmentCount;
+    c->mem = malloc((size_t)segmentSize * segmentCount);
+    if (c->mem == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    memset(c->mem, 0xFF, (size_t)segmentSize * segmentCount);
+}
+
+static NorDevice Chip_Device(Chip *c)
+{
+    NorDevice dev = { Chip_Read, Chip_Program, Chip_Erase, c, c->segmentSize, c->segmentCount };
+    return dev;
+}
+
+/* The store and the volume are large; one of each is enough. */
+static NorStore store;
+static FatVolume vol;
+
+static bool NewStore(Chip *chip)
+{
+    NorDevice dev = Chip_Device(chip);
+    memset(chip->mem, 0xFF, (size_t)chip->segmentSize * chip->segmentCount);
+    return NorStore_Format(&store, &dev) == NOR_STORE_OK && NorStore_Mount(&store, &dev) == NOR_STORE_OK;
+}
+
+/* ---- Image builder ---- */
+
+typedef struct {
+    uint8_t *data;
+    uint32_t totalSectors;       /* whole disk */
+    uint32_t start;              /* volume (partition) start */
+    int type;
+    uint32_t spc;
+    uint32_t fatSectors;
+    uint32_t rootEntries;
+    uint32_t fatLba, rootLba, dataLba;
+    uint32_t clusters;
+    uint8_t *used;               /* per cluster */
+} Image;
+
+typedef struct {
+    Image *im;
+    bool fixedRoot;
+    uint32_t firstCluster;
+    uint32_t lastCluster;
+    uint32_t count;              /* entries written */
+    uint32_t tail;               /* next ~N of generated short names */
+} Dir;
+
+static void Put16(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void Put32(uint8_t *p, uint32_t v)
+{
+    Put16(p, v);
+    Put16(p + 2, v >> 16);
+}
+
+static uint8_t *Sector(Image *im, uint32_t lba)
+{
+    return &im->data[(size_t)lba * FAT_SECTOR_SIZE];
+}
+
+static uint32_t ClusterBytes(const Image *im)
+{
+    return im->spc * FAT_SECTOR_SIZE;
+}
+
+static uint8_t *ClusterData(Image *im, uint32_t cluster)
+{
+    return Sector(im, im->dataLba + (cluster - 2U) * im->spc);
+}
+
+static uint32_t EndOfChain(const Image *im)
+{
+    return (im->type == 12) ? 0x0FFFU : (im->type == 16) ? 0xFFFFU : 0x0FFFFFFFU;
+}
+
+static void SetFat(Image *im, uint32_t cluster, uint32_t value)
+{
+    for (uint32_t f = 0; f < 2U; f++)
+    {
+        uint8_t *fat = Sector(im, im->fatLba + f * im->fatSectors);
+        if (im->type == 12)
+        {
+            uint32_t o = cluster + cluster / 2U;
+            if (cluster & 1U) {
+                fat[o] = (uint8_t)((fat[o] & 0x0FU) | ((value << 4) & 0xF0U));
+                fat[o + 1U] = (uint8_t)(value >> 4);
+            } else {
+                fat[o] = (uint8_t)value;
+                fat[o + 1U] = (uint8_t)((fat[o + 1U] & 0xF0U) | ((value >> 8) & 0x0FU));
+            }
+        }
+        else if (im->type == 16) Put16(&fat[cluster * 2U], value);
+        else Put32(&fat[cluster * 4U], value & 0x0FFFFFFFU);
+    }
+}
+
+static void Image_Format(Image *im, int type, uint32_t volSectors, uint32_t spc, uint32_t partStart)
+{
+    uint32_t reserved = (type == 32) ? 32U : 1U;
+    uint32_t fatSectors = 1;
+    uint32_t bits = (type == 12) ? 12U : (type == 16) ? 16U : 32U;
+
+    memset(im, 0, sizeof(*im));
+    im->type = type;
+    im->spc = spc;
+    im->start = partStart;
+    im->totalSectors = partStart + volSectors;
+    im->rootEntries = (type == 32) ? 0U : (type == 12) ? 224U : 512U;
+    uint32_t rootSectors = im->rootEntries * 32U / FAT_SECTOR_SIZE;
+
+    for (;;)
+    {
+        im->clusters = (volSectors - reserved - 2U * fatSectors - rootSectors) / spc;
+        uint32_t need = ((im->clusters + 2U) * bits / 8U + FAT_SECTOR_SIZE) / FAT_SECTOR_SIZE;
+        if (need <= fatSectors) break;
+        fatSectors = need;
+    }
+    im->fatSectors = fatSectors;
+    im->fatLba = partStart + reserved;
+    im->rootLba = im->fatLba + 2U * fatSectors;
+    im->dataLba = im->rootLba + rootSectors;
+
+    im->data = calloc(im->totalSectors, FAT_SECTOR_SIZE);
+    im->used = calloc(im->clusters + 2U, 1);
+    if (im->data == NULL || im->used == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+
+    if (partStart != 0U)
+    {
+        uint8_t *mbr = Sector(im, 0);
+        uint8_t *p = &mbr[446];
+        p[4] = (type == 12) ? 0x01U : (type == 16) ? 0x0EU : 0x0CU;
+        Put32(&p[8], partStart);
+        Put32(&p[12], volSectors);
+        mbr[510] = 0x55;
+        mbr[511] = 0xAA;
+    }
+
+    uint8_t *b = Sector(im, partStart);
+    b[0] = 0xEB; b[1] = 0x3C; b[2] = 0x90;
+    memcpy(&b[3], "MSWIN4.1", 8);
+    Put16(&b[11], FAT_SECTOR_SIZE);
+    b[13] = (uint8_t)spc;
+    Put16(&b[14], reserved);
+    b[16] = 2;
+    Put16(&b[17], im->rootEntries);
+    if (volSectors < 0x10000U && type != 32) Put16(&b[19], volSectors);
+    else Put32(&b[32], volSectors);
+    b[21] = 0xF8;
+    if (type == 32) {
+        Put32(&b[36], fatSectors);
+        Put32(&b[44], 2);
+        Put16(&b[48], 1);
+        Put16(&b[50], 6);
+    } else {
+        Put16(&b[22], fatSectors);
+    }
+    b[510] = 0x55;
+    b[511] = 0xAA;
+
+    SetFat(im, 0, 0x0FFFFFF8U & EndOfChain(im));
+    SetFat(im, 1, EndOfChain(im));
+    im->used[0] = im->used[1] = 1;
+}
+
+/* First free cluster from 'from' on; with gaps, a few free clusters are passed over (left to later files). */
+static uint32_t AllocCluster(Image *im, uint32_t from, bool gaps)
+{
+    uint32_t skip = gaps ? (uint32_t)(rand() % 3) : 0U;
+    for (uint32_t c = from; c < im->clusters + 2U; c++)
+    {
+        if (im->used[c]) continue;
+        if (skip > 0U) { skip--; continue; }
+        im->used[c] = 1;
+        memset(ClusterData(im, c), 0, ClusterBytes(im));
+        return c;
+    }
+    fprintf(stderr, "image full\n");
+    exit(1);
+}
+
+static uint32_t WriteChain(Image *im, const uint8_t *data, uint32_t len, bool gaps)
+{
+    uint32_t n = (len + ClusterBytes(im) - 1U) / ClusterBytes(im);
+    uint32_t first = 0, prev = 0;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t c = AllocCluster(im, gaps ? 2U : prev + 1U, gaps);
+        uint32_t part = len - i * ClusterBytes(im);
+        if (part > ClusterBytes(im)) part = ClusterBytes(im);
+        memcpy(ClusterData(im, c), &data[i * ClusterBytes(im)], part);
+        if (prev != 0U) SetFat(im, prev, c); else first = c;
+        prev = c;
+    }
+    if (prev != 0U) SetFat(im, prev, EndOfChain(im));
+    return first;
+}
+
+static uint8_t *DirSlot(Dir *d)
+{
+    Image *im = d->im;
+    uint32_t perCluster = ClusterBytes(im) / 32U;
+    uint8_t *slot;
+
+    if (d->fixedRoot)
+    {
+        if (d->count >= im->rootEntries) {
+            fprintf(stderr, "root directory full\n");
+            exit(1);
+        }
+        slot = Sector(im, im->rootLba) + d->count * 32U;
+    }
+    else
+    {
+        if (d->count > 0U && d->count % perCluster == 0U)
+        {
+            uint32_t c = AllocCluster(im, 2, false);
+            SetFat(im, d->lastCluster, c);
+            SetFat(im, c, EndOfChain(im));
+            d->lastCluster = c;
+        }
+        slot = ClusterData(im, d->lastCluster) + (d->count % perCluster) * 32U;
+    }
+    d->count++;
+    return slot;
+}
+
+static Dir RootDir(Image *im)
+{
+    Dir d = { im, im->type != 32, 0, 0, 0, 1 };
+    if (im->type == 32)
+    {
+        im->used[2] = 1;
+        memset(ClusterData(im, 2), 0, ClusterBytes(im));
+        SetFat(im, 2, EndOfChain(im));
+        d.firstCluster = d.lastCluster = 2;
+    }
+    return d;
+}
+
+static uint8_t Checksum(const uint8_t *name11)
+{
+    uint8_t sum = 0;
+    for (int i = 0; i < 11; i++) sum = (uint8_t)(((sum & 1U) ? 0x80U : 0U) + (sum >> 1) + name11[i]);
+    return sum;
+}
+
+static void WriteShortEntry(Dir *d, const uint8_t *name11, uint8_t nt, uint8_t attr, uint32_t cluster, uint32_t size)
+{
+    uint8_t *e = DirSlot(d);
+    memcpy(e, name11, 11);
+    e[11] = attr;
+    e[12] = nt;
+    if (d->im->type == 32) Put16(&e[20], cluster >> 16);
+    Put16(&e[26], cluster & 0xFFFFU);
+    Put32(&e[28], size);
+}
+
+static void WriteLongName(Dir *d, const char *name, uint8_t sum)
+{
+    uint32_t len = (uint32_t)strlen(name);
+    uint32_t parts = (len + 12U) / 13U;
+    static const uint8_t offs[13] = { 1, 3, 5, 7, 9, 14, 16, 18, 20, 22, 24, 28, 30 };
+
+    for (uint32_t k = parts; k >= 1U; k--)
+    {
+        uint8_t *e = DirSlot(d);
+        memset(e, 0, 32);
+        e[0] = (uint8_t)(k | ((k == parts) ? 0x40U : 0U));
+        e[11] = 0x0F;
+        e[13] = sum;
+        for (uint32_t i = 0; i < 13U; i++)
+        {
+            uint32_t at = (k - 1U) * 13U + i;
+            uint32_t c = (at < len) ? (uint8_t)name[at] : (at == len) ? 0x0000U : 0xFFFFU;
+            Put16(&e[offs[i]], c);
+        }
+    }
+}
+
+static bool Valid83(char c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+}
+
+/* Directory entry with the names Windows would write: 8.3 (NT case flags) or a long name + NAME~N.EXT */
+static void AddEntry(Dir *d, const char *name, uint8_t attr, uint32_t cluster, uint32_t size)
+{
+    uint8_t name11[11];
+    const char *dot = strrchr(name, '.');
+    uint32_t baseLen = (dot != NULL) ? (uint32_t)(dot - name) : (uint32_t)strlen(name);
+    uint32_t extLen = (dot != NULL) ? (uint32_t)strlen(dot + 1) : 0U;
+    bool fits = baseLen >= 1U && baseLen <= 8U && extLen <= 3U;
+    bool upper = false, lowerBase = false, lowerExt = false;
+
+    for (uint32_t i = 0; name[i] != '\0'; i++)
+    {
+        char c = name[i];
+        if (&name[i] == dot) continue;
+        if (!Valid83(c)) fits = false;
+        if (c >= 'A' && c <= 'Z') upper = true;
+        if (c >= 'a' && c <= 'z') {
+            if (dot == NULL || &name[i] < dot) lowerBase = true; else lowerExt = true;
+        }
+    }
+    if (upper && (lowerBase || lowerExt)) fits = false;     /* mixed case needs a long name */
+
+    memset(name11, ' ', sizeof(name11));
+    if (fits)
+    {
+        for (uint32_t i = 0; i < baseLen; i++) name11[i] = (uint8_t)toupper((unsigned char)name[i]);
+        for (uint32_t i = 0; i < extLen; i++) name11[8 + i] = (uint8_t)toupper((unsigned char)dot[1 + i]);
+        WriteShortEntry(d, name11, (uint8_t)((lowerBase ? 0x08U : 0U) | (lowerExt ? 0x10U : 0U)), attr, cluster, size);
+        return;
+    }
+
+    char tail[8];
+    uint32_t n = 0;
+    int tailLen = snprintf(tail, sizeof(tail), "~%u", (unsigned)d->tail++);
+    for (uint32_t i = 0; i < baseLen && n < 8U - (uint32_t)tailLen; i++) {
+        if (Valid83(name[i])) name11[n++] = (uint8_t)toupper((unsigned char)name[i]);
+    }
+    memcpy(&name11[n], tail, (size_t)tailLen);
+    for (uint32_t i = 0, m = 0; i < extLen && m < 3U; i++) {
+        if (Valid83(dot[1 + i])) name11[8 + m++] = (uint8_t)toupper((unsigned char)dot[1 + i]);
+    }
+    WriteLongName(d, name, Checksum(name11));
+    WriteShortEntry(d, name11, 0, attr, cluster, size);
+}
+
+static Dir MakeDir(Dir *parent, const char *name)
+{
+    Image *im = parent->im;
+    uint32_t c = AllocCluster(im, 2, false);
+    Dir d = { im, false, c, c, 0, 1 };
+    uint8_t dotName[11], dotDotName[11];
+
+    SetFat(im, c, EndOfChain(im));
+    memset(dotName, ' ', 11);
+    memset(dotDotName, ' ', 11);
+    dotName[0] = '.';
+    dotDotName[0] = dotDotName[1] = '.';
+    WriteShortEntry(&d, dotName, 0, FAT_ATTR_DIRECTORY, c, 0);
+    WriteShortEntry(&d, dotDotName, 0, FAT_ATTR_DIRECTORY, parent->fixedRoot ? 0U : parent->firstCluster, 0);
+    AddEntry(parent, name, FAT_ATTR_DIRECTORY, c, 0);
+    return d;
+}
+
+static void AddFile(Dir *d, const char *name, const uint8_t *data, uint32_t len, bool gaps)
+{
+    uint32_t c = (len > 0U) ? WriteChain(d->im, data, len, gaps) : 0U;
+    AddEntry(d, name, FAT_ATTR_ARCHIVE, c, len);
+}
+
+/* ---- Generated songs ---- */
+
+#define SONG_FILES  (100U)
+
+typedef struct {
+    char name[64];
+    uint8_t *data;
+    uint32_t size;
+    uint8_t type;                /* NOR_STORE_SONG_SMF / _TEXT */
+} SongFile;
+
+static SongFile songFiles[SONG_FILES];
+
+static uint32_t MakeSmf(uint8_t **out, uint32_t notes, uint32_t seed)
+{
+    uint32_t trackLen = 7U + 8U + notes * 8U + 4U;
+    uint32_t size = 14U + 8U + trackLen;
+    uint8_t *p = malloc(size);
+    uint8_t *q = p;
+
+    memcpy(q, "MThd\0\0\0\6\0\0\0\1\0\x60", 14); q += 14;
+    memcpy(q, "MTrk", 4); q += 4;
+    *q++ = (uint8_t)(trackLen >> 24); *q++ = (uint8_t)(trackLen >> 16);
+    *q++ = (uint8_t)(trackLen >> 8); *q++ = (uint8_t)trackLen;
+    memcpy(q, "\0\xFF\x51\x03\x07\xA1\x20", 7); q += 7;          /* 120 bpm */
+    memcpy(q, "\0\xFF\x58\x04\x04\x02\x18\x08", 8); q += 8;      /* 4/4 */
+    for (uint32_t n = 0; n < notes; n++)
+    {
+        uint8_t pitch = (uint8_t)(60U + (seed + n * 7U) % 13U);
+        *q++ = 0; *q++ = 0x90; *q++ = pitch; *q++ = 100;
+        *q++ = 48; *q++ = 0x80; *q++ = pitch; *q++ = 0;
+    }
+    memcpy(q, "\0\xFF\x2F\0", 4); q += 4;
+    *out = p;
+    return (uint32_t)(q - p);
+}
+
+static uint32_t MakeText(uint8_t **out, uint32_t bars, uint32_t seed)
+{
+    static const char letters[] = "CDEFGAB";
+    char *p = malloc(64U + bars * 16U);
+    int n = sprintf(p, "T:Exercise %u\nQ:100\nM:4/4\n", (unsigned)seed);
+
+    for (uint32_t b = 0; b < bars; b++)
+    {
+        for (uint32_t k = 0; k < 4U; k++) {
+            n += sprintf(p + n, "%c4 ", letters[(seed + b + k) % 7U]);
+        }
+        n += sprintf(p + n, (b + 1U == bars) ? "||\n" : "|\n");
+    }
+    *out = (uint8_t *)p;
+    return (uint32_t)n;
+}
+
+static void MakeSongs(void)
+{
+    for (uint32_t i = 0; i < SONG_FILES; i++)
+    {
+        SongFile *s = &songFiles[i];
+        bool text = (i % 4U) == 3U;
+        static const char *const patterns[] = {
+            "Song %03u - Etude", "piece%u", "MINUET%u", "A very long name for a piano piece number %u", "Sonatina %u"
+        };
+
+        snprintf(s->name, sizeof(s->name), patterns[i % 5U], (unsigned)i);
+        strcat(s->name, text ? ".txt" : ((i % 5U) == 3U ? ".midi" : ((i % 5U) == 2U ? ".MID" : ".mid")));
+        s->type = text ? NOR_STORE_SONG_TEXT : NOR_STORE_SONG_SMF;
+        if (text) {
+            s->size = MakeText(&s->data, 4U + (i * 13U) % 40U, i);
+        } else {
+            uint32_t notes = ((i % 10U) == 9U) ? 3000U : 40U + (i * 37U) % 400U;
+            s->size = MakeSmf(&s->data, notes, i);
+        }
+    }
+}
+
+/* Listing expected in SONGS, in directory order */
+typedef struct {
+    const char *name;
+    uint32_t size;
+    bool isDir;
+} Expected;
+
+static Expected expected[SONG_FILES + 8U];
+static uint32_t expectedCount;
+
+static void Expect(const char *name, uint32_t size, bool isDir)
+{
+    expected[expectedCount].name = name;
+    expected[expectedCount].size = size;
+    expected[expectedCount].isDir = isDir;
+    expectedCount++;
+}
+
+static void BuildImage(Image *im, int type, uint32_t volSectors, uint32_t spc, uint32_t partStart)
+{
+    static uint8_t junk[4096];
+    static const char readme[] = "Songs for the keyboard assistant.\n";
+
+    srand(1234);
+    Image_Format(im, type, volSectors, spc, partStart);
+    Dir root = RootDir(im);
+
+    /* Root: volume label, a deleted file, an orphaned long name before a plain 8.3 file */
+    uint8_t label[11];
+    memcpy(label, "SNKEYS     ", 11);
+    WriteShortEntry(&root, label, 0, FAT_ATTR_VOLUME_ID, 0, 0);
+    AddFile(&root, "Deleted song.mid", junk, 1000, false);
+    root.count--;
+    *(DirSlot(&root) - 0) = 0xE5;                         /* the short entry */
+    WriteLongName(&root, "Ghost name.txt", 0x5A);
+    AddFile(&root, "PLAIN.TXT", (const uint8_t *)readme, sizeof(readme) - 1U, false);
+
+    Dir songs = MakeDir(&root, "SONGS");
+    expectedCount = 0;
+
+    /* Clutter first, then the songs, with a subfolder in the middle */
+    AddFile(&songs, "._Song 000 - Etude.mid", junk, sizeof(junk), false);
+    Expect("._Song 000 - Etude.mid", sizeof(junk), false);
+    AddFile(&songs, "readme.doc", (const uint8_t *)readme, sizeof(readme) - 1U, false);
+    Expect("readme.doc", sizeof(readme) - 1U, false);
+    AddFile(&songs, "empty.mid", NULL, 0, false);
+    Expect("empty.mid", 0, false);
+
+    for (uint32_t i = 0; i < SONG_FILES; i++)
+    {
+        SongFile *s = &songFiles[i];
+        if (i == SONG_FILES / 2U) {
+            (void)MakeDir(&songs, "old");
+            Expect("old", 0, true);
+        }
+        AddFile(&songs, s->name, s->data, s->size, (i & 1U) != 0U);
+        Expect(s->name, s->size, false);
+    }
+}
+
+/* ---- Tests ---- */
+
+static const char *FatStatusName(FatStatus st)
+{
+    static const char *const names[] = {
+        "ok", "end", "i/o error", "no FAT volume", "unsupported", "not found", "corrupt", "not a directory"
+    };
+    return ((unsigned)st < sizeof(names) / sizeof(names[0])) ? names[st] : "?";
+}
+
+static const char *StoreStatusName(NorStoreStatus st)
+{
+    static const char *const names[] = {
+        "ok", "i/o error", "unformatted", "full", "index full", "too large", "not found", "crc", "state"
+    };
+    return ((unsigned)st < sizeof(names) / sizeof(names[0])) ? names[st] : "?";
+}
+
+static void TestListing(FatFile *dir)
+{
+    FatEntry e;
+    uint32_t n = 0;
+    FatStatus st;
+
+    Fat_Rewind(dir);
+    while ((st = Fat_NextEntry(dir, &e)) == FAT_OK)
+    {
+        if (n < expectedCount)
+        {
+            const Expected *x = &expected[n];
+            CHECK(strncmp(e.name, x->name, FAT_NAME_MAX - 1U) == 0, "entry %u: \"%s\", expected \"%s\"", (unsigned)n, e.name, x->name);
+            CHECK(((e.attr & FAT_ATTR_DIRECTORY) != 0U) == x->isDir, "entry %u: directory flag", (unsigned)n);
+            if (!x->isDir) CHECK(e.size == x->size, "%s: size %u, expected %u", e.name, (unsigned)e.size, (unsigned)x->size);
+        }
+        n++;
+    }
+    CHECK(st == FAT_END, "listing ended with %s", FatStatusName(st));
+    CHECK(n == expectedCount, "%u entries, expected %u", (unsigned)n, (unsigned)expectedCount);
+}
+
+static void TestRoot(FatVolume *v)
+{
+    FatFile root;
+    FatEntry e;
+
+    Fat_OpenRoot(v, &root);
+    CHECK(Fat_NextEntry(&root, &e) == FAT_OK && strcmp(e.name, "PLAIN.TXT") == 0,
+          "root: first entry \"%s\", expected PLAIN.TXT (label, deleted entry, orphaned long name skipped)", e.name);
+    CHECK(Fat_Find(&root, "songs", &e) == FAT_OK && (e.attr & FAT_ATTR_DIRECTORY) != 0U, "root: SONGS not found");
+    CHECK(Fat_Find(&root, "Ghost name.txt", &e) == FAT_ERR_NOT_FOUND, "root: orphaned long name found");
+}
+
+static void TestReads(FatVolume *v, FatFile *dir)
+{
+    static uint8_t buf[70000];
+
+    for (uint32_t i = 0; i < SONG_FILES; i += 3U)
+    {
+        const SongFile *s = &songFiles[i];
+        FatEntry e;
+        FatFile f;
+
+        if (Fat_Find(dir, s->name, &e) != FAT_OK) {
+            CHECK(false, "%s not found", s->name);
+            continue;
+        }
+        Fat_Open(v, &e, &f);
+        CHECK(Fat_Read(&f, 0, buf, s->size) == FAT_OK && memcmp(buf, s->data, s->size) == 0, "%s: whole file", s->name);
+        for (int k = 0; k < 20; k++)
+        {
+            uint32_t off = (uint32_t)rand() % s->size;
+            uint32_t len = (uint32_t)rand() % (s->size - off + 1U);
+            if (len > 3000U && (k & 1)) len = 3000U;
+            CHECK(Fat_Read(&f, off, buf, len) == FAT_OK && memcmp(buf, &s->data[off], len) == 0,
+                  "%s: %u bytes at %u", s->name, (unsigned)len, (unsigned)off);
+        }
+        CHECK(Fat_Read(&f, s->size - 1U, buf, 2) != FAT_OK, "%s: read past the end", s->name);
+    }
+}
+
+/* A fragmented .mid played from the image must give the same steps as from memory. */
+static void TestStreaming(FatVolume *v, FatFile *dir)
+{
+    const SongFile *s = &songFiles[9];    /* 3000 notes, fragmented */
+    static Song memSong, fatSong;
+    static PackedSong memBody, fatBody;
+    static FatFile f;
+    static SmfSource src;
+    static NoteEntry memNotes[256][SONG_PACK_MAX_STEP_NOTES];
+    static uint8_t memCounts[256];
+    FatEntry e;
+
+    if (Fat_Find(dir, s->name, &e) != FAT_OK) {
+        CHECK(false, "%s not found", s->name);
+        return;
+    }
+    Fat_Open(v, &e, &f);
+    Fat_Source(&f, &src);
+
+    CHECK(SongPack_OpenSmf(&memSong, &memBody, s->data, s->size, "mem"), "open from memory");
+    for (uint8_t i = 0; i < memSong.stepCount; i++)
+    {
+        const SongStep *step = Song_Step(&memSong, i);
+        memCounts[i] = (step != NULL) ? step->noteCount : 0U;
+        if (step != NULL) memcpy(memNotes[i], step->notes, step->noteCount * sizeof(NoteEntry));
+    }
+
+    uint32_t readsBefore = v->reads;
+    CHECK(SongPack_OpenSmfSource(&fatSong, &fatBody, &src, "stick"), "open from the image");
+    CHECK(fatSong.stepCount == memSong.stepCount && fatSong.tempoBpm == memSong.tempoBpm,
+          "steps %u / %u, tempo %u / %u", fatSong.stepCount, memSong.stepCount, fatSong.tempoBpm, memSong.tempoBpm);
+    for (uint8_t i = 0; i < fatSong.stepCount && i < memSong.stepCount; i++)
+    {
+        const SongStep *step = Song_Step(&fatSong, i);
+        bool same = step != NULL && step->noteCount == memCounts[i];
+        for (uint8_t k = 0; same && k < step->noteCount; k++) {
+            same = step->notes[k].midiNote == memNotes[i][k].midiNote &&
+                   step->notes[k].onsetTick == memNotes[i][k].onsetTick &&
+                   step->notes[k].durationTicks == memNotes[i][k].durationTicks;
+        }
+        CHECK(same, "step %u differs", i);
+    }
+    CHECK(SongPack_IsTruncated(&fatSong) && SongPack_IsTruncated(&memSong), "3000 notes not flagged as cut");
+    printf("  streamed %s: %u steps (cut), %lu sector reads\n", s->name, fatSong.stepCount,
+           (unsigned long)(v->reads - readsBefore));
+}
+
+/* 200 bars of whole notes: past tick 65535 at bar 171, so the song is cut there and flagged. */
+static void TestLongSmf(void)
+{
+    static uint8_t file[64 + 200U * 9U];
+    static Song song;
+    static PackedSong body;
+    uint32_t trackLen = 4U + 200U * 9U;
+    uint8_t *q = file;
+
+    memcpy(q, "MThd\0\0\0\6\0\0\0\1\0\x60", 14); q += 14;
+    memcpy(q, "MTrk", 4); q += 4;
+    *q++ = 0; *q++ = 0;
+    *q++ = (uint8_t)(trackLen >> 8); *q++ = (uint8_t)trackLen;
+    for (uint32_t n = 0; n < 200U; n++)
+    {
+        uint8_t pitch = (uint8_t)(60U + n % 12U);
+        *q++ = 0; *q++ = 0x90; *q++ = pitch; *q++ = 100;
+        *q++ = 0x83; *q++ = 0x00; *q++ = 0x80; *q++ = pitch; *q++ = 0;   /* 384 ticks later */
+    }
+    memcpy(q, "\0\xFF\x2F\0", 4); q += 4;
+
+    CHECK(SongPack_OpenSmf(&song, &body, file, (uint32_t)(q - file), "long"), "200 bars: open");
+    CHECK(song.stepCount < 200U && SongPack_IsTruncated(&song),
+          "200 bars: %u steps, %s", song.stepCount, SongPack_IsTruncated(&song) ? "cut" : "not flagged as cut");
+    printf("200 bars of whole notes: %u steps (cut at tick 65535)\n", song.stepCount);
+}
+
+static void CheckStore(void)
+{
+    static uint8_t buf[70000];
+
+    for (uint32_t i = 0; i < SONG_FILES; i++)
+    {
+        const SongFile *s = &songFiles[i];
+        uint32_t id = SongImport_Id(s->name);
+        NorStoreItem item;
+        char title[SONG_IMPORT_TITLE_MAX + 1U];
+
+        bool found = NorStore_Find(&store, NOR_STORE_KEY(s->type, id), &item) == NOR_STORE_OK;
+        CHECK(found && item.length == s->size && NorStore_Read(&item, 0, buf, s->size) &&
+              memcmp(buf, s->data, s->size) == 0, "%s: not in the store", s->name);
+        SongImport_Title(s->name, title);
+        found = NorStore_Find(&store, NOR_STORE_KEY(NOR_STORE_SONG_TITLE, id), &item) == NOR_STORE_OK;
+        CHECK(found && item.length == strlen(title) && NorStore_Read(&item, 0, buf, item.length) &&
+              memcmp(buf, title, item.length) == 0, "%s: title", s->name);
+    }
+
+    StoreSongs_Attach(&store);
+    CHECK(StoreSongs_Count() == SONG_FILES, "%u store songs", StoreSongs_Count());
+    for (uint16_t i = 0; i < StoreSongs_Count(); i++)
+    {
+        const char *title = StoreSongs_Title(i);
+        const Song *song = StoreSongs_Open(i);
+        CHECK(title[0] != '\0', "store song %u: no title", i);
+        CHECK(song != NULL && song->stepCount > 0U && Song_Step(song, 0) != NULL, "store song %u (%s) does not open", i, title);
+    }
+    StoreSongs_Attach(NULL);
+}
+
+static void PrintReport(const char *what, const SongImportReport *r, double ms, const Disk *disk)
+{
+    printf("  %-10s %u files: %u imported, %u unchanged, %u skipped, %u failed; %lu bytes, "
+           "%lu data reads (%lu sectors), %lu commands in all, %.2f s\n",
+           what, r->files, r->imported, r->unchanged, r->skipped, r->failed, (unsigned long)r->bytes,
+           (unsigned long)r->reads, (unsigned long)r->sectors, disk->commands, ms / 1000.0);
+}
+
+static bool Import(Disk *disk, bool pipelined, SongImportReport *report, double *ms)
+{
+    FatDisk fd = Disk_Fat(disk, pipelined);
+    FatFile folder;
+    FatEntry e;
+
+    disk->commands = disk->sectorsRead = 0;
+    simNow = 0.0;
+    if (Fat_Mount(&vol, &fd) != FAT_OK) return false;
+    Fat_OpenRoot(&vol, &folder);
+    if (Fat_Find(&folder, "SONGS", &e) == FAT_OK && (e.attr & FAT_ATTR_DIRECTORY) != 0U) {
+        Fat_Open(&vol, &e, &folder);
+    } else {
+        Fat_OpenRoot(&vol, &folder);
+    }
+    bool ok = SongImport_Folder(&store, &folder, report);
+    *ms = simNow;
+    return ok;
+}
+
+static void TestImage(const char *label, int type, uint32_t volSectors, uint32_t spc, uint32_t partStart, Chip *chip)
+{
+    Image im;
+    Disk disk;
+    FatDisk fd;
+    FatFile songs;
+    FatEntry e;
+    SongImportReport r;
+    double ms, blockingMs;
+
+    BuildImage(&im, type, volSectors, spc, partStart);
+    memset(&disk, 0, sizeof(disk));
+    disk.mem = im.data;
+    disk.sectors = im.totalSectors;
+
+    printf("%s: %u clusters of %u bytes%s\n", label, (unsigned)im.clusters, (unsigned)ClusterBytes(&im),
+           partStart ? ", MBR" : ", no partition table");
+
+    fd = Disk_Fat(&disk, false);
+    FatStatus st = Fat_Mount(&vol, &fd);
+    CHECK(st == FAT_OK && vol.type == type, "mount: %s, FAT%u", FatStatusName(st), vol.type);
+    if (st != FAT_OK) return;
+
+    TestRoot(&vol);
+    Fat_OpenRoot(&vol, &songs);
+    CHECK(Fat_Find(&songs, "SONGS", &e) == FAT_OK, "SONGS");
+    Fat_Open(&vol, &e, &songs);
+    TestListing(&songs);
+    TestReads(&vol, &songs);
+    TestStreaming(&vol, &songs);
+
+    /* Import: blocking reads first (for the time), then pipelined into a fresh store */
+    CHECK(NewStore(chip), "store");
+    CHECK(Import(&disk, false, &r, &blockingMs), "blocking import stopped: %s", StoreStatusName(r.storeStatus));
+    CHECK(NewStore(chip), "store");
+    CHECK(Import(&disk, true, &r, &ms), "import stopped: %s / %s", StoreStatusName(r.storeStatus), FatStatusName(r.diskStatus));
+    PrintReport("import", &r, ms, &disk);
+    printf("  same import with blocking reads: %.2f s\n", blockingMs / 1000.0);
+    CHECK(r.files == SONG_FILES + 1U && r.imported == SONG_FILES && r.skipped == 1U && r.failed == 0U,
+          "report: %u files, %u imported, %u skipped, %u failed", r.files, r.imported, r.skipped, r.failed);
+    CHECK(disk.overlaps == 0U, "%lu commands while a read was queued", disk.overlaps);
+    CheckStore();
+
+    /* Again: nothing changed, nothing may be programmed */
+    unsigned long programmed = chip->programmed;
+    CHECK(Import(&disk, true, &r, &ms), "second import");
+    PrintReport("again", &r, ms, &disk);
+    CHECK(r.unchanged == SONG_FILES && r.imported == 0U && chip->programmed == programmed,
+          "second import: %u unchanged, %u imported, %lu bytes programmed", r.unchanged, r.imported,
+          chip->programmed - programmed);
+
+    /* One byte of one song changed on the stick */
+    SongFile *s = &songFiles[17];
+    s->data[s->size - 5U] ^= 0x01U;
+    {
+        /* patched where the reader maps it, so the fragmentation does not matter */
+        FatFile f;
+        uint32_t lba;
+        CHECK(Fat_Find(&songs, s->name, &e) == FAT_OK, "%s", s->name);
+        Fat_Open(&vol, &e, &f);
+        CHECK(Fat_Run(&f, s->size - 5U, &lba) > 0U, "run");
+        im.data[(size_t)lba * FAT_SECTOR_SIZE + (s->size - 5U) % FAT_SECTOR_SIZE] = s->data[s->size - 5U];
+    }
+    CHECK(Import(&disk, true, &r, &ms), "third import");
+    PrintReport("changed", &r, ms, &disk);
+    CHECK(r.imported == 1U && r.unchanged == SONG_FILES - 1U, "changed song: %u imported, %u unchanged", r.imported, r.unchanged);
+    CheckStore();
+    s->data[s->size - 5U] ^= 0x01U;
+
+    free(im.data);
+    free(im.used);
+}
+
+/* ---- Existing image ---- */
+
+static int RunImage(const char *path, Chip *chip)
+{
+    Disk disk;
+    FatDisk fd;
+    FatFile folder;
+    FatEntry e;
+    SongImportReport r;
+    double ms;
+
+    memset(&disk, 0, sizeof(disk));
+    disk.file = fopen(path, "rb");
+    if (disk.file == NULL) {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return 1;
+    }
+    fseek(disk.file, 0, SEEK_END);
+    disk.sectors = (uint32_t)(ftell(disk.file) / (long)FAT_SECTOR_SIZE);
+
+    fd = Disk_Fat(&disk, false);
+    FatStatus st = Fat_Mount(&vol, &fd);
+    if (st != FAT_OK) {
+        fprintf(stderr, "%s: %s\n", path, FatStatusName(st));
+        return 1;
+    }
+    printf("%s: FAT%u, %u clusters of %u bytes\n", path, vol.type, (unsigned)vol.clusterCount,
+           (unsigned)(vol.sectorsPerCluster * FAT_SECTOR_SIZE));
+
+    Fat_OpenRoot(&vol, &folder);
+    if (Fat_Find(&folder, "SONGS", &e) == FAT_OK && (e.attr & FAT_ATTR_DIRECTORY) != 0U) {
+        Fat_Open(&vol, &e, &folder);
+        printf("SONGS:\n");
+    }
+    Fat_Rewind(&folder);
+    while ((st = Fat_NextEntry(&folder, &e)) == FAT_OK) {
+        printf("  %-12s %8lu  %s%s\n", e.shortName, (unsigned long)e.size, e.name,
+               (e.attr & FAT_ATTR_DIRECTORY) ? "/" : "");
+    }
+    if (st != FAT_END) printf("  listing stopped: %s\n", FatStatusName(st));
+
+    if (!NewStore(chip)) return 1;
+    bool ok = Import(&disk, true, &r, &ms);
+    PrintReport("import", &r, ms, &disk);
+    if (!ok) printf("  stopped: store %s, disk %s\n", StoreStatusName(r.storeStatus), FatStatusName(r.diskStatus));
+    fclose(disk.file);
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    static Chip chip;
+
+    Chip_Init(&chip, 65536U, 128U);          /* 8 MB, a W25Q64 */
+    if (argc > 1) return RunImage(argv[1], &chip);
+
+    MakeSongs();
+    TestLongSmf();
+    TestImage("FAT12", 12, 2880U, 1U, 0U, &chip);
+    TestImage("FAT16", 16, 65536U, 4U, 63U, &chip);
+    TestImage("FAT32", 32, 70000U, 1U, 2048U, &chip);
+
+    printf(failures ? "%d FAILED\n" : "all passed\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * gen_chord_table.c
+ *
+ * Build step for free-play chord naming: evaluates the chord definitions of
+ * chord_id.c for all 4096 bass-relative pitch-class masks and writes the
+ * results as a const table to Core/Src/chord_table.c.
+ *
+ * Re-run after changing the definitions or the search in chord_id.c. A stale
+ * table is harmless (ChordId_Lookup() compares the hash and searches at
+ * runtime instead), it just costs the speed-up.
+ *
+ * Build and run from the project directory (SN_Keyboard_Assistant):
+ *
+ *   gcc -std=c11 -Wall -ICore/Inc \
+ *       Tools/gen_chord_table.c Core/Src/chord_id.c \
+ *       -o gen_chord_table && ./gen_chord_table > Core/Src/chord_table.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "chord_id.h"
+
+/* chord_id.c links against the table; the generator only calls ChordId_Search(). */
+const ChordTableEntry_t chordTable[CHORD_TABLE_SIZE] = { 0 };
+const uint32_t CHORD_TABLE_HASH = 0;
+
+#define PER_LINE  (8U)
+
+int main(void)
+{
+    unsigned named = 0;
+
+    printf("#include \"chord_id.h\"\n\n");
+    printf("/*\n");
+    printf(" * chord_table.c\n");
+    printf(" *\n");
+    printf(" * GENERATED by Tools/gen_chord_table.c - do not edit.\n");
+    printf(" *\n");
+    printf(" * Chord per bass-relative pitch-class mask (see chord_id.h).\n");
+    printf(" * Comments: mask of the first entry, and the chord each entry names\n");
+    printf(" * over a C bass.\n");
+    printf(" * Version %u.\n", (unsigned)CHORD_ID_VERSION);
+    printf(" */\n\n");
+
+    printf("const uint32_t CHORD_TABLE_HASH = 0x%08lXUL;\n\n", (unsigned long)ChordId_DefinitionHash());
+    printf("const ChordTableEntry_t chordTable[CHORD_TABLE_SIZE] = {\n");
+
+    for (unsigned base = 0; base < CHORD_TABLE_SIZE; base += PER_LINE)
+    {
+        char names[PER_LINE * (CHORD_NAME_MAX + 1U) + 1U];
+        size_t used = 0;
+
+        printf("    ");
+        for (unsigned i = 0; i < PER_LINE; i++)
+        {
+            ChordTableEntry_t e = ChordId_Search((uint16_t)(base + i));
+            printf("0x%04X,%s", (unsigned)e, (i + 1U < PER_LINE) ? " " : "");
+
+            if (CHORD_ENTRY_QUALITY(e) != CHORD_Q_NONE)
+            {
+                ChordId id = { CHORD_ENTRY_QUALITY(e), CHORD_ENTRY_ROOT(e), 0, CHORD_ENTRY_INVERSION(e) };
+                if (used > 0U) names[used++] = ' ';
+                used += ChordId_Format(&id, &names[used], sizeof(names) - used);
+                named++;
+            }
+        }
+        names[used] = '\0';
+        printf("   /* %03X%s%s */\n", base, (used > 0U) ? " " : "", names);
+    }
+    printf("};\n");
+
+    fprintf(stderr, "%u of %u masks name a chord\n", named, (unsigned)CHORD_TABLE_SIZE);
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * gen_lesson_frames.c
+ *
+ * Build step for the lesson screens: renders every step of the built-in songs
+ * and chord packs with the firmware's own layout code (lesson_render.c) and
+ * writes the frames as const tables to Core/Src/lesson_frames.c.
+ *
+ * Re-run after changing songs.c, chords.c or lesson_render.c. Stale tables are
+ * harmless (lesson.c checks the source hash and falls back to rendering at
+ * runtime), they just cost the speed-up.
+ *
+ * Build and run from the project directory (SN_Keyboard_Assistant):
+ *
+ *   gcc -std=c11 -Wall -DDISPLAY_HOST_BUILD -ICore/Inc \
+ *       Tools/gen_lesson_frames.c Core/Src/lesson_render.c \
+ *       Core/Src/songs.c Core/Src/chords.c \
+ *       -o gen_lesson_frames && ./gen_lesson_frames > Core/Src/lesson_frames.c
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "lesson_render.h"
+
+typedef void (*RenderFn)(const void *source, uint8_t index, uint8_t total, LessonFrame_t *out);
+
+static void RenderSongStep(const void *source, uint8_t index, uint8_t total, LessonFrame_t *out)
+{
+    LessonRender_SongStep(&((const Song *)source)->steps[index], index, total, out);
+}
+
+static void RenderChordStep(const void *source, uint8_t index, uint8_t total, LessonFrame_t *out)
+{
+    LessonRender_ChordStep(&((const ChordPack *)source)->chords[index], index, total, out);
+}
+
+/* Readable comment for a frame row: glyph cells as '~'. */
+static void RowComment(const uint8_t *cells, char *out)
+{
+    for (uint8_t i = 0; i < LESSON_FRAME_COLS; i++) {
+        uint8_t c = cells[i];
+        out[i] = (c < 0x20U || c >= 0x7FU || c == '*' || c == '/') ? '~' : (char)c;
+    }
+    out[LESSON_FRAME_COLS] = '\0';
+}
+
+static void EmitFrames(const char *array, const char *label, const void *source,
+                       uint8_t total, RenderFn render)
+{
+    printf("/* %s */\n", label);
+    printf("static const LessonFrame_t %s[%u] = {\n", array, (unsigned)total);
+
+    for (uint8_t i = 0; i < total; i++)
+    {
+        LessonFrame_t f;
+        render(source, i, total, &f);
+
+        printf("    { {\n");
+        for (uint8_t row = 0; row < LESSON_FRAME_ROWS; row++)
+        {
+            char text[LESSON_FRAME_COLS + 1];
+            RowComment(f.cells[row], text);
+
+            printf("        {");
+            for (uint8_t col = 0; col < LESSON_FRAME_COLS; col++) {
+                printf("%s0x%02X", (col == 0) ? " " : ", ", f.cells[row][col]);
+            }
+            printf(" },   /* |%s| */\n", text);
+        }
+        printf("      }, 0x%08lXUL },\n", (unsigned long)f.glyphs);
+    }
+    printf("};\n\n");
+}
+
+int main(void)
+{
+    char array[32];
+
+    printf("#include \"lesson_frames.h\"\n\n");
+    printf("/*\n");
+    printf(" * lesson_frames.c\n");
+    printf(" *\n");
+    printf(" * GENERATED by Tools/gen_lesson_frames.c - do not edit.\n");
+    printf(" *\n");
+    printf(" * One 2x16 frame + glyph mask per lesson step (see lesson_frames.h).\n");
+    printf(" * Layout version %u.\n", (unsigned)LESSON_RENDER_VERSION);
+    printf(" */\n\n");
+
+    for (uint8_t s = 0; s < SONG_COUNT; s++) {
+        snprintf(array, sizeof(array), "songFrames%u", (unsigned)s);
+        EmitFrames(array, songs[s].title, &songs[s], songs[s].stepCount, RenderSongStep);
+    }
+    for (uint8_t p = 0; p < CHORD_PACK_COUNT; p++) {
+        snprintf(array, sizeof(array), "chordPackFrames%u", (unsigned)p);
+        EmitFrames(array, chordPacks[p].packName, &chordPacks[p], chordPacks[p].chordCount, RenderChordStep);
+    }
+
+    printf("const LessonFrameSet_t songFrameSets[] = {\n");
+    for (uint8_t s = 0; s < SONG_COUNT; s++) {
+        printf("    { 0x%08lXUL, %u, songFrames%u },\n",
+               (unsigned long)LessonRender_SongHash(&songs[s]), (unsigned)songs[s].stepCount, (unsigned)s);
+    }
+    printf("};\n\n");
+    printf("const uint8_t SONG_FRAME_SET_COUNT = (uint8_t)(sizeof(songFrameSets) / sizeof(songFrameSets[0]));\n\n");
+
+    printf("const LessonFrameSet_t chordPackFrameSets[] = {\n");
+    for (uint8_t p = 0; p < CHORD_PACK_COUNT; p++) {
+        printf("    { 0x%08lXUL, %u, chordPackFrames%u },\n",
+               (unsigned long)LessonRender_ChordPackHash(&chordPacks[p]), (unsigned)chordPacks[p].chordCount, (unsigned)p);
+    }
+    printf("};\n\n");
+    printf("const uint8_t CHORD_PACK_FRAME_SET_COUNT = (uint8_t)(sizeof(chordPackFrameSets) / sizeof(chordPackFrameSets[0]));\n");
+
+    return 0;
+}
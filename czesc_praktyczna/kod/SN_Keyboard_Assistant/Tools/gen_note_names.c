@@ -0,0 +1,81 @@
+/*
+ * gen_note_names.c
+ *
+ * Build step for song authoring: runs every spelled note name (letter A..G,
+ * natural / sharp / flat, octaves 0..9) through NoteName_ToMidi() of notes.c
+ * and writes the results as macros to Core/Inc/note_names.h, so that songs
+ * can name a pitch once (PITCH(Cs4, ...) in songs.h) and the compiler fills
+ * in letter, accidental and MIDI number, which then always agree.
+ *
+ * Identifiers cannot hold '#', so sharps are written 's' and flats 'b':
+ * C#4 -> Cs4, Bb3 -> Bb3. Names outside MIDI 0..127 are left out.
+ *
+ * Build and run from the project directory (SN_Keyboard_Assistant):
+ *
+ *   gcc -std=c11 -Wall -ICore/Inc \
+ *       Tools/gen_note_names.c Core/Src/notes.c \
+ *       -o gen_note_names && ./gen_note_names > Core/Inc/note_names.h
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "notes.h"
+
+static const char letters[] = "CDEFGAB";
+
+static const struct {
+    char sign;          /* in the parsed name ('\0' = natural) */
+    char suffix;        /* in the macro name */
+    const char *acc;    /* with the comma after it */
+} spellings[] = {
+    { '\0', '\0', "ACC_NONE,"  },
+    { '#',  's',  "ACC_SHARP," },
+    { 'b',  'b',  "ACC_FLAT,"  },
+};
+
+int main(void)
+{
+    unsigned count = 0;
+
+    printf("#ifndef NOTE_NAMES_H\n");
+    printf("#define NOTE_NAMES_H\n\n");
+    printf("/*\n");
+    printf(" * note_names.h\n");
+    printf(" *\n");
+    printf(" * GENERATED by Tools/gen_note_names.c - do not edit.\n");
+    printf(" *\n");
+    printf(" * PITCH_<name>: letter, accidental and MIDI number of a spelled note, as\n");
+    printf(" * the first three NOTE() arguments (songs.h). Sharps are written 's'\n");
+    printf(" * (Cs4 = C#4), flats 'b' (Bb3). Use through PITCH().\n");
+    printf(" */\n");
+
+    for (int octave = 0; octave <= 9; octave++)
+    {
+        printf("\n/* Octave %d */\n", octave);
+        for (const char *l = letters; *l != '\0'; l++)
+        {
+            for (size_t s = 0; s < sizeof(spellings) / sizeof(spellings[0]); s++)
+            {
+                char text[4];
+                char macro[4];
+                uint8_t midi;
+
+                if (spellings[s].sign != '\0') {
+                    snprintf(text, sizeof(text), "%c%c%d", *l, spellings[s].sign, octave);
+                    snprintf(macro, sizeof(macro), "%c%c%d", *l, spellings[s].suffix, octave);
+                } else {
+                    snprintf(text, sizeof(text), "%c%d", *l, octave);
+                    snprintf(macro, sizeof(macro), "%c%d", *l, octave);
+                }
+                if (NoteName_ToMidi(text, &midi) != NOTE_OK) continue;
+
+                printf("#define PITCH_%-4s '%c', %-10s %3u\n", macro, *l, spellings[s].acc, midi);
+                count++;
+            }
+        }
+    }
+
+    printf("\n#endif /* NOTE_NAMES_H */\n");
+    fprintf(stderr, "%u note names\n", count);
+    return 0;
+}
@@ -0,0 +1,852 @@
+/*
+ * midi2song.c
+ *
+ * Song compiler: turns Standard MIDI Files into packed songs (song_pack.h)
+ * and writes them as const tables to Core/Src/song_library.c. The songs show
+ * up in the song lists after the built-in ones (songs.c).
+ *
+ * - SMF format 0 and 1, ticks-per-quarter division (SMPTE time is rejected);
+ *   all tracks are merged, the drum channel (10) is skipped
+ * - first tempo, time signature, key signature and track name are used
+ *   (title: track name, else the file name)
+ * - times are rescaled to SONG_PPQ, onsets snapped to the sixteenth grid,
+ *   durations (stretched to the next onset when released slightly early) to
+ *   the nearest duration code
+ * - a step ends at a bar line or after --max-notes notes
+ *
+ * Options (apply to all files):
+ *   --max-notes N   notes per step, 1..8 (default 4)
+ *   --flats         spell black keys with flats (default: from the key
+ *                   signature, flats when it has any)
+ *   --masks         also emit per-step note masks (16 bytes per step)
+ *   --frames        also emit pre-rendered LCD frames (33 bytes per step)
+ *   --lz            compress the steps (SONG_PACK_LZ, song_lz.h); each song
+ *                   is decoded back and checked against the packed steps
+ *   --smf           store the MIDI files unchanged (SONG_PACK_SMF), to be
+ *                   read in place on the target by smf_reader.c; steps
+ *                   follow the target's rules (SONG_PACK_SMF_STEP_NOTES)
+ *
+ * A size report goes to stderr. With no input files an empty library is
+ * written.
+ *
+ * Build and run from the project directory (SN_Keyboard_Assistant):
+ *
+ *   gcc -std=c11 -Wall -DDISPLAY_HOST_BUILD -ICore/Inc \
+ *       Tools/midi2song.c Core/Src/song_pack.c Core/Src/song_lz.c \
+ *       Core/Src/smf_reader.c Core/Src/song_text.c Core/Src/notes.c \
+ *       Core/Src/lesson_render.c \
+ *       -o midi2song && ./midi2song --lz --masks --frames Tools/songs/ode_to_joy.mid \
+ *       > Core/Src/song_library.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "song_pack.h"
+#include "song_lz.h"
+#include "lesson_render.h"
+
+#define MAX_NOTES        (4096U)
+#define MAX_STEPS        (255U)
+#define MAX_TITLE        (32U)
+#define DRUM_CHANNEL     (9U)
+
+typedef struct {
+    uint32_t onset;      /* ticks (file PPQ, later SONG_PPQ) */
+    uint32_t duration;
+    uint8_t pitch;
+} MidiNote;
+
+typedef struct {
+    char title[MAX_TITLE];
+    uint16_t division;
+    uint32_t tempoUsPerQuarter;  /* 0 = none seen */
+    uint8_t beatsPerBar;
+    uint8_t beatUnit;
+    int8_t keySharps;            /* key signature: <0 flats, >0 sharps */
+    bool haveTimeSig;
+    bool haveKeySig;
+    MidiNote notes[MAX_NOTES];
+    uint32_t noteCount;
+} MidiFile;
+
+/* Encoded song */
+typedef struct {
+    uint8_t data[65535];
+    uint32_t size;
+    uint8_t stepCount;
+    uint16_t noteCount;
+    uint16_t restCount;
+} Packed;
+
+static uint8_t maxStepNotes = 4;
+static bool forceFlats = false;
+static bool emitMasks = false;
+static bool emitFrames = false;
+static bool embedSmf = false;
+static bool compressLz = false;
+
+static MidiFile midi;
+static Packed packed;
+
+/* --- Standard MIDI File parsing --- */
+
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+    bool error;
+} Reader;
+
+static uint8_t ReadByte(Reader *r)
+{
+    if (r->p >= r->end) {
+        r->error = true;
+        return 0;
+    }
+    return *r->p++;
+}
+
+static uint32_t ReadBE(Reader *r, uint8_t bytes)
+{
+    uint32_t v = 0;
+    while (bytes-- > 0U) v = (v << 8) | ReadByte(r);
+    return v;
+}
+
+/* Variable-length quantity: 7 bits per byte, high bit = more follows (max 4 bytes). */
+static uint32_t ReadVlq(Reader *r)
+{
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < 4U; i++)
+    {
+        uint8_t b = ReadByte(r);
+        v = (v << 7) | (b & 0x7FU);
+        if ((b & 0x80U) == 0U) return v;
+    }
+    r->error = true;
+    return v;
+}
+
+static void Skip(Reader *r, uint32_t n)
+{
+    if ((uint32_t)(r->end - r->p) < n) {
+        r->error = true;
+        r->p = r->end;
+        return;
+    }
+    r->p += n;
+}
+
+static void AddNote(uint32_t onset, uint32_t off, uint8_t pitch)
+{
+    if (midi.noteCount >= MAX_NOTES) return;
+    midi.notes[midi.noteCount].onset = onset;
+    midi.notes[midi.noteCount].duration = off - onset;
+    midi.notes[midi.noteCount].pitch = pitch;
+    midi.noteCount++;
+}
+
+static void ParseMeta(Reader *r, uint8_t type, uint32_t len)
+{
+    const uint8_t *body = r->p;
+    Skip(r, len);
+    if (r->error) return;
+
+    switch (type)
+    {
+        case 0x03:  /* track name */
+            if (midi.title[0] == '\0' && len > 0U) {
+                uint32_t n = (len < MAX_TITLE - 1U) ? len : MAX_TITLE - 1U;
+                memcpy(midi.title, body, n);
+                midi.title[n] = '\0';
+            }
+            break;
+        case 0x51:  /* tempo: microseconds per quarter */
+            if (midi.tempoUsPerQuarter == 0U && len == 3U) {
+                midi.tempoUsPerQuarter = ((uint32_t)body[0] << 16) | ((uint32_t)body[1] << 8) | body[2];
+            }
+            break;
+        case 0x58:  /* time signature: numerator, log2(denominator), ... */
+            if (!midi.haveTimeSig && len >= 2U && body[1] <= 5U) {
+                midi.beatsPerBar = body[0];
+                midi.beatUnit = (uint8_t)(1U << body[1]);
+                midi.haveTimeSig = true;
+            }
+            break;
+        case 0x59:  /* key signature: sharps (<0 = flats), major/minor */
+            if (!midi.haveKeySig && len >= 1U) {
+                midi.keySharps = (int8_t)body[0];
+                midi.haveKeySig = true;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static bool ParseTrack(Reader *r)
+{
+    uint32_t tick = 0;
+    uint8_t status = 0;
+    uint32_t onTick[16][128];
+    bool on[16][128];
+
+    memset(on, 0, sizeof(on));
+
+    while (r->p < r->end && !r->error)
+    {
+        tick += ReadVlq(r);
+
+        uint8_t b = ReadByte(r);
+        if (b & 0x80U) {
+            /* Meta / SysEx events cancel running status */
+            if (b >= 0xF0U) status = 0;
+            else status = b;
+        } else {
+            if (status == 0U) return false;   /* data byte without status */
+            r->p--;                           /* running status */
+            b = status;
+        }
+
+        if (b == 0xFFU)
+        {
+            uint8_t type = ReadByte(r);
+            uint32_t len = ReadVlq(r);
+            if (type == 0x2FU) break;         /* end of track */
+            ParseMeta(r, type, len);
+            continue;
+        }
+        if (b == 0xF0U || b == 0xF7U)
+        {
+            Skip(r, ReadVlq(r));
+            continue;
+        }
+        if (b >= 0xF0U) return false;         /* system common / realtime: not valid in files */
+
+        uint8_t channel = b & 0x0FU;
+        uint8_t kind = b & 0xF0U;
+        uint8_t d1 = ReadByte(r) & 0x7FU;
+        uint8_t d2 = (kind == 0xC0U || kind == 0xD0U) ? 0U : (ReadByte(r) & 0x7FU);
+
+        if (channel == DRUM_CHANNEL) continue;
+
+        if (kind == 0x90U && d2 > 0U)
+        {
+            if (on[channel][d1]) AddNote(onTick[channel][d1], tick, d1);   /* re-strike */
+            on[channel][d1] = true;
+            onTick[channel][d1] = tick;
+        }
+        else if (kind == 0x80U || kind == 0x90U)
+        {
+            if (on[channel][d1]) AddNote(onTick[channel][d1], tick, d1);
+            on[channel][d1] = false;
+        }
+    }
+
+    /* Notes still held at the end of the track end there */
+    for (uint8_t c = 0; c < 16U; c++) {
+        for (uint8_t n = 0; n < 128U; n++) {
+            if (on[c][n]) AddNote(onTick[c][n], tick, n);
+        }
+    }
+    return !r->error;
+}
+
+static bool ParseFile(const uint8_t *buf, size_t size)
+{
+    Reader r = { buf, buf + size, false };
+
+    if (size < 14U || memcmp(buf, "MThd", 4) != 0) {
+        fprintf(stderr, "not a MIDI file\n");
+        return false;
+    }
+    Skip(&r, 4);
+    uint32_t headerLen = ReadBE(&r, 4);
+    uint16_t format = (uint16_t)ReadBE(&r, 2);
+    uint16_t tracks = (uint16_t)ReadBE(&r, 2);
+    midi.division = (uint16_t)ReadBE(&r, 2);
+    Skip(&r, headerLen - 6U);
+
+    if (format > 1U) {
+        fprintf(stderr, "SMF format %u not supported\n", (unsigned)format);
+        return false;
+    }
+    if ((midi.division & 0x8000U) != 0U || midi.division == 0U) {
+        fprintf(stderr, "SMPTE time division not supported\n");
+        return false;
+    }
+
+    for (uint16_t t = 0; t < tracks && !r.error; t++)
+    {
+        if ((size_t)(r.end - r.p) < 8U) break;
+        bool isTrack = memcmp(r.p, "MTrk", 4) == 0;
+        Skip(&r, 4);
+        uint32_t len = ReadBE(&r, 4);
+        if ((uint32_t)(r.end - r.p) < len) {
+            fprintf(stderr, "truncated track %u\n", (unsigned)t);
+            return false;
+        }
+        if (!isTrack) {   /* unknown chunk */
+            Skip(&r, len);
+            t--;
+            continue;
+        }
+
+        Reader track = { r.p, r.p + len, false };
+        if (!ParseTrack(&track)) {
+            fprintf(stderr, "bad event data in track %u\n", (unsigned)t);
+            return false;
+        }
+        Skip(&r, len);
+    }
+    return !r.error;
+}
+
+/* --- Packing --- */
+
+static int CompareNotes(const void *a, const void *b)
+{
+    const MidiNote *x = a;
+    const MidiNote *y = b;
+    if (x->onset != y->onset) return (x->onset < y->onset) ? -1 : 1;
+    return (int)x->pitch - (int)y->pitch;
+}
+
+/*
+ * Rescale to SONG_PPQ, snap onsets to the grid, drop duplicates, and shorten
+ * silences longer than the rests of one step can bridge by whole bars.
+ */
+static void Quantize(uint32_t barTicks)
+{
+    uint32_t out = 0;
+    uint32_t grid = SONG_PACK_GRID_TICKS;
+
+    for (uint32_t i = 0; i < midi.noteCount; i++)
+    {
+        MidiNote *n = &midi.notes[i];
+        uint32_t onset = (n->onset * SONG_PPQ + midi.division / 2U) / midi.division;
+        n->onset = (onset + grid / 2U) / grid * grid;
+        n->duration = (n->duration * SONG_PPQ + midi.division / 2U) / midi.division;
+        if (n->pitch == SONG_PACK_REST) continue;   /* MIDI note 0 cannot be stored */
+        midi.notes[out++] = *n;
+    }
+    midi.noteCount = out;
+
+    qsort(midi.notes, midi.noteCount, sizeof(MidiNote), CompareNotes);
+
+    out = 0;
+    for (uint32_t i = 0; i < midi.noteCount; i++)
+    {
+        if (out > 0U && midi.notes[out - 1U].onset == midi.notes[i].onset &&
+            midi.notes[out - 1U].pitch == midi.notes[i].pitch) continue;
+        midi.notes[out++] = midi.notes[i];
+    }
+    midi.noteCount = out;
+
+    /*
+     * Performed MIDI releases early (non-legato); a note sounding for most of
+     * the time to the next onset is written as lasting until it.
+     */
+    for (uint32_t i = 0; i < midi.noteCount; i++)
+    {
+        MidiNote *n = &midi.notes[i];
+        uint32_t k = i + 1U;
+        while (k < midi.noteCount && midi.notes[k].onset == n->onset) k++;
+        if (k >= midi.noteCount) continue;
+
+        uint32_t ioi = midi.notes[k].onset - n->onset;
+        if (n->duration < ioi && n->duration * 4U >= ioi * 3U) n->duration = ioi;
+    }
+
+    uint32_t maxGap = SONG_PACK_MAX_STEP_NOTES * SONG_PACK_MAX_DELTA * SONG_PACK_GRID_TICKS;
+    uint32_t cut = (barTicks < maxGap) ? barTicks : SONG_PACK_GRID_TICKS;
+    uint32_t shift = 0;
+    uint32_t prev = 0;
+
+    for (uint32_t i = 0; i < midi.noteCount; i++)
+    {
+        uint32_t onset = midi.notes[i].onset - shift;
+        while (onset - prev > maxGap) {
+            onset -= cut;
+            shift += cut;
+        }
+        midi.notes[i].onset = onset;
+        prev = onset;
+    }
+    if (shift > 0U) fprintf(stderr, "  long silences shortened by %u ticks\n", (unsigned)shift);
+}
+
+static void PutEntry(uint32_t countAt, uint8_t pitch, uint8_t dur, uint8_t delta)
+{
+    uint16_t e = SONG_PACK_ENTRY(pitch, dur, delta);
+    packed.data[packed.size++] = (uint8_t)(e & 0xFFU);
+    packed.data[packed.size++] = (uint8_t)(e >> 8);
+    packed.data[countAt]++;
+}
+
+static void Pack(uint32_t barTicks)
+{
+    uint32_t prevOnset = 0;
+    uint32_t countAt = 0;
+    uint8_t stepNotes = 0;
+    uint8_t stepEntries = 0;
+    uint32_t stepBar = 0;
+    bool open = false;
+
+    memset(&packed, 0, sizeof(packed));
+
+    for (uint32_t i = 0; i < midi.noteCount; i++)
+    {
+        const MidiNote *n = &midi.notes[i];
+        uint32_t gapUnits = (n->onset - prevOnset) / SONG_PACK_GRID_TICKS;
+        uint32_t rests = (gapUnits > 0U) ? (gapUnits - 1U) / SONG_PACK_MAX_DELTA : 0U;
+
+        if (n->onset > UINT16_MAX) {
+            fprintf(stderr, "  song longer than %u ticks, cut\n", (unsigned)UINT16_MAX);
+            break;
+        }
+
+        /* New step at a bar line, when full, or when the rests would not fit */
+        bool newStep = !open || (n->onset / barTicks) != stepBar || stepNotes >= maxStepNotes ||
+                       stepEntries + rests + 1U > SONG_PACK_MAX_STEP_NOTES;
+        /* ...but keep notes starting together in one step */
+        if (open && gapUnits == 0U && stepEntries < SONG_PACK_MAX_STEP_NOTES) newStep = false;
+
+        if (newStep)
+        {
+            if (packed.stepCount >= MAX_STEPS) {
+                fprintf(stderr, "  more than %u steps, cut\n", (unsigned)MAX_STEPS);
+                break;
+            }
+            countAt = packed.size++;
+            packed.stepCount++;
+            stepNotes = 0;
+            stepEntries = 0;
+            stepBar = n->onset / barTicks;
+            open = true;
+        }
+
+        /* Gaps longer than one delta: rests, each moving time forward */
+        while (gapUnits > SONG_PACK_MAX_DELTA) {
+            PutEntry(countAt, SONG_PACK_REST, 0, SONG_PACK_MAX_DELTA);
+            gapUnits -= SONG_PACK_MAX_DELTA;
+            stepEntries++;
+            packed.restCount++;
+        }
+
+        uint32_t duration = (n->duration > 0U) ? n->duration : SONG_PACK_GRID_TICKS;
+        PutEntry(countAt, n->pitch, SongPack_DurationCode(duration), (uint8_t)gapUnits);
+        stepEntries++;
+        stepNotes++;
+        packed.noteCount++;
+        prevOnset = n->onset;
+    }
+}
+
+/* --- Compression (--lz, format in song_lz.h) --- */
+
+typedef struct {
+    uint8_t raw[SONG_LZ_BLOCK_MAX];
+    uint32_t rawLen;
+    uint8_t firstStep;
+    uint16_t startTick;
+} LzBlock;
+
+static LzBlock lzBlocks[MAX_STEPS];
+static uint8_t lzData[65535];
+static uint32_t lzSize;
+
+static void PutVlq(uint8_t *out, uint32_t *n, uint32_t v)
+{
+    uint8_t groups = 1;
+    while (groups < 5U && (v >> (7U * groups)) != 0U) groups++;
+    while (groups-- > 0U) {
+        out[(*n)++] = (uint8_t)(((v >> (7U * groups)) & 0x7FU) | ((groups > 0U) ? 0x80U : 0U));
+    }
+}
+
+/* Tokens of one step, continuing from pitch / tick; returns the length. */
+static uint32_t StepTokens(const SongStep *step, uint8_t *pitch, uint32_t *tick, uint8_t *out)
+{
+    uint32_t n = 0;
+
+    out[n++] = step->noteCount;
+    for (uint8_t i = 0; i < step->noteCount; i++)
+    {
+        const NoteEntry *note = &step->notes[i];
+        int32_t dp = (int32_t)note->midiNote - (int32_t)*pitch;
+        uint32_t delta = (note->onsetTick - *tick) / SONG_PACK_GRID_TICKS;
+
+        PutVlq(out, &n, (uint32_t)((dp << 1) ^ (dp >> 31)));
+        out[n++] = (uint8_t)((SongPack_DurationCode(note->durationTicks) << 4) | ((delta < 15U) ? delta : 15U));
+        if (delta >= 15U) PutVlq(out, &n, delta - 15U);
+
+        *pitch = (uint8_t)note->midiNote;
+        *tick = note->onsetTick;
+    }
+    return n;
+}
+
+/* Greedy LZSS over one block (matches stay inside the block). */
+static uint32_t Deflate(const uint8_t *src, uint32_t len, uint8_t *dst)
+{
+    uint32_t in = 0;
+    uint32_t out = 0;
+    uint32_t flagAt = 0;
+    uint8_t items = 8;
+
+    while (in < len)
+    {
+        if (items == 8U) {
+            flagAt = out;
+            dst[out++] = 0;
+            items = 0;
+        }
+
+        uint32_t bestLen = 0;
+        uint32_t bestDist = 0;
+        for (uint32_t dist = 1; dist <= 256U && dist <= in; dist++)
+        {
+            uint32_t l = 0;
+            while (in + l < len && l < SONG_LZ_MAX_MATCH && src[in + l] == src[in + l - dist]) l++;
+            if (l > bestLen) {
+                bestLen = l;
+                bestDist = dist;
+            }
+        }
+
+        if (bestLen >= SONG_LZ_MIN_MATCH) {
+            dst[flagAt] |= (uint8_t)(1U << items);
+            dst[out++] = (uint8_t)(bestDist - 1U);
+            dst[out++] = (uint8_t)(bestLen - SONG_LZ_MIN_MATCH);
+            in += bestLen;
+        } else {
+            dst[out++] = src[in++];
+        }
+        items++;
+    }
+    return out;
+}
+
+/* Compress a song's steps into lzData; false if it does not fit the format. */
+static bool CompressSong(const Song *song)
+{
+    uint32_t blocks = 0;
+    uint8_t pitch = SONG_LZ_BASE_PITCH;
+    uint32_t tick = 0;
+    LzBlock *b = NULL;
+
+    for (uint8_t i = 0; i < song->stepCount; i++)
+    {
+        const SongStep *step = Song_Step(song, i);
+        uint8_t tokens[64];
+        uint8_t p = pitch;
+        uint32_t t = tick;
+        uint32_t n = (step != NULL && b != NULL) ? StepTokens(step, &p, &t, tokens) : 0U;
+
+        if (step == NULL) return false;
+
+        /* New block when full (its tokens restart from the base pitch) */
+        if (b == NULL || (uint32_t)(i - b->firstStep) >= SONG_LZ_BLOCK_STEPS || b->rawLen + n > SONG_LZ_BLOCK_MAX)
+        {
+            b = &lzBlocks[blocks++];
+            b->rawLen = 0;
+            b->firstStep = i;
+            b->startTick = (uint16_t)tick;
+            p = SONG_LZ_BASE_PITCH;
+            t = tick;
+            n = StepTokens(step, &p, &t, tokens);
+        }
+        memcpy(&b->raw[b->rawLen], tokens, n);
+        b->rawLen += n;
+        pitch = p;
+        tick = t;
+    }
+
+    lzSize = 1U + SONG_LZ_INDEX_ENTRY * blocks;
+    lzData[0] = (uint8_t)blocks;
+    for (uint32_t k = 0; k < blocks; k++)
+    {
+        uint8_t *entry = &lzData[1U + SONG_LZ_INDEX_ENTRY * k];
+        if (lzSize + 2U * SONG_LZ_BLOCK_MAX > sizeof(lzData)) return false;
+
+        entry[0] = (uint8_t)(lzSize & 0xFFU);
+        entry[1] = (uint8_t)(lzSize >> 8);
+        entry[2] = (uint8_t)(lzBlocks[k].startTick & 0xFFU);
+        entry[3] = (uint8_t)(lzBlocks[k].startTick >> 8);
+        entry[4] = lzBlocks[k].firstStep;
+
+        lzData[lzSize++] = (uint8_t)(lzBlocks[k].rawLen - 1U);
+        lzSize += Deflate(lzBlocks[k].raw, lzBlocks[k].rawLen, &lzData[lzSize]);
+    }
+    return lzSize <= UINT16_MAX;
+}
+
+/* Both songs give the same steps (through the target's decoders). */
+static bool SameSteps(const Song *a, const Song *b)
+{
+    for (uint8_t i = 0; i < a->stepCount; i++)
+    {
+        const SongStep *x = Song_Step(a, i);
+        const SongStep *y = Song_Step(b, i);
+        if (x == NULL || y == NULL || x->noteCount != y->noteCount) return false;
+
+        for (uint8_t k = 0; k < x->noteCount; k++)
+        {
+            const NoteEntry *m = &x->notes[k];
+            const NoteEntry *n = &y->notes[k];
+            if (m->letter != n->letter || m->accidental != n->accidental || m->midiNote != n->midiNote ||
+                m->lengthIcon != n->lengthIcon || m->onsetTick != n->onsetTick ||
+                m->durationTicks != n->durationTicks) return false;
+        }
+    }
+    return true;
+}
+
+/* --- Output --- */
+
+static void EmitBytes(const char *name, const uint8_t *data, uint32_t size)
+{
+    printf("static const uint8_t %s[%u] = {", name, (unsigned)size);
+    for (uint32_t i = 0; i < size; i++) {
+        printf("%s0x%02X,", (i % 12U == 0U) ? "\n    " : " ", data[i]);
+    }
+    printf("\n};\n\n");
+}
+
+static void EmitMasks(const char *name, const Song *song)
+{
+    printf("static const NoteMask128_t %s[%u] = {\n", name, (unsigned)song->stepCount);
+    for (uint8_t i = 0; i < song->stepCount; i++)
+    {
+        const SongStep *step = Song_Step(song, i);
+        NoteMask128_t m;
+        NoteMask_Clear(&m);
+        for (uint8_t k = 0; step != NULL && k < step->noteCount; k++) {
+            NoteMask_Set(&m, (uint8_t)step->notes[k].midiNote);
+        }
+        printf("    { { 0x%08lXUL, 0x%08lXUL, 0x%08lXUL, 0x%08lXUL } },\n",
+               (unsigned long)m.w[0], (unsigned long)m.w[1], (unsigned long)m.w[2], (unsigned long)m.w[3]);
+    }
+    printf("};\n\n");
+}
+
+static void EmitFrames(const char *name, const Song *song)
+{
+    printf("static const LessonFrame_t %s[%u] = {\n", name, (unsigned)song->stepCount);
+    for (uint8_t i = 0; i < song->stepCount; i++)
+    {
+        LessonFrame_t f;
+        LessonRender_SongStep(Song_Step(song, i), i, song->stepCount, &f);
+
+        printf("    { {\n");
+        for (uint8_t row = 0; row < LESSON_FRAME_ROWS; row++)
+        {
+            printf("        {");
+            for (uint8_t col = 0; col < LESSON_FRAME_COLS; col++) {
+                printf("%s0x%02X", (col == 0) ? " " : ", ", f.cells[row][col]);
+            }
+            printf(" },\n");
+        }
+        printf("      }, 0x%08lXUL },\n", (unsigned long)f.glyphs);
+    }
+    printf("};\n\n");
+}
+
+/* Title as a C string literal (quotes, backslashes and non-ASCII dropped). */
+static void PrintTitle(const char *s)
+{
+    putchar('"');
+    for (; *s != '\0'; s++) {
+        if (*s >= 0x20 && *s < 0x7F && *s != '"' && *s != '\\') putchar(*s);
+    }
+    putchar('"');
+}
+
+static void TitleFromPath(const char *path, char *out)
+{
+    const char *base = strrchr(path, '/');
+    base = (base != NULL) ? base + 1 : path;
+
+    size_t n = 0;
+    for (; base[n] != '\0' && base[n] != '.' && n < MAX_TITLE - 1U; n++) {
+        out[n] = (base[n] == '_') ? ' ' : base[n];
+    }
+    out[n] = '\0';
+}
+
+typedef struct {
+    char title[MAX_TITLE];
+    uint8_t stepCount;
+    uint16_t tempoBpm;
+    uint8_t beatsPerBar;
+    uint8_t beatUnit;
+} LibraryEntry;
+
+int main(int argc, char **argv)
+{
+    LibraryEntry entries[64];
+    unsigned count = 0;
+    unsigned long totalPacked = 0;
+    unsigned long totalArrays = 0;
+
+    printf("#include \"song_library.h\"\n\n");
+    printf("/*\n");
+    printf(" * song_library.c\n");
+    printf(" *\n");
+    printf(" * GENERATED by Tools/midi2song.c - do not edit.\n");
+    printf(" *\n");
+    printf(" * Songs compiled from MIDI files, in the packed format of song_pack.h.\n");
+    printf(" */\n\n");
+
+    for (int a = 1; a < argc; a++)
+    {
+        if (strcmp(argv[a], "--masks") == 0)  { emitMasks = true; continue; }
+        if (strcmp(argv[a], "--frames") == 0) { emitFrames = true; continue; }
+        if (strcmp(argv[a], "--flats") == 0)  { forceFlats = true; continue; }
+        if (strcmp(argv[a], "--smf") == 0)    { embedSmf = true; continue; }
+        if (strcmp(argv[a], "--lz") == 0)     { compressLz = true; continue; }
+        if (strcmp(argv[a], "--max-notes") == 0 && a + 1 < argc) {
+            int n = atoi(argv[++a]);
+            maxStepNotes = (uint8_t)((n < 1) ? 1 : (n > (int)SONG_PACK_MAX_STEP_NOTES) ? (int)SONG_PACK_MAX_STEP_NOTES : n);
+            continue;
+        }
+        if (argv[a][0] == '-') {
+            fprintf(stderr, "unknown option %s\n", argv[a]);
+            return 1;
+        }
+        if (count >= sizeof(entries) / sizeof(entries[0])) {
+            fprintf(stderr, "too many songs\n");
+            return 1;
+        }
+
+        FILE *f = fopen(argv[a], "rb");
+        if (f == NULL) {
+            perror(argv[a]);
+            return 1;
+        }
+        static uint8_t buf[1U << 20];
+        size_t size = fread(buf, 1, sizeof(buf), f);
+        fclose(f);
+
+        memset(&midi, 0, sizeof(midi));
+        fprintf(stderr, "%s\n", argv[a]);
+        if (!ParseFile(buf, size)) return 1;
+        if (midi.noteCount >= MAX_NOTES) fprintf(stderr, "  more than %u notes, cut\n", (unsigned)MAX_NOTES);
+
+        LibraryEntry *e = &entries[count];
+        if (midi.title[0] != '\0') memcpy(e->title, midi.title, MAX_TITLE);
+        else TitleFromPath(argv[a], e->title);
+        e->tempoBpm = (midi.tempoUsPerQuarter != 0U) ? (uint16_t)((60000000UL + midi.tempoUsPerQuarter / 2U) / midi.tempoUsPerQuarter) : 0U;
+        e->beatsPerBar = midi.haveTimeSig ? midi.beatsPerBar : 4U;
+        e->beatUnit = midi.haveTimeSig ? midi.beatUnit : 4U;
+
+        uint32_t barTicks = (uint32_t)SONG_PPQ * 4U * e->beatsPerBar / e->beatUnit;
+        Quantize(barTicks);
+        Pack(barTicks);
+        e->stepCount = packed.stepCount;
+
+        if (packed.stepCount == 0U) {
+            fprintf(stderr, "  no notes, skipped\n");
+            continue;
+        }
+
+        /* The song as the firmware will see it (masks / frames are decoded from the data) */
+        PackedSong body = { packed.data, (uint16_t)packed.size, packed.noteCount,
+                            (forceFlats || midi.keySharps < 0) ? SONG_PACK_FLATS : 0U, NULL, NULL };
+        Song song = { e->title, packed.stepCount, NULL, e->tempoBpm, e->beatsPerBar, e->beatUnit, &body };
+        const uint8_t *data = packed.data;
+        uint32_t dataSize = packed.size;
+        char name[32];
+
+        if (embedSmf)
+        {
+            /* The file itself, opened the way the target does */
+            if (!SongPack_OpenSmf(&song, &body, buf, (uint32_t)size, e->title)) {
+                fprintf(stderr, "  cannot be read as a song on the target (larger than 64 KiB?)\n");
+                return 1;
+            }
+            if (forceFlats) body.flags |= SONG_PACK_FLATS;
+            data = buf;
+            dataSize = (uint32_t)size;
+            e->stepCount = song.stepCount;
+            e->tempoBpm = song.tempoBpm;
+            e->beatsPerBar = song.beatsPerBar;
+            e->beatUnit = song.beatUnit;
+        }
+        else if (compressLz)
+        {
+            static PackedSong lzBody;
+            Song lzSong = song;
+
+            if (!CompressSong(&song)) {
+                fprintf(stderr, "  too large to compress\n");
+                return 1;
+            }
+            lzBody = body;
+            lzBody.data = lzData;
+            lzBody.size = (uint16_t)lzSize;
+            lzBody.flags |= SONG_PACK_LZ;
+            lzSong.packed = &lzBody;
+            if (!SameSteps(&song, &lzSong)) {
+                fprintf(stderr, "  compressed steps differ from the packed ones\n");
+                return 1;
+            }
+            fprintf(stderr, "  packed %u bytes -> compressed %u bytes (%u blocks)\n", (unsigned)packed.size,
+                    (unsigned)lzSize, (unsigned)lzData[0]);
+            body = lzBody;
+            data = lzData;
+            dataSize = lzSize;
+        }
+
+        printf("/* ");
+        PrintTitle(e->title);
+        printf(": %u steps, %u notes, %u/%u, %u bpm%s */\n", (unsigned)song.stepCount, (unsigned)body.noteCount,
+               (unsigned)e->beatsPerBar, (unsigned)e->beatUnit, (unsigned)e->tempoBpm, embedSmf ? ", MIDI file" : "");
+        snprintf(name, sizeof(name), "song%uData", count);
+        EmitBytes(name, data, dataSize);
+        if (emitMasks) {
+            snprintf(name, sizeof(name), "song%uMasks", count);
+            EmitMasks(name, &song);
+        }
+        if (emitFrames) {
+            snprintf(name, sizeof(name), "song%uFrames", count);
+            EmitFrames(name, &song);
+        }
+        printf("static const PackedSong song%uBody = {\n", count);
+        printf("    song%uData, sizeof(song%uData), %u, 0x%02X,\n", count, count, (unsigned)body.noteCount, (unsigned)body.flags);
+        printf("    %s, ", emitMasks ? (snprintf(name, sizeof(name), "song%uMasks", count), name) : "NULL");
+        printf("%s\n", emitFrames ? (snprintf(name, sizeof(name), "song%uFrames", count), name) : "NULL");
+        printf("};\n\n");
+
+        /* Size report: packed stream + extras vs. the same song as NoteEntry / SongStep arrays */
+        unsigned long extras = (emitMasks ? song.stepCount * sizeof(NoteMask128_t) : 0U) +
+                               (emitFrames ? song.stepCount * sizeof(LessonFrame_t) : 0U);
+        unsigned long arrays = body.noteCount * sizeof(NoteEntry) + song.stepCount * sizeof(SongStep);
+        fprintf(stderr, "  %u steps, %u notes, %u rests: %u bytes (%.2f bytes/note)", (unsigned)song.stepCount,
+                (unsigned)body.noteCount, embedSmf ? 0U : (unsigned)packed.restCount, (unsigned)dataSize,
+                (double)dataSize / body.noteCount);
+        if (extras > 0U) fprintf(stderr, " + %lu bytes masks/frames", extras);
+        fprintf(stderr, "; as NoteEntry/SongStep arrays: %lu bytes\n", arrays);
+        totalPacked += dataSize + extras;
+        totalArrays += arrays;
+        count++;
+    }
+
+    printf("const Song librarySongs[] = {\n");
+    for (unsigned s = 0; s < count; s++)
+    {
+        printf("    { ");
+        PrintTitle(entries[s].title);
+        printf(", %u, NULL, %u, %u, %u, &song%uBody },\n", (unsigned)entries[s].stepCount, (unsigned)entries[s].tempoBpm,
+               (unsigned)entries[s].beatsPerBar, (unsigned)entries[s].beatUnit, s);
+    }
+    if (count == 0U) printf("    { \"\", 0, NULL, 0, 0, 0, NULL }   /* empty library */\n");
+    printf("};\n\n");
+    printf("const uint8_t LIBRARY_SONG_COUNT = %u;\n", count);
+
+    fprintf(stderr, "%u songs: %lu bytes packed, %lu bytes as arrays\n", count, totalPacked, totalArrays);
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*
+ * note_parse_bench.c
+ *
+ * Host micro-benchmark for the runtime note name parser: times
+ * NoteName_ToMidi() (table-driven, notes.c) against the previous
+ * implementation (uppercase copy + strcmp chain, kept below as
+ * Legacy_ToMidi) on the same inputs, and counts the inputs on which the two
+ * disagree (listing those in octave 4).
+ *
+ * Build and run from the project directory (SN_Keyboard_Assistant):
+ *
+ *   gcc -std=c11 -O2 -Wall -ICore/Inc \
+ *       Tools/note_parse_bench.c Core/Src/notes.c \
+ *       -o note_parse_bench && ./note_parse_bench [rounds]
+ *
+ * Inputs: every letter C..H with the accidentals "", #, b, is, es, s in
+ * upper and lower case over octaves 0..9, plus malformed names. The times
+ * are host nanoseconds per call; on the Cortex-M4 both scale roughly with
+ * the number of compared characters.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "notes.h"
+
+/* ---- Previous parser (strcmp chain), unchanged ---- */
+
+static int8_t Legacy_MapRootToSemitone(const char *root)
+{
+    if (root == NULL || *root == '\0') return -1;
+
+    if (strcmp(root, "C") == 0) return 0;
+    if (strcmp(root, "D") == 0) return 2;
+    if (strcmp(root, "E") == 0) return 4;
+    if (strcmp(root, "F") == 0) return 5;
+    if (strcmp(root, "G") == 0) return 7;
+    if (strcmp(root, "A") == 0) return 9;
+    if (strcmp(root, "B") == 0) return 11;
+    if (strcmp(root, "H") == 0) return 11;
+
+    if (strlen(root) == 2)
+    {
+        int8_t baseSemi;
+        switch (root[0])
+        {
+            case 'C': baseSemi = 0;  break;
+            case 'D': baseSemi = 2;  break;
+            case 'E': baseSemi = 4;  break;
+            case 'F': baseSemi = 5;  break;
+            case 'G': baseSemi = 7;  break;
+            case 'A': baseSemi = 9;  break;
+            case 'B': baseSemi = 11; break;
+            case 'H': baseSemi = 11; break;
+            default:  baseSemi = -1; break;
+        }
+        if (baseSemi < 0) return -1;
+        if (root[1] == '#') return (int8_t)((baseSemi + 1) % 12);
+        if (root[1] == 'B') return (int8_t)((baseSemi + 11) % 12);
+    }
+
+    if (strcmp(root, "CIS") == 0 || strcmp(root, "DES") == 0)  return 1;
+    if (strcmp(root, "DIS") == 0 || strcmp(root, "ES")  == 0)  return 3;
+    if (strcmp(root, "FIS") == 0 || strcmp(root, "GES") == 0)  return 6;
+    if (strcmp(root, "GIS") == 0 || strcmp(root, "AS")  == 0)  return 8;
+    if (strcmp(root, "AIS") == 0 || strcmp(root, "BES") == 0 || strcmp(root, "HES") == 0) return 10;
+    return -1;
+}
+
+static NoteParseStatus Legacy_ToMidi(const char *name, uint8_t *outNote)
+{
+    if (name == NULL || outNote == NULL) return NOTE_ERR_INVALID_FORMAT;
+
+    char temp[8];
+    size_t len = strlen(name);
+    if (len < 2 || len >= sizeof(temp)) return NOTE_ERR_INVALID_FORMAT;
+    for (size_t i = 0; i < len; ++i) temp[i] = (char)toupper((unsigned char)name[i]);
+    temp[len] = '\0';
+
+    char octaveChar = temp[len - 1];
+    if (octaveChar < '0' || octaveChar > '9') return NOTE_ERR_INVALID_FORMAT;
+    int octave = octaveChar - '0';
+
+    temp[len - 1] = '\0';
+    int8_t semitone = Legacy_MapRootToSemitone(temp);
+    if (semitone < 0) return NOTE_ERR_INVALID_NOTE;
+
+    int midi = 12 * (octave + 1) + semitone;
+    if (midi > 127) return NOTE_ERR_INVALID_OCTAVE;
+    *outNote = (uint8_t)midi;
+    return NOTE_OK;
+}
+
+/* ---- Inputs ---- */
+
+#define MAX_INPUTS  (1200U)
+
+static char inputs[MAX_INPUTS][8];
+static size_t inputCount;
+
+static void AddInput(const char *s)
+{
+    if (inputCount < MAX_INPUTS) {
+        snprintf(inputs[inputCount], sizeof(inputs[0]), "%s", s);
+        inputCount++;
+    }
+}
+
+static void BuildInputs(void)
+{
+    static const char *const accidentals[] = { "", "#", "b", "is", "es", "s" };
+    static const char *const malformed[] = {
+        "", "C", "C#", "X4", "c10", "CX4", "CISS4", "C#b4", "4C", "Hb", "  C4", "Cis-1"
+    };
+
+    for (const char *l = "CDEFGABH"; *l != '\0'; l++)
+    {
+        for (size_t a = 0; a < sizeof(accidentals) / sizeof(accidentals[0]); a++)
+        {
+            for (int octave = 0; octave <= 9; octave++)
+            {
+                char s[8];
+                snprintf(s, sizeof(s), "%c%s%d", *l, accidentals[a], octave);
+                AddInput(s);
+                s[0] = (char)tolower((unsigned char)s[0]);
+                AddInput(s);
+            }
+        }
+    }
+    for (size_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++) {
+        AddInput(malformed[i]);
+    }
+}
+
+typedef NoteParseStatus (*ParseFn)(const char *name, uint8_t *outNote);
+
+/* Nanoseconds per call over all inputs, `rounds` times. */
+static double TimeParser(ParseFn parse, unsigned rounds)
+{
+    volatile unsigned sink = 0;
+    clock_t start = clock();
+    for (unsigned r = 0; r < rounds; r++)
+    {
+        for (size_t i = 0; i < inputCount; i++)
+        {
+            uint8_t midi = 0;
+            sink += (unsigned)parse(inputs[i], &midi) + midi;
+        }
+    }
+    clock_t end = clock();
+    (void)sink;
+    return (double)(end - start) * 1e9 / CLOCKS_PER_SEC / ((double)rounds * (double)inputCount);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned rounds = (argc > 1) ? (unsigned)strtoul(argv[1], NULL, 10) : 2000U;
+    unsigned valid = 0;
+    unsigned differ = 0;
+
+    BuildInputs();
+
+    printf("Inputs where the parsers differ, octave 4 (name: legacy -> table):\n");
+    for (size_t i = 0; i < inputCount; i++)
+    {
+        uint8_t a = 0;
+        uint8_t b = 0;
+        NoteParseStatus sa = Legacy_ToMidi(inputs[i], &a);
+        NoteParseStatus sb = NoteName_ToMidi(inputs[i], &b);
+        if (sb == NOTE_OK) valid++;
+        if (sa != sb || (sa == NOTE_OK && a != b))
+        {
+            differ++;
+            size_t len = strlen(inputs[i]);
+            if (len == 0 || inputs[i][len - 1] != '4' || islower((unsigned char)inputs[i][0])) continue;
+            printf("  %-6s: ", inputs[i]);
+            if (sa == NOTE_OK) printf("%3u", a); else printf("err%u", (unsigned)sa);
+            printf(" -> ");
+            if (sb == NOTE_OK) printf("%3u\n", b); else printf("err%u\n", (unsigned)sb);
+        }
+    }
+    printf("%zu inputs, %u valid, %u differ\n\n", inputCount, valid, differ);
+
+    double legacyNs = TimeParser(Legacy_ToMidi, rounds);
+    double tableNs = TimeParser(NoteName_ToMidi, rounds);
+    printf("strcmp chain : %6.1f ns/call\n", legacyNs);
+    printf("table-driven : %6.1f ns/call  (%.1fx)\n", tableNs, legacyNs / tableNs);
+    return 0;
+}
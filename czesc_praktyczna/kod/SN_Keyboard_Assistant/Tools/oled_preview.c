@@ -0,0 +1,162 @@
+/*
+ * oled_preview.c
+ *
+ * Host preview of the OLED lesson screens: draws every step of the built-in
+ * songs and chord packs the way the firmware does (text rows from the
+ * lesson renderer, staff from oled_staff.c), saves each frame as a PBM image
+ * and prints what the incremental flush would send for it.
+ *
+ * Build and run from the project directory (SN_Keyboard_Assistant):
+ *
+ *   gcc -std=c11 -Wall -DDISPLAY_HOST_BUILD -ICore/Inc \
+ *       Tools/oled_preview.c Core/Src/oled_gfx.c Core/Src/oled_staff.c \
+ *       Core/Src/lesson_render.c Core/Src/lcd_framebuffer.c \
+ *       Core/Src/display_virtual.c Core/Src/glyphs.c \
+ *       Core/Src/songs.c Core/Src/song_pack.c Core/Src/song_lz.c \
+ *       Core/Src/smf_reader.c Core/Src/song_text.c Core/Src/notes.c \
+ *       Core/Src/chords.c \
+ *       -o oled_preview && ./oled_preview [output-dir]
+ *
+ * Images are written as <output-dir>/song<S>_step<N>.pbm and
+ * <output-dir>/chords<P>_step<N>.pbm (any image viewer opens PBM).
+ *
+ * Bus cost per changed page: address command (2 + 3 bytes) + data burst
+ * (2 + n bytes). At 100 kHz one byte takes 90 us.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "oled_gfx.h"
+#include "oled_staff.h"
+#include "lesson_render.h"
+#include "lcd_framebuffer.h"
+#include "display_virtual.h"
+
+#define TEXT_CELL_W   (8)
+
+static OledGfx_t gfx;
+static uint8_t shadow[OLED_PAGES][OLED_WIDTH];
+static DisplayVirtual_t panel;
+static Display_t display;
+
+/* Same cell placement as display_oled.c. */
+static void DrawTextRows(void)
+{
+    for (uint8_t row = 0; row < DISPLAY_VIRTUAL_ROWS; row++)
+    {
+        int16_t y = (row == 0U) ? 0 : (int16_t)(OLED_HEIGHT - OLED_FONT_H);
+        for (uint8_t col = 0; col < DISPLAY_VIRTUAL_COLS; col++)
+        {
+            uint8_t code = panel.ddram[row][col];
+            int16_t x = (int16_t)(col * TEXT_CELL_W + 1);
+            if (code < 8U) OledGfx_DrawPattern(&gfx, x, y, panel.cgram[code]);
+            else OledGfx_DrawChar(&gfx, x, y, (char)code);
+        }
+    }
+}
+
+static void ShowFrame(const LessonFrame_t *f)
+{
+    LcdFb_Load(f->cells, f->glyphs);
+    LcdFb_Flush();
+    DrawTextRows();
+}
+
+/* Takes the pending changes like Oled_Flush(); returns bytes on the wire. */
+static uint32_t FlushCost(uint32_t *pages)
+{
+    uint32_t bytes = 0;
+    *pages = 0;
+
+    for (uint8_t p = 0; p < OLED_PAGES; p++)
+    {
+        uint8_t lo, hi;
+        if (!OledGfx_TakeChanges(&gfx, shadow, p, &lo, &hi)) continue;
+        (*pages)++;
+        bytes += (2U + 3U) + (2U + (uint32_t)(hi - lo + 1U));
+    }
+    return bytes;
+}
+
+static int WritePbm(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) return -1;
+
+    fprintf(f, "P4\n%u %u\n", (unsigned)OLED_WIDTH, (unsigned)OLED_HEIGHT);
+    for (int16_t y = 0; y < (int16_t)OLED_HEIGHT; y++)
+    {
+        for (int16_t x = 0; x < (int16_t)OLED_WIDTH; x += 8)
+        {
+            uint8_t b = 0;
+            for (int16_t i = 0; i < 8; i++) {
+                if (OledGfx_GetPixel(&gfx, (int16_t)(x + i), y)) b |= (uint8_t)(0x80U >> i);
+            }
+            fputc(b, f);
+        }
+    }
+    return fclose(f);
+}
+
+static void Report(const char *name, const char *dir, uint32_t *total)
+{
+    char path[256];
+    uint32_t pages;
+    uint32_t bytes = FlushCost(&pages);
+
+    snprintf(path, sizeof(path), "%s/%s.pbm", dir, name);
+    if (WritePbm(path) != 0) fprintf(stderr, "cannot write %s\n", path);
+
+    printf("%-18s %5u %6u %7.2fms\n", name, (unsigned)pages, (unsigned)bytes, bytes * 0.09);
+    *total += bytes;
+}
+
+int main(int argc, char **argv)
+{
+    const char *dir = (argc > 1) ? argv[1] : ".";
+    uint32_t total = 0;
+    uint32_t steps = 0;
+    char name[32];
+
+    OledGfx_Init(&gfx);
+    DisplayVirtual_Init(&display, &panel);
+    LcdFb_Init(&display);
+
+    printf("%-18s %5s %6s %9s\n", "screen", "pages", "bytes", "time@100k");
+
+    for (uint8_t s = 0; s < SONG_COUNT; s++)
+    {
+        for (uint8_t i = 0; i < songs[s].stepCount; i++)
+        {
+            LessonFrame_t f;
+            LessonRender_SongStep(&songs[s].steps[i], i, songs[s].stepCount, &f);
+            ShowFrame(&f);
+            OledStaff_DrawSong(&gfx, &songs[s], i);
+
+            snprintf(name, sizeof(name), "song%u_step%u", (unsigned)s, (unsigned)i);
+            Report(name, dir, &total);
+            steps++;
+        }
+    }
+
+    for (uint8_t p = 0; p < CHORD_PACK_COUNT; p++)
+    {
+        for (uint8_t i = 0; i < chordPacks[p].chordCount; i++)
+        {
+            LessonFrame_t f;
+            LessonRender_ChordStep(&chordPacks[p].chords[i], i, chordPacks[p].chordCount, &f);
+            ShowFrame(&f);
+            OledStaff_DrawChords(&gfx, &chordPacks[p], i);
+
+            snprintf(name, sizeof(name), "chords%u_step%u", (unsigned)p, (unsigned)i);
+            Report(name, dir, &total);
+            steps++;
+        }
+    }
+
+    uint32_t full = OLED_PAGES * ((2U + 3U) + (2U + OLED_WIDTH));
+    printf("total: %u bytes for %u screens (full redraws: %u bytes)\n",
+           (unsigned)total, (unsigned)steps, (unsigned)(full * steps));
+    return 0;
+}
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""
+plot_latency.py
+
+Plot the latency histograms printed by Latency_Dump() (latency.c).
+
+Capture the SWV/ITM console (e.g. CubeIDE "SWV ITM Data Console" -> save,
+or openocd/pyocd SWO output) to a text file, press OK on the "Latency" screen
+to trigger a dump, then run:
+
+    python3 plot_latency.py swo_log.txt            # summary + interactive plot
+    python3 plot_latency.py swo_log.txt -o lat.png # summary + PNG file
+    python3 plot_latency.py swo_log.txt --no-plot  # summary only
+
+Each dump line looks like:
+    LAT <stage> hz=<cpu> n=<count> min=<cyc> max=<cyc> h=<b0>,<b1>,...,<b31>
+
+Bucket 0 holds 0 cycles, bucket i holds [2^(i-1), 2^i) cycles.
+If the log contains several dumps, the last one of each stage is used.
+"""
+
+import argparse
+import re
+import sys
+
+LINE_RE = re.compile(
+    r"LAT\s+(?P<stage>\S+)\s+hz=(?P<hz>\d+)\s+n=(?P<n>\d+)\s+"
+    r"min=(?P<min>\d+)\s+max=(?P<max>\d+)\s+h=(?P<h>[\d,]+)"
+)
+
+STAGE_ORDER = ["DEQ", "EVAL", "LED", "LCD"]
+
+
+def parse(stream):
+    stages = {}
+    for line in stream:
+        m = LINE_RE.search(line)
+        if not m:
+            continue
+        buckets = [int(x) for x in m.group("h").split(",") if x]
+        stages[m.group("stage")] = {
+            "hz": int(m.group("hz")),
+            "n": int(m.group("n")),
+            "min": int(m.group("min")),
+            "max": int(m.group("max")),
+            "buckets": buckets,
+        }
+    return stages
+
+
+def bucket_upper_cycles(i):
+    return 0 if i == 0 else (1 << i)
+
+
+def percentile_us(st, pct):
+    """Upper bucket edge of the given percentile, clamped to max (same rule as firmware)."""
+    if st["n"] == 0:
+        return 0.0
+    rank = -(-st["n"] * pct // 100)
+    seen = 0
+    edge = st["max"]
+    for i, c in enumerate(st["buckets"]):
+        seen += c
+        if seen >= rank:
+            edge = bucket_upper_cycles(i)
+            break
+    edge = min(edge, st["max"])
+    return edge * 1e6 / st["hz"]
+
+
+def print_summary(stages):
+    print("%-5s %8s %10s %10s %10s %10s" % ("stage", "n", "min[us]", "p50[us]", "p99[us]", "max[us]"))
+    for name in ordered(stages):
+        st = stages[name]
+        hz = st["hz"]
+        print("%-5s %8d %10.1f %10.1f %10.1f %10.1f" % (
+            name, st["n"], st["min"] * 1e6 / hz, percentile_us(st, 50),
+            percentile_us(st, 99), st["max"] * 1e6 / hz))
+
+
+def ordered(stages):
+    known = [s for s in STAGE_ORDER if s in stages]
+    return known + sorted(s for s in stages if s not in STAGE_ORDER)
+
+
+def plot(stages, out):
+    try:
+        import matplotlib
+    except ImportError:
+        sys.exit("matplotlib is required for plotting (pip install matplotlib), or use --no-plot")
+    if out:
+        matplotlib.use("Agg")
+    import matplotlib.pyplot as plt
+
+    names = ordered(stages)
+    fig, axes = plt.subplots(len(names), 1, figsize=(9, 2.4 * len(names)), sharex=True, squeeze=False)
+
+    for ax, name in zip(axes[:, 0], names):
+        st = stages[name]
+        hz = st["hz"]
+        # Label each bucket with its upper edge in microseconds.
+        edges_us = [bucket_upper_cycles(i) * 1e6 / hz for i in range(len(st["buckets"]))]
+        used = [i for i, c in enumerate(st["buckets"]) if c]
+        lo = max(0, (used[0] if used else 0) - 1)
+        hi = min(len(st["buckets"]), (used[-1] if used else 0) + 2)
+
+        xs = list(range(lo, hi))
+        ax.bar(xs, [st["buckets"][i] for i in xs], color="tab:blue")
+        ax.set_ylabel("%s\nn=%d" % (name, st["n"]))
+        ax.axvline(x=next((i for i in xs if edges_us[i] >= percentile_us(st, 99)), xs[-1]),
+                   color="tab:red", linestyle="--", linewidth=1, label="p99")
+        ax.legend(loc="upper right")
+        ax.set_xticks(xs)
+        ax.set_xticklabels(["<%.3g" % edges_us[i] for i in xs], rotation=45, fontsize=8)
+
+    axes[-1, 0].set_xlabel("latency since URB done [us] (log2 buckets)")
+    fig.tight_layout()
+
+    if out:
+        fig.savefig(out, dpi=120)
+        print("written", out)
+    else:
+        plt.show()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("log", nargs="?", help="captured SWO text (default: stdin)")
+    ap.add_argument("-o", "--out", help="write plot to this image file instead of showing it")
+    ap.add_argument("--no-plot", action="store_true", help="only print the summary table")
+    args = ap.parse_args()
+
+    if args.log:
+        with open(args.log, "r", errors="replace") as f:
+            stages = parse(f)
+    else:
+        stages = parse(sys.stdin)
+
+    if not stages:
+        sys.exit("no 'LAT ...' lines found")
+
+    print_summary(stages)
+    if not args.no_plot:
+        plot(stages, args.out)
+
+
+if __name__ == "__main__":
+    main()
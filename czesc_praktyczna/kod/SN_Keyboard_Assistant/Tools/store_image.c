@@ -0,0 +1,452 @@
+/*
+ * store_image.c
+ *
+ * Host side of the NOR content store (nor_store.h): builds and lists flash
+ * images for the external SPI NOR chip, and runs the store against a
+ * simulated chip with power cuts.
+ *
+ * The simulated chip behaves like NOR flash: programming ANDs the new bytes
+ * into the old ones (and counts attempts to turn a 0 back into a 1, which
+ * the store must never need), erase sets a segment to 0xFF. A power cut
+ * stops the chip after a given number of programmed bytes; an erase cut
+ * short leaves the segment with random contents.
+ *
+ * Commands:
+ *   pack IMAGE FILE...   new image with the files as items: .mid as
+ *                        NOR_STORE_SONG_SMF, .txt as NOR_STORE_SONG_TEXT
+ *                        (id and NOR_STORE_SONG_TITLE item as a USB stick
+ *                        import gives them, song_import.h), anything else
+ *                        as NOR_STORE_CHORD_PACK with ids 1, 2, ...
+ *   list IMAGE           mount the image, list the items, check their CRCs
+ *                        and read the songs in place (text: steps, SMF: events)
+ *   torture [OPS] [SEED] random writes and deletes on a small simulated chip,
+ *                        cutting the power at a random point in about one
+ *                        operation of 64; after each cut
+ *                        the store is mounted again and every item checked
+ *                        against a model (the item being written when the
+ *                        power went may be the old or the new version)
+ *
+ * Options (before the command):
+ *   --segment BYTES      erase segment (default 65536, the chip's 64 KB block)
+ *   --segments N         segments in the image (default 32)
+ *
+ * Build and run from the project directory (SN_Keyboard_Assistant):
+ *
+ *   gcc -std=c11 -Wall -Wextra -ICore/Inc \
+ *       Tools/store_image.c Core/Src/nor_store.c Core/Src/smf_reader.c \
+ *       Core/Src/song_text.c Core/Src/notes.c Core/Src/song_import.c \
+ *       Core/Src/fat_reader.c \
+ *       -o store_image && ./store_image torture
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nor_store.h"
+#include "smf_reader.h"
+#include "song_text.h"
+#include "song_import.h"
+
+/* ---- Simulated chip ---- */
+
+#define ERASE_COST  (64L)     /* power budget units per erase (1 per programmed byte) */
+
+typedef struct {
+    uint8_t *mem;
+    uint32_t segmentSize;
+    uint16_t segmentCount;
+    long budget;              /* units left before the power cut, -1 = no cut */
+    bool dead;                /* power is off until Chip_PowerOn() */
+    unsigned long overwrites; /* program attempts to set a 0 bit back to 1 */
+    unsigned long erases;
+} Chip;
+
+static bool Chip_Spend(Chip *c, long units)
+{
+    if (c->dead) return false;
+    if (c->budget < 0) return true;
+    if (c->budget < units) {
+        c->dead = true;
+        return false;
+    }
+    c->budget -= units;
+    return true;
+}
+
+static bool Chip_Read(void *ctx, uint32_t addr, uint8_t *buf, uint32_t len)
+{
+    Chip *c = ctx;
+    if (c->dead || addr + len > c->segmentSize * (uint32_t)c->segmentCount) return false;
+    memcpy(buf, &c->mem[addr], len);
+    return true;
+}
+
+static bool Chip_Program(void *ctx, uint32_t addr, const uint8_t *buf, uint32_t len)
+{
+    Chip *c = ctx;
+    if (addr + len > c->segmentSize * (uint32_t)c->segmentCount) return false;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if (!Chip_Spend(c, 1)) return false;
+        if ((buf[i] & ~c->mem[addr + i]) != 0U) c->overwrites++;
+        c->mem[addr + i] &= buf[i];
+    }
+    return true;
+}
+
+static bool Chip_Erase(void *ctx, uint32_t addr)
+{
+    Chip *c = ctx;
+    if (addr % c->segmentSize != 0U || addr >= c->segmentSize * (uint32_t)c->segmentCount) return false;
+    if (!Chip_Spend(c, ERASE_COST))
+    {
+        if (c->dead) {
+            for (uint32_t i = 0; i < c->segmentSize; i++) c->mem[addr + i] = (uint8_t)rand();
+        }
+        return false;
+    }
+    memset(&c->mem[addr], 0xFF, c->segmentSize);
+    c->erases++;
+    return true;
+}
+
+static void Chip_Init(Chip *c, uint32_t segmentSize, uint16_t segmentCount)
+{
+    memset(c, 0, sizeof(*c));
+    c->segmentSize = segmentSize;
+    c->segmentCount = segmentCount;
+    c->mem = malloc((size_t)segmentSize * segmentCount);
+    if (c->mem == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    memset(c->mem, 0xFF, (size_t)segmentSize * segmentCount);
+    c->budget = -1;
+}
+
+static void Chip_PowerOn(Chip *c)
+{
+    c->dead = false;
+    c->budget = -1;
+}
+
+static NorDevice Chip_Device(Chip *c)
+{
+    NorDevice dev = { Chip_Read, Chip_Program, Chip_Erase, c, c->segmentSize, c->segmentCount };
+    return dev;
+}
+
+/* The store is large (index); one is enough. */
+static NorStore store;
+
+static const char *StatusName(NorStoreStatus st)
+{
+    static const char *const names[] = {
+        "ok", "i/o error", "unformatted", "full", "index full", "too large", "not found", "crc", "state"
+    };
+    return ((unsigned)st < sizeof(names) / sizeof(names[0])) ? names[st] : "?";
+}
+
+/* ---- pack / list ---- */
+
+static uint8_t TypeOf(const char *path)
+{
+    const char *dot = strrchr(path, '.');
+    if (dot != NULL && strcmp(dot, ".mid") == 0) return NOR_STORE_SONG_SMF;
+    if (dot != NULL && strcmp(dot, ".txt") == 0) return NOR_STORE_SONG_TEXT;
+    return NOR_STORE_CHORD_PACK;
+}
+
+static uint8_t *LoadFile(const char *path, uint32_t *size)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return NULL;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *data = malloc((n > 0) ? (size_t)n : 1U);
+    if (data != NULL && n > 0 && fread(data, 1, (size_t)n, f) != (size_t)n) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    *size = (uint32_t)((n > 0) ? n : 0);
+    return data;
+}
+
+static int Pack(Chip *chip, const char *image, int fileCount, char **files)
+{
+    NorDevice dev = Chip_Device(chip);
+    NorStoreStatus st = NorStore_Format(&store, &dev);
+    if (st == NOR_STORE_OK) st = NorStore_Mount(&store, &dev);
+    if (st != NOR_STORE_OK) {
+        fprintf(stderr, "format: %s\n", StatusName(st));
+        return 1;
+    }
+
+    for (int i = 0; i < fileCount; i++)
+    {
+        uint32_t size;
+        uint8_t *data = LoadFile(files[i], &size);
+        if (data == NULL) {
+            fprintf(stderr, "%s: cannot read\n", files[i]);
+            return 1;
+        }
+        uint8_t type = TypeOf(files[i]);
+        const char *name = strrchr(files[i], '/');
+        name = (name != NULL) ? name + 1 : files[i];
+        uint32_t id = (type == NOR_STORE_CHORD_PACK) ? (uint32_t)i + 1U : SongImport_Id(name);
+        st = NorStore_Write(&store, NOR_STORE_KEY(type, id), data, size);
+        free(data);
+        if (st == NOR_STORE_OK && type != NOR_STORE_CHORD_PACK)
+        {
+            char title[SONG_IMPORT_TITLE_MAX + 1U];
+            SongImport_Title(name, title);
+            st = NorStore_Write(&store, NOR_STORE_KEY(NOR_STORE_SONG_TITLE, id), (const uint8_t *)title, (uint32_t)strlen(title));
+        }
+        if (st != NOR_STORE_OK) {
+            fprintf(stderr, "%s: %s\n", files[i], StatusName(st));
+            return 1;
+        }
+    }
+
+    FILE *f = fopen(image, "wb");
+    size_t total = (size_t)chip->segmentSize * chip->segmentCount;
+    if (f == NULL || fwrite(chip->mem, 1, total, f) != total) {
+        fprintf(stderr, "%s: cannot write\n", image);
+        return 1;
+    }
+    fclose(f);
+    fprintf(stderr, "%u items, %u bytes free\n", (unsigned)NorStore_Count(&store), (unsigned)NorStore_FreeBytes(&store));
+    return 0;
+}
+
+static int List(Chip *chip, const char *image)
+{
+    uint32_t size;
+    uint8_t *data = LoadFile(image, &size);
+    if (data == NULL || size != chip->segmentSize * (uint32_t)chip->segmentCount) {
+        fprintf(stderr, "%s: cannot read, or not %u x %u bytes\n", image,
+                (unsigned)chip->segmentCount, (unsigned)chip->segmentSize);
+        return 1;
+    }
+    memcpy(chip->mem, data, size);
+    free(data);
+
+    NorDevice dev = Chip_Device(chip);
+    NorStoreStatus st = NorStore_Mount(&store, &dev);
+    if (st != NOR_STORE_OK) {
+        fprintf(stderr, "mount: %s\n", StatusName(st));
+        return 1;
+    }
+
+    int bad = 0;
+    for (uint16_t i = 0; i < NorStore_Count(&store); i++)
+    {
+        uint32_t key = NorStore_KeyAt(&store, i);
+        NorStoreItem item;
+        SmfSource src;
+
+        if (NorStore_Find(&store, key, &item) != NOR_STORE_OK) { bad++; continue; }
+        st = NorStore_Verify(&item);
+        printf("type %u id %-6u %7u bytes  %s", (unsigned)NOR_STORE_KEY_TYPE(key),
+               (unsigned)NOR_STORE_KEY_ID(key), (unsigned)item.length, StatusName(st));
+        if (st != NOR_STORE_OK) bad++;
+
+        NorStore_Source(&item, &src);
+        if (NOR_STORE_KEY_TYPE(key) == NOR_STORE_SONG_TEXT)
+        {
+            static SongText text;
+            SongStep step;
+            NoteEntry notes[SONG_TEXT_MAX_NOTES];
+            char title[32] = "";
+            unsigned steps = 0;
+
+            if (SongText_Begin(&text, &src, SONG_TEXT_MAX_NOTES) == SONG_TEXT_OK) {
+                (void)SongText_Title(&text, title, sizeof(title));
+                while (SongText_Next(&text, &step, notes)) steps++;
+            }
+            printf("  \"%s\", %u steps", title, steps);
+            if (text.status != SONG_TEXT_OK) printf(", error %u at line %u", (unsigned)text.status, (unsigned)text.at.line);
+        }
+        else if (NOR_STORE_KEY_TYPE(key) == NOR_STORE_SONG_SMF)
+        {
+            static SmfReader smf;
+            SmfEvent ev;
+            unsigned events = 0;
+
+            if (SmfReader_Open(&smf, &src) == SMF_OK) {
+                while (SmfReader_Next(&smf, &ev)) events++;
+            }
+            printf("  %u events", events);
+        }
+        printf("\n");
+    }
+    printf("%u items, %u bytes free\n", (unsigned)NorStore_Count(&store), (unsigned)NorStore_FreeBytes(&store));
+    return bad ? 1 : 0;
+}
+
+/* ---- torture ---- */
+
+#define TORTURE_SEGMENT   (4096U)
+#define TORTURE_SEGMENTS  (16U)
+#define TORTURE_KEYS      (40U)
+#define TORTURE_MAX_LEN   (1500U)
+
+static uint32_t versions[TORTURE_KEYS];   /* 0 = not in the store */
+static uint8_t buf[TORTURE_MAX_LEN];
+static uint8_t got[TORTURE_MAX_LEN];
+
+static uint32_t Mix(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7FEB352DUL;
+    x ^= x >> 15;
+    x *= 0x846CA68BUL;
+    return x ^ (x >> 16);
+}
+
+/* Contents of version `ver` of item `k` */
+static uint32_t Make(uint32_t k, uint32_t ver, uint8_t *out)
+{
+    uint32_t seed = Mix(k * 7919U + ver);
+    uint32_t len = seed % (TORTURE_MAX_LEN + 1U);
+    for (uint32_t i = 0; i < len; i++) out[i] = (uint8_t)Mix(seed + i);
+    return len;
+}
+
+/* 0 = item k matches version ver (0 = absent) */
+static int Check(uint32_t k, uint32_t ver)
+{
+    NorStoreItem item;
+    NorStoreStatus st = NorStore_Find(&store, NOR_STORE_KEY(NOR_STORE_STATS, k), &item);
+
+    if (ver == 0U) return (st == NOR_STORE_ERR_NOT_FOUND) ? 0 : 1;
+    if (st != NOR_STORE_OK) return 1;
+
+    uint32_t len = Make(k, ver, buf);
+    if (item.length != len || !NorStore_Read(&item, 0, got, len) || memcmp(buf, got, len) != 0) return 1;
+    return (NorStore_Verify(&item) == NOR_STORE_OK) ? 0 : 1;
+}
+
+static int Torture(unsigned long ops, unsigned seed)
+{
+    Chip chip;
+    NorDevice dev;
+    unsigned long cuts = 0;
+    unsigned long full = 0;
+    uint32_t nextVersion = 1;
+
+    srand(seed);
+    Chip_Init(&chip, TORTURE_SEGMENT, TORTURE_SEGMENTS);
+    dev = Chip_Device(&chip);
+    if (NorStore_Format(&store, &dev) != NOR_STORE_OK || NorStore_Mount(&store, &dev) != NOR_STORE_OK) {
+        fprintf(stderr, "format failed\n");
+        return 1;
+    }
+
+    for (unsigned long op = 0; op < ops; op++)
+    {
+        uint32_t k = (uint32_t)rand() % TORTURE_KEYS;
+        bool del = (rand() % 5) == 0 && versions[k] != 0U;
+        uint32_t ver = del ? 0U : nextVersion++;
+        NorStoreStatus st;
+
+        if (rand() % 64 == 0) chip.budget = rand() % 6000;
+
+        if (del) {
+            st = NorStore_Delete(&store, NOR_STORE_KEY(NOR_STORE_STATS, k));
+        } else {
+            uint32_t len = Make(k, ver, buf);
+            st = NorStore_Write(&store, NOR_STORE_KEY(NOR_STORE_STATS, k), buf, len);
+        }
+
+        if (chip.dead)
+        {
+            /* Power back: either version of k is fine, everything else must be intact */
+            cuts++;
+            Chip_PowerOn(&chip);
+            st = NorStore_Mount(&store, &dev);
+            if (st != NOR_STORE_OK) {
+                fprintf(stderr, "op %lu: mount after the cut: %s\n", op, StatusName(st));
+                return 1;
+            }
+            if (Check(k, ver) == 0) versions[k] = ver;
+            else if (Check(k, versions[k]) != 0) {
+                fprintf(stderr, "op %lu: item %u is neither the old nor the new version\n", op, (unsigned)k);
+                return 1;
+            }
+        }
+        else
+        {
+            chip.budget = -1;
+            if (st == NOR_STORE_ERR_FULL) full++;
+            else if (st != NOR_STORE_OK) {
+                fprintf(stderr, "op %lu: %s\n", op, StatusName(st));
+                return 1;
+            }
+            else versions[k] = ver;
+        }
+
+        for (uint32_t j = 0; j < TORTURE_KEYS; j++)
+        {
+            if (Check(j, versions[j]) != 0) {
+                fprintf(stderr, "op %lu: item %u does not match\n", op, (unsigned)j);
+                return 1;
+            }
+        }
+    }
+
+    /* Wear: erase counts from the segment headers */
+    uint32_t minErase = UINT32_MAX;
+    uint32_t maxErase = 0;
+    for (uint16_t seg = 0; seg < chip.segmentCount; seg++)
+    {
+        const uint8_t *h = &chip.mem[(size_t)seg * chip.segmentSize + 4U];
+        uint32_t n = (uint32_t)h[0] | ((uint32_t)h[1] << 8) | ((uint32_t)h[2] << 16) | ((uint32_t)h[3] << 24);
+        if (n < minErase) minErase = n;
+        if (n > maxErase) maxErase = n;
+    }
+
+    printf("%lu operations, %lu power cuts, %lu full, %lu erases (per segment %u..%u), %lu overwrites\n",
+           ops, cuts, full, chip.erases, (unsigned)minErase, (unsigned)maxErase, chip.overwrites);
+    printf("%u items, %u bytes free\n", (unsigned)NorStore_Count(&store), (unsigned)NorStore_FreeBytes(&store));
+    free(chip.mem);
+    return (chip.overwrites == 0U) ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t segmentSize = 65536U;
+    uint16_t segmentCount = 32U;
+    int a = 1;
+
+    for (; a + 1 < argc && strncmp(argv[a], "--", 2) == 0; a += 2)
+    {
+        if (strcmp(argv[a], "--segment") == 0) segmentSize = (uint32_t)strtoul(argv[a + 1], NULL, 0);
+        else if (strcmp(argv[a], "--segments") == 0) segmentCount = (uint16_t)strtoul(argv[a + 1], NULL, 0);
+        else break;
+    }
+
+    if (a < argc && strcmp(argv[a], "torture") == 0)
+    {
+        unsigned long ops = (a + 1 < argc) ? strtoul(argv[a + 1], NULL, 0) : 20000UL;
+        unsigned seed = (a + 2 < argc) ? (unsigned)strtoul(argv[a + 2], NULL, 0) : 1U;
+        return Torture(ops, seed);
+    }
+    if (a + 1 < argc && (strcmp(argv[a], "pack") == 0 || strcmp(argv[a], "list") == 0) &&
+        segmentSize >= 1024U && segmentSize % NOR_STORE_BLOCK == 0U)
+    {
+        Chip chip;
+        Chip_Init(&chip, segmentSize, segmentCount);
+        int rc = (argv[a][0] == 'p') ? Pack(&chip, argv[a + 1], argc - a - 2, &argv[a + 2])
+                                     : List(&chip, argv[a + 1]);
+        free(chip.mem);
+        return rc;
+    }
+
+    fprintf(stderr, "usage: store_image [--segment BYTES] [--segments N] pack IMAGE FILE...\n"
+                    "       store_image [--segment BYTES] [--segments N] list IMAGE\n"
+                    "       store_image torture [OPS] [SEED]\n");
+    return 2;
+}
@@ -27,6 +27,9 @@
 /* USER CODE BEGIN Includes */
 #include <stdio.h>
 #include "usbh_midi.h"
+#if STORE_USE_SPI_NOR
+#include "usbh_msc.h"
+#endif
 /* USER CODE END Includes */
 
 /* USER CODE BEGIN PV */
@@ -75,6 +78,10 @@ void MX_USB_HOST_Init(void)
   *	to
   *	(USBH_RegisterClass(&hUsbHostFS, USBH_MIDI_CLASS) != USBH_OK)
   *	it change every time during generating code via STM32CubeMX
+  *
+  *	With STORE_USE_SPI_NOR (main.h) the MSC class (USB stick with songs) is
+  *	registered below, in PostTreatment; it needs USBH_MAX_NUM_SUPPORTED_CLASS
+  *	2U in usbh_conf.h, which CubeMX also resets to 1U.
   */
   /* USER CODE END USB_HOST_Init_PreTreatment */
 
@@ -92,6 +99,13 @@ void MX_USB_HOST_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN USB_HOST_Init_PostTreatment */
+#if STORE_USE_SPI_NOR
+  /* Registered after USBH_Start(): the core only picks a class when a device is enumerated */
+  if (USBH_RegisterClass(&hUsbHostFS, USBH_MSC_CLASS) != USBH_OK)
+  {
+    Error_Handler();
+  }
+#endif
   /* USER CODE END USB_HOST_Init_PostTreatment */
 }
 
@@ -23,7 +23,7 @@
 #include "main.h"
 
 /* USER CODE BEGIN Includes */
-
+#include "latency.h"   /* Latency_Now(): URB-done stamps */
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -32,7 +32,10 @@
 
 /* USER CODE BEGIN PV */
 /* Private variables ---------------------------------------------------------*/
+#define URB_STAMP_CHANNELS  16U
 
+/* Latency_Now() at the last URB_DONE of each host channel (set in the channel interrupt) */
+static volatile uint32_t urbDoneStamp[URB_STAMP_CHANNELS];
 /* USER CODE END PV */
 
 HCD_HandleTypeDef hhcd_USB_OTG_FS;
@@ -197,6 +200,14 @@ void HAL_HCD_Disconnect_Callback(HCD_HandleTypeDef *hhcd)
   */
 void HAL_HCD_HC_NotifyURBChange_Callback(HCD_HandleTypeDef *hhcd, uint8_t chnum, HCD_URBStateTypeDef urb_state)
 {
+  /* USER CODE BEGIN HC_NotifyURBChange */
+  /* Stamp the transfer completion here, not when the class polls the URB state */
+  if (urb_state == URB_DONE && chnum < URB_STAMP_CHANNELS)
+  {
+    urbDoneStamp[chnum] = Latency_Now();
+  }
+  /* USER CODE END HC_NotifyURBChange */
+
   /* To be used with OS to sync URB state with the global state machine */
 #if (USBH_USE_OS == 1)
   USBH_LL_NotifyURBChange(hhcd->pData);
@@ -366,6 +377,18 @@ uint32_t USBH_LL_GetLastXferSize(USBH_HandleTypeDef *phost, uint8_t pipe)
   return HAL_HCD_HC_GetXferCount(phost->pData, pipe);
 }
 
+/* USER CODE BEGIN GetURBDoneStamp */
+/**
+  * @brief  Time of the last completed transfer of a pipe.
+  * @param  pipe: Pipe index
+  * @retval Latency_Now() value taken in the channel interrupt at URB_DONE
+  */
+uint32_t USBH_LL_GetURBDoneStamp(uint8_t pipe)
+{
+  return (pipe < URB_STAMP_CHANNELS) ? urbDoneStamp[pipe] : Latency_Now();
+}
+/* USER CODE END GetURBDoneStamp */
+
 /**
   * @brief  Open a pipe of the low level driver.
   * @param  phost: Host handle
@@ -75,7 +75,11 @@
 #define USBH_KEEP_CFG_DESCRIPTOR      1U
 
 /*----------   -----------*/
+#if STORE_USE_SPI_NOR
+#define USBH_MAX_NUM_SUPPORTED_CLASS      2U
+#else
 #define USBH_MAX_NUM_SUPPORTED_CLASS      1U
+#endif
 
 /*----------   -----------*/
 #define USBH_MAX_SIZE_CONFIGURATION      256U
@@ -175,6 +179,11 @@
 
 /* Exported functions -------------------------------------------------------*/
 
+/* USER CODE BEGIN EXPORTED_FUNCTIONS */
+/* Latency_Now() stamp of the last completed transfer (URB_DONE) of a pipe, taken in the channel interrupt */
+uint32_t USBH_LL_GetURBDoneStamp(uint8_t pipe);
+/* USER CODE END EXPORTED_FUNCTIONS */
+
 /**
   * @}
   */